@@ -22,6 +22,8 @@
 #include "arrow/memory.h"
 #include "arrow/test-util.h"
 
+#include "arrow/types/dictionary.h"
+#include "arrow/types/floating.h"
 #include "arrow/types/integer.h"
 #include "arrow/types/string.h"
 
@@ -112,6 +114,107 @@ TEST_F(TestArray, TestCopy) {
 }
 
 
+TEST_F(TestArray, TestEqualsIgnoresNullSlots) {
+  vector<int32_t> left = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  vector<int32_t> right = {1, -1, 3, 4, -1, 6, 7, 8, 9, 10};
+  vector<uint8_t> nulls = {0, 1, 0, 0, 1, 0, 0, 0, 0, 0};
+
+  Int32Array a(left.size(), to_buffer(left),
+      bytes_to_null_buffer(nulls.data(), nulls.size()));
+  Int32Array b(right.size(), to_buffer(right),
+      bytes_to_null_buffer(nulls.data(), nulls.size()));
+  ASSERT_TRUE(a.Equals(b));
+  ASSERT_TRUE(b.Equals(a));
+
+  // Null in a different slot
+  nulls[1] = 0;
+  Int32Array c(right.size(), to_buffer(right),
+      bytes_to_null_buffer(nulls.data(), nulls.size()));
+  ASSERT_FALSE(a.Equals(c));
+
+  // Same values, but no nulls at all
+  Int32Array d(left.size(), to_buffer(left));
+  ASSERT_FALSE(a.Equals(d));
+  ASSERT_TRUE(d.Equals(d));
+
+  // Different lengths
+  Int32Array e(left.size() - 1, to_buffer(left));
+  ASSERT_FALSE(d.Equals(e));
+}
+
+
+TEST_F(TestArray, TestRangeEquals) {
+  size_t n = 1000;
+  vector<int64_t> values;
+  vector<uint8_t> nulls;
+  randint<int64_t>(n, 0, 100, values);
+  random_nulls(n, 0.2, nulls);
+
+  // Shift the second copy by an offset that is not byte aligned
+  size_t shift = 13;
+  vector<int64_t> shifted(shift, 0);
+  vector<uint8_t> shifted_nulls(shift, 1);
+  shifted.insert(shifted.end(), values.begin(), values.end());
+  shifted_nulls.insert(shifted_nulls.end(), nulls.begin(), nulls.end());
+
+  Int64Array a(n, to_buffer(values), bytes_to_null_buffer(nulls.data(), n));
+  Int64Array b(n + shift, to_buffer(shifted),
+      bytes_to_null_buffer(shifted_nulls.data(), n + shift));
+
+  ASSERT_TRUE(a.RangeEquals(0, n, shift, b));
+  ASSERT_TRUE(a.RangeEquals(100, 700, 100 + shift, b));
+  ASSERT_FALSE(a.RangeEquals(0, n, 0, b));
+
+  // Flip a non-null value in the middle
+  size_t pos = 500;
+  while (nulls[pos]) ++pos;
+  shifted[pos + shift] += 1;
+  ASSERT_FALSE(a.RangeEquals(0, n, shift, b));
+  ASSERT_TRUE(a.RangeEquals(0, pos, shift, b));
+  ASSERT_TRUE(a.RangeEquals(pos + 1, n, pos + 1 + shift, b));
+}
+
+
+TEST_F(TestArray, TestApproxEquals) {
+  vector<double> left = {1.0, 2.0, NAN, 4.0};
+  vector<double> right = {1.0 + 1e-9, 2.0 - 1e-9, NAN, 4.0};
+
+  DoubleArray a(left.size(), to_buffer(left));
+  DoubleArray b(right.size(), to_buffer(right));
+
+  ASSERT_FALSE(a.Equals(b));
+  ASSERT_TRUE(a.ApproxEquals(b));
+  ASSERT_FALSE(a.ApproxEquals(b, 1e-12));
+
+  vector<float> fleft = {1.0f, 2.0f};
+  vector<float> fright = {1.01f, 2.0f};
+  FloatArray fa(fleft.size(), to_buffer(fleft));
+  FloatArray fb(fright.size(), to_buffer(fright));
+  ASSERT_FALSE(fa.ApproxEquals(fb));
+  ASSERT_TRUE(fa.ApproxEquals(fb, 0.1f));
+}
+
+
+TEST_F(TestArray, TestValidate) {
+  ASSERT_OK(arr_->Validate());
+
+  vector<int32_t> values(16, 7);
+  vector<uint8_t> nulls(16, 0);
+  ASSERT_OK(Int32Array(16, to_buffer(values)).Validate());
+  ASSERT_OK(Int32Array(0, nullptr).Validate());
+  ASSERT_TRUE(Int32Array(17, to_buffer(values)).Validate().IsInvalid());
+  ASSERT_TRUE(Int32Array(1, nullptr).Validate().IsInvalid());
+
+  // The 2-byte bitmap covers 16 slots but not 17
+  values.push_back(7);
+  ASSERT_OK(Int32Array(16, to_buffer(values),
+          bytes_to_null_buffer(nulls.data(), nulls.size())).Validate());
+  ASSERT_TRUE(Int32Array(17, to_buffer(values),
+          bytes_to_null_buffer(nulls.data(), nulls.size())).Validate()
+      .IsInvalid());
+}
+
+
 class TestStringArrayBasics : public TestBase {
  public:
   void SetUp() {
@@ -190,6 +293,33 @@ TEST_F(TestStringArrayBasics, TestDestructor) {
   ASSERT_EQ(1, nulls_buf_->ref_count());
 }
 
+TEST_F(TestStringArrayBasics, TestEquals) {
+  // Same logical strings, with a different garbage value in the null slot
+  vector<char> chars = {'a', 'z', 'b', 'b', 'c', 'c', 'c'};
+  vector<int32_t> offsets = {0, 1, 1, 2, 4, 7};
+
+  ArrayPtr values(new UInt8Array(chars.size(), to_buffer(chars)));
+  StringArray other(length_, to_buffer(offsets), values,
+      bytes_to_null_buffer(nulls_.data(), nulls_.size()));
+
+  ASSERT_TRUE(strings_.Equals(other));
+  ASSERT_TRUE(other.Equals(strings_));
+  ASSERT_TRUE(strings_.RangeEquals(3, 5, 3, other));
+
+  // "bb" vs "bc"
+  chars[3] = 'c';
+  ASSERT_FALSE(strings_.Equals(other));
+  ASSERT_TRUE(strings_.RangeEquals(0, 3, 0, other));
+  ASSERT_FALSE(strings_.RangeEquals(3, 4, 3, other));
+  ASSERT_TRUE(strings_.RangeEquals(4, 5, 4, other));
+
+  // A list array of the same layout is a different type
+  ArrayPtr list_values(new UInt8Array(chars_.size(), to_buffer(chars_)));
+  ListArray list(TypePtr(new ListType(TypePtr(new UInt8Type()))), length_,
+      to_buffer(offsets_), list_values);
+  ASSERT_FALSE(strings_.Equals(list));
+}
+
 TEST_F(TestStringArrayBasics, TestGetString) {
   for (size_t i = 0; i < expected_.size(); ++i) {
     if (nulls_[i]) {
@@ -201,4 +331,103 @@ TEST_F(TestStringArrayBasics, TestGetString) {
 }
 
 
+TEST_F(TestStringArrayBasics, TestValidate) {
+  ASSERT_OK(strings_.Validate());
+
+  // Offsets that decrease, start before 0 or end past the values
+  vector<vector<int32_t> > bad_offsets = {{0, 1, 0, 1, 3, 6},
+    {-1, 1, 1, 1, 3, 6}, {0, 1, 1, 1, 3, 7}};
+  for (const vector<int32_t>& offsets : bad_offsets) {
+    StringArray strings(length_, to_buffer(offsets), values_);
+    ASSERT_TRUE(strings.Validate().IsInvalid());
+  }
+
+  // Too few offsets for the length
+  vector<int32_t> short_offsets = {0, 1, 1, 1, 3};
+  StringArray truncated(length_, to_buffer(short_offsets), values_);
+  Status s = truncated.Validate();
+  ASSERT_TRUE(s.IsInvalid());
+  ASSERT_NE(string::npos, s.ToString().find("offsets buffer"));
+
+  // The offsets are within the values, but the values buffer is short
+  ArrayPtr short_values(new UInt8Array(6, to_buffer(vector<char>(5, 'a'))));
+  StringArray short_strings(length_, to_buffer(offsets_), short_values);
+  ASSERT_TRUE(short_strings.Validate().IsInvalid());
+
+  // Values that are not bytes
+  vector<int32_t> ints(6, 0);
+  ArrayPtr int_values(new Int32Array(ints.size(), to_buffer(ints)));
+  StringArray wrong_type;
+  wrong_type.ListArray::Init(TypePtr(new StringType()), length_,
+      to_buffer(offsets_), int_values);
+  ASSERT_TRUE(wrong_type.Validate().IsInvalid());
+
+  // A list of strings validates the strings
+  vector<int32_t> list_offsets = {0, 2, 5};
+  ListArray list(TypePtr(new ListType(TypePtr(new StringType()))), 2,
+      to_buffer(list_offsets), ArrayPtr(new StringArray(length_,
+              to_buffer(bad_offsets[0]), values_)));
+  ASSERT_TRUE(list.Validate().IsInvalid());
+  ListArray good_list(TypePtr(new ListType(TypePtr(new StringType()))), 2,
+      to_buffer(list_offsets), ArrayPtr(new StringArray(length_,
+              to_buffer(offsets_), values_)));
+  ASSERT_OK(good_list.Validate());
+}
+
+
+TEST_F(TestStringArrayBasics, TestValidateUtf8) {
+  ASSERT_OK(strings_.ValidateUtf8());
+
+  // "\xC3\xA9" is a two-byte character
+  vector<char> chars = {'a', '\xC3', '\xA9', 'b', '\xC3', '\xA9'};
+  vector<int32_t> offsets = {0, 3, 3, 6};
+  ArrayPtr values(new UInt8Array(chars.size(), to_buffer(chars)));
+  StringArray strings(3, to_buffer(offsets), values);
+  ASSERT_OK(strings.Validate());
+  ASSERT_OK(strings.ValidateUtf8());
+
+  // Valid bytes as a whole, but a slot starts in the middle of a character
+  vector<int32_t> split = {0, 2, 2, 6};
+  StringArray split_strings(3, to_buffer(split), values);
+  Status s = split_strings.ValidateUtf8();
+  ASSERT_TRUE(s.IsInvalid());
+  ASSERT_NE(string::npos, s.ToString().find("string 0"));
+
+  chars[5] = 'x';
+  s = strings.ValidateUtf8();
+  ASSERT_TRUE(s.IsInvalid());
+  ASSERT_NE(string::npos, s.ToString().find("string 2"));
+}
+
+
+TEST(TestDictionaryArray, TestValidate) {
+  vector<int32_t> dict_offsets = {0, 1, 2};
+  vector<char> dict_chars = {'a', 'b'};
+  ArrayPtr dictionary(new StringArray(2, to_buffer(dict_offsets),
+          ArrayPtr(new UInt8Array(2, to_buffer(dict_chars)))));
+  TypePtr type(new DictionaryType(TypePtr(new Int16Type()),
+          TypePtr(new StringType())));
+
+  // An out of range index in a null slot is ignored
+  vector<int16_t> indices = {0, 1, 5, 1};
+  vector<uint8_t> nulls = {0, 0, 1, 0};
+  DictionaryArray array(type, ArrayPtr(new Int16Array(indices.size(),
+              to_buffer(indices),
+              bytes_to_null_buffer(nulls.data(), nulls.size()))), dictionary);
+  ASSERT_OK(array.Validate());
+
+  nulls[2] = 0;
+  indices[2] = -1;
+  DictionaryArray bad(type, ArrayPtr(new Int16Array(indices.size(),
+              to_buffer(indices))), dictionary);
+  Status s = bad.Validate();
+  ASSERT_TRUE(s.IsInvalid());
+  ASSERT_NE(string::npos, s.ToString().find("slot 2"));
+
+  vector<int64_t> wide = {0, 1};
+  DictionaryArray wide_indices(type, ArrayPtr(new Int64Array(wide.size(),
+              to_buffer(wide))), dictionary);
+  ASSERT_TRUE(wide_indices.Validate().IsInvalid());
+}
+
 } // namespace arrow
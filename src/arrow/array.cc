@@ -25,9 +25,28 @@ void Array::Init(const TypePtr& type, size_t length, Buffer* nulls) {
   nulls_ = nulls;
 
   nullable_ = type->nullable;
-  if (nulls != nullptr) {
-    null_bits_ = nulls->data();
+  null_bits_ = nulls == nullptr ? nullptr : nulls->data();
+}
+
+bool Array::Equals(const Array& other) const {
+  if (this == &other) return true;
+  if (length_ != other.length_) return false;
+  return RangeEquals(0, length_, 0, other);
+}
+
+bool Array::RangeEquals(size_t start, size_t end, size_t other_start,
+    const Array& other) const {
+  // The base class has no values, only nulls
+  if (type_enum() != other.type_enum()) return false;
+  return util::bitmaps_equal(null_bits_, start, other.null_bits_, other_start,
+      end - start);
+}
+
+Status Array::Validate() const {
+  if (nulls_ != nullptr && nulls_->size() < (length_ + 7) / 8) {
+    return Status::Invalid("null bitmap is smaller than the array length");
   }
+  return Status::OK();
 }
 
 // ----------------------------------------------------------------------
@@ -40,17 +59,4 @@ void PrimitiveArray::Init(const TypePtr& type, size_t length, Buffer* data,
   raw_data_ = data == nullptr? nullptr : data_->data();
 }
 
-bool PrimitiveArray::Equals(const PrimitiveArray& other) const {
-  if (this == &other) return true;
-  if (type_->nullable != other.type_->nullable) return false;
-
-  bool equal_data = data_->Equals(*other.data_, length_);
-  if (type_->nullable) {
-    return equal_data &&
-      nulls_->Equals(*other.nulls_, util::ceil_byte(length_) / 8);
-  } else {
-    return equal_data;
-  }
-}
-
 } // namespace arrow
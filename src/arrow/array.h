@@ -18,9 +18,11 @@
 #define ARROW_ARRAY_H
 
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "arrow/memory.h"
+#include "arrow/statistics.h"
 #include "arrow/types.h"
 
 #include "arrow/util/bit-util.h"
@@ -41,7 +43,7 @@ namespace arrow {
 class Array {
  public:
 
-  Array() : length_(0), nulls_(nullptr), null_bits_(nullptr) {}
+  Array() : nullable_(false), length_(0), nulls_(nullptr), null_bits_(nullptr) {}
 
   Array(const TypePtr& type, size_t length, Buffer* nulls = nullptr) {
     Init(type, length, nulls);
@@ -65,6 +67,33 @@ class Array {
   const TypePtr& type() const { return type_;}
   TypeEnum type_enum() const { return type_->type;}
 
+  Buffer* nulls() const { return nulls_;}
+  const uint8_t* null_bits() const { return null_bits_;}
+
+  // Logical equality: both arrays have the same type and length, the same
+  // slots are null, and all non-null slots hold equal values. Whatever is
+  // stored in the null slots is ignored
+  bool Equals(const Array& other) const;
+
+  // Compare the slots [start, end) of this array with the slots
+  // [other_start, other_start + end - start) of other, using the same
+  // semantics as Equals. Does *not* boundscheck
+  virtual bool RangeEquals(size_t start, size_t end, size_t other_start,
+      const Array& other) const;
+
+  // Check that the buffers are large enough for the length and that any
+  // offsets or indices stay within the child arrays, so that every slot can
+  // be read safely. Meant for arrays assembled from untrusted input; returns
+  // Invalid describing the first problem found
+  virtual Status Validate() const;
+
+  // Zone-map statistics attached by the builder of the array, or nullptr if
+  // there are none
+  const StatisticsPtr& statistics() const { return statistics_;}
+  void set_statistics(const StatisticsPtr& statistics) {
+    statistics_ = statistics;
+  }
+
   // virtual Array* Copy() = 0;
 
  protected:
@@ -75,12 +104,18 @@ class Array {
   Buffer* nulls_;
   const uint8_t* null_bits_;
 
+  StatisticsPtr statistics_;
+
   DISALLOW_COPY_AND_ASSIGN(Array);
 };
 
 
 typedef std::shared_ptr<Array> ArrayPtr;
 
+// Arrays of NullType need nothing but the base class, with every bit of the
+// null bitmap set
+typedef Array NullArray;
+
 
 // Base class for fixed-size logical types
 class PrimitiveArray : public Array {
@@ -98,8 +133,6 @@ class PrimitiveArray : public Array {
 
   Buffer* data() const { return data_;}
 
-  bool Equals(const PrimitiveArray& other) const;
-
  protected:
   Buffer* data_;
   const uint8_t* raw_data_;
@@ -122,8 +155,48 @@ class PrimitiveArrayImpl : public PrimitiveArray {
     PrimitiveArray::Init(type, length, data, nulls);
   }
 
-  bool Equals(const PrimitiveArrayImpl& other) const {
-    return PrimitiveArray::Equals(*static_cast<const PrimitiveArray*>(&other));
+  // Values are compared bitwise, so for floating point types NaN equals NaN
+  // and 0.0 does not equal -0.0. See ApproxEquals for a tolerant comparison
+  virtual bool RangeEquals(size_t start, size_t end, size_t other_start,
+      const Array& other) const {
+    if (this == &other && start == other_start) return true;
+    if (type_enum() != other.type_enum()) return false;
+
+    // Compare as same-width unsigned integers
+    typedef typename util::uint_for_width<sizeof(T)>::type U;
+    const auto& o = static_cast<const PrimitiveArrayImpl&>(other);
+    const U* left = reinterpret_cast<const U*>(raw_data()) + start;
+    const U* right = reinterpret_cast<const U*>(o.raw_data()) + other_start;
+
+    return util::masked_equals(left, null_bits_, start, right, o.null_bits(),
+        other_start, end - start,
+        [](U a, U b) { return a == b; });
+  }
+
+  // Like Equals, except floating point values match if they are within
+  // epsilon of each other (or are both NaN)
+  bool ApproxEquals(const PrimitiveArrayImpl& other,
+      T epsilon = static_cast<T>(1e-5)) const {
+    static_assert(std::is_floating_point<T>::value,
+        "ApproxEquals requires a floating point type");
+    if (length_ != other.length_) return false;
+    if (type_enum() != other.type_enum()) return false;
+
+    return util::masked_equals(raw_data(), null_bits_, 0, other.raw_data(),
+        other.null_bits(), 0, length_,
+        [epsilon](T a, T b) {
+          T diff = a > b ? a - b : b - a;
+          return diff <= epsilon || a == b || (a != a && b != b);
+        });
+  }
+
+  virtual Status Validate() const {
+    RETURN_NOT_OK(Array::Validate());
+    size_t size = data_ == nullptr ? 0 : data_->size();
+    if (size / sizeof(T) < length_) {
+      return Status::Invalid("data buffer is smaller than the array length");
+    }
+    return Status::OK();
   }
 
   const T* raw_data() const { return reinterpret_cast<const T*>(raw_data_);}
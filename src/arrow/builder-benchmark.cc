@@ -0,0 +1,121 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/string.h"
+#include "arrow/util/benchmark-util.h"
+
+namespace arrow {
+
+static constexpr size_t kNumValues = 10000000;
+
+// Append kNumValues values one at a time and build the array
+static void BenchmarkInt32(MemoryPool* pool, bool nullable) {
+  TypePtr type(new Int32Type(nullable));
+  std::string suffix = nullable ? "/nullable" : "/non-nullable";
+  size_t bytes = kNumValues * sizeof(int32_t);
+
+  benchmark::run(("Int32 Append" + suffix).c_str(), bytes, [&]() {
+        Int32Builder builder(pool, type);
+        for (size_t i = 0; i < kNumValues; ++i) {
+          BENCHMARK_OK(builder.Append(static_cast<int32_t>(i)));
+        }
+        Array* out;
+        BENCHMARK_OK(builder.ToArray(&out));
+        delete out;
+      });
+  benchmark::run(("Int32 UnsafeAppend" + suffix).c_str(), bytes, [&]() {
+        Int32Builder builder(pool, type);
+        BENCHMARK_OK(builder.Reserve(kNumValues));
+        for (size_t i = 0; i < kNumValues; ++i) {
+          builder.UnsafeAppend(static_cast<int32_t>(i));
+        }
+        Array* out;
+        BENCHMARK_OK(builder.ToArray(&out));
+        delete out;
+      });
+}
+
+static void BenchmarkString(MemoryPool* pool) {
+  TypePtr type(new StringType());
+  const uint8_t* value = reinterpret_cast<const uint8_t*>("abcdefgh");
+  size_t length = 8;
+  size_t bytes = kNumValues * (length + sizeof(int32_t));
+
+  benchmark::run("String Append", bytes, [&]() {
+        StringBuilder builder(pool, type);
+        for (size_t i = 0; i < kNumValues; ++i) {
+          BENCHMARK_OK(builder.Append(value, length));
+        }
+        Array* out;
+        BENCHMARK_OK(builder.ToArray(&out));
+        delete out;
+      });
+  benchmark::run("String UnsafeAppend", bytes, [&]() {
+        StringBuilder builder(pool, type);
+        BENCHMARK_OK(builder.Reserve(kNumValues));
+        BENCHMARK_OK(builder.ReserveData(kNumValues * length));
+        for (size_t i = 0; i < kNumValues; ++i) {
+          builder.UnsafeAppend(value, length);
+        }
+        Array* out;
+        BENCHMARK_OK(builder.ToArray(&out));
+        delete out;
+      });
+
+  // Bulk appends of the layouts decoders produce: views into an input buffer
+  // and string-array offsets
+  std::vector<uint8_t> data(kNumValues * length, 'a');
+  std::vector<StringView> views(kNumValues);
+  std::vector<int32_t> offsets(kNumValues + 1);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    views[i].data = data.data() + i * length;
+    views[i].length = length;
+    offsets[i] = static_cast<int32_t>(i * length);
+  }
+  offsets[kNumValues] = static_cast<int32_t>(kNumValues * length);
+
+  benchmark::run("String bulk Append views", bytes, [&]() {
+        StringBuilder builder(pool, type);
+        BENCHMARK_OK(builder.Append(views.data(), kNumValues));
+        Array* out;
+        BENCHMARK_OK(builder.ToArray(&out));
+        delete out;
+      });
+  benchmark::run("String bulk Append offsets", bytes, [&]() {
+        StringBuilder builder(pool, type);
+        BENCHMARK_OK(builder.Append(offsets.data(), data.data(), kNumValues));
+        Array* out;
+        BENCHMARK_OK(builder.ToArray(&out));
+        delete out;
+      });
+}
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::BenchmarkInt32(&pool, false);
+  arrow::BenchmarkInt32(&pool, true);
+  arrow::BenchmarkString(&pool);
+  return 0;
+}
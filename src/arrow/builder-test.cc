@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -22,9 +25,16 @@
 #include "arrow/memory.h"
 #include "arrow/test-util.h"
 
+#include "arrow/types/boolean.h"
+#include "arrow/types/datetime.h"
+#include "arrow/types/dictionary.h"
+#include "arrow/types/floating.h"
 #include "arrow/types/integer.h"
+#include "arrow/types/json.h"
 #include "arrow/types/list.h"
 #include "arrow/types/string.h"
+#include "arrow/types/struct.h"
+#include "arrow/types/union.h"
 
 using std::string;
 using std::unique_ptr;
@@ -292,6 +302,217 @@ TYPED_TEST(TestPrimitiveBuilder, TestAppendVector) {
   this->CheckNonNullable();
 }
 
+TYPED_TEST(TestPrimitiveBuilder, TestAppendBitmap) {
+  PLIFT_TYPEDEFS();
+
+  size_t size = 10000;
+  this->RandomData(size);
+  vector<T>& draws = this->draws_;
+  vector<uint8_t>& nulls = this->nulls_;
+
+  // The bitmap starts 3 bits in, and the pieces end at unaligned positions
+  size_t shift = 3;
+  vector<uint8_t> shifted(shift, 1);
+  shifted.insert(shifted.end(), nulls.begin(), nulls.end());
+  Buffer* bits = bytes_to_null_buffer(shifted.data(), shifted.size());
+
+  vector<size_t> pieces = {0, 1, 63, 64, 100, 1000, 5};
+  size_t pos = 0;
+  for (size_t piece : pieces) {
+    ASSERT_OK(this->builder_->Append(draws.data() + pos, piece,
+            bits->data(), shift + pos));
+    ASSERT_OK(this->builder_nn_->Append(draws.data() + pos, piece,
+            bits->data(), shift + pos));
+    pos += piece;
+  }
+  ASSERT_OK(this->builder_->Append(draws.data() + pos, size - pos,
+          bits->data(), shift + pos));
+  ASSERT_OK(this->builder_nn_->Append(draws.data() + pos, size - pos,
+          nullptr, 0));
+  bits->Decref();
+
+  this->CheckNullable();
+  this->CheckNonNullable();
+}
+
+TYPED_TEST(TestPrimitiveBuilder, TestAppendArray) {
+  PLIFT_TYPEDEFS();
+
+  size_t size = 10000;
+  this->RandomData(size);
+  vector<T>& draws = this->draws_;
+  vector<uint8_t>& nulls = this->nulls_;
+
+  ArrayType values;
+  values.Init(size, to_buffer(draws),
+      bytes_to_null_buffer(nulls.data(), size));
+  ASSERT_OK(this->builder_->Append(values, 0, 77));
+  ASSERT_OK(this->builder_->Append(values, 77, 0));
+  ASSERT_OK(this->builder_->Append(values, 77, size - 77));
+  ASSERT_TRUE(this->builder_->Append(values, 1, size).IsInvalid());
+  this->CheckNullable();
+
+  Int8Array other(0, nullptr);
+  UInt8Array uint8s(0, nullptr);
+  const Array& mismatched = values.type_enum() == TypeEnum::INT8 ?
+    static_cast<const Array&>(uint8s) : static_cast<const Array&>(other);
+  ASSERT_TRUE(this->builder_->Append(mismatched, 0, 0).IsInvalid());
+}
+
+TYPED_TEST(TestPrimitiveBuilder, TestUnsafeAppend) {
+  PLIFT_TYPEDEFS();
+
+  size_t size = 10000;
+  this->RandomData(size);
+  vector<T>& draws = this->draws_;
+  vector<uint8_t>& nulls = this->nulls_;
+
+  ASSERT_OK(this->builder_->Reserve(size));
+  ASSERT_OK(this->builder_nn_->Reserve(size));
+  for (size_t i = 0; i < 1000; ++i) {
+    if (nulls[i]) {
+      this->builder_->UnsafeAppendNull();
+    } else {
+      this->builder_->UnsafeAppend(draws[i]);
+    }
+    this->builder_nn_->UnsafeAppend(draws[i]);
+  }
+  ASSERT_OK(this->builder_->Append(draws.data() + 1000, size - 1000,
+          nulls.data() + 1000));
+  this->builder_nn_->UnsafeAppend(draws.data() + 1000, size - 1000);
+  ASSERT_EQ(util::next_power2(size), this->builder_->capacity());
+
+  this->CheckNullable();
+  this->CheckNonNullable();
+}
+
+TYPED_TEST(TestPrimitiveBuilder, TestSizing) {
+  PLIFT_TYPEDEFS();
+
+  size_t size = 1000;
+  this->RandomData(size);
+  vector<T>& draws = this->draws_;
+
+  this->builder_->set_sizing(BuilderSizing::LAST_LENGTH);
+  ASSERT_OK(this->builder_->Append(draws.data(), size));
+  unique_ptr<ArrayType> first(new ArrayType());
+  ASSERT_OK(this->builder_->Transfer(first.get()));
+
+  // The capacity of the next batch is reserved right away, so a batch of
+  // the same size does not reallocate
+  ASSERT_EQ(size, this->builder_->capacity());
+  Buffer* reserved = this->builder_->buffer();
+  for (size_t i = 0; i < size; ++i) {
+    ASSERT_OK(this->builder_->Append(draws[i]));
+  }
+  ASSERT_EQ(reserved, this->builder_->buffer());
+  ASSERT_EQ(size, this->builder_->capacity());
+
+  // Once the first array is gone, its buffer is taken back for the third
+  Buffer* first_values = first->data();
+  first.reset();
+  ArrayType second;
+  ASSERT_OK(this->builder_->Transfer(&second));
+  ASSERT_EQ(first_values, this->builder_->buffer());
+  ASSERT_OK(this->builder_->Append(draws.data(), 10));
+
+  // The second array is still alive, so its buffer is not reused
+  ArrayType third;
+  ASSERT_OK(this->builder_->Transfer(&third));
+  ASSERT_NE(second.data(), this->builder_->buffer());
+  ASSERT_EQ(10, this->builder_->capacity());
+
+  Buffer* ex_data = new Buffer(reinterpret_cast<uint8_t*>(draws.data()),
+      size * sizeof(T), false);
+  ArrayType expected;
+  expected.Init(size, ex_data);
+  ASSERT_TRUE(second.Equals(expected));
+
+  // The moving average follows the lengths a quarter of the way
+  this->builder_nn_->set_sizing(BuilderSizing::MOVING_AVERAGE);
+  ArrayType results[3];
+  for (size_t length : {1000, 2000, 0}) {
+    ASSERT_OK(this->builder_nn_->Append(draws.data(), std::min(length, size)));
+    for (size_t i = size; i < length; ++i) {
+      ASSERT_OK(this->builder_nn_->Append(draws[0]));
+    }
+    ASSERT_OK(this->builder_nn_->Transfer(&results[length / 1000]));
+  }
+  ASSERT_EQ(938, this->builder_nn_->capacity());
+}
+
+TYPED_TEST(TestPrimitiveBuilder, TestStatistics) {
+  PLIFT_TYPEDEFS();
+
+  size_t size = 10000;
+  this->RandomData(size);
+  vector<T>& draws = this->draws_;
+  vector<uint8_t>& nulls = this->nulls_;
+
+  // Half scalar appends, half vector appends
+  size_t K = size / 2;
+  for (size_t i = 0; i < K; ++i) {
+    ASSERT_OK(this->builder_->Append(draws[i], nulls[i] > 0));
+  }
+  ASSERT_OK(this->builder_->Append(draws.data() + K, size - K,
+          nulls.data() + K));
+
+  T ex_min = std::numeric_limits<T>::max();
+  T ex_max = std::numeric_limits<T>::lowest();
+  size_t ex_null_count = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (nulls[i]) {
+      ++ex_null_count;
+    } else {
+      ex_min = std::min(ex_min, draws[i]);
+      ex_max = std::max(ex_max, draws[i]);
+    }
+  }
+
+  ArrayType result;
+  ASSERT_OK(this->builder_->Transfer(&result));
+  const TypedStatistics<T>& stats =
+    static_cast<const TypedStatistics<T>&>(*result.statistics());
+  ASSERT_EQ(ex_null_count, stats.null_count);
+  ASSERT_TRUE(stats.has_min_max);
+  ASSERT_EQ(ex_min, stats.min);
+  ASSERT_EQ(ex_max, stats.max);
+  ASSERT_TRUE(stats.MayOverlap(ex_max, ex_max));
+  if (ex_min > std::numeric_limits<T>::lowest()) {
+    ASSERT_FALSE(stats.MayOverlap(std::numeric_limits<T>::lowest(),
+            ex_min - 1));
+  }
+
+  // The statistics start over, and without values there is no min or max
+  ASSERT_OK(this->builder_->AppendNull());
+  ArrayType nulls_only;
+  ASSERT_OK(this->builder_->Transfer(&nulls_only));
+  ASSERT_EQ(1, nulls_only.statistics()->null_count);
+  ASSERT_FALSE(nulls_only.statistics()->has_min_max);
+
+  // Values written through Advance are not seen
+  ASSERT_OK(this->builder_nn_->Reserve(10));
+  ASSERT_OK(this->builder_nn_->Advance(10));
+  ArrayType advanced;
+  ASSERT_OK(this->builder_nn_->Transfer(&advanced));
+  ASSERT_EQ(nullptr, advanced.statistics());
+
+  // Nor are any values with statistics turned off, until turned back on
+  this->builder_nn_->set_collect_statistics(false);
+  ASSERT_OK(this->builder_nn_->Reserve(11));
+  ASSERT_OK(this->builder_nn_->Append(draws.data(), 10));
+  this->builder_nn_->UnsafeAppend(draws[0]);
+  ArrayType unseen;
+  ASSERT_OK(this->builder_nn_->Transfer(&unseen));
+  ASSERT_EQ(nullptr, unseen.statistics());
+
+  this->builder_nn_->set_collect_statistics(true);
+  ASSERT_OK(this->builder_nn_->Append(draws[0]));
+  ArrayType seen;
+  ASSERT_OK(this->builder_nn_->Transfer(&seen));
+  ASSERT_TRUE(seen.statistics()->has_min_max);
+}
+
 TYPED_TEST(TestPrimitiveBuilder, TestAdvance) {
   size_t n = 1000;
   ASSERT_OK(this->builder_->Init(n));
@@ -417,6 +638,27 @@ TEST_F(TestListBuilder, TestBasics) {
   }
 }
 
+TEST_F(TestListBuilder, TestUnsafeAppend) {
+  Int32Builder* vb = static_cast<Int32Builder*>(builder_->value_builder());
+  ASSERT_OK(builder_->Reserve(3));
+  ASSERT_OK(vb->Reserve(3));
+  builder_->UnsafeAppend();
+  vb->UnsafeAppend(1);
+  vb->UnsafeAppend(2);
+  builder_->UnsafeAppendNull();
+  builder_->UnsafeAppend();
+  vb->UnsafeAppend(3);
+
+  Done();
+  ASSERT_OK(result_->Validate());
+  vector<int32_t> ex_offsets = {0, 2, 2, 3};
+  for (size_t i = 0; i < ex_offsets.size(); ++i) {
+    ASSERT_EQ(ex_offsets[i], result_->offset(i));
+  }
+  ASSERT_TRUE(result_->IsNull(1));
+  ASSERT_FALSE(result_->IsNull(2));
+}
+
 TEST_F(TestListBuilder, TestBasicsNonNullable) {
 
 }
@@ -502,4 +744,782 @@ TEST_F(TestStringBuilder, TestZeroLength) {
   Done();
 }
 
+TEST_F(TestStringBuilder, TestUnsafeAppend) {
+  vector<string> strings = {"a", "bb", "", "", "ccc"};
+  vector<uint8_t> is_null = {0, 0, 0, 1, 0};
+  size_t reps = 100;
+
+  ASSERT_OK(builder_->Reserve(reps * strings.size()));
+  ASSERT_OK(builder_->ReserveData(reps * 6));
+  for (size_t j = 0; j < reps; ++j) {
+    for (size_t i = 0; i < strings.size(); ++i) {
+      if (is_null[i]) {
+        builder_->UnsafeAppendNull();
+      } else {
+        builder_->UnsafeAppend(strings[i]);
+      }
+    }
+  }
+  ASSERT_EQ(reps * strings.size(), builder_->length());
+  Done();
+
+  ASSERT_OK(result_->Validate());
+  for (size_t i = 0; i < result_->length(); ++i) {
+    size_t k = i % strings.size();
+    ASSERT_EQ(static_cast<bool>(is_null[k]), result_->IsNull(i));
+    ASSERT_EQ(strings[k], result_->GetString(i));
+  }
+  ASSERT_EQ("", static_cast<const TypedStatistics<string>&>(
+          *result_->statistics()).min);
+}
+
+TEST_F(TestStringBuilder, TestSizing) {
+  builder_->set_sizing(BuilderSizing::LAST_LENGTH);
+  ASSERT_EQ(BuilderSizing::LAST_LENGTH, builder_->value_builder()->sizing());
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_OK(builder_->Append("abc"));
+  }
+  Done();
+  ASSERT_EQ(300, builder_->capacity());
+  ASSERT_EQ(900, builder_->value_builder()->capacity());
+
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_OK(builder_->Append("xyz"));
+  }
+  Done();
+  ASSERT_OK(result_->Validate());
+  ASSERT_EQ(300, result_->length());
+  ASSERT_EQ("xyz", result_->GetString(299));
+  ASSERT_EQ(900, result_->offset(300));
+}
+
+TEST_F(TestStringBuilder, TestStatistics) {
+  vector<string> strings = {"bb", "", "b", "c", "ba"};
+  for (const string& value : strings) {
+    ASSERT_OK(builder_->Append(value));
+  }
+  ASSERT_OK(builder_->AppendNull());
+  Done();
+
+  const TypedStatistics<string>& stats =
+    static_cast<const TypedStatistics<string>&>(*result_->statistics());
+  ASSERT_EQ(1, stats.null_count);
+  ASSERT_TRUE(stats.has_min_max);
+  ASSERT_EQ("", stats.min);
+  ASSERT_EQ("c", stats.max);
+  ASSERT_FALSE(stats.MayOverlap("d", "e"));
+
+  ASSERT_OK(builder_->AppendNull());
+  Done();
+  ASSERT_FALSE(result_->statistics()->has_min_max);
+}
+
+TEST_F(TestStringBuilder, TestNoByteStatistics) {
+  ASSERT_OK(builder_->Append("abc"));
+  const uint8_t bytes[] = {'x', 'y'};
+  ASSERT_OK(builder_->Reserve(1));
+  ASSERT_OK(builder_->ReserveData(2));
+  builder_->UnsafeAppend(bytes, 2);
+  Done();
+
+  // Only the strings have statistics, not their bytes
+  ASSERT_TRUE(result_->statistics() != nullptr);
+  ASSERT_TRUE(result_->values()->statistics() == nullptr);
+  ASSERT_EQ("abc", result_->GetString(0));
+  ASSERT_EQ("xy", result_->GetString(1));
+}
+
+TEST_F(TestStringBuilder, TestBulkAppend) {
+  ASSERT_OK(builder_->Append("x"));
+
+  // The null slot's view is ignored
+  const char* chars = "dd" "e" "ffff";
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(chars);
+  vector<StringView> views = {{data, 2}, {nullptr, 0}, {data + 2, 1},
+                              {data, 100}, {data + 3, 4}};
+  vector<uint8_t> view_nulls = {0, 0, 0, 1, 0};
+  ASSERT_OK(builder_->Append(views.data(), views.size(), view_nulls.data()));
+
+  // Offsets starting past zero, with a null slot keeping its bytes
+  vector<int32_t> offsets = {2, 3, 3, 7};
+  vector<uint8_t> offset_nulls = {0, 1, 0};
+  ASSERT_OK(builder_->Append(offsets.data(), data, 3, offset_nulls.data()));
+
+  ASSERT_OK(builder_->Append(vector<string>{"gg", "a"}, nullptr));
+  ASSERT_OK(builder_->Append(views.data(), 0));
+  Done();
+
+  ASSERT_OK(result_->Validate());
+  vector<string> expected = {"x", "dd", "", "e", "", "ffff", "e", "", "ffff",
+                             "gg", "a"};
+  vector<int32_t> ex_offsets = {0, 1, 3, 3, 4, 4, 8, 9, 9, 13, 15, 16};
+  ASSERT_EQ(expected.size(), result_->length());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], result_->GetString(i));
+    ASSERT_EQ(ex_offsets[i], result_->offset(i));
+    ASSERT_EQ(i == 4 || i == 7, result_->IsNull(i));
+  }
+  ASSERT_EQ(ex_offsets.back(), result_->values()->length());
+
+  const TypedStatistics<string>& stats =
+    static_cast<const TypedStatistics<string>&>(*result_->statistics());
+  ASSERT_EQ(2, stats.null_count);
+  ASSERT_EQ("", stats.min);
+  ASSERT_EQ("x", stats.max);
+}
+
+TEST_F(TestStringBuilder, TestBulkAppendMatchesScalar) {
+  // Enough values to run the vectorized prefix sum, with a tail
+  size_t length = 1003;
+  string chars(length, 'a');
+  vector<StringView> views(length);
+  vector<uint8_t> nulls(length);
+  for (size_t i = 0; i < length; ++i) {
+    views[i].data = reinterpret_cast<const uint8_t*>(chars.data()) + i % 7;
+    views[i].length = (i * 31) % 17;
+    nulls[i] = i % 5 == 0;
+  }
+
+  LargeStringBuilder scalar(pool_.get(), TypePtr(new LargeStringType()));
+  LargeStringBuilder bulk(pool_.get(), TypePtr(new LargeStringType()));
+  for (size_t i = 0; i < length; ++i) {
+    if (nulls[i]) {
+      ASSERT_OK(scalar.AppendNull());
+    } else {
+      ASSERT_OK(scalar.Append(views[i].data, views[i].length));
+    }
+  }
+  ASSERT_OK(bulk.Append(views.data(), length, nulls.data()));
+
+  LargeStringArray expected, result;
+  ASSERT_OK(scalar.Transfer(&expected));
+  ASSERT_OK(bulk.Transfer(&result));
+  ASSERT_OK(result.Validate());
+  ASSERT_TRUE(result.Equals(expected));
+  for (size_t i = 0; i <= length; ++i) {
+    ASSERT_EQ(expected.offset(i), result.offset(i));
+  }
+}
+
+TEST_F(TestBuilder, TestFloatStatistics) {
+  DoubleBuilder builder(pool_.get(), TypePtr(new DoubleType()));
+  vector<double> values = {NAN, 2.5, -1, NAN, 7};
+  vector<uint8_t> nulls = {0, 0, 0, 0, 1};
+  ASSERT_OK(builder.Append(values.data(), values.size(), nulls.data()));
+  ASSERT_OK(builder.Append(NAN));
+
+  DoubleArray result;
+  ASSERT_OK(builder.Transfer(&result));
+  const TypedStatistics<double>& stats =
+    static_cast<const TypedStatistics<double>&>(*result.statistics());
+  ASSERT_EQ(1, stats.null_count);
+  ASSERT_EQ(-1, stats.min);
+  ASSERT_EQ(2.5, stats.max);
+
+  // Only NaN
+  ASSERT_OK(builder.Append(NAN));
+  DoubleArray nan_only;
+  ASSERT_OK(builder.Transfer(&nan_only));
+  ASSERT_FALSE(nan_only.statistics()->has_min_max);
+}
+
+TEST_F(TestBuilder, TestLargeStringBuilder) {
+  ArrayBuilder* tmp;
+  ASSERT_OK(make_builder(pool_.get(), TypePtr(new LargeStringType()), &tmp));
+  unique_ptr<LargeStringBuilder> builder(static_cast<LargeStringBuilder*>(tmp));
+
+  vector<string> strings = {"a", "bb", "", "ccc"};
+  for (const string& value : strings) {
+    ASSERT_OK(builder->Append(value));
+  }
+  ASSERT_OK(builder->AppendNull());
+
+  Array* out;
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<LargeStringArray> result(static_cast<LargeStringArray*>(out));
+  ASSERT_OK(result->Validate());
+  ASSERT_EQ(TypeEnum::LARGE_STRING, result->type_enum());
+  ASSERT_EQ(5, result->length());
+
+  vector<int64_t> ex_offsets = {0, 1, 3, 3, 6, 6};
+  for (size_t i = 0; i < ex_offsets.size(); ++i) {
+    ASSERT_EQ(ex_offsets[i], result->offset(i));
+  }
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ASSERT_EQ(strings[i], result->GetString(i));
+  }
+  ASSERT_TRUE(result->IsNull(4));
+}
+
+TEST_F(TestBuilder, TestLargeListBuilder) {
+  TypePtr type(new LargeListType(TypePtr(new Int32Type())));
+  ArrayBuilder* tmp;
+  ASSERT_OK(make_builder(pool_.get(), type, &tmp));
+  unique_ptr<LargeListBuilder> builder(static_cast<LargeListBuilder*>(tmp));
+  Int32Builder* vb = static_cast<Int32Builder*>(builder->value_builder());
+
+  ASSERT_OK(builder->Append());
+  ASSERT_OK(vb->Append(1));
+  ASSERT_OK(vb->Append(2));
+  ASSERT_OK(builder->AppendNull());
+  ASSERT_OK(builder->Append());
+  ASSERT_OK(vb->Append(3));
+
+  Array* out;
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<LargeListArray> result(static_cast<LargeListArray*>(out));
+  ASSERT_OK(result->Validate());
+  ASSERT_EQ(TypeEnum::LARGE_LIST, result->type_enum());
+  vector<int64_t> ex_offsets = {0, 2, 2, 3};
+  for (size_t i = 0; i < ex_offsets.size(); ++i) {
+    ASSERT_EQ(ex_offsets[i], result->offset(i));
+  }
+  ASSERT_TRUE(result->IsNull(1));
+  ASSERT_EQ(1, result->value_length(2));
+}
+
+TEST_F(TestBuilder, TestTemporalBuilders) {
+  TypePtr type(new TimestampType(TimestampType::Unit::NANO));
+  ArrayBuilder* tmp;
+  ASSERT_OK(make_builder(pool_.get(), type, &tmp));
+  unique_ptr<TimestampBuilder> builder(static_cast<TimestampBuilder*>(tmp));
+  ASSERT_OK(builder->Append(-1));
+  ASSERT_OK(builder->AppendNull());
+  ASSERT_OK(builder->Append(1735625228000000000LL));
+
+  Array* out;
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<TimestampArray> result(static_cast<TimestampArray*>(out));
+  ASSERT_EQ(TypeEnum::TIMESTAMP, result->type_enum());
+  ASSERT_TRUE(result->unit() == TimestampType::Unit::NANO);
+  ASSERT_EQ(3, result->length());
+  ASSERT_EQ(-1, result->Value(0));
+  ASSERT_TRUE(result->IsNull(1));
+  ASSERT_EQ(1735625228000000000LL, result->Value(2));
+
+  ASSERT_OK(make_builder(pool_.get(), TypePtr(new DateType()), &tmp));
+  unique_ptr<DateBuilder> date_builder(static_cast<DateBuilder*>(tmp));
+  ASSERT_OK(date_builder->Append(20088));
+  ASSERT_OK(date_builder->ToArray(&out));
+  unique_ptr<DateArray> dates(static_cast<DateArray*>(out));
+  ASSERT_EQ(TypeEnum::DATE, dates->type_enum());
+  ASSERT_TRUE(dates->unit() == DateType::Unit::DAY);
+  ASSERT_EQ(20088, dates->Value(0));
+
+  // The same values in another unit are not equal
+  ASSERT_OK(make_builder(pool_.get(), TypePtr(new TimeType()), &tmp));
+  unique_ptr<TimeBuilder> ms_builder(static_cast<TimeBuilder*>(tmp));
+  ASSERT_OK(make_builder(pool_.get(),
+          TypePtr(new TimeType(TimeType::Unit::SECOND)), &tmp));
+  unique_ptr<TimeBuilder> s_builder(static_cast<TimeBuilder*>(tmp));
+  ASSERT_OK(ms_builder->Append(60));
+  ASSERT_OK(s_builder->Append(60));
+  ASSERT_OK(ms_builder->ToArray(&out));
+  unique_ptr<Array> millis(out);
+  ASSERT_OK(s_builder->ToArray(&out));
+  unique_ptr<Array> seconds(out);
+  ASSERT_EQ(TypeEnum::TIME, millis->type_enum());
+  ASSERT_FALSE(millis->Equals(*seconds));
+}
+
+// ----------------------------------------------------------------------
+// Struct builder tests
+
+class TestStructBuilder : public TestBuilder {
+ public:
+  void SetUp() {
+    TestBuilder::SetUp();
+    type_ = TypePtr(new StructType({TypePtr(new Int32Type()),
+            TypePtr(new StringType(false))}));
+
+    ArrayBuilder* tmp;
+    ASSERT_OK(make_builder(pool_.get(), type_, &tmp));
+    builder_.reset(static_cast<StructBuilder*>(tmp));
+  }
+
+  void Done() {
+    Array* out;
+    ASSERT_OK(builder_->ToArray(&out));
+    result_.reset(static_cast<StructArray*>(out));
+  }
+
+ protected:
+  TypePtr type_;
+
+  unique_ptr<StructBuilder> builder_;
+  unique_ptr<StructArray> result_;
+};
+
+TEST_F(TestStructBuilder, TestAppendRows) {
+  ASSERT_EQ(2, builder_->num_children());
+  StructRowAppender<Int32Builder, StringBuilder> rows(builder_.get());
+  ASSERT_EQ(builder_->child(1), rows.child<1>());
+
+  ASSERT_OK(rows.Append(1, "one"));
+  ASSERT_OK(rows.AppendNull());
+  ASSERT_OK(rows.Append(3, string("three")));
+
+  // A record whose field is null, appended child by child
+  ASSERT_OK(builder_->Append());
+  ASSERT_OK(rows.child<0>()->AppendNull());
+  ASSERT_OK(rows.child<1>()->Append(""));
+  Done();
+
+  ASSERT_OK(result_->Validate());
+  ASSERT_EQ(4, result_->length());
+  ASSERT_TRUE(result_->IsNull(1));
+  ASSERT_FALSE(result_->IsNull(3));
+
+  // The null record's fields are placeholders, not nulls
+  const Int32Array& ints = static_cast<const Int32Array&>(*result_->child(0));
+  const StringArray& strings =
+    static_cast<const StringArray&>(*result_->child(1));
+  ASSERT_EQ(1, ints.Value(0));
+  ASSERT_FALSE(ints.IsNull(1));
+  ASSERT_EQ(3, ints.Value(2));
+  ASSERT_TRUE(ints.IsNull(3));
+  ASSERT_EQ("one", strings.GetString(0));
+  ASSERT_EQ("", strings.GetString(1));
+  ASSERT_EQ("three", strings.GetString(2));
+
+  // Placeholders do not count in the children's statistics
+  const TypedStatistics<int32_t>& stats =
+    static_cast<const TypedStatistics<int32_t>&>(*ints.statistics());
+  ASSERT_EQ(1, stats.min);
+  ASSERT_EQ(3, stats.max);
+
+  // The builder is empty again afterwards
+  ASSERT_EQ(0, builder_->length());
+  ASSERT_OK(rows.Append(5, "five"));
+  Done();
+  ASSERT_EQ(1, result_->length());
+}
+
+TEST_F(TestStructBuilder, TestEquals) {
+  StructRowAppender<Int32Builder, StringBuilder> rows(builder_.get());
+  ASSERT_OK(rows.Append(1, "a"));
+  ASSERT_OK(rows.AppendNull());
+  ASSERT_OK(rows.Append(2, "b"));
+  Done();
+  unique_ptr<StructArray> left(result_.release());
+
+  // Different placeholders under the null record
+  ASSERT_OK(rows.Append(1, "a"));
+  ASSERT_OK(builder_->AppendNull());
+  ASSERT_OK(rows.child<0>()->Append(7));
+  ASSERT_OK(rows.child<1>()->Append("x"));
+  ASSERT_OK(rows.Append(2, "b"));
+  Done();
+  ASSERT_TRUE(left->Equals(*result_));
+
+  ASSERT_OK(rows.Append(1, "a"));
+  ASSERT_OK(rows.Append(0, ""));
+  ASSERT_OK(rows.Append(2, "b"));
+  Done();
+  ASSERT_FALSE(left->Equals(*result_));
+  ASSERT_TRUE(left->RangeEquals(2, 3, 2, *result_));
+}
+
+TEST_F(TestStructBuilder, TestChildLengthMismatch) {
+  ASSERT_OK(builder_->Append());
+  ASSERT_OK(static_cast<Int32Builder*>(builder_->child(0))->Append(1));
+  Array* out;
+  ASSERT_RAISES(Invalid, builder_->ToArray(&out));
+
+  ASSERT_OK(static_cast<StringBuilder*>(builder_->child(1))->Append("a"));
+  Done();
+  ASSERT_OK(result_->Validate());
+}
+
+TEST_F(TestStructBuilder, TestValidate) {
+  TypePtr int_type(new Int32Type());
+  vector<ArrayPtr> children = {ArrayPtr(new Int32Array(0, nullptr))};
+  StructArray missing_child(type_, 0, children);
+  ASSERT_RAISES(Invalid, missing_child.Validate());
+
+  children.push_back(children[0]);
+  StructArray wrong_type(type_, 0, children);
+  ASSERT_RAISES(Invalid, wrong_type.Validate());
+
+  TypePtr ints_type(new StructType({int_type, int_type}));
+  StructArray too_short(ints_type, 1, children);
+  ASSERT_RAISES(Invalid, too_short.Validate());
+}
+
+TEST_F(TestStructBuilder, TestNonNullable) {
+  TypePtr type(new StructType({TypePtr(new Int32Type(false))}, false));
+  ArrayBuilder* tmp;
+  ASSERT_OK(make_builder(pool_.get(), type, &tmp));
+  unique_ptr<StructBuilder> builder(static_cast<StructBuilder*>(tmp));
+  ASSERT_RAISES(Invalid, builder->AppendNull());
+
+  StructRowAppender<Int32Builder> rows(builder.get());
+  for (int32_t i = 0; i < 1000; ++i) {
+    ASSERT_OK(rows.Append(i));
+  }
+  Array* out;
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<StructArray> result(static_cast<StructArray*>(out));
+  ASSERT_OK(result->Validate());
+  ASSERT_EQ(nullptr, result->nulls());
+  ASSERT_EQ(1000, result->child(0)->length());
+}
+
+TEST_F(TestStructBuilder, TestZeroLength) {
+  Done();
+  ASSERT_OK(result_->Validate());
+  ASSERT_EQ(0, result_->length());
+}
+
+
+// ----------------------------------------------------------------------
+// Union builder tests
+
+class TestUnionBuilder : public TestBuilder {
+ public:
+  // Append the JSON scalars 1, "a", null, 2.5, true, 2, "" through builder,
+  // a DenseUnionBuilder or SparseUnionBuilder
+  template <typename BuilderType>
+  void AppendScalars(BuilderType* builder) {
+    Int32Builder* ints = static_cast<Int32Builder*>(
+        builder->child(JSONScalar::INT32));
+    StringBuilder* strings = static_cast<StringBuilder*>(
+        builder->child(JSONScalar::STRING));
+
+    ASSERT_OK(builder->Append(JSONScalar::INT32));
+    ASSERT_OK(ints->Append(1));
+    ASSERT_OK(builder->Append(JSONScalar::STRING));
+    ASSERT_OK(strings->Append("a"));
+    ASSERT_OK(builder->Append(JSONScalar::NA));
+    ASSERT_OK(static_cast<NullBuilder*>(
+            builder->child(JSONScalar::NA))->AppendNull());
+    ASSERT_OK(builder->Append(JSONScalar::DOUBLE));
+    ASSERT_OK(static_cast<DoubleBuilder*>(
+            builder->child(JSONScalar::DOUBLE))->Append(2.5));
+    ASSERT_OK(builder->Append(JSONScalar::BOOL));
+    ASSERT_OK(static_cast<BooleanBuilder*>(
+            builder->child(JSONScalar::BOOL))->Append(1));
+    ASSERT_OK(builder->Append(JSONScalar::INT32));
+    ASSERT_OK(ints->Append(2));
+    ASSERT_OK(builder->Append(JSONScalar::STRING));
+    ASSERT_OK(strings->Append(""));
+  }
+
+  template <typename BuilderType>
+  void Make(bool dense, unique_ptr<BuilderType>* out) {
+    ArrayBuilder* tmp;
+    ASSERT_OK(make_builder(pool_.get(), TypePtr(new JSONScalar(dense)), &tmp));
+    out->reset(static_cast<BuilderType*>(tmp));
+  }
+
+  void CheckScalars(const UnionArray& result) {
+    ASSERT_OK(result.Validate());
+    ASSERT_EQ(7, result.length());
+    vector<int16_t> ex_codes = {1, 2, 0, 3, 4, 1, 2};
+    for (size_t i = 0; i < ex_codes.size(); ++i) {
+      ASSERT_EQ(ex_codes[i], result.type_code(i));
+      ASSERT_FALSE(result.IsNull(i));
+    }
+    const Int32Array& ints = static_cast<const Int32Array&>(
+        *result.child(JSONScalar::INT32));
+    const StringArray& strings = static_cast<const StringArray&>(
+        *result.child(JSONScalar::STRING));
+    ASSERT_EQ(1, ints.Value(result.value_offset(0)));
+    ASSERT_EQ(2, ints.Value(result.value_offset(5)));
+    ASSERT_EQ("a", strings.GetString(result.value_offset(1)));
+    ASSERT_EQ("", strings.GetString(result.value_offset(6)));
+    ASSERT_TRUE(result.child(JSONScalar::NA)->IsNull(result.value_offset(2)));
+    ASSERT_EQ(2.5, static_cast<const DoubleArray&>(
+            *result.child(JSONScalar::DOUBLE)).Value(result.value_offset(3)));
+    ASSERT_EQ(1, static_cast<const BooleanArray&>(
+            *result.child(JSONScalar::BOOL)).Value(result.value_offset(4)));
+  }
+};
+
+TEST_F(TestUnionBuilder, TestDense) {
+  unique_ptr<DenseUnionBuilder> builder;
+  Make(true, &builder);
+  AppendScalars(builder.get());
+  ASSERT_RAISES(Invalid, builder->Append(5));
+  ASSERT_RAISES(Invalid, builder->Append(-1));
+
+  Array* out;
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<DenseUnionArray> result(static_cast<DenseUnionArray*>(out));
+  ASSERT_EQ(TypeEnum::DENSE_UNION, result->type_enum());
+  CheckScalars(*result);
+
+  // Each child only holds the values of its type
+  ASSERT_EQ(2, result->child(JSONScalar::INT32)->length());
+  ASSERT_EQ(1, result->child(JSONScalar::BOOL)->length());
+  vector<int32_t> ex_offsets = {0, 0, 0, 0, 0, 1, 1};
+  for (size_t i = 0; i < ex_offsets.size(); ++i) {
+    ASSERT_EQ(ex_offsets[i], result->value_offset(i));
+  }
+
+  // A slot whose value was never appended
+  ASSERT_OK(builder->Append(JSONScalar::INT32));
+  ASSERT_RAISES(Invalid, builder->ToArray(&out));
+}
+
+TEST_F(TestUnionBuilder, TestSparse) {
+  unique_ptr<SparseUnionBuilder> builder;
+  Make(false, &builder);
+  AppendScalars(builder.get());
+
+  Array* out;
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<SparseUnionArray> result(static_cast<SparseUnionArray*>(out));
+  ASSERT_EQ(TypeEnum::SPARSE_UNION, result->type_enum());
+  ASSERT_EQ(nullptr, result->raw_offsets());
+  CheckScalars(*result);
+
+  // Every child has a slot per union slot, the others being placeholders
+  for (size_t c = 0; c < result->num_children(); ++c) {
+    ASSERT_EQ(7, result->child(c)->length());
+  }
+  ASSERT_FALSE(result->child(JSONScalar::INT32)->IsNull(1));
+  ASSERT_EQ("", static_cast<const StringArray&>(
+          *result->child(JSONScalar::STRING)).GetString(0));
+}
+
+TEST_F(TestUnionBuilder, TestEquals) {
+  unique_ptr<DenseUnionBuilder> builder;
+  Make(true, &builder);
+  AppendScalars(builder.get());
+  Array* out;
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<Array> left(out);
+
+  AppendScalars(builder.get());
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<Array> right(out);
+  ASSERT_TRUE(left->Equals(*right));
+
+  // Same type codes, different value
+  AppendScalars(builder.get());
+  ASSERT_OK(builder->Append(JSONScalar::INT32));
+  ASSERT_OK(static_cast<Int32Builder*>(
+          builder->child(JSONScalar::INT32))->Append(3));
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<Array> longer(out);
+  ASSERT_TRUE(left->RangeEquals(0, 7, 0, *longer));
+  ASSERT_FALSE(left->RangeEquals(5, 6, 7, *longer));
+  ASSERT_FALSE(left->RangeEquals(0, 1, 1, *longer));
+}
+
+TEST_F(TestUnionBuilder, TestValidate) {
+  vector<ArrayPtr> children = {ArrayPtr(new Int32Array(0, nullptr))};
+  TypePtr type(new SparseUnionType({TypePtr(new Int32Type(false))}));
+
+  vector<int16_t> codes = {0, 1};
+  vector<int32_t> values = {5, 6};
+  ArrayPtr types(new Int16Array(2, to_buffer(codes)));
+  children[0].reset(new Int32Array(2, to_buffer(values)));
+  SparseUnionArray out_of_range(type, types, children);
+  ASSERT_RAISES(Invalid, out_of_range.Validate());
+
+  codes[1] = 0;
+  SparseUnionArray valid(type, ArrayPtr(new Int16Array(2, to_buffer(codes))),
+      children);
+  ASSERT_OK(valid.Validate());
+
+  // Sparse children must be as long as the union
+  SparseUnionArray too_short(type,
+      ArrayPtr(new Int16Array(1, to_buffer(codes))), children);
+  ASSERT_RAISES(Invalid, too_short.Validate());
+
+  // Dense offsets past the end of the child
+  TypePtr dense_type(new DenseUnionType({TypePtr(new Int32Type(false))}));
+  vector<int32_t> offsets = {0, 2};
+  DenseUnionArray bad_offset(dense_type,
+      ArrayPtr(new Int16Array(2, to_buffer(codes))),
+      ArrayPtr(new Int32Array(2, to_buffer(offsets))), children);
+  ASSERT_RAISES(Invalid, bad_offset.Validate());
+}
+
+TEST_F(TestUnionBuilder, TestNullBuilder) {
+  NullBuilder builder(pool_.get(), TypePtr(new NullType()));
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_OK(builder.AppendNull());
+  }
+  ASSERT_OK(builder.AppendEmpty());
+  Array* out;
+  ASSERT_OK(builder.ToArray(&out));
+  unique_ptr<NullArray> result(out);
+  ASSERT_OK(result->Validate());
+  ASSERT_EQ(1001, result->length());
+  ASSERT_EQ(1001, util::count_set_bits(result->null_bits(), 0, 1001));
+
+  NullBuilder builder_nn(pool_.get(), TypePtr(new NullType(false)));
+  ASSERT_RAISES(Invalid, builder_nn.AppendNull());
+}
+
+TEST_F(TestUnionBuilder, TestAppendEmptyNotImplemented) {
+  DictionaryStringBuilder builder(pool_.get(), TypePtr(new StringType()));
+  ASSERT_RAISES(NotImplemented, builder.AppendEmpty());
+}
+
+
+// ----------------------------------------------------------------------
+// Dictionary-encoding string builder tests
+
+class TestDictionaryStringBuilder : public TestBuilder {
+ public:
+  void SetUp() {
+    TestBuilder::SetUp();
+    TypePtr dict_type(new DictionaryType(TypePtr(new Int32Type()),
+            TypePtr(new StringType())));
+
+    ArrayBuilder* tmp;
+    ASSERT_OK(make_builder(pool_.get(), dict_type, &tmp));
+    builder_.reset(static_cast<DictionaryStringBuilder*>(tmp));
+    ASSERT_EQ(dict_type, builder_->type());
+  }
+
+  void Append(const vector<string>& strings, const vector<uint8_t>& is_null,
+      size_t reps) {
+    for (size_t j = 0; j < reps; ++j) {
+      for (size_t i = 0; i < strings.size(); ++i) {
+        if (is_null[i]) {
+          ASSERT_OK(builder_->AppendNull());
+        } else {
+          ASSERT_OK(builder_->Append(strings[i]));
+        }
+      }
+    }
+  }
+
+  void Done() {
+    Array* out;
+    ASSERT_OK(builder_->ToArray(&out));
+    result_.reset(out);
+  }
+
+ protected:
+  unique_ptr<DictionaryStringBuilder> builder_;
+  unique_ptr<Array> result_;
+};
+
+TEST_F(TestDictionaryStringBuilder, TestAppend) {
+  vector<string> strings = {"a", "bb", "", "", "bb"};
+  vector<uint8_t> is_null = {0, 0, 0, 1, 0};
+  size_t reps = 1000;
+  Append(strings, is_null, reps);
+  ASSERT_EQ(reps * strings.size(), builder_->length());
+  ASSERT_EQ(3, builder_->dictionary_size());
+  Done();
+
+  ASSERT_EQ(TypeEnum::DICTIONARY, result_->type_enum());
+  DictionaryArray* result = static_cast<DictionaryArray*>(result_.get());
+  StringArray* dictionary =
+    static_cast<StringArray*>(result->dictionary().get());
+  ASSERT_EQ(3, dictionary->length());
+  ASSERT_EQ(string("a"), dictionary->GetString(0));
+  ASSERT_EQ(string("bb"), dictionary->GetString(1));
+  ASSERT_EQ(string(""), dictionary->GetString(2));
+
+  vector<int32_t> ex_indices = {0, 1, 2, -1, 1};
+  for (size_t i = 0; i < reps * strings.size(); ++i) {
+    size_t k = i % strings.size();
+    ASSERT_EQ(static_cast<bool>(is_null[k]), result->IsNull(i));
+    if (!is_null[k]) {
+      ASSERT_EQ(ex_indices[k], result->index(i));
+    }
+  }
+}
+
+TEST_F(TestDictionaryStringBuilder, TestFallBack) {
+  builder_.reset(new DictionaryStringBuilder(pool_.get(),
+          TypePtr(new DictionaryType(TypePtr(new Int32Type()),
+                  TypePtr(new StringType()))), 10));
+
+  vector<string> strings;
+  vector<uint8_t> is_null;
+  for (int i = 0; i < 20; ++i) {
+    strings.push_back(std::to_string(i % 7));
+    is_null.push_back(i % 5 == 4);
+  }
+  Append(strings, is_null, 1);
+  ASSERT_FALSE(builder_->is_plain());
+
+  // Past 10 distinct values the builder switches to plain encoding
+  for (int i = 0; i < 20; ++i) {
+    strings.push_back(std::to_string(i));
+    is_null.push_back(0);
+  }
+  Append(vector<string>(strings.begin() + 20, strings.end()),
+      vector<uint8_t>(20, 0), 1);
+  ASSERT_TRUE(builder_->is_plain());
+  ASSERT_EQ(strings.size(), builder_->length());
+  Done();
+
+  ASSERT_EQ(TypeEnum::STRING, result_->type_enum());
+  StringArray* result = static_cast<StringArray*>(result_.get());
+  ASSERT_EQ(strings.size(), result->length());
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ASSERT_EQ(static_cast<bool>(is_null[i]), result->IsNull(i));
+    if (!is_null[i]) {
+      ASSERT_EQ(strings[i], result->GetString(i));
+    }
+  }
+
+  // The builder can be reused, starting over with a dictionary
+  Append({"x", "y", "x"}, {0, 0, 0}, 1);
+  ASSERT_FALSE(builder_->is_plain());
+  Done();
+  ASSERT_EQ(TypeEnum::DICTIONARY, result_->type_enum());
+  ASSERT_EQ(3, result_->length());
+}
+
+TEST_F(TestDictionaryStringBuilder, TestNarrowIndices) {
+  vector<TypePtr> index_types = {TypePtr(new Int8Type()),
+                                 TypePtr(new Int16Type())};
+  for (const TypePtr& index_type : index_types) {
+    TypePtr dict_type(new DictionaryType(index_type,
+            TypePtr(new StringType())));
+    ArrayBuilder* tmp;
+    ASSERT_OK(make_builder(pool_.get(), dict_type, &tmp));
+    builder_.reset(static_cast<DictionaryStringBuilder*>(tmp));
+    Append({"a", "bb", "", "bb"}, {0, 0, 1, 0}, 1);
+    Done();
+
+    // The built array has the index type the builder was made for
+    ASSERT_EQ(TypeEnum::DICTIONARY, result_->type_enum());
+    DictionaryArray* result = static_cast<DictionaryArray*>(result_.get());
+    ASSERT_EQ(index_type->type, result->indices()->type_enum());
+    ASSERT_EQ(index_type->type, static_cast<const DictionaryType&>(
+            *result->type()).index_type->type);
+    ASSERT_EQ(0, result->index(0));
+    ASSERT_EQ(1, result->index(1));
+    ASSERT_TRUE(result->IsNull(2));
+    ASSERT_EQ(1, result->index(3));
+  }
+
+  // int8 indices address at most 128 values, past which the builder falls
+  // back to plain strings
+  builder_.reset(new DictionaryStringBuilder(pool_.get(),
+          TypePtr(new DictionaryType(TypePtr(new Int8Type()),
+                  TypePtr(new StringType())))));
+  for (int i = 0; i < 128; ++i) {
+    ASSERT_OK(builder_->Append(std::to_string(i)));
+  }
+  ASSERT_FALSE(builder_->is_plain());
+  ASSERT_OK(builder_->Append("128"));
+  ASSERT_TRUE(builder_->is_plain());
+  Done();
+  ASSERT_EQ(TypeEnum::STRING, result_->type_enum());
+  ASSERT_EQ(129, result_->length());
+
+  ArrayBuilder* tmp;
+  ASSERT_RAISES(NotImplemented, make_builder(pool_.get(),
+          TypePtr(new DictionaryType(TypePtr(new Int64Type()),
+                  TypePtr(new StringType()))), &tmp));
+}
+
+TEST_F(TestDictionaryStringBuilder, TestZeroLength) {
+  Done();
+  ASSERT_EQ(0, result_->length());
+}
+
 } // namespace arrow
@@ -0,0 +1,271 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/builder.h"
+
+#include <cstring>
+
+#include "arrow/types/json.h"
+
+namespace arrow {
+
+// ----------------------------------------------------------------------
+// Dictionary-encoding string builder
+
+// Copy int32 dictionary indices, which all fit, into an array of the
+// narrower TypeClass that shares their null bitmap
+template <typename TypeClass>
+static Status narrow_indices(MemoryPool* pool, const Int32Array& indices,
+    ArrayPtr* out) {
+  typedef typename TypeClass::c_type T;
+  size_t n = indices.length();
+  Buffer* data;
+  RETURN_NOT_OK(pool->NewBuffer(n * sizeof(T), &data));
+  T* dst = reinterpret_cast<T*>(data->data());
+  const int32_t* src = indices.raw_data();
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = static_cast<T>(src[i]);
+  }
+
+  Buffer* nulls = indices.nulls();
+  if (nulls != nullptr) {
+    nulls->Incref();
+  }
+  PrimitiveArray* result = new PrimitiveArrayImpl<TypeClass>();
+  result->Init(TypePtr(new TypeClass(indices.nullable())), n, data, nulls);
+  out->reset(result);
+  return Status::OK();
+}
+
+Status DictionaryStringBuilder::FallBack() {
+  plain_builder_.reset(new StringBuilder(pool_,
+          TypePtr(new StringType(nullable_))));
+
+  const int32_t* indices = index_builder_->raw_buffer();
+  const uint8_t* null_bits = index_builder_->nulls() == nullptr ? nullptr :
+    index_builder_->nulls()->data();
+  const std::vector<int32_t>& offsets = dictionary_.offsets();
+  const uint8_t* bytes = dictionary_.bytes().data();
+  for (size_t i = 0; i < index_builder_->length(); ++i) {
+    if (null_bits != nullptr && util::get_bit(null_bits, i)) {
+      RETURN_NOT_OK(plain_builder_->AppendNull());
+    } else {
+      int32_t index = indices[i];
+      RETURN_NOT_OK(plain_builder_->Append(bytes + offsets[index],
+              offsets[index + 1] - offsets[index]));
+    }
+  }
+
+  // Release the memory of the dictionary
+  index_builder_.reset();
+  dictionary_ = util::StringHashTable();
+  return Status::OK();
+}
+
+Status DictionaryStringBuilder::ToArray(Array** out) {
+  if (plain_builder_) {
+    RETURN_NOT_OK(plain_builder_->ToArray(out));
+    plain_builder_.reset();
+    index_builder_.reset(new Int32Builder(pool_,
+            TypePtr(new Int32Type(nullable_))));
+    length_ = 0;
+    return Status::OK();
+  }
+
+  const std::vector<int32_t>& offsets = dictionary_.offsets();
+  const std::vector<uint8_t>& bytes = dictionary_.bytes();
+  Buffer* offset_buf;
+  RETURN_NOT_OK(pool_->NewBuffer(offsets.size() * sizeof(int32_t),
+          &offset_buf));
+  memcpy(offset_buf->data(), offsets.data(), offsets.size() * sizeof(int32_t));
+  Buffer* byte_buf;
+  Status s = pool_->NewBuffer(bytes.size(), &byte_buf);
+  if (!s.ok()) {
+    offset_buf->Decref();
+    return s;
+  }
+  if (!bytes.empty()) {
+    memcpy(byte_buf->data(), bytes.data(), bytes.size());
+  }
+  ArrayPtr chars(new UInt8Array(bytes.size(), byte_buf));
+  ArrayPtr dictionary(new StringArray(dictionary_.size(), offset_buf, chars));
+
+  Array* indices;
+  RETURN_NOT_OK(index_builder_->ToArray(&indices));
+  ArrayPtr index_array(indices);
+  const Int32Array& wide = static_cast<const Int32Array&>(*indices);
+  ArrayPtr narrow;
+  if (index_type_ == TypeEnum::INT8) {
+    RETURN_NOT_OK(narrow_indices<Int8Type>(pool_, wide, &narrow));
+    index_array = narrow;
+  } else if (index_type_ == TypeEnum::INT16) {
+    RETURN_NOT_OK(narrow_indices<Int16Type>(pool_, wide, &narrow));
+    index_array = narrow;
+  }
+
+  TypePtr type(new DictionaryType(index_array->type(), dictionary->type(),
+          nullable_));
+  *out = new DictionaryArray(type, index_array, dictionary);
+
+  dictionary_.Clear();
+  length_ = 0;
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Builder factory
+
+#define BUILDER_CASE(ENUM, BuilderType)                               \
+    case TypeEnum::ENUM:                                                \
+      *out = static_cast<ArrayBuilder*>(new BuilderType(pool, type));   \
+      return Status::OK();
+
+#define RUN_END_BUILDER_CASE(ENUM, TypeClass)                         \
+          case TypeEnum::ENUM:                                          \
+            *out = new RunEndBuilder<TypeClass>(pool, type);            \
+            return Status::OK();
+
+// Make a builder per child type. On failure the ones made so far are freed
+static Status make_child_builders(MemoryPool* pool,
+    const std::vector<TypePtr>& child_types,
+    std::vector<ArrayBuilder*>* out) {
+  std::vector<std::unique_ptr<ArrayBuilder> > children;
+  for (const TypePtr& child_type : child_types) {
+    ArrayBuilder* child;
+    RETURN_NOT_OK(make_builder(pool, child_type, &child));
+    children.emplace_back(child);
+  }
+  for (auto& child : children) {
+    out->push_back(child.release());
+  }
+  return Status::OK();
+}
+
+Status make_builder(MemoryPool* pool, const TypePtr& type, ArrayBuilder** out) {
+  switch (type->type) {
+    BUILDER_CASE(NA, NullBuilder);
+    BUILDER_CASE(UINT8, UInt8Builder);
+    BUILDER_CASE(INT8, Int8Builder);
+    BUILDER_CASE(UINT16, UInt16Builder);
+    BUILDER_CASE(INT16, Int16Builder);
+    BUILDER_CASE(UINT32, UInt32Builder);
+    BUILDER_CASE(INT32, Int32Builder);
+    BUILDER_CASE(UINT64, UInt64Builder);
+    BUILDER_CASE(INT64, Int64Builder);
+
+    BUILDER_CASE(BOOL, BooleanBuilder);
+
+    BUILDER_CASE(FLOAT, FloatBuilder);
+    BUILDER_CASE(DOUBLE, DoubleBuilder);
+
+    BUILDER_CASE(DATE, DateBuilder);
+    BUILDER_CASE(TIMESTAMP, TimestampBuilder);
+    BUILDER_CASE(TIME, TimeBuilder);
+
+    BUILDER_CASE(STRING, StringBuilder);
+    BUILDER_CASE(LARGE_STRING, LargeStringBuilder);
+
+    case TypeEnum::LIST:
+      {
+        ListType* list_type = static_cast<ListType*>(type.get());
+        ArrayBuilder* value_builder;
+        RETURN_NOT_OK(make_builder(pool, list_type->value_type, &value_builder));
+
+        // The ListBuilder takes ownership of the value_builder
+        ListBuilder* builder = new ListBuilder(pool, type, value_builder);
+        *out = static_cast<ArrayBuilder*>(builder);
+        return Status::OK();
+      }
+    case TypeEnum::LARGE_LIST:
+      {
+        LargeListType* list_type = static_cast<LargeListType*>(type.get());
+        ArrayBuilder* value_builder;
+        RETURN_NOT_OK(make_builder(pool, list_type->value_type, &value_builder));
+        *out = new LargeListBuilder(pool, type, value_builder);
+        return Status::OK();
+      }
+    // The nested builders take ownership of the child builders
+    case TypeEnum::STRUCT:
+      {
+        std::vector<ArrayBuilder*> children;
+        RETURN_NOT_OK(make_child_builders(pool,
+                static_cast<StructType*>(type.get())->child_types_,
+                &children));
+        *out = new StructBuilder(pool, type, children);
+        return Status::OK();
+      }
+    case TypeEnum::DENSE_UNION:
+      {
+        std::vector<ArrayBuilder*> children;
+        RETURN_NOT_OK(make_child_builders(pool,
+                static_cast<DenseUnionType*>(type.get())->child_types_,
+                &children));
+        *out = new DenseUnionBuilder(pool, type, children);
+        return Status::OK();
+      }
+    case TypeEnum::SPARSE_UNION:
+      {
+        std::vector<ArrayBuilder*> children;
+        RETURN_NOT_OK(make_child_builders(pool,
+                static_cast<SparseUnionType*>(type.get())->child_types_,
+                &children));
+        *out = new SparseUnionBuilder(pool, type, children);
+        return Status::OK();
+      }
+    case TypeEnum::JSON_SCALAR:
+      return make_builder(pool,
+          static_cast<JSONScalar*>(type.get())->storage_type(), out);
+    case TypeEnum::DICTIONARY:
+      {
+        DictionaryType* dict_type = static_cast<DictionaryType*>(type.get());
+        TypeEnum index_type = dict_type->index_type->type;
+        if (dict_type->value_type->type != TypeEnum::STRING ||
+            (index_type != TypeEnum::INT8 && index_type != TypeEnum::INT16 &&
+                index_type != TypeEnum::INT32)) {
+          return Status::NotImplemented(type->ToString());
+        }
+        *out = new DictionaryStringBuilder(pool, type);
+        return Status::OK();
+      }
+    case TypeEnum::RUN_END:
+      {
+        RunEndType* run_end_type = static_cast<RunEndType*>(type.get());
+        switch (run_end_type->value_type->type) {
+          RUN_END_BUILDER_CASE(UINT8, UInt8Type);
+          RUN_END_BUILDER_CASE(INT8, Int8Type);
+          RUN_END_BUILDER_CASE(UINT16, UInt16Type);
+          RUN_END_BUILDER_CASE(INT16, Int16Type);
+          RUN_END_BUILDER_CASE(UINT32, UInt32Type);
+          RUN_END_BUILDER_CASE(INT32, Int32Type);
+          RUN_END_BUILDER_CASE(UINT64, UInt64Type);
+          RUN_END_BUILDER_CASE(INT64, Int64Type);
+          RUN_END_BUILDER_CASE(FLOAT, FloatType);
+          RUN_END_BUILDER_CASE(DOUBLE, DoubleType);
+          default:
+            return Status::NotImplemented(type->ToString());
+        }
+      }
+    // BUILDER_CASE(CHAR, CharBuilder);
+
+    // BUILDER_CASE(VARCHAR, VarcharBuilder);
+    // BUILDER_CASE(BINARY, BinaryBuilder);
+
+    // BUILDER_CASE(LIST, ListBuilder);
+
+    default:
+      return Status::NotImplemented(type->ToString());
+  }
+}
+
+} // namespace arrow
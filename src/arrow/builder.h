@@ -15,27 +15,59 @@
 #ifndef ARROW_BUILDER_H
 #define ARROW_BUILDER_H
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "arrow/array.h"
+#include "arrow/chunked-array.h"
 #include "arrow/types.h"
 #include "arrow/memory.h"
 
 #include "arrow/util/bit-util.h"
+#include "arrow/util/prefix-sum.h"
 #include "arrow/util/status.h"
+#include "arrow/util/string-hash-table.h"
 
+#include "arrow/types/boolean.h"
+#include "arrow/types/datetime.h"
+#include "arrow/types/dictionary.h"
 #include "arrow/types/floating.h"
 #include "arrow/types/integer.h"
 #include "arrow/types/list.h"
+#include "arrow/types/run-end.h"
 #include "arrow/types/string.h"
+#include "arrow/types/struct.h"
+#include "arrow/types/union.h"
 
 namespace arrow {
 
 static constexpr size_t MIN_BUILDER_CAPACITY = 1 << 8;
 
+// How a builder sizes its buffers for the next array once ToArray has handed
+// the current ones over
+enum class BuilderSizing: char {
+  // Start again from MIN_BUILDER_CAPACITY and double as values are appended
+  GROW = 0,
+
+  // Reserve the length of the last array right away, so that batches of a
+  // fixed size are built without any reallocation
+  LAST_LENGTH = 1,
+
+  // Reserve an exponential moving average of the lengths of the arrays built
+  // so far, for batches whose size drifts
+  MOVING_AVERAGE = 2
+};
+
+// Weight of the newest length in the BuilderSizing::MOVING_AVERAGE
+static constexpr double BUILDER_SIZING_WEIGHT = 0.25;
+
 // Base class for all data array builders
 class ArrayBuilder {
  public:
@@ -45,12 +77,20 @@ class ArrayBuilder {
         nullable_(type_->nullable),
         nulls_(nullptr), null_bits_(nullptr),
         length_(0),
-        capacity_(0) {}
+        capacity_(0),
+        sizing_(BuilderSizing::GROW),
+        num_built_(0),
+        last_length_(0),
+        average_length_(0),
+        recycled_nulls_(nullptr) {}
 
   virtual ~ArrayBuilder() {
     if (nulls_ != nullptr) {
       nulls_->Decref();
     }
+    if (recycled_nulls_ != nullptr) {
+      recycled_nulls_->Decref();
+    }
   }
 
   // Non-copyable
@@ -70,6 +110,7 @@ class ArrayBuilder {
   size_t length() const { return length_;}
   size_t capacity() const { return capacity_;}
   bool nullable() const { return nullable_;}
+  const TypePtr& type() const { return type_;}
 
   // Allocates requires memory at this level, but children need to be
   // initialized independently
@@ -115,7 +156,57 @@ class ArrayBuilder {
   // ownership of the data
   virtual Status ToArray(Array** out) = 0;
 
+  // Append a placeholder slot, one that only fills a position such as a
+  // child slot of a null struct record. Only some builders support it
+  virtual Status AppendEmpty() {
+    return Status::NotImplemented("placeholder slots of " + type_->ToString());
+  }
+
+  // Set how the buffers of the next array are sized after ToArray. Nested
+  // builders pass the sizing on to their children
+  virtual void set_sizing(BuilderSizing sizing) { sizing_ = sizing;}
+  BuilderSizing sizing() const { return sizing_;}
+
+  // The capacity reserved for the next array after ToArray, by the sizing
+  // and the lengths of the arrays built so far
+  size_t next_capacity() const {
+    switch (sizing_) {
+      case BuilderSizing::LAST_LENGTH:
+        return last_length_;
+      case BuilderSizing::MOVING_AVERAGE:
+        return static_cast<size_t>(average_length_ + 0.5);
+      default:
+        return 0;
+    }
+  }
+
  protected:
+  // Make room for elements more slots, for builders whose only buffer is
+  // the null bitmap
+  Status ReserveNulls(size_t elements) {
+    if (length_ + elements <= capacity_) {
+      return Status::OK();
+    }
+    size_t capacity = util::next_power2(length_ + elements);
+    if (capacity < MIN_BUILDER_CAPACITY) {
+      capacity = MIN_BUILDER_CAPACITY;
+    }
+    if (capacity_ == 0) {
+      return Init(capacity);
+    }
+    RETURN_NOT_OK(Resize(capacity));
+    capacity_ = capacity;
+    return Status::OK();
+  }
+
+  // Account for an array of length just built, for next_capacity
+  void RecordLength(size_t length) {
+    last_length_ = length;
+    average_length_ = num_built_ == 0 ? length : average_length_ +
+      BUILDER_SIZING_WEIGHT * (static_cast<double>(length) - average_length_);
+    ++num_built_;
+  }
+
   MemoryPool* pool_;
   TypePtr type_;
   bool nullable_;
@@ -128,6 +219,15 @@ class ArrayBuilder {
   size_t length_;
   size_t capacity_;
 
+  BuilderSizing sizing_;
+  size_t num_built_;
+  size_t last_length_;
+  double average_length_;
+
+  // With a sizing other than GROW, the null bitmap of the last array built,
+  // to be taken back for the array after next once nothing else holds it
+  Buffer* recycled_nulls_;
+
   // Child value array builders. These are owned by this class
   std::vector<std::unique_ptr<ArrayBuilder> > children_;
 };
@@ -139,14 +239,19 @@ class PrimitiveBuilder : public ArrayBuilder {
   typedef typename Type::c_type T;
 
   PrimitiveBuilder(MemoryPool* pool, const TypePtr& type)
-      : ArrayBuilder(pool, type), values_(nullptr) {
+      : ArrayBuilder(pool, type), values_(nullptr), recycled_values_(nullptr),
+        collect_statistics_(true) {
     elsize_ = sizeof(T);
+    ResetStatistics();
   }
 
   virtual ~PrimitiveBuilder() {
     if (values_ != nullptr) {
       values_->Decref();
     }
+    if (recycled_values_ != nullptr) {
+      recycled_values_->Decref();
+    }
   }
 
   Status Resize(size_t capacity) {
@@ -178,7 +283,23 @@ class PrimitiveBuilder : public ArrayBuilder {
     return Status::OK();
   }
 
+  // Whether the arrays built get min/max statistics. Builders of values
+  // nobody queries, such as the bytes of strings, turn them off to save the
+  // fold over every appended value. Turned on after values were appended,
+  // the statistics resume with the next array
+  void set_collect_statistics(bool collect) {
+    collect_statistics_ = collect;
+    if (length_ == 0) {
+      ResetStatistics();
+    } else {
+      has_statistics_ = has_statistics_ && collect;
+    }
+  }
+
+  // The values written directly to the buffer are not seen, so the array
+  // gets no statistics
   Status Advance(size_t elements) {
+    has_statistics_ = false;
     return ArrayBuilder::Advance(elements);
   }
 
@@ -192,6 +313,44 @@ class PrimitiveBuilder : public ArrayBuilder {
       util::set_bit(null_bits_, length_, is_null);
     }
     raw_buffer()[length_++] = val;
+    if (collect_statistics_ && !(nullable_ && is_null)) {
+      min_ = val < min_ ? val : min_;
+      max_ = max_ < val ? val : max_;
+    }
+    return Status::OK();
+  }
+
+  // Appends without checking the capacity, for loops that know how many
+  // values they append: Reserve must have made room for them beforehand.
+  // UnsafeAppendNull requires a nullable builder
+  void UnsafeAppend(T val) {
+    raw_buffer()[length_++] = val;
+    if (collect_statistics_) {
+      min_ = val < min_ ? val : min_;
+      max_ = max_ < val ? val : max_;
+    }
+  }
+
+  void UnsafeAppend(const T* values, size_t length) {
+    // The buffers may not be allocated yet
+    if (length == 0) return;
+    memcpy(raw_buffer() + length_, values, length * elsize_);
+    UpdateMinMax(values, length);
+    length_ += length;
+  }
+
+  void UnsafeAppendNull() {
+    util::set_bit(null_bits_, length_++, true);
+  }
+
+  // The placeholder holds zero, is not marked null and does not count in
+  // the statistics
+  virtual Status AppendEmpty() {
+    RETURN_NOT_OK(Reserve(1));
+    if (nullable_) {
+      util::set_bit(null_bits_, length_, false);
+    }
+    raw_buffer()[length_++] = T();
     return Status::OK();
   }
 
@@ -200,6 +359,10 @@ class PrimitiveBuilder : public ArrayBuilder {
   // If passed, null_bytes is of equal length to values, and any nonzero byte
   // will be considered as a null for that slot
   Status Append(const T* values, size_t length, uint8_t* null_bytes = nullptr) {
+    if (length == 0) {
+      // Nothing to do, and the buffers may not be allocated yet
+      return Status::OK();
+    }
     if (length_ + length > capacity_) {
       size_t new_capacity = util::next_power2(length_ + length);
       RETURN_NOT_OK(Resize(new_capacity));
@@ -211,12 +374,53 @@ class PrimitiveBuilder : public ArrayBuilder {
       for (size_t i = 0; i < length; ++i) {
         util::set_bit(null_bits_, length_ + i, static_cast<bool>(null_bytes[i]));
       }
+      UpdateMinMax(values, length, null_bytes);
+    } else {
+      UpdateMinMax(values, length);
+    }
+
+    length_ += length;
+    return Status::OK();
+  }
+
+  // Vector append with the nulls given as a bitmap: slot i is null if bit
+  // null_offset + i of null_bits is set, and nullptr means there are no
+  // nulls. The bits are copied a word at a time, shifted to their position
+  // in the builder, so the append is little more than two memcpys
+  Status Append(const T* values, size_t length, const uint8_t* null_bits,
+      size_t null_offset) {
+    if (length == 0) {
+      return Status::OK();
+    }
+    RETURN_NOT_OK(Reserve(length));
+    memcpy(raw_buffer() + length_, values, length * elsize_);
+
+    if (nullable_ && null_bits != nullptr) {
+      util::copy_bits(null_bits, null_offset, length, null_bits_, length_);
+      UpdateMinMax(values, length, null_bits, null_offset);
+    } else {
+      UpdateMinMax(values, length);
     }
 
     length_ += length;
     return Status::OK();
   }
 
+  // Append the slots [start, start + length) of values, an array of the
+  // type of the builder
+  Status Append(const Array& values, size_t start, size_t length) {
+    if (values.type_enum() != type_->type) {
+      return Status::Invalid("cannot append " + values.type()->ToString() +
+          " values to a " + type_->ToString() + " builder");
+    }
+    if (start > values.length() || length > values.length() - start) {
+      return Status::Invalid("slots out of bounds of the array");
+    }
+    const T* data =
+      static_cast<const PrimitiveArrayImpl<Type>&>(values).raw_data();
+    return Append(data + start, length, values.null_bits(), start);
+  }
+
   Status AppendNull() {
     if (!nullable_) {
       return Status::Invalid("not nullable");
@@ -233,8 +437,16 @@ class PrimitiveBuilder : public ArrayBuilder {
   // Transfers ownership of all buffers
   Status Transfer(PrimitiveArray* out) {
     out->Init(type_, length_, values_, nulls_);
-    values_ = nulls_ = nullptr;
-    capacity_ = length_ = 0;
+    if (has_statistics_) {
+      // The null count is taken from the bitmap, which is cheaper than
+      // counting the nulls as they are appended
+      size_t null_count = null_bits_ == nullptr ? 0 :
+        util::count_set_bits(null_bits_, 0, length_);
+      out->set_statistics(StatisticsPtr(new TypedStatistics<T>(null_count,
+                  !(max_ < min_), min_, max_)));
+    }
+    ResetStatistics();
+    ReleaseBuffers();
     return Status::OK();
   }
 
@@ -258,8 +470,140 @@ class PrimitiveBuilder : public ArrayBuilder {
   }
 
  protected:
+  void ResetStatistics() {
+    min_ = std::numeric_limits<T>::max();
+    max_ = std::numeric_limits<T>::lowest();
+    has_statistics_ = collect_statistics_;
+  }
+
+  // Fold values into the running min and max. The loops have no branches so
+  // that they vectorize: a null slot selects the current extremes instead of
+  // its value, and NaN never compares smaller or larger
+  void UpdateMinMax(const T* values, size_t length) {
+    if (!collect_statistics_) return;
+    T min = min_;
+    T max = max_;
+    for (size_t i = 0; i < length; ++i) {
+      T val = values[i];
+      min = val < min ? val : min;
+      max = max < val ? val : max;
+    }
+    min_ = min;
+    max_ = max;
+  }
+
+  void UpdateMinMax(const T* values, size_t length,
+      const uint8_t* null_bytes) {
+    if (!collect_statistics_) return;
+    T min = min_;
+    T max = max_;
+    for (size_t i = 0; i < length; ++i) {
+      T val = values[i];
+      bool valid = null_bytes[i] == 0;
+      min = valid && val < min ? val : min;
+      max = valid && max < val ? val : max;
+    }
+    min_ = min;
+    max_ = max;
+  }
+
+  void UpdateMinMax(const T* values, size_t length, const uint8_t* null_bits,
+      size_t null_offset) {
+    if (!collect_statistics_) return;
+    for (size_t i = 0; i < length; i += 64) {
+      size_t n = length - i < 64 ? length - i : 64;
+      uint64_t nulls = util::load_bits(null_bits, null_offset + i, n);
+      if (nulls == 0) {
+        UpdateMinMax(values + i, n);
+        continue;
+      }
+      T min = min_;
+      T max = max_;
+      for (size_t j = 0; j < n; ++j) {
+        T val = values[i + j];
+        bool valid = !((nulls >> j) & 1);
+        min = valid && val < min ? val : min;
+        max = valid && max < val ? val : max;
+      }
+      min_ = min;
+      max_ = max;
+    }
+  }
+
+  // Forget the buffers, which have been handed over to an array. With a
+  // sizing other than GROW, capacity for the next array is reserved right
+  // away: the buffers of the array built before this one are taken back if
+  // nothing else holds them any more, while those of this one are kept
+  // for the array after next. Reserving is best effort: on failure the
+  // buffers are allocated again by the next append. extra slots are
+  // reserved on top of next_capacity without being counted in the capacity
+  void ReleaseBuffers(size_t extra = 0) {
+    Buffer* values = values_;
+    Buffer* nulls = nulls_;
+    size_t length = length_;
+    values_ = nulls_ = nullptr;
+    null_bits_ = nullptr;
+    capacity_ = length_ = 0;
+    if (sizing_ == BuilderSizing::GROW) return;
+
+    RecordLength(length);
+    size_t capacity = next_capacity();
+    if (capacity > 0 && !Recycle(capacity, extra).ok()) {
+      if (values_ != nullptr) values_->Decref();
+      if (nulls_ != nullptr) nulls_->Decref();
+      values_ = nulls_ = nullptr;
+      null_bits_ = nullptr;
+      capacity_ = 0;
+    }
+
+    if (values != nullptr) values->Incref();
+    if (nulls != nullptr) nulls->Incref();
+    if (recycled_values_ != nullptr) recycled_values_->Decref();
+    if (recycled_nulls_ != nullptr) recycled_nulls_->Decref();
+    recycled_values_ = values;
+    recycled_nulls_ = nulls;
+  }
+
+  // Allocate the buffers for capacity + extra slots, reusing the recycled
+  // buffers if this builder holds the only reference to them
+  Status Recycle(size_t capacity, size_t extra) {
+    size_t nbytes = (capacity + extra) * elsize_;
+    bool reuse = recycled_values_ != nullptr &&
+      recycled_values_->ref_count() == 1 &&
+      (!nullable_ || (recycled_nulls_ != nullptr &&
+          recycled_nulls_->ref_count() == 1));
+    if (!reuse) {
+      RETURN_NOT_OK(ArrayBuilder::Init(capacity + extra));
+      RETURN_NOT_OK(pool_->NewBuffer(nbytes, &values_));
+      capacity_ = capacity;
+      return Status::OK();
+    }
+
+    std::swap(values_, recycled_values_);
+    RETURN_NOT_OK(values_->Resize(nbytes));
+    if (nullable_) {
+      size_t null_bytes = util::ceil_byte(capacity + extra) / 8;
+      std::swap(nulls_, recycled_nulls_);
+      RETURN_NOT_OK(nulls_->Resize(null_bytes));
+      null_bits_ = nulls_->data();
+      memset(null_bits_, 0, null_bytes);
+    }
+    capacity_ = capacity;
+    return Status::OK();
+  }
+
   Buffer* values_;
   size_t elsize_;
+
+  // With a sizing other than GROW, the values of the last array built, to be
+  // taken back for the array after next once nothing else holds them
+  Buffer* recycled_values_;
+
+  // Running statistics of the values appended since the last Transfer
+  T min_;
+  T max_;
+  bool has_statistics_;
+  bool collect_statistics_;
 };
 
 typedef PrimitiveBuilder<UInt8Type, UInt8Array> UInt8Builder;
@@ -274,7 +618,43 @@ typedef PrimitiveBuilder<Int64Type, Int64Array> Int64Builder;
 
 typedef PrimitiveBuilder<FloatType, FloatArray> FloatBuilder;
 typedef PrimitiveBuilder<DoubleType, DoubleArray> DoubleBuilder;
-// typedef PrimitiveBuilder<BooleanType, BooleanArray> BooleanBuilder;
+typedef PrimitiveBuilder<BooleanType, BooleanArray> BooleanBuilder;
+
+// The arrays get the builder's type, and with it the unit
+typedef PrimitiveBuilder<DateType, DateArray> DateBuilder;
+typedef PrimitiveBuilder<TimestampType, TimestampArray> TimestampBuilder;
+typedef PrimitiveBuilder<TimeType, TimeArray> TimeBuilder;
+
+
+// Builder for arrays of NullType, whose slots are all null, so that only the
+// null bitmap is built
+class NullBuilder : public ArrayBuilder {
+ public:
+  NullBuilder(MemoryPool* pool, const TypePtr& type)
+      : ArrayBuilder(pool, type) {}
+
+  Status AppendNull() {
+    if (!nullable_) {
+      return Status::Invalid("not nullable");
+    }
+    RETURN_NOT_OK(ReserveNulls(1));
+    util::set_bit(null_bits_, length_++, true);
+    return Status::OK();
+  }
+
+  // The only slot there is
+  virtual Status AppendEmpty() {
+    return AppendNull();
+  }
+
+  virtual Status ToArray(Array** out) {
+    *out = new NullArray(type_, length_, nulls_);
+    nulls_ = nullptr;
+    null_bits_ = nullptr;
+    capacity_ = length_ = 0;
+    return Status::OK();
+  }
+};
 
 
 // Builder class for variable-length list array value types
@@ -282,11 +662,20 @@ typedef PrimitiveBuilder<DoubleType, DoubleArray> DoubleBuilder;
 // To use this class, you must append values to the child array builder and use
 // the Append function to delimit each distinct list value (once the values
 // have been appended to the child array)
-class ListBuilder : public Int32Builder {
+//
+// The offsets are built as values of OffsetTypeClass: Int32Type for
+// ListBuilder and Int64Type for LargeListBuilder
+template <typename OffsetTypeClass, typename ArrayType>
+class BaseListBuilder : public PrimitiveBuilder<OffsetTypeClass,
+    PrimitiveArrayImpl<OffsetTypeClass> > {
  public:
+  typedef PrimitiveBuilder<OffsetTypeClass,
+                           PrimitiveArrayImpl<OffsetTypeClass> > OffsetBuilder;
+  typedef typename OffsetTypeClass::c_type T;
 
-  ListBuilder(MemoryPool* pool, const TypePtr& type, ArrayBuilder* value_builder)
-      : Int32Builder(pool, type) {
+  BaseListBuilder(MemoryPool* pool, const TypePtr& type,
+      ArrayBuilder* value_builder)
+      : OffsetBuilder(pool, type) {
     value_builder_.reset(value_builder);
   }
 
@@ -295,15 +684,15 @@ class ListBuilder : public Int32Builder {
     //
     // XXX: This is slightly imprecise, because we might trigger null mask
     // resizes that are unnecessary when creating arrays with power-of-two size
-    return Int32Builder::Init(elements + 1);
+    return OffsetBuilder::Init(elements + 1);
   }
 
   Status Resize(size_t capacity) {
     // Need space for the end offset
-    RETURN_NOT_OK(Int32Builder::Resize(capacity + 1));
+    RETURN_NOT_OK(OffsetBuilder::Resize(capacity + 1));
 
     // Slight hack, as the "real" capacity is one less
-    --capacity_;
+    --this->capacity_;
     return Status::OK();
   }
 
@@ -312,20 +701,22 @@ class ListBuilder : public Int32Builder {
   // If passed, null_bytes is of equal length to values, and any nonzero byte
   // will be considered as a null for that slot
   Status Append(T* values, size_t length, uint8_t* null_bytes = nullptr) {
-    if (length_ + length > capacity_) {
-      size_t new_capacity = util::next_power2(length_ + length);
+    if (this->length_ + length > this->capacity_) {
+      size_t new_capacity = util::next_power2(this->length_ + length);
       RETURN_NOT_OK(Resize(new_capacity));
     }
-    memcpy(raw_buffer() + length_, values, length * elsize_);
+    memcpy(this->raw_buffer() + this->length_, values,
+        length * this->elsize_);
 
-    if (nullable_ && null_bytes != nullptr) {
+    if (this->nullable_ && null_bytes != nullptr) {
       // If null_bytes is all not null, then none of the values are null
       for (size_t i = 0; i < length; ++i) {
-        util::set_bit(null_bits_, length_ + i, static_cast<bool>(null_bytes[i]));
+        util::set_bit(this->null_bits_, this->length_ + i,
+            static_cast<bool>(null_bytes[i]));
       }
     }
 
-    length_ += length;
+    this->length_ += length;
     return Status::OK();
   }
 
@@ -333,23 +724,30 @@ class ListBuilder : public Int32Builder {
   // Transfers ownership of all buffers
   template <typename Container>
   Status Transfer(Container* out) {
+    RETURN_NOT_OK(CheckOffset());
     Array* child_values;
     RETURN_NOT_OK(value_builder_->ToArray(&child_values));
 
     // Add final offset if the length is non-zero
-    if (length_) {
-      raw_buffer()[length_] = child_values->length();
+    if (this->length_) {
+      this->raw_buffer()[this->length_] = child_values->length();
     }
 
-    out->Init(type_, length_, values_, ArrayPtr(child_values), nulls_);
-    values_ = nulls_ = nullptr;
-    capacity_ = length_ = 0;
+    out->Init(this->type_, this->length_, this->values_,
+        ArrayPtr(child_values), this->nulls_);
+
+    // Room for the end offset, as in Resize
+    this->ReleaseBuffers(1);
     return Status::OK();
   }
 
   virtual Status ToArray(Array** out) {
-    ListArray* result = new ListArray();
-    RETURN_NOT_OK(Transfer(result));
+    ArrayType* result = new ArrayType();
+    Status s = Transfer(result);
+    if (!s.ok()) {
+      delete result;
+      return s;
+    }
     *out = static_cast<Array*>(result);
     return Status::OK();
   }
@@ -359,131 +757,883 @@ class ListBuilder : public Int32Builder {
   // This function should be called before beginning to append elements to the
   // value builder
   Status Append(bool is_null = false) {
-    if (length_ == capacity_) {
+    RETURN_NOT_OK(CheckOffset());
+    if (this->length_ == this->capacity_) {
       // If the capacity was not already a multiple of 2, do so here
-      RETURN_NOT_OK(Resize(util::next_power2(capacity_ + 1)));
+      RETURN_NOT_OK(Resize(util::next_power2(this->capacity_ + 1)));
     }
-    if (nullable_) {
-      util::set_bit(null_bits_, length_, is_null);
+    if (this->nullable_) {
+      util::set_bit(this->null_bits_, this->length_, is_null);
     }
 
-    raw_buffer()[length_++] = value_builder_->length();
+    this->raw_buffer()[this->length_++] = value_builder_->length();
     return Status::OK();
   }
 
   // Status Append(int32_t* offsets, size_t length, uint8_t* null_bytes) {
   //   return Int32Builder::Append(offsets, length, null_bytes);
   // }
+  // Make room for elements more list slots, and the end offset
+  Status Reserve(size_t elements) {
+    if (this->length_ + elements > this->capacity_) {
+      return Resize(util::next_power2(this->length_ + elements));
+    }
+    return Status::OK();
+  }
+
+  // Start a list slot without checking the capacity, which Reserve must
+  // have made room for, or that the values fit in the offsets
+  void UnsafeAppend() {
+    this->raw_buffer()[this->length_++] = value_builder_->length();
+  }
+
+  void UnsafeAppendNull() {
+    util::set_bit(this->null_bits_, this->length_, true);
+    UnsafeAppend();
+  }
+
 
   Status AppendNull() {
     return Append(true);
   }
 
+  // The placeholder is an empty list, not marked null
+  virtual Status AppendEmpty() {
+    return Append(false);
+  }
+
   ArrayBuilder* value_builder() const { return value_builder_.get();}
 
+  virtual void set_sizing(BuilderSizing sizing) {
+    OffsetBuilder::set_sizing(sizing);
+    value_builder_->set_sizing(sizing);
+  }
+
  protected:
+  // The values appended so far must be addressable by an offset
+  Status CheckOffset() const {
+    if (value_builder_->length() >
+        static_cast<size_t>(std::numeric_limits<T>::max())) {
+      return Status::Invalid("list values do not fit in " +
+          std::to_string(sizeof(T) * 8) + "-bit offsets");
+    }
+    return Status::OK();
+  }
+
   std::unique_ptr<ArrayBuilder> value_builder_;
 };
 
+typedef BaseListBuilder<Int32Type, ListArray> ListBuilder;
+typedef BaseListBuilder<Int64Type, LargeListArray> LargeListBuilder;
 
-class StringBuilder : public ListBuilder {
- public:
 
-  StringBuilder(MemoryPool* pool, const TypePtr& type)
-      : ListBuilder(pool, type,
-          static_cast<ArrayBuilder*>(new UInt8Builder(pool, value_type_))) {
-    byte_builder_ = static_cast<UInt8Builder*>(value_builder_.get());
+// Builder for arrays of strings, where ListBuilderType builds the offsets:
+// ListBuilder for StringBuilder and LargeListBuilder for LargeStringBuilder
+template <typename ListBuilderType, typename ArrayType>
+class BaseStringBuilder : public ListBuilderType {
+ public:
+  typedef typename ListBuilderType::T offset_type;
+
+  BaseStringBuilder(MemoryPool* pool, const TypePtr& type)
+      : ListBuilderType(pool, type,
+          static_cast<ArrayBuilder*>(new UInt8Builder(pool,
+                  TypePtr(new UInt8Type(false))))) {
+    byte_builder_ = static_cast<UInt8Builder*>(this->value_builder_.get());
+    // The strings get their own statistics; those of their bytes are of no
+    // use
+    byte_builder_->set_collect_statistics(false);
+    ResetStatistics();
   }
 
   Status Append(const std::string& value) {
-    RETURN_NOT_OK(ListBuilder::Append());
-    return byte_builder_->Append(reinterpret_cast<const uint8_t*>(value.c_str()),
+    return Append(reinterpret_cast<const uint8_t*>(value.c_str()),
         value.size());
   }
 
-  Status Append(const uint8_t* value, size_t length);
+  Status Append(const uint8_t* value, size_t length) {
+    RETURN_NOT_OK(ListBuilderType::Append());
+    size_t offset = byte_builder_->length();
+    RETURN_NOT_OK(byte_builder_->Append(value, length));
+    UpdateMinMax(value, offset, length);
+    return Status::OK();
+  }
+
+  // Bulk appends
+  //
+  // If passed, null_bytes is of equal length to the values, and any nonzero
+  // byte will be considered as a null for that slot. The offset and byte
+  // buffers are both sized before anything is copied
+
+  // Append length strings laid out as in a string array: string i is the
+  // bytes [offsets[i], offsets[i + 1]) of data. The offsets need not start at
+  // zero
+  Status Append(const offset_type* offsets, const uint8_t* data,
+      size_t length, const uint8_t* null_bytes = nullptr) {
+    if (length == 0) return Status::OK();
+    size_t nbytes = offsets[length] - offsets[0];
+    RETURN_NOT_OK(CheckBytes(nbytes));
+    RETURN_NOT_OK(this->Reserve(length));
+    RETURN_NOT_OK(ReserveData(nbytes));
+
+    offset_type* out = this->raw_buffer() + this->length_;
+    offset_type shift = static_cast<offset_type>(byte_builder_->length()) -
+      offsets[0];
+    for (size_t i = 0; i < length; ++i) {
+      out[i] = offsets[i] + shift;
+    }
+    byte_builder_->UnsafeAppend(data + offsets[0], nbytes);
+    AppendNulls(null_bytes, length);
+
+    for (size_t i = 0; i < length; ++i) {
+      if (!IsNull(null_bytes, i)) {
+        UpdateMinMax(data + offsets[i], out[i], offsets[i + 1] - offsets[i]);
+      }
+    }
+    this->length_ += length;
+    return Status::OK();
+  }
+
+  // Append length strings held elsewhere. Null slots are empty, whatever
+  // their view
+  Status Append(const StringView* values, size_t length,
+      const uint8_t* null_bytes = nullptr) {
+    if (length == 0) return Status::OK();
+    RETURN_NOT_OK(this->Reserve(length));
+
+    // Gather the lengths one slot ahead, so that the prefix sum leaves the
+    // start offset of every string in its slot. The last one lands on the
+    // end offset, which Reserve keeps room for
+    offset_type* out = this->raw_buffer() + this->length_;
+    size_t nbytes = 0;
+    for (size_t i = 0; i < length; ++i) {
+      size_t value_length = IsNull(null_bytes, i) ? 0 : values[i].length;
+      out[i + 1] = static_cast<offset_type>(value_length);
+      nbytes += value_length;
+    }
+    RETURN_NOT_OK(CheckBytes(nbytes));
+    RETURN_NOT_OK(ReserveData(nbytes));
+    out[0] = static_cast<offset_type>(byte_builder_->length());
+    util::prefix_sum(out + 1, length, out[0]);
+
+    for (size_t i = 0; i < length; ++i) {
+      size_t value_length = out[i + 1] - out[i];
+      if (IsNull(null_bytes, i)) continue;
+      byte_builder_->UnsafeAppend(values[i].data, value_length);
+      UpdateMinMax(values[i].data, out[i], value_length);
+    }
+    AppendNulls(null_bytes, length);
+    this->length_ += length;
+    return Status::OK();
+  }
+
   Status Append(const std::vector<std::string>& values,
-                uint8_t* null_bytes);
+      uint8_t* null_bytes) {
+    std::vector<StringView> views(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      views[i].data = reinterpret_cast<const uint8_t*>(values[i].data());
+      views[i].length = values[i].size();
+    }
+    return Append(views.data(), views.size(), null_bytes);
+  }
+
+  // Make room for nbytes more bytes of characters, in addition to the slots
+  // made room for by Reserve
+  Status ReserveData(size_t nbytes) {
+    return byte_builder_->Reserve(nbytes);
+  }
+
+  // Append without checking the capacity: Reserve and ReserveData must have
+  // made room for the slot and its bytes beforehand
+  void UnsafeAppend(const uint8_t* value, size_t length) {
+    ListBuilderType::UnsafeAppend();
+    size_t offset = byte_builder_->length();
+    byte_builder_->UnsafeAppend(value, length);
+    UpdateMinMax(value, offset, length);
+  }
+
+  void UnsafeAppend(const std::string& value) {
+    UnsafeAppend(reinterpret_cast<const uint8_t*>(value.c_str()),
+        value.size());
+  }
+
 
   virtual Status ToArray(Array** out) {
-    StringArray* result = new StringArray();
-    RETURN_NOT_OK(ListBuilder::Transfer(result));
+    ArrayType* result = new ArrayType();
+    Status s = ListBuilderType::Transfer(result);
+    if (!s.ok()) {
+      delete result;
+      return s;
+    }
+    const uint8_t* bytes =
+      static_cast<const UInt8Array&>(*result->values()).raw_data();
+    size_t null_count = result->null_bits() == nullptr ? 0 :
+      util::count_set_bits(result->null_bits(), 0, result->length());
+    result->set_statistics(StatisticsPtr(new TypedStatistics<std::string>(
+                null_count, has_min_max_,
+                to_string(bytes, min_offset_, min_length_),
+                to_string(bytes, max_offset_, max_length_))));
+    ResetStatistics();
     *out = static_cast<Array*>(result);
     return Status::OK();
   }
 
  protected:
+  bool IsNull(const uint8_t* null_bytes, size_t i) const {
+    return this->nullable_ && null_bytes != nullptr && null_bytes[i];
+  }
+
+  // Set the null bits of the next length slots from null_bytes
+  void AppendNulls(const uint8_t* null_bytes, size_t length) {
+    if (!this->nullable_ || null_bytes == nullptr) return;
+    for (size_t i = 0; i < length; ++i) {
+      util::set_bit(this->null_bits_, this->length_ + i,
+          static_cast<bool>(null_bytes[i]));
+    }
+  }
+
+  // The bytes appended so far and nbytes more must be addressable by an
+  // offset
+  Status CheckBytes(size_t nbytes) const {
+    if (byte_builder_->length() + nbytes >
+        static_cast<size_t>(std::numeric_limits<offset_type>::max())) {
+      return Status::Invalid("strings do not fit in " +
+          std::to_string(sizeof(offset_type) * 8) + "-bit offsets");
+    }
+    return Status::OK();
+  }
+
+  void ResetStatistics() {
+    has_min_max_ = false;
+    min_offset_ = min_length_ = max_offset_ = max_length_ = 0;
+  }
+
+  static std::string to_string(const uint8_t* bytes, size_t offset,
+      size_t length) {
+    return length == 0 ? std::string() :
+      std::string(reinterpret_cast<const char*>(bytes) + offset, length);
+  }
+
+  // Bytewise comparison of a string with the one at offset in the bytes
+  // appended so far
+  int Compare(const uint8_t* value, size_t length, size_t offset,
+      size_t other_length) {
+    size_t n = length < other_length ? length : other_length;
+    int cmp = n == 0 ? 0 :
+      memcmp(value, byte_builder_->raw_buffer() + offset, n);
+    if (cmp != 0) return cmp;
+    return length < other_length ? -1 : length > other_length;
+  }
+
+  // The min and max are kept as positions in the bytes, so that they are
+  // not copied until the array is built
+  void UpdateMinMax(const uint8_t* value, size_t offset, size_t length) {
+    if (!has_min_max_ || Compare(value, length, min_offset_, min_length_) < 0) {
+      min_offset_ = offset;
+      min_length_ = length;
+    }
+    if (!has_min_max_ || Compare(value, length, max_offset_, max_length_) > 0) {
+      max_offset_ = offset;
+      max_length_ = length;
+    }
+    has_min_max_ = true;
+  }
+
   UInt8Builder* byte_builder_;
 
-  static TypePtr value_type_;
+  // Running statistics of the strings appended since the last ToArray
+  bool has_min_max_;
+  size_t min_offset_;
+  size_t min_length_;
+  size_t max_offset_;
+  size_t max_length_;
 };
-TypePtr StringBuilder::value_type_ = TypePtr(new UInt8Type(false));
 
+typedef BaseStringBuilder<ListBuilder, StringArray> StringBuilder;
+typedef BaseStringBuilder<LargeListBuilder, LargeStringArray>
+  LargeStringBuilder;
 
-// class BinaryBuilder : protected ListBuilder {
 
-// };
+// Builder for struct arrays, with one child builder per field.
+//
+// Like the list builder, Append only records a struct slot: one value must
+// be appended to each child builder for every slot, including null ones,
+// whose child slots are placeholders (see AppendEmpty). StructRowAppender
+// does both at once
+class StructBuilder : public ArrayBuilder {
+ public:
+  // Takes ownership of the child builders, one per child type of type
+  StructBuilder(MemoryPool* pool, const TypePtr& type,
+      const std::vector<ArrayBuilder*>& children)
+      : ArrayBuilder(pool, type) {
+    for (ArrayBuilder* child : children) {
+      children_.emplace_back(child);
+    }
+  }
+
+  // Make room for elements more struct slots. The child builders are
+  // reserved separately
+  Status Reserve(size_t elements) {
+    return ReserveNulls(elements);
+  }
+
+  Status Append(bool is_null = false) {
+    if (is_null && !nullable_) {
+      return Status::Invalid("not nullable");
+    }
+    RETURN_NOT_OK(Reserve(1));
+    if (nullable_) {
+      util::set_bit(null_bits_, length_, is_null);
+    }
+    ++length_;
+    return Status::OK();
+  }
 
+  Status AppendNull() {
+    return Append(true);
+  }
 
-// class DenseUnionBuilder : protected ArrayBuilder {
+  // The placeholder is a non-null record of placeholders
+  virtual Status AppendEmpty() {
+    RETURN_NOT_OK(Append());
+    for (auto& child : children_) {
+      RETURN_NOT_OK(child->AppendEmpty());
+    }
+    return Status::OK();
+  }
 
-// };
+  virtual Status ToArray(Array** out) {
+    for (size_t i = 0; i < children_.size(); ++i) {
+      if (children_[i]->length() != length_) {
+        return Status::Invalid("struct child " + std::to_string(i) + " has " +
+            std::to_string(children_[i]->length()) +
+            " slots but the struct has " + std::to_string(length_));
+      }
+    }
+    std::vector<ArrayPtr> children(children_.size());
+    for (size_t i = 0; i < children_.size(); ++i) {
+      Array* child;
+      RETURN_NOT_OK(children_[i]->ToArray(&child));
+      children[i].reset(child);
+    }
+    *out = new StructArray(type_, length_, children, nulls_);
+    nulls_ = nullptr;
+    null_bits_ = nullptr;
+    capacity_ = length_ = 0;
+    return Status::OK();
+  }
 
+  virtual void set_sizing(BuilderSizing sizing) {
+    ArrayBuilder::set_sizing(sizing);
+    for (auto& child : children_) {
+      child->set_sizing(sizing);
+    }
+  }
+};
 
 
-#define BUILDER_CASE(ENUM, BuilderType)                               \
-    case TypeEnum::ENUM:                                                \
-      *out = static_cast<ArrayBuilder*>(new BuilderType(pool, type));   \
-      return Status::OK();
+// Appends whole records to a StructBuilder whose child builder i is a
+// BuilderTypes[i], e.g.
+//
+//   StructRowAppender<Int32Builder, StringBuilder> rows(&builder);
+//   RETURN_NOT_OK(rows.Append(1, "one"));
+//
+// The child builders are looked up and cast once, so every field of a row
+// is appended by a direct, inlinable call to its concrete builder
+template <typename... BuilderTypes>
+class StructRowAppender {
+ public:
+  explicit StructRowAppender(StructBuilder* builder) : builder_(builder) {
+    Bind(std::integral_constant<size_t, 0>());
+  }
+
+  // Append a record with values[i] appended to child i
+  template <typename... Values>
+  Status Append(const Values&... values) {
+    static_assert(sizeof...(Values) == sizeof...(BuilderTypes),
+        "one value per child builder");
+    RETURN_NOT_OK(builder_->Append());
+    return AppendValues<0>(values...);
+  }
+
+  // Append a null record, with a placeholder slot in every child
+  Status AppendNull() {
+    RETURN_NOT_OK(builder_->AppendNull());
+    return AppendEmpty(std::integral_constant<size_t, 0>());
+  }
+
+  template <size_t I>
+  typename std::tuple_element<I, std::tuple<BuilderTypes*...> >::type
+  child() const {
+    return std::get<I>(children_);
+  }
+
+ private:
+  typedef std::integral_constant<size_t, sizeof...(BuilderTypes)> End;
+
+  void Bind(End) {}
+
+  template <size_t I>
+  void Bind(std::integral_constant<size_t, I>) {
+    std::get<I>(children_) = static_cast<
+      typename std::tuple_element<I, std::tuple<BuilderTypes*...> >::type>(
+          builder_->child(I));
+    Bind(std::integral_constant<size_t, I + 1>());
+  }
+
+  template <size_t I>
+  Status AppendValues() {
+    return Status::OK();
+  }
+
+  template <size_t I, typename Value, typename... Rest>
+  Status AppendValues(const Value& value, const Rest&... rest) {
+    RETURN_NOT_OK(std::get<I>(children_)->Append(value));
+    return AppendValues<I + 1>(rest...);
+  }
+
+  Status AppendEmpty(End) {
+    return Status::OK();
+  }
+
+  template <size_t I>
+  Status AppendEmpty(std::integral_constant<size_t, I>) {
+    RETURN_NOT_OK(std::get<I>(children_)->AppendEmpty());
+    return AppendEmpty(std::integral_constant<size_t, I + 1>());
+  }
+
+  StructBuilder* builder_;
+  std::tuple<BuilderTypes*...> children_;
+};
+
+
+// Base class of the union builders, with one child builder per child type.
+//
+// Like the list builder, Append(type_code) only records a union slot, whose
+// value must then be appended to child(type_code). The type codes are int16
+// and index the children
+class UnionBuilder : public ArrayBuilder {
+ public:
+  // Takes ownership of the child builders, one per child type of type
+  UnionBuilder(MemoryPool* pool, const TypePtr& type,
+      const std::vector<ArrayBuilder*>& children)
+      : ArrayBuilder(pool, type),
+        types_(pool, TypePtr(new Int16Type(false))) {
+    for (ArrayBuilder* child : children) {
+      children_.emplace_back(child);
+    }
+  }
+
+  virtual void set_sizing(BuilderSizing sizing) {
+    ArrayBuilder::set_sizing(sizing);
+    types_.set_sizing(sizing);
+    for (auto& child : children_) {
+      child->set_sizing(sizing);
+    }
+  }
+
+ protected:
+  Status CheckTypeCode(int16_t type_code) const {
+    if (type_code < 0 || static_cast<size_t>(type_code) >= children_.size()) {
+      return Status::Invalid("type code " + std::to_string(type_code) +
+          " is not a child of " + type_->ToString());
+    }
+    return Status::OK();
+  }
+
+  // Build the type codes and the children
+  Status Finish(ArrayPtr* types, std::vector<ArrayPtr>* children) {
+    children->resize(children_.size());
+    for (size_t i = 0; i < children_.size(); ++i) {
+      Array* child;
+      RETURN_NOT_OK(children_[i]->ToArray(&child));
+      (*children)[i].reset(child);
+    }
+    Array* out;
+    RETURN_NOT_OK(types_.ToArray(&out));
+    types->reset(out);
+    length_ = 0;
+    return Status::OK();
+  }
 
+  Int16Builder types_;
+};
 
-Status make_builder(MemoryPool* pool, const TypePtr& type, ArrayBuilder** out) {
-  switch (type->type) {
-    BUILDER_CASE(UINT8, UInt8Builder);
-    BUILDER_CASE(INT8, Int8Builder);
-    BUILDER_CASE(UINT16, UInt16Builder);
-    BUILDER_CASE(INT16, Int16Builder);
-    BUILDER_CASE(UINT32, UInt32Builder);
-    BUILDER_CASE(INT32, Int32Builder);
-    BUILDER_CASE(UINT64, UInt64Builder);
-    BUILDER_CASE(INT64, Int64Builder);
 
-    // BUILDER_CASE(BOOL, BooleanBuilder);
+// Builder for dense unions: each child only gets the values of its type
+class DenseUnionBuilder : public UnionBuilder {
+ public:
+  DenseUnionBuilder(MemoryPool* pool, const TypePtr& type,
+      const std::vector<ArrayBuilder*>& children)
+      : UnionBuilder(pool, type, children),
+        offsets_(pool, TypePtr(new Int32Type(false))) {}
+
+  Status Append(int16_t type_code) {
+    RETURN_NOT_OK(CheckTypeCode(type_code));
+    size_t offset = children_[type_code]->length();
+    if (offset > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      return Status::Invalid("union child does not fit in 32-bit offsets");
+    }
+    RETURN_NOT_OK(types_.Append(type_code));
+    RETURN_NOT_OK(offsets_.Append(static_cast<int32_t>(offset)));
+    ++length_;
+    return Status::OK();
+  }
 
-    BUILDER_CASE(FLOAT, FloatBuilder);
-    BUILDER_CASE(DOUBLE, DoubleBuilder);
+  virtual Status ToArray(Array** out) {
+    size_t num_values = 0;
+    for (auto& child : children_) {
+      num_values += child->length();
+    }
+    if (num_values != length_) {
+      return Status::Invalid("dense union children have " +
+          std::to_string(num_values) + " values for " +
+          std::to_string(length_) + " slots");
+    }
+    ArrayPtr types;
+    std::vector<ArrayPtr> children;
+    RETURN_NOT_OK(Finish(&types, &children));
+    Array* offsets;
+    RETURN_NOT_OK(offsets_.ToArray(&offsets));
+    *out = new DenseUnionArray(type_, types, ArrayPtr(offsets), children);
+    return Status::OK();
+  }
 
-    BUILDER_CASE(STRING, StringBuilder);
+  virtual void set_sizing(BuilderSizing sizing) {
+    UnionBuilder::set_sizing(sizing);
+    offsets_.set_sizing(sizing);
+  }
+
+ protected:
+  Int32Builder offsets_;
+};
 
-    case TypeEnum::LIST:
-      {
-        ListType* list_type = static_cast<ListType*>(type.get());
-        ArrayBuilder* value_builder;
-        RETURN_NOT_OK(make_builder(pool, list_type->value_type, &value_builder));
 
-        // The ListBuilder takes ownership of the value_builder
-        ListBuilder* builder = new ListBuilder(pool, type, value_builder);
-        *out = static_cast<ArrayBuilder*>(builder);
-        return Status::OK();
+// Builder for sparse unions: every child has a slot per union slot, and
+// Append gives the children other than child(type_code) a placeholder (see
+// AppendEmpty)
+class SparseUnionBuilder : public UnionBuilder {
+ public:
+  SparseUnionBuilder(MemoryPool* pool, const TypePtr& type,
+      const std::vector<ArrayBuilder*>& children)
+      : UnionBuilder(pool, type, children) {}
+
+  Status Append(int16_t type_code) {
+    RETURN_NOT_OK(CheckTypeCode(type_code));
+    RETURN_NOT_OK(types_.Append(type_code));
+    for (size_t i = 0; i < children_.size(); ++i) {
+      if (i != static_cast<size_t>(type_code)) {
+        RETURN_NOT_OK(children_[i]->AppendEmpty());
       }
-    // BUILDER_CASE(CHAR, CharBuilder);
+    }
+    ++length_;
+    return Status::OK();
+  }
 
-    // BUILDER_CASE(VARCHAR, VarcharBuilder);
-    // BUILDER_CASE(BINARY, BinaryBuilder);
+  virtual Status ToArray(Array** out) {
+    for (size_t i = 0; i < children_.size(); ++i) {
+      if (children_[i]->length() != length_) {
+        return Status::Invalid("union child " + std::to_string(i) + " has " +
+            std::to_string(children_[i]->length()) +
+            " slots but the sparse union has " + std::to_string(length_));
+      }
+    }
+    ArrayPtr types;
+    std::vector<ArrayPtr> children;
+    RETURN_NOT_OK(Finish(&types, &children));
+    *out = new SparseUnionArray(type_, types, children);
+    return Status::OK();
+  }
+};
 
-    // BUILDER_CASE(DATE, DateBuilder);
-    // BUILDER_CASE(TIMESTAMP, TimestampBuilder);
-    // BUILDER_CASE(TIME, TimeBuilder);
 
-    // BUILDER_CASE(LIST, ListBuilder);
-    // BUILDER_CASE(STRUCT, StructBuilder);
-    // BUILDER_CASE(DENSE_UNION, DenseUnionBuilder);
-    // BUILDER_CASE(SPARSE_UNION, SparseUnionBuilder);
+static constexpr size_t DEFAULT_MAX_DICTIONARY_SIZE = 1 << 16;
 
-    default:
-      return Status::NotImplemented(type->ToString());
+// Builder for string values that interns them while appending: each distinct
+// value is stored once, in a dictionary, and every slot holds an index into
+// it. ToArray returns a DictionaryArray.
+//
+// High-cardinality data gains nothing from a dictionary, so once more than
+// max_dictionary_size distinct values have been seen, the values so far are
+// decoded into a plain StringBuilder and all later values are appended to it
+// directly. ToArray then returns a StringArray
+//
+// type is the DictionaryType the builder was made for, and the indices of the
+// array have its int8, int16 or int32 index type. With a narrow index type
+// the builder also falls back once the dictionary outgrows what the indices
+// can address. Given a StringType instead, the indices are int32
+class DictionaryStringBuilder : public ArrayBuilder {
+ public:
+  DictionaryStringBuilder(MemoryPool* pool, const TypePtr& type,
+      size_t max_dictionary_size = DEFAULT_MAX_DICTIONARY_SIZE)
+      : ArrayBuilder(pool, type),
+        index_type_(type->type == TypeEnum::DICTIONARY ?
+            static_cast<const DictionaryType&>(*type).index_type->type :
+            TypeEnum::INT32),
+        max_dictionary_size_(std::min(max_dictionary_size,
+                max_addressable(index_type_))) {
+    index_builder_.reset(new Int32Builder(pool,
+            TypePtr(new Int32Type(type->nullable))));
+  }
+
+  Status Append(const std::string& value) {
+    return Append(reinterpret_cast<const uint8_t*>(value.c_str()),
+        value.size());
+  }
+
+  Status Append(const uint8_t* value, size_t length) {
+    if (plain_builder_) {
+      RETURN_NOT_OK(plain_builder_->Append(value, length));
+    } else {
+      RETURN_NOT_OK(index_builder_->Append(
+              dictionary_.GetOrInsert(value, length)));
+      if (dictionary_.size() > max_dictionary_size_) {
+        RETURN_NOT_OK(FallBack());
+      }
+    }
+    ++length_;
+    return Status::OK();
+  }
+
+  Status AppendNull() {
+    if (plain_builder_) {
+      RETURN_NOT_OK(plain_builder_->AppendNull());
+    } else {
+      RETURN_NOT_OK(index_builder_->AppendNull());
+    }
+    ++length_;
+    return Status::OK();
+  }
+
+  // Whether the builder has given up on dictionary encoding
+  bool is_plain() const { return plain_builder_ != nullptr;}
+
+  // Number of distinct values so far, while dictionary encoding
+  size_t dictionary_size() const { return dictionary_.size();}
+
+  virtual Status ToArray(Array** out);
+
+ protected:
+  // Number of dictionary values indices of type can address
+  static size_t max_addressable(TypeEnum type) {
+    switch (type) {
+      case TypeEnum::INT8:
+        return static_cast<size_t>(std::numeric_limits<int8_t>::max()) + 1;
+      case TypeEnum::INT16:
+        return static_cast<size_t>(std::numeric_limits<int16_t>::max()) + 1;
+      default:
+        return std::numeric_limits<size_t>::max();
+    }
+  }
+
+  // Switch to plain encoding, decoding the values appended so far
+  Status FallBack();
+
+  // The indices are built as int32 and narrowed by ToArray
+  TypeEnum index_type_;
+  size_t max_dictionary_size_;
+  util::StringHashTable dictionary_;
+  std::unique_ptr<Int32Builder> index_builder_;
+  std::unique_ptr<StringBuilder> plain_builder_;
+};
+
+
+// Builder for run-end encoded primitive values. Runs are detected while
+// appending: a value that is bitwise equal to the previous one, or a null
+// after a null, extends the current run instead of adding a slot. The
+// current run is only written out when a different value arrives or in
+// ToArray, which returns a RunEndArray
+template <typename TypeClass>
+class RunEndBuilder : public ArrayBuilder {
+ public:
+  typedef typename TypeClass::c_type T;
+
+  RunEndBuilder(MemoryPool* pool, const TypePtr& type)
+      : ArrayBuilder(pool, type),
+        run_value_(0),
+        run_null_(false),
+        written_length_(0) {
+    const RunEndType& run_end_type = static_cast<const RunEndType&>(*type);
+    value_builder_.reset(new PrimitiveBuilder<TypeClass,
+            PrimitiveArrayImpl<TypeClass> >(pool, run_end_type.value_type));
+    run_end_builder_.reset(new Int32Builder(pool,
+            TypePtr(new Int32Type(false))));
+  }
+
+  Status Append(T val, bool is_null = false) {
+    return AppendRun(val, 1, is_null);
+  }
+
+  // Append run_length copies of val
+  Status AppendRun(T val, size_t run_length, bool is_null = false) {
+    if (run_length == 0) return Status::OK();
+    if (length_ == 0 || !SameAsRun(val, is_null)) {
+      RETURN_NOT_OK(FinishRun());
+      run_value_ = val;
+      run_null_ = is_null;
+    }
+    length_ += run_length;
+    return Status::OK();
+  }
+
+  Status AppendNull() {
+    return AppendRun(0, 1, true);
   }
-}
+
+  // Vector append
+  //
+  // If passed, null_bytes is of equal length to values, and any nonzero byte
+  // will be considered as a null for that slot
+  Status Append(const T* values, size_t length, uint8_t* null_bytes = nullptr) {
+    size_t i = 0;
+    while (i < length) {
+      bool is_null = null_bytes != nullptr && null_bytes[i];
+      size_t j = i + 1;
+      if (is_null) {
+        while (j < length && null_bytes[j]) ++j;
+      } else {
+        while (j < length && BitwiseEqual(values[j], values[i]) &&
+            (null_bytes == nullptr || !null_bytes[j])) {
+          ++j;
+        }
+      }
+      RETURN_NOT_OK(AppendRun(values[i], j - i, is_null));
+      i = j;
+    }
+    return Status::OK();
+  }
+
+  // Runs written out so far, plus the current one
+  size_t num_runs() const {
+    return run_end_builder_->length() + (length_ > written_length_);
+  }
+
+  virtual Status ToArray(Array** out) {
+    RETURN_NOT_OK(FinishRun());
+    Array* run_ends;
+    RETURN_NOT_OK(run_end_builder_->ToArray(&run_ends));
+    ArrayPtr run_end_array(run_ends);
+    Array* values;
+    RETURN_NOT_OK(value_builder_->ToArray(&values));
+    *out = new RunEndArray(type_, run_end_array, ArrayPtr(values));
+    length_ = written_length_ = 0;
+    return Status::OK();
+  }
+
+ protected:
+  static bool BitwiseEqual(T left, T right) {
+    typedef typename util::uint_for_width<sizeof(T)>::type U;
+    U l, r;
+    memcpy(&l, &left, sizeof(T));
+    memcpy(&r, &right, sizeof(T));
+    return l == r;
+  }
+
+  bool SameAsRun(T val, bool is_null) const {
+    return run_null_ ? is_null : !is_null && BitwiseEqual(val, run_value_);
+  }
+
+  // Write out the current run, if it has not been already
+  Status FinishRun() {
+    if (length_ == written_length_) return Status::OK();
+    if (length_ > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      return Status::Invalid("run end array is too long for int32 run ends");
+    }
+    if (run_null_) {
+      RETURN_NOT_OK(value_builder_->AppendNull());
+    } else {
+      RETURN_NOT_OK(value_builder_->Append(run_value_));
+    }
+    RETURN_NOT_OK(run_end_builder_->Append(static_cast<int32_t>(length_)));
+    written_length_ = length_;
+    return Status::OK();
+  }
+
+  T run_value_;
+  bool run_null_;
+
+  // Slots covered by the runs written out
+  size_t written_length_;
+
+  std::unique_ptr<PrimitiveBuilder<TypeClass, PrimitiveArrayImpl<TypeClass> > >
+    value_builder_;
+  std::unique_ptr<Int32Builder> run_end_builder_;
+};
+
+
+// Builds a ChunkedArray with a builder of type BuilderType. Once the builder
+// holds at least chunk_length slots it is sealed into a new chunk, instead
+// of having its buffers reallocated as the column keeps growing. A vector
+// append is kept in one chunk, so chunks may run past chunk_length by less
+// than the length of one append
+template <typename BuilderType>
+class ChunkedBuilder {
+ public:
+  ChunkedBuilder(MemoryPool* pool, const TypePtr& type, size_t chunk_length)
+      : type_(type),
+        chunk_length_(chunk_length),
+        builder_(pool, type),
+        length_(0) {}
+
+  // Forward to any Append of BuilderType
+  template <typename... Args>
+  Status Append(Args&&... args) {
+    RETURN_NOT_OK(builder_.Append(std::forward<Args>(args)...));
+    return MaybeSeal();
+  }
+
+  Status AppendNull() {
+    RETURN_NOT_OK(builder_.AppendNull());
+    return MaybeSeal();
+  }
+
+  // Slots appended so far, sealed or not
+  size_t length() const { return length_ + builder_.length();}
+
+  size_t num_sealed_chunks() const { return chunks_.size();}
+
+  // Seal the slots appended since the last chunk, if any, into a chunk
+  Status Seal() {
+    if (builder_.length() == 0) return Status::OK();
+    Array* chunk;
+    RETURN_NOT_OK(builder_.ToArray(&chunk));
+    chunks_.push_back(ArrayPtr(chunk));
+    length_ += chunk->length();
+    return Status::OK();
+  }
+
+  // Seal the last chunk and return all of them as one column, then reset
+  // the builder
+  Status Finish(ChunkedArrayPtr* out) {
+    RETURN_NOT_OK(Seal());
+    out->reset(new ChunkedArray(type_, chunks_));
+    chunks_.clear();
+    length_ = 0;
+    return Status::OK();
+  }
+
+ protected:
+  Status MaybeSeal() {
+    return builder_.length() >= chunk_length_ ? Seal() : Status::OK();
+  }
+
+  TypePtr type_;
+  size_t chunk_length_;
+  BuilderType builder_;
+  std::vector<ArrayPtr> chunks_;
+
+  // Slots in the sealed chunks
+  size_t length_;
+};
+
+
+// class BinaryBuilder : protected ListBuilder {
+
+// };
+
+
+
+// Create a builder for arrays of type. The caller owns the builder
+Status make_builder(MemoryPool* pool, const TypePtr& type, ArrayBuilder** out);
 
 } // namespace arrow
 
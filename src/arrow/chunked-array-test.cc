@@ -0,0 +1,198 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/chunked-array.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/types/integer.h"
+#include "arrow/types/string.h"
+
+using std::string;
+using std::vector;
+
+namespace arrow {
+
+class TestChunkedArray : public TestBase {
+ public:
+  // Split values into chunks of the given lengths, which must add up to
+  // the length of values
+  ChunkedArrayPtr Split(const vector<int32_t>& values,
+      const vector<uint8_t>& nulls, const vector<size_t>& lengths) {
+    std::vector<ArrayPtr> chunks;
+    size_t start = 0;
+    for (size_t length : lengths) {
+      Int32Builder builder(pool_.get(), TypePtr(new Int32Type()));
+      EXPECT_OK(builder.Append(values.data() + start, length,
+              const_cast<uint8_t*>(nulls.data()) + start));
+      Array* chunk;
+      EXPECT_OK(builder.ToArray(&chunk));
+      chunks.push_back(ArrayPtr(chunk));
+      start += length;
+    }
+    return ChunkedArrayPtr(new ChunkedArray(TypePtr(new Int32Type()), chunks));
+  }
+};
+
+
+TEST_F(TestChunkedArray, TestFindChunk) {
+  vector<int32_t> values;
+  vector<uint8_t> nulls;
+  for (int i = 0; i < 20; ++i) {
+    values.push_back(i);
+    nulls.push_back(i % 3 == 0);
+  }
+  ChunkedArrayPtr column = Split(values, nulls, {0, 5, 0, 0, 10, 5, 0});
+  ASSERT_OK(column->Validate());
+  ASSERT_EQ(20, column->length());
+  ASSERT_EQ(7, column->num_chunks());
+  ASSERT_EQ(5, column->chunk_offset(2));
+
+  // Empty chunks are never found
+  ASSERT_EQ(1, column->FindChunk(0));
+  ASSERT_EQ(1, column->FindChunk(4));
+  ASSERT_EQ(4, column->FindChunk(5));
+  ASSERT_EQ(4, column->FindChunk(14));
+  ASSERT_EQ(5, column->FindChunk(15));
+  ASSERT_EQ(5, column->FindChunk(19));
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(static_cast<bool>(nulls[i]), column->IsNull(i)) << i;
+    size_t c = column->FindChunk(i);
+    const Int32Array& chunk = static_cast<const Int32Array&>(
+        *column->chunk(c));
+    ASSERT_EQ(values[i], chunk.Value(i - column->chunk_offset(c)));
+  }
+}
+
+
+TEST_F(TestChunkedArray, TestVisitRange) {
+  vector<int32_t> values(30, 0);
+  vector<uint8_t> nulls(30, 0);
+  ChunkedArrayPtr column = Split(values, nulls, {10, 0, 10, 10});
+
+  vector<size_t> starts;
+  vector<size_t> lengths;
+  column->VisitRange(5, 25, [&](const Array& chunk, size_t start,
+          size_t length) {
+        starts.push_back(start);
+        lengths.push_back(length);
+      });
+  ASSERT_EQ(vector<size_t>({5, 0, 0}), starts);
+  ASSERT_EQ(vector<size_t>({5, 10, 5}), lengths);
+
+  size_t pieces = 0;
+  column->VisitRange(12, 12, [&](const Array&, size_t, size_t) { ++pieces;});
+  column->VisitRange(0, 30, [&](const Array&, size_t, size_t) { ++pieces;});
+  ASSERT_EQ(3, pieces);
+}
+
+
+TEST_F(TestChunkedArray, TestEquals) {
+  vector<int32_t> values;
+  vector<uint8_t> nulls;
+  randint<int32_t>(100, 0, 10, values);
+  random_nulls(100, 0.2, nulls);
+
+  ChunkedArrayPtr a = Split(values, nulls, {100});
+  ChunkedArrayPtr b = Split(values, nulls, {30, 0, 33, 37});
+  ChunkedArrayPtr c = Split(values, nulls, {1, 98, 1});
+  ASSERT_TRUE(a->Equals(*b));
+  ASSERT_TRUE(b->Equals(*c));
+  ASSERT_TRUE(c->Equals(*a));
+
+  size_t pos = 50;
+  while (nulls[pos]) ++pos;
+  values[pos] += 1;
+  ChunkedArrayPtr d = Split(values, nulls, {50, 50});
+  ASSERT_FALSE(b->Equals(*d));
+  ASSERT_FALSE(d->Equals(*a));
+
+  ChunkedArrayPtr shorter = Split(values, nulls, {50});
+  ASSERT_FALSE(shorter->Equals(*d));
+}
+
+
+TEST_F(TestChunkedArray, TestValidate) {
+  vector<int32_t> values = {1, 2};
+  vector<int32_t> offsets = {0, 1, 2};
+  vector<char> chars = {'a', 'b'};
+  ArrayPtr ints(new Int32Array(2, to_buffer(values)));
+  ArrayPtr strings(new StringArray(2, to_buffer(offsets),
+          ArrayPtr(new UInt8Array(2, to_buffer(chars)))));
+
+  ChunkedArray mixed(TypePtr(new Int32Type()), {ints, strings});
+  ASSERT_TRUE(mixed.Validate().IsInvalid());
+
+  ChunkedArray missing(TypePtr(new Int32Type()), {ints, ArrayPtr()});
+  ASSERT_TRUE(missing.Validate().IsInvalid());
+
+  // A chunk that is invalid itself
+  ArrayPtr short_ints(new Int32Array(3, to_buffer(values)));
+  ChunkedArray bad_chunk(TypePtr(new Int32Type()), {ints, short_ints});
+  ASSERT_TRUE(bad_chunk.Validate().IsInvalid());
+}
+
+
+TEST_F(TestChunkedArray, TestChunkedBuilder) {
+  ChunkedBuilder<Int32Builder> builder(pool_.get(), TypePtr(new Int32Type()),
+      100);
+  for (int i = 0; i < 1050; ++i) {
+    if (i % 7 == 0) {
+      ASSERT_OK(builder.AppendNull());
+    } else {
+      ASSERT_OK(builder.Append(i));
+    }
+  }
+  ASSERT_EQ(1050, builder.length());
+  ASSERT_EQ(10, builder.num_sealed_chunks());
+
+  // A vector append stays in one chunk
+  vector<int32_t> more(250, 3);
+  ASSERT_OK(builder.Append(more.data(), more.size()));
+  ASSERT_EQ(11, builder.num_sealed_chunks());
+
+  ChunkedArrayPtr column;
+  ASSERT_OK(builder.Finish(&column));
+  ASSERT_OK(column->Validate());
+  ASSERT_EQ(1300, column->length());
+  ASSERT_EQ(11, column->num_chunks());
+  ASSERT_EQ(300, column->chunk(10)->length());
+  for (size_t i = 0; i < 1050; ++i) {
+    ASSERT_EQ(i % 7 == 0, column->IsNull(i));
+  }
+  ASSERT_EQ(0, builder.length());
+
+  ChunkedBuilder<StringBuilder> strings(pool_.get(),
+      TypePtr(new StringType()), 2);
+  for (const char* value : {"a", "bb", "", "ccc", "d"}) {
+    ASSERT_OK(strings.Append(string(value)));
+  }
+  ASSERT_OK(strings.Finish(&column));
+  ASSERT_OK(column->Validate());
+  ASSERT_EQ(3, column->num_chunks());
+  ASSERT_EQ("ccc",
+      static_cast<const StringArray&>(*column->chunk(1)).GetString(1));
+}
+
+} // namespace arrow
@@ -0,0 +1,69 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/chunked-array.h"
+
+#include <string>
+
+namespace arrow {
+
+ChunkedArray::ChunkedArray(const TypePtr& type,
+    const std::vector<ArrayPtr>& chunks)
+    : type_(type),
+      chunks_(chunks) {
+  offsets_.reserve(chunks.size() + 1);
+  offsets_.push_back(0);
+  for (const ArrayPtr& chunk : chunks) {
+    // A missing chunk is reported by Validate
+    offsets_.push_back(offsets_.back() + (chunk ? chunk->length() : 0));
+  }
+}
+
+bool ChunkedArray::Equals(const ChunkedArray& other) const {
+  if (this == &other) return true;
+  if (type_->type != other.type_->type) return false;
+  if (length() != other.length()) return false;
+
+  // Compare each chunk with the matching range of the other column, which
+  // may span several of its chunks
+  bool equal = true;
+  size_t i = 0;
+  for (size_t c = 0; c < chunks_.size() && equal; ++c) {
+    const Array& chunk = *chunks_[c];
+    other.VisitRange(i, i + chunk.length(), [&](const Array& other_chunk,
+            size_t other_start, size_t length) {
+          size_t start = i - offsets_[c];
+          equal = equal && chunk.RangeEquals(start, start + length,
+              other_start, other_chunk);
+          i += length;
+        });
+  }
+  return equal;
+}
+
+Status ChunkedArray::Validate() const {
+  for (size_t c = 0; c < chunks_.size(); ++c) {
+    if (!chunks_[c]) {
+      return Status::Invalid("chunk " + std::to_string(c) + " is missing");
+    }
+    if (chunks_[c]->type_enum() != type_->type) {
+      return Status::Invalid("chunk " + std::to_string(c) + " is " +
+          chunks_[c]->type()->ToString() + ", not " + type_->ToString());
+    }
+    RETURN_NOT_OK(chunks_[c]->Validate());
+  }
+  return Status::OK();
+}
+
+} // namespace arrow
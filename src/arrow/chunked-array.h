@@ -0,0 +1,95 @@
+// Copyright 2015 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A logical column made of a sequence of arrays
+
+#ifndef ARROW_CHUNKED_ARRAY_H
+#define ARROW_CHUNKED_ARRAY_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/types.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+// One column of type split into chunks, each an array of the same type.
+// Slot i of the column is slot i - chunk_offset(c) of the chunk c holding
+// it. A column can grow by adding chunks without copying or reallocating
+// the existing ones, and no chunk needs to be addressable with the 32-bit
+// offsets of a single array. Chunks may be empty
+class ChunkedArray {
+ public:
+  ChunkedArray(const TypePtr& type, const std::vector<ArrayPtr>& chunks);
+
+  const TypePtr& type() const { return type_;}
+  size_t length() const { return offsets_.back();}
+
+  size_t num_chunks() const { return chunks_.size();}
+  const ArrayPtr& chunk(size_t i) const { return chunks_[i];}
+  const std::vector<ArrayPtr>& chunks() const { return chunks_;}
+
+  // Position in the column of the first slot of chunk i
+  size_t chunk_offset(size_t i) const { return offsets_[i];}
+
+  // The chunk holding slot i, found by binary search over the chunk
+  // offsets. Does *not* boundscheck
+  size_t FindChunk(size_t i) const {
+    return std::upper_bound(offsets_.begin() + 1, offsets_.end(), i) -
+      (offsets_.begin() + 1);
+  }
+
+  bool IsNull(size_t i) const {
+    size_t c = FindChunk(i);
+    return chunks_[c]->IsNull(i - offsets_[c]);
+  }
+
+  // Call visit(chunk, chunk_start, length) for each piece of the slots
+  // [start, end) held by one chunk, in order, where the piece is the slots
+  // [chunk_start, chunk_start + length) of chunk. Empty pieces are skipped
+  template <typename Visitor>
+  void VisitRange(size_t start, size_t end, Visitor visit) const {
+    if (start >= end) return;
+    for (size_t c = FindChunk(start); offsets_[c] < end; ++c) {
+      size_t piece_start = std::max(start, offsets_[c]);
+      size_t piece_end = std::min(end, offsets_[c + 1]);
+      if (piece_start < piece_end) {
+        visit(*chunks_[c], piece_start - offsets_[c], piece_end - piece_start);
+      }
+    }
+  }
+
+  // Logical equality: the same type, length and slots, however the two
+  // columns are split into chunks
+  bool Equals(const ChunkedArray& other) const;
+
+  // Every chunk must be of the column type and pass its own Validate
+  Status Validate() const;
+
+ private:
+  TypePtr type_;
+  std::vector<ArrayPtr> chunks_;
+
+  // num_chunks() + 1 entries: the start of each chunk, then the length
+  std::vector<size_t> offsets_;
+};
+
+typedef std::shared_ptr<ChunkedArray> ChunkedArrayPtr;
+
+} // namespace arrow
+
+#endif // ARROW_CHUNKED_ARRAY_H
@@ -0,0 +1,32 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The AVX2 build of the aggregation kernels. Compiled with -mavx2; only
+// called after checking that the CPU supports AVX2
+
+#include "arrow/compute/aggregate-internal.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace avx2 {
+
+ARROW_AGGREGATE_DEFINE_TARGET()
+
+} // namespace avx2
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,85 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/aggregate.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+// Each slot is null with probability percent / 100; nullptr for 0
+static Buffer* MakeNulls(MemoryPool* pool, int percent) {
+  if (percent == 0) return nullptr;
+  Random rng(random_seed());
+  std::vector<uint8_t> bits((kNumValues + 7) / 8, 0);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    util::set_bit(bits.data(), i, rng.Uniform(100) < percent);
+  }
+  return benchmark::make_buffer(pool, bits);
+}
+
+template <typename TypeClass>
+static void BenchmarkType(MemoryPool* pool, const std::string& label) {
+  typedef typename TypeClass::c_type T;
+  std::vector<T> values(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = static_cast<T>(i % 1000);
+  }
+
+  for (int percent : {0, 1, 10, 50, 90, 100}) {
+    PrimitiveArrayImpl<TypeClass> array(kNumValues,
+        benchmark::make_buffer(pool, values), MakeNulls(pool, percent));
+    std::string suffix = label + "/nulls:" + std::to_string(percent) + "%";
+    size_t bytes = kNumValues * sizeof(T);
+
+    typename sum_type<TypeClass>::type sum;
+    benchmark::run(("Sum/" + suffix).c_str(), bytes, [&]() {
+          BENCHMARK_OK(Sum(array, &sum));
+        });
+    T min;
+    benchmark::run(("Min/" + suffix).c_str(), bytes, [&]() {
+          Status s = Min(array, &min);
+        });
+    double mean;
+    benchmark::run(("Mean/" + suffix).c_str(), bytes, [&]() {
+          Status s = Mean(array, &mean);
+        });
+  }
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkType<arrow::Int32Type>(&pool, "int32");
+  arrow::compute::BenchmarkType<arrow::Int64Type>(&pool, "int64");
+  arrow::compute::BenchmarkType<arrow::DoubleType>(&pool, "double");
+  return 0;
+}
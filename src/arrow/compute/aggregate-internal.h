@@ -0,0 +1,406 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Aggregation kernels over raw value buffers and null bitmaps. This header
+// is compiled twice: once by aggregate.cc for the baseline instruction set
+// and once by aggregate-avx2.cc with -mavx2, so that the same loops are
+// vectorized for both targets. The loops keep kLanes independent
+// accumulators, so that the compiler can map them onto vector registers
+// without reassociating any floating point arithmetic; both builds therefore
+// produce bit-identical results.
+//
+// Not installed: for use by the aggregate and chunked kernels only
+
+#ifndef ARROW_COMPUTE_AGGREGATE_INTERNAL_H
+#define ARROW_COMPUTE_AGGREGATE_INTERNAL_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+#include "arrow/util/bit-util.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+typedef __int128 int128_t;
+
+// Exact integer sums are accumulated in 128 bits; floating point sums in
+// double
+template <typename T>
+struct raw_sum_type {
+  typedef typename std::conditional<std::is_floating_point<T>::value,
+                                    double, int128_t>::type type;
+};
+
+// Entry points of the two builds, instantiated for every integer and
+// floating point c_type. Min and Max return false if there are no non-null
+// values
+namespace portable {
+
+template <typename T>
+typename raw_sum_type<T>::type Sum(const T* values, const uint8_t* null_bits,
+    size_t length);
+template <typename T>
+bool Min(const T* values, const uint8_t* null_bits, size_t length, T* out);
+template <typename T>
+bool Max(const T* values, const uint8_t* null_bits, size_t length, T* out);
+
+} // namespace portable
+
+namespace avx2 {
+
+template <typename T>
+typename raw_sum_type<T>::type Sum(const T* values, const uint8_t* null_bits,
+    size_t length);
+template <typename T>
+bool Min(const T* values, const uint8_t* null_bits, size_t length, T* out);
+template <typename T>
+bool Max(const T* values, const uint8_t* null_bits, size_t length, T* out);
+
+} // namespace avx2
+
+// Defined by aggregate.cc: the sum of the build for the CPU, and its
+// narrowing to sum_type, which returns Invalid if an integer sum does not
+// fit. The chunked kernels add the raw sums of the chunks and narrow only
+// the total, so that a chunk may overflow on its own
+template <typename T>
+typename raw_sum_type<T>::type raw_sum(const T* values,
+    const uint8_t* null_bits, size_t length);
+
+template <typename Out>
+Status narrow_sum(int128_t sum, Out* out);
+Status narrow_sum(double sum, double* out);
+
+// The kernels have internal linkage so that the two builds do not collide
+namespace {
+
+static constexpr size_t kLanes = 8;
+
+// Slots per call to a dense block function when there are no nulls. Bounds
+// the work between folds of the lane accumulators
+static constexpr size_t kMaxDenseRun = 1024;
+
+// Feed the values of 64-slot blocks to op: whole runs of blocks without
+// nulls to op->Dense(values, n), blocks with some nulls to
+// op->Mixed(values, n, null_word). Blocks of only nulls are skipped without
+// touching their values
+template <typename T, typename Op>
+inline void visit_blocks(const T* values, const uint8_t* null_bits,
+    size_t length, size_t max_run, Op* op) {
+  if (null_bits == nullptr) {
+    for (size_t i = 0; i < length; i += max_run) {
+      op->Dense(values + i, length - i < max_run ? length - i : max_run);
+    }
+    return;
+  }
+
+  size_t run_start = 0;
+  size_t run_length = 0;
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t word = util::load_bits(null_bits, i, n);
+    if (word == 0) {
+      if (run_length == 0) run_start = i;
+      run_length += n;
+      if (run_length >= max_run) {
+        op->Dense(values + run_start, run_length);
+        run_length = 0;
+      }
+      continue;
+    }
+    if (run_length > 0) {
+      op->Dense(values + run_start, run_length);
+      run_length = 0;
+    }
+    uint64_t all_null = n < 64 ? (static_cast<uint64_t>(1) << n) - 1 :
+      ~static_cast<uint64_t>(0);
+    if (word != all_null) {
+      op->Mixed(values + i, n, word);
+    }
+  }
+  if (run_length > 0) {
+    op->Dense(values + run_start, run_length);
+  }
+}
+
+// Sums of 8- to 32-bit integers: int64 lanes cannot overflow within a run
+template <typename T, typename Enable = void>
+struct SumOp {
+  typedef typename std::conditional<std::is_signed<T>::value, int64_t,
+                                    uint64_t>::type Lane;
+  int128_t total = 0;
+
+  void Dense(const T* values, size_t n) {
+    Lane lanes[kLanes] = {};
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+      for (size_t k = 0; k < kLanes; ++k) {
+        lanes[k] += values[i + k];
+      }
+    }
+    for (; i < n; ++i) {
+      lanes[0] += values[i];
+    }
+    Fold(lanes);
+  }
+
+  void Mixed(const T* values, size_t n, uint64_t null_word) {
+    Lane lanes[kLanes] = {};
+    for (size_t i = 0; i < n; ++i) {
+      lanes[i % kLanes] += ((null_word >> i) & 1) ? 0 : values[i];
+    }
+    Fold(lanes);
+  }
+
+  void Fold(const Lane* lanes) {
+    for (size_t k = 0; k < kLanes; ++k) {
+      total += lanes[k];
+    }
+  }
+};
+
+// 64-bit integers are split into their high and low 32-bit halves, which
+// are summed separately in 64-bit lanes and only combined into 128 bits when
+// the lanes are folded
+template <typename T>
+struct SumOp<T, typename std::enable_if<std::is_integral<T>::value &&
+                                        sizeof(T) == 8>::type> {
+  typedef typename std::conditional<std::is_signed<T>::value, int64_t,
+                                    uint64_t>::type High;
+  int128_t total = 0;
+
+  void Dense(const T* values, size_t n) {
+    High high[kLanes] = {};
+    uint64_t low[kLanes] = {};
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+      for (size_t k = 0; k < kLanes; ++k) {
+        high[k] += values[i + k] >> 32;
+        low[k] += static_cast<uint64_t>(values[i + k]) & 0xFFFFFFFF;
+      }
+    }
+    for (; i < n; ++i) {
+      high[0] += values[i] >> 32;
+      low[0] += static_cast<uint64_t>(values[i]) & 0xFFFFFFFF;
+    }
+    Fold(high, low);
+  }
+
+  void Mixed(const T* values, size_t n, uint64_t null_word) {
+    High high[kLanes] = {};
+    uint64_t low[kLanes] = {};
+    for (size_t i = 0; i < n; ++i) {
+      T value = ((null_word >> i) & 1) ? 0 : values[i];
+      high[i % kLanes] += value >> 32;
+      low[i % kLanes] += static_cast<uint64_t>(value) & 0xFFFFFFFF;
+    }
+    Fold(high, low);
+  }
+
+  void Fold(const High* high, const uint64_t* low) {
+    for (size_t k = 0; k < kLanes; ++k) {
+      total += static_cast<int128_t>(high[k]) * (static_cast<int128_t>(1) << 32);
+      total += low[k];
+    }
+  }
+};
+
+// Floating point sums: each run is summed in kLanes double accumulators,
+// and the run sums are combined pairwise, so that the rounding error grows
+// with the log of the number of runs rather than linearly
+template <typename T>
+struct SumOp<T, typename std::enable_if<
+                  std::is_floating_point<T>::value>::type> {
+  // partial[level] holds the sum of 2^level runs, if set
+  double partial[64];
+  uint64_t num_runs = 0;
+
+  void Dense(const T* values, size_t n) {
+    double lanes[kLanes] = {};
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+      for (size_t k = 0; k < kLanes; ++k) {
+        lanes[k] += values[i + k];
+      }
+    }
+    for (; i < n; ++i) {
+      lanes[0] += values[i];
+    }
+    Fold(lanes);
+  }
+
+  void Mixed(const T* values, size_t n, uint64_t null_word) {
+    double lanes[kLanes] = {};
+    for (size_t i = 0; i < n; ++i) {
+      lanes[i % kLanes] += ((null_word >> i) & 1) ? 0 : values[i];
+    }
+    Fold(lanes);
+  }
+
+  void Fold(const double* lanes) {
+    double sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+      ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+    // Like incrementing a binary counter: merge equal-sized partial sums
+    size_t level = 0;
+    for (uint64_t runs = num_runs; runs & 1; runs >>= 1, ++level) {
+      sum += partial[level];
+    }
+    partial[level] = sum;
+    ++num_runs;
+  }
+
+  double total() const {
+    double sum = 0;
+    size_t level = 0;
+    for (uint64_t runs = num_runs; runs != 0; runs >>= 1, ++level) {
+      if (runs & 1) sum += partial[level];
+    }
+    return sum;
+  }
+};
+
+// Minimum (kIsMin) or maximum. Null slots are replaced by the identity,
+// the largest (smallest) value of the type. NaNs never compare less or
+// greater, so they are ignored
+template <typename T, bool kIsMin>
+struct ExtremeOp {
+  T lanes[kLanes];
+  bool any = false;
+
+  ExtremeOp() {
+    for (size_t k = 0; k < kLanes; ++k) {
+      lanes[k] = Identity();
+    }
+  }
+
+  static T Identity() {
+    if (std::is_floating_point<T>::value) {
+      return kIsMin ? std::numeric_limits<T>::infinity() :
+        -std::numeric_limits<T>::infinity();
+    }
+    return kIsMin ? std::numeric_limits<T>::max() :
+      std::numeric_limits<T>::lowest();
+  }
+
+  static T Pick(T acc, T value) {
+    if (kIsMin) {
+      return value < acc ? value : acc;
+    }
+    return value > acc ? value : acc;
+  }
+
+  void Dense(const T* values, size_t n) {
+    any = true;
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+      for (size_t k = 0; k < kLanes; ++k) {
+        lanes[k] = Pick(lanes[k], values[i + k]);
+      }
+    }
+    for (; i < n; ++i) {
+      lanes[0] = Pick(lanes[0], values[i]);
+    }
+  }
+
+  void Mixed(const T* values, size_t n, uint64_t null_word) {
+    any = true;
+    const T identity = Identity();
+    for (size_t i = 0; i < n; ++i) {
+      T value = ((null_word >> i) & 1) ? identity : values[i];
+      lanes[i % kLanes] = Pick(lanes[i % kLanes], value);
+    }
+  }
+
+  T result() const {
+    T out = lanes[0];
+    for (size_t k = 1; k < kLanes; ++k) {
+      out = Pick(out, lanes[k]);
+    }
+    return out;
+  }
+};
+
+template <typename T>
+inline int128_t finish_sum(const SumOp<T>& op, int128_t*) {
+  return op.total;
+}
+
+template <typename T>
+inline double finish_sum(const SumOp<T>& op, double*) {
+  return op.total();
+}
+
+template <typename T>
+inline typename raw_sum_type<T>::type sum_kernel(const T* values,
+    const uint8_t* null_bits, size_t length) {
+  SumOp<T> op;
+  visit_blocks(values, null_bits, length, kMaxDenseRun, &op);
+  return finish_sum(op, static_cast<typename raw_sum_type<T>::type*>(nullptr));
+}
+
+template <typename T, bool kIsMin>
+inline bool extreme_kernel(const T* values, const uint8_t* null_bits,
+    size_t length, T* out) {
+  ExtremeOp<T, kIsMin> op;
+  visit_blocks(values, null_bits, length, kMaxDenseRun, &op);
+  *out = op.result();
+  return op.any;
+}
+
+} // namespace
+
+// Define the entry points of one build in the current namespace
+#define ARROW_AGGREGATE_INSTANTIATE(T)                                  \
+  template typename raw_sum_type<T>::type Sum<T>(const T*,              \
+      const uint8_t*, size_t);                                          \
+  template bool Min<T>(const T*, const uint8_t*, size_t, T*);           \
+  template bool Max<T>(const T*, const uint8_t*, size_t, T*);
+
+#define ARROW_AGGREGATE_DEFINE_TARGET()                                 \
+  template <typename T>                                                 \
+  typename raw_sum_type<T>::type Sum(const T* values,                   \
+      const uint8_t* null_bits, size_t length) {                        \
+    return sum_kernel(values, null_bits, length);                       \
+  }                                                                     \
+  template <typename T>                                                 \
+  bool Min(const T* values, const uint8_t* null_bits, size_t length,    \
+      T* out) {                                                         \
+    return extreme_kernel<T, true>(values, null_bits, length, out);     \
+  }                                                                     \
+  template <typename T>                                                 \
+  bool Max(const T* values, const uint8_t* null_bits, size_t length,    \
+      T* out) {                                                         \
+    return extreme_kernel<T, false>(values, null_bits, length, out);    \
+  }                                                                     \
+  ARROW_AGGREGATE_INSTANTIATE(int8_t)                                   \
+  ARROW_AGGREGATE_INSTANTIATE(uint8_t)                                  \
+  ARROW_AGGREGATE_INSTANTIATE(int16_t)                                  \
+  ARROW_AGGREGATE_INSTANTIATE(uint16_t)                                 \
+  ARROW_AGGREGATE_INSTANTIATE(int32_t)                                  \
+  ARROW_AGGREGATE_INSTANTIATE(uint32_t)                                 \
+  ARROW_AGGREGATE_INSTANTIATE(int64_t)                                  \
+  ARROW_AGGREGATE_INSTANTIATE(uint64_t)                                 \
+  ARROW_AGGREGATE_INSTANTIATE(float)                                    \
+  ARROW_AGGREGATE_INSTANTIATE(double)
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_AGGREGATE_INTERNAL_H
@@ -0,0 +1,224 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/aggregate.h"
+#include "arrow/compute/aggregate-internal.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestAggregate : public TestBase {};
+
+
+template <typename TypeClass, typename T>
+void CheckIntegers(const vector<T>& values, vector<uint8_t> nulls) {
+  PrimitiveArrayImpl<TypeClass> array(values.size(), to_buffer(values),
+      nulls.empty() ? nullptr : bytes_to_null_buffer(nulls.data(),
+          nulls.size()));
+
+  int64_t ex_sum = 0;
+  size_t ex_count = 0;
+  T ex_min = std::numeric_limits<T>::max();
+  T ex_max = std::numeric_limits<T>::lowest();
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (!nulls.empty() && nulls[i]) continue;
+    ex_sum += values[i];
+    ++ex_count;
+    ex_min = std::min(ex_min, values[i]);
+    ex_max = std::max(ex_max, values[i]);
+  }
+
+  typename sum_type<TypeClass>::type sum;
+  ASSERT_OK(Sum(array, &sum));
+  ASSERT_EQ(ex_sum, sum);
+  ASSERT_EQ(ex_count, Count(array));
+
+  T min, max;
+  ASSERT_OK(Min(array, &min));
+  ASSERT_OK(Max(array, &max));
+  ASSERT_EQ(ex_min, min);
+  ASSERT_EQ(ex_max, max);
+
+  double mean;
+  ASSERT_OK(Mean(array, &mean));
+  ASSERT_DOUBLE_EQ(static_cast<double>(ex_sum) / ex_count, mean);
+}
+
+
+TEST_F(TestAggregate, TestIntegers) {
+  // Lengths that are not multiples of the lanes or of 64, and null
+  // densities covering null-free, mixed and all-null words
+  for (size_t n : {1, 7, 64, 1000, 5000}) {
+    for (double null_probability : {0.0, 0.1, 0.9}) {
+      vector<uint8_t> nulls;
+      if (null_probability > 0) {
+        random_nulls(n, 1 - null_probability, nulls);
+        nulls[0] = 0;
+      }
+
+      vector<int8_t> i8;
+      randint<int8_t>(n, -100, 100, i8);
+      CheckIntegers<Int8Type>(i8, nulls);
+
+      vector<uint16_t> u16;
+      randint<uint16_t>(n, 0, 60000, u16);
+      CheckIntegers<UInt16Type>(u16, nulls);
+
+      vector<int32_t> i32;
+      randint<int32_t>(n, -2000000000, 2000000000, i32);
+      CheckIntegers<Int32Type>(i32, nulls);
+
+      vector<int64_t> i64;
+      randint<int64_t>(n, -1000000000000LL, 1000000000000LL, i64);
+      CheckIntegers<Int64Type>(i64, nulls);
+    }
+  }
+}
+
+
+TEST_F(TestAggregate, TestWideningAndOverflow) {
+  // int32 values whose sum overflows int32
+  vector<int32_t> i32(1000, std::numeric_limits<int32_t>::max());
+  Int32Array i32_array(i32.size(), to_buffer(i32));
+  int64_t sum;
+  ASSERT_OK(Sum(i32_array, &sum));
+  ASSERT_EQ(1000LL * std::numeric_limits<int32_t>::max(), sum);
+
+  // Partial int64 sums may leave the int64 range as long as the total fits
+  int64_t big = std::numeric_limits<int64_t>::max();
+  vector<int64_t> i64 = {big, big, -big, -big, 5};
+  Int64Array i64_array(i64.size(), to_buffer(i64));
+  ASSERT_OK(Sum(i64_array, &sum));
+  ASSERT_EQ(5, sum);
+
+  double mean;
+  vector<int64_t> overflow = {big, big, 1};
+  Int64Array overflow_array(overflow.size(), to_buffer(overflow));
+  ASSERT_RAISES(Invalid, Sum(overflow_array, &sum));
+  ASSERT_OK(Mean(overflow_array, &mean));
+  ASSERT_DOUBLE_EQ((2.0 * big + 1) / 3, mean);
+
+  vector<uint64_t> u64 = {std::numeric_limits<uint64_t>::max(), 0};
+  UInt64Array u64_array(u64.size(), to_buffer(u64));
+  uint64_t usum;
+  ASSERT_OK(Sum(u64_array, &usum));
+  ASSERT_EQ(std::numeric_limits<uint64_t>::max(), usum);
+  u64[1] = 1;
+  ASSERT_RAISES(Invalid, Sum(u64_array, &usum));
+}
+
+
+TEST_F(TestAggregate, TestPairwiseSum) {
+  // Naive summation of 1e7 copies of 0.1 is off by about 1e-4; the pairwise
+  // sum stays within a few ulps
+  size_t n = 10000000;
+  vector<double> values(n, 0.1);
+  DoubleArray array(n, to_buffer(values));
+  double sum;
+  ASSERT_OK(Sum(array, &sum));
+  ASSERT_NEAR(1e6, sum, 1e-8);
+
+  vector<float> floats(n, 0.1f);
+  FloatArray float_array(n, to_buffer(floats));
+  ASSERT_OK(Sum(float_array, &sum));
+  ASSERT_NEAR(n * static_cast<double>(0.1f), sum, 1e-6);
+}
+
+
+TEST_F(TestAggregate, TestFloatingNulls) {
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  vector<double> values = {1.5, 1e300, nan, -2.5, 4.0};
+  vector<uint8_t> nulls = {0, 1, 0, 0, 0};
+  DoubleArray array(values.size(), to_buffer(values),
+      bytes_to_null_buffer(nulls.data(), nulls.size()));
+
+  double min, max;
+  ASSERT_OK(Min(array, &min));
+  ASSERT_OK(Max(array, &max));
+  ASSERT_EQ(-2.5, min);
+  ASSERT_EQ(4.0, max);
+  ASSERT_EQ(4, Count(array));
+
+  vector<double> nans = {nan, nan};
+  DoubleArray nan_array(nans.size(), to_buffer(nans));
+  ASSERT_OK(Min(nan_array, &min));
+  ASSERT_TRUE(std::isnan(min));
+
+  // A genuine infinity is not mistaken for the identity
+  vector<double> inf = {nan, std::numeric_limits<double>::infinity()};
+  DoubleArray inf_array(inf.size(), to_buffer(inf));
+  ASSERT_OK(Min(inf_array, &min));
+  ASSERT_EQ(std::numeric_limits<double>::infinity(), min);
+}
+
+
+TEST_F(TestAggregate, TestAllNull) {
+  vector<int32_t> values = {1, 2, 3};
+  vector<uint8_t> nulls = {1, 1, 1};
+  Int32Array array(values.size(), to_buffer(values),
+      bytes_to_null_buffer(nulls.data(), nulls.size()));
+
+  int64_t sum;
+  ASSERT_OK(Sum(array, &sum));
+  ASSERT_EQ(0, sum);
+  ASSERT_EQ(0, Count(array));
+
+  int32_t min;
+  double mean;
+  ASSERT_RAISES(Invalid, Min(array, &min));
+  ASSERT_RAISES(Invalid, Max(array, &min));
+  ASSERT_RAISES(Invalid, Mean(array, &mean));
+}
+
+
+TEST_F(TestAggregate, TestBuildsAgree) {
+  if (!__builtin_cpu_supports("avx2")) return;
+
+  size_t n = 10000;
+  vector<double> values;
+  vector<uint8_t> nulls;
+  randint<double>(n, -1e6, 1e6, values);
+  for (size_t i = 0; i < n; ++i) values[i] /= 7;
+  random_nulls(n, 0.7, nulls);
+  Buffer* null_buf = bytes_to_null_buffer(nulls.data(), n);
+
+  ASSERT_EQ(portable::Sum(values.data(), null_buf->data(), n),
+      avx2::Sum(values.data(), null_buf->data(), n));
+  double portable_min, avx2_min;
+  portable::Min(values.data(), null_buf->data(), n, &portable_min);
+  avx2::Min(values.data(), null_buf->data(), n, &avx2_min);
+  ASSERT_EQ(portable_min, avx2_min);
+  null_buf->Decref();
+}
+
+} // namespace compute
+
+} // namespace arrow
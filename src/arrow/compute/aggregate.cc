@@ -0,0 +1,185 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/aggregate.h"
+
+#include <cmath>
+#include <limits>
+
+#include "arrow/compute/aggregate-internal.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace portable {
+
+ARROW_AGGREGATE_DEFINE_TARGET()
+
+} // namespace portable
+
+namespace {
+
+bool use_avx2() {
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+
+} // namespace
+
+template <typename T>
+typename raw_sum_type<T>::type raw_sum(const T* values,
+    const uint8_t* null_bits, size_t length) {
+  return use_avx2() ? avx2::Sum(values, null_bits, length) :
+    portable::Sum(values, null_bits, length);
+}
+
+template <typename Out>
+Status narrow_sum(int128_t sum, Out* out) {
+  if (sum < static_cast<int128_t>(std::numeric_limits<Out>::min()) ||
+      sum > static_cast<int128_t>(std::numeric_limits<Out>::max())) {
+    return Status::Invalid("integer sum overflows");
+  }
+  *out = static_cast<Out>(sum);
+  return Status::OK();
+}
+
+Status narrow_sum(double sum, double* out) {
+  *out = sum;
+  return Status::OK();
+}
+
+template Status narrow_sum<int64_t>(int128_t, int64_t*);
+template Status narrow_sum<uint64_t>(int128_t, uint64_t*);
+
+namespace {
+
+double to_double(int128_t sum) {
+  return static_cast<double>(sum);
+}
+
+double to_double(double sum) {
+  return sum;
+}
+
+// Whether every non-null value is NaN
+template <typename T>
+bool all_nan(const T* values, const uint8_t* null_bits, size_t length) {
+  if (!std::is_floating_point<T>::value) return false;
+  for (size_t i = 0; i < length; ++i) {
+    if (null_bits != nullptr && util::get_bit(null_bits, i)) continue;
+    if (!std::isnan(values[i])) return false;
+  }
+  return true;
+}
+
+template <typename TypeClass, bool kIsMin>
+Status Extreme(const PrimitiveArrayImpl<TypeClass>& values,
+    typename TypeClass::c_type* out) {
+  typedef typename TypeClass::c_type T;
+  const T* data = values.raw_data();
+  const uint8_t* null_bits = values.null_bits();
+  size_t length = values.length();
+
+  bool found;
+  if (use_avx2()) {
+    found = kIsMin ? avx2::Min(data, null_bits, length, out) :
+      avx2::Max(data, null_bits, length, out);
+  } else {
+    found = kIsMin ? portable::Min(data, null_bits, length, out) :
+      portable::Max(data, null_bits, length, out);
+  }
+  if (!found) {
+    return Status::Invalid("no non-null values");
+  }
+
+  // NaNs are skipped by the kernels, so an all-NaN input leaves the
+  // identity (an infinity) behind
+  if (std::is_floating_point<T>::value && std::isinf(*out) &&
+      all_nan(data, null_bits, length)) {
+    *out = std::numeric_limits<T>::quiet_NaN();
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+size_t Count(const Array& values) {
+  if (values.null_bits() == nullptr) {
+    return values.length();
+  }
+  return values.length() -
+    util::count_set_bits(values.null_bits(), 0, values.length());
+}
+
+template <typename TypeClass>
+Status Sum(const PrimitiveArrayImpl<TypeClass>& values,
+    typename sum_type<TypeClass>::type* out) {
+  return narrow_sum(raw_sum(values.raw_data(), values.null_bits(),
+          values.length()), out);
+}
+
+template <typename TypeClass>
+Status Min(const PrimitiveArrayImpl<TypeClass>& values,
+    typename TypeClass::c_type* out) {
+  return Extreme<TypeClass, true>(values, out);
+}
+
+template <typename TypeClass>
+Status Max(const PrimitiveArrayImpl<TypeClass>& values,
+    typename TypeClass::c_type* out) {
+  return Extreme<TypeClass, false>(values, out);
+}
+
+template <typename TypeClass>
+Status Mean(const PrimitiveArrayImpl<TypeClass>& values, double* out) {
+  size_t count = Count(values);
+  if (count == 0) {
+    return Status::Invalid("no non-null values");
+  }
+  *out = to_double(raw_sum(values.raw_data(), values.null_bits(),
+          values.length())) / count;
+  return Status::OK();
+}
+
+#define AGGREGATE_INSTANTIATE(TypeClass)                                \
+  template Status Sum<TypeClass>(const PrimitiveArrayImpl<TypeClass>&,  \
+      sum_type<TypeClass>::type*);                                      \
+  template Status Min<TypeClass>(const PrimitiveArrayImpl<TypeClass>&,  \
+      TypeClass::c_type*);                                              \
+  template Status Max<TypeClass>(const PrimitiveArrayImpl<TypeClass>&,  \
+      TypeClass::c_type*);                                              \
+  template Status Mean<TypeClass>(const PrimitiveArrayImpl<TypeClass>&, \
+      double*);                                                         \
+  template raw_sum_type<TypeClass::c_type>::type                        \
+  raw_sum<TypeClass::c_type>(const TypeClass::c_type*, const uint8_t*,  \
+      size_t);
+
+AGGREGATE_INSTANTIATE(Int8Type);
+AGGREGATE_INSTANTIATE(UInt8Type);
+AGGREGATE_INSTANTIATE(Int16Type);
+AGGREGATE_INSTANTIATE(UInt16Type);
+AGGREGATE_INSTANTIATE(Int32Type);
+AGGREGATE_INSTANTIATE(UInt32Type);
+AGGREGATE_INSTANTIATE(Int64Type);
+AGGREGATE_INSTANTIATE(UInt64Type);
+AGGREGATE_INSTANTIATE(FloatType);
+AGGREGATE_INSTANTIATE(DoubleType);
+
+#undef AGGREGATE_INSTANTIATE
+
+} // namespace compute
+
+} // namespace arrow
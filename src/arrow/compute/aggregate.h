@@ -0,0 +1,81 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_AGGREGATE_H
+#define ARROW_COMPUTE_AGGREGATE_H
+
+#include <cstdint>
+#include <type_traits>
+
+#include "arrow/array.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Aggregates of the non-null values of integer and floating point arrays.
+//
+// Null slots are skipped a 64-slot word of the null bitmap at a time: words
+// without nulls go through a dense loop, words of only nulls are not read
+// at all. The loops keep several independent accumulators so that they
+// vectorize; an AVX2 build of them is used when the CPU supports it, and it
+// gives the same results as the baseline build.
+
+// Integer sums are widened to 64 bits, int64 for signed and uint64 for
+// unsigned types; floating point sums are computed in double
+template <typename TypeClass>
+struct sum_type {
+  typedef typename TypeClass::c_type T;
+  typedef typename std::conditional<
+    std::is_floating_point<T>::value, double,
+    typename std::conditional<std::is_signed<T>::value, int64_t,
+                              uint64_t>::type>::type type;
+};
+
+// Number of non-null slots
+size_t Count(const Array& values);
+
+// Sum of the non-null values, 0 if there are none. Integer values are summed
+// exactly, and Invalid is returned if the sum does not fit in the widened
+// type. Floating point values are summed pairwise, with an error bound that
+// grows with the log of the length rather than linearly
+template <typename TypeClass>
+Status Sum(const PrimitiveArrayImpl<TypeClass>& values,
+    typename sum_type<TypeClass>::type* out);
+
+// Smallest and largest non-null value. NaNs are ignored unless every
+// non-null value is NaN, in which case the result is NaN. Returns Invalid if
+// there are no non-null values
+template <typename TypeClass>
+Status Min(const PrimitiveArrayImpl<TypeClass>& values,
+    typename TypeClass::c_type* out);
+
+template <typename TypeClass>
+Status Max(const PrimitiveArrayImpl<TypeClass>& values,
+    typename TypeClass::c_type* out);
+
+// Mean of the non-null values, computed from the exact (integer) or
+// pairwise (floating point) sum. Returns Invalid if there are no non-null
+// values
+template <typename TypeClass>
+Status Mean(const PrimitiveArrayImpl<TypeClass>& values, double* out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_AGGREGATE_H
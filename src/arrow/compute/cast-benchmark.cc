@@ -0,0 +1,88 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/cast.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/benchmark-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+// Cast kNumValues small whole numbers, which pass every check, from
+// FromType to ToType, with and without the checks
+template <typename FromType, typename ToType>
+static void BenchmarkCast(MemoryPool* pool, const std::string& label) {
+  typedef typename FromType::c_type From;
+  Buffer* buf;
+  BENCHMARK_OK(pool->NewBuffer(kNumValues * sizeof(From), &buf));
+  From* values = reinterpret_cast<From*>(buf->data());
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = static_cast<From>(i % 100);
+  }
+  PrimitiveArrayImpl<FromType> array(kNumValues, buf);
+  TypePtr to_type(new ToType(false));
+
+  CastOptions checked;
+  CastOptions unchecked;
+  unchecked.check_overflow = false;
+  unchecked.check_truncation = false;
+  for (bool check : {true, false}) {
+    std::string name = "Cast/" + label + (check ? "/checked" : "/unchecked");
+    benchmark::run(name.c_str(), kNumValues * sizeof(From), [&]() {
+          Array* out;
+          BENCHMARK_OK(Cast(pool, array, to_type, check ? checked : unchecked,
+                  &out));
+          delete out;
+        });
+  }
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkCast<arrow::Int32Type, arrow::Int64Type>(&pool,
+      "int32->int64");
+  arrow::compute::BenchmarkCast<arrow::Int64Type, arrow::Int32Type>(&pool,
+      "int64->int32");
+  arrow::compute::BenchmarkCast<arrow::Int32Type, arrow::Int8Type>(&pool,
+      "int32->int8");
+  arrow::compute::BenchmarkCast<arrow::Int32Type, arrow::DoubleType>(&pool,
+      "int32->double");
+  arrow::compute::BenchmarkCast<arrow::Int64Type, arrow::DoubleType>(&pool,
+      "int64->double");
+  arrow::compute::BenchmarkCast<arrow::DoubleType, arrow::Int32Type>(&pool,
+      "double->int32");
+  arrow::compute::BenchmarkCast<arrow::FloatType, arrow::Int32Type>(&pool,
+      "float->int32");
+  arrow::compute::BenchmarkCast<arrow::DoubleType, arrow::FloatType>(&pool,
+      "double->float");
+  arrow::compute::BenchmarkCast<arrow::Int32Type, arrow::UInt32Type>(&pool,
+      "int32->uint32");
+  return 0;
+}
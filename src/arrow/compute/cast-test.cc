@@ -0,0 +1,388 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/cast.h"
+#include "arrow/compute/kernel-util.h"
+#include "arrow/types/boolean.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestCast : public TestBase {
+ public:
+  template <typename FromType, typename From>
+  Status CastValues(const vector<From>& values, const vector<uint8_t>& nulls,
+      const TypePtr& to_type, const CastOptions& options,
+      unique_ptr<Array>* out) {
+    PrimitiveArrayImpl<FromType> array(values.size(), to_buffer(values),
+        nulls.empty() ? nullptr :
+        bytes_to_null_buffer(const_cast<uint8_t*>(nulls.data()),
+            nulls.size()));
+    Array* result;
+    RETURN_NOT_OK(Cast(pool_.get(), array, to_type, options, &result));
+    out->reset(result);
+    return Status::OK();
+  }
+
+  template <typename ToType, typename To>
+  void AssertValues(const Array& array, const vector<To>& expected) {
+    TypeEnum type = ToType::type_enum;
+    ASSERT_EQ(type, array.type_enum());
+    ASSERT_EQ(expected.size(), array.length());
+    const To* values =
+      static_cast<const PrimitiveArrayImpl<ToType>&>(array).raw_data();
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i], values[i]) << i;
+    }
+  }
+};
+
+// Cast the values 0..99, which every numeric type represents exactly,
+// between every pair of numeric types
+template <typename FromType>
+struct CastFromVisitor {
+  TestCast* test;
+
+  template <typename ToType>
+  Status Visit() {
+    typedef typename FromType::c_type From;
+    typedef typename ToType::c_type To;
+    if (FromType::type_enum == TypeEnum::BOOL ||
+        ToType::type_enum == TypeEnum::BOOL) {
+      return Status::OK();
+    }
+    vector<From> values;
+    vector<To> expected;
+    vector<uint8_t> nulls;
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(static_cast<From>(i));
+      expected.push_back(static_cast<To>(i));
+      nulls.push_back(i % 7 == 3);
+    }
+    unique_ptr<Array> result;
+    RETURN_NOT_OK(test->CastValues<FromType>(values, nulls,
+            TypePtr(new ToType()), CastOptions(), &result));
+    EXPECT_TRUE(result->type()->nullable);
+    const To* out =
+      static_cast<const PrimitiveArrayImpl<ToType>&>(*result).raw_data();
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(nulls[i], result->IsNull(i));
+      EXPECT_EQ(expected[i], out[i]) << result->type()->ToString() << " " << i;
+    }
+    return Status::OK();
+  }
+};
+
+struct CastPairsVisitor {
+  TestCast* test;
+
+  template <typename FromType>
+  Status Visit() {
+    CastFromVisitor<FromType> visitor = {test};
+    for (TypeEnum to : {TypeEnum::UINT8, TypeEnum::INT8, TypeEnum::UINT16,
+            TypeEnum::INT16, TypeEnum::UINT32, TypeEnum::INT32,
+            TypeEnum::UINT64, TypeEnum::INT64, TypeEnum::FLOAT,
+            TypeEnum::DOUBLE}) {
+      RETURN_NOT_OK(visit_primitive(to, &visitor));
+    }
+    return Status::OK();
+  }
+};
+
+
+TEST_F(TestCast, TestAllPairs) {
+  CastPairsVisitor visitor = {this};
+  for (TypeEnum from : {TypeEnum::UINT8, TypeEnum::INT8, TypeEnum::UINT16,
+          TypeEnum::INT16, TypeEnum::UINT32, TypeEnum::INT32,
+          TypeEnum::UINT64, TypeEnum::INT64, TypeEnum::FLOAT,
+          TypeEnum::DOUBLE}) {
+    ASSERT_OK(visit_primitive(from, &visitor));
+  }
+}
+
+
+TEST_F(TestCast, TestIntegerOverflow) {
+  vector<int32_t> values(200, 1);
+  values[130] = 128;
+  values[150] = -129;
+  TypePtr int8(new Int8Type());
+
+  unique_ptr<Array> result;
+  Status s = CastValues<Int32Type>(values, {}, int8, CastOptions(), &result);
+  ASSERT_TRUE(s.IsInvalid());
+  ASSERT_NE(string::npos, s.ToString().find("index 130 overflows"))
+    << s.ToString();
+
+  // The first bad value is reported, wherever it is in its block
+  values[130] = 1;
+  s = CastValues<Int32Type>(values, {}, int8, CastOptions(), &result);
+  ASSERT_NE(string::npos, s.ToString().find("index 150 overflows"))
+    << s.ToString();
+
+  // Bad values in null slots are ignored
+  vector<uint8_t> nulls(200, 0);
+  nulls[150] = 1;
+  ASSERT_OK(CastValues<Int32Type>(values, nulls, int8, CastOptions(),
+          &result));
+
+  // Unchecked, out of range values wrap around
+  CastOptions options;
+  options.check_overflow = false;
+  ASSERT_OK(CastValues<Int32Type>(vector<int32_t>({128, -129, 5}), {}, int8,
+          options, &result));
+  AssertValues<Int8Type>(*result, vector<int8_t>({-128, 127, 5}));
+
+  // Signedness
+  s = CastValues<Int32Type>(vector<int32_t>({1, -1}), {},
+      TypePtr(new UInt64Type()), CastOptions(), &result);
+  ASSERT_NE(string::npos, s.ToString().find("index 1 overflows"));
+  s = CastValues<UInt64Type>(vector<uint64_t>({1ULL << 63}), {},
+      TypePtr(new Int64Type()), CastOptions(), &result);
+  ASSERT_TRUE(s.IsInvalid());
+  ASSERT_OK(CastValues<UInt32Type>(vector<uint32_t>({0xFFFFFFFF}), {},
+          TypePtr(new Int64Type()), CastOptions(), &result));
+  AssertValues<Int64Type>(*result, vector<int64_t>({0xFFFFFFFFLL}));
+  ASSERT_OK(CastValues<Int16Type>(vector<int16_t>({-32768, 32767}), {},
+          TypePtr(new Int64Type()), CastOptions(), &result));
+  AssertValues<Int64Type>(*result, vector<int64_t>({-32768, 32767}));
+}
+
+
+TEST_F(TestCast, TestFloatToInteger) {
+  TypePtr int32(new Int32Type());
+  unique_ptr<Array> result;
+
+  Status s = CastValues<DoubleType>(vector<double>({1, 2.5}), {}, int32,
+      CastOptions(), &result);
+  ASSERT_NE(string::npos, s.ToString().find("index 1 truncates"));
+
+  s = CastValues<DoubleType>(vector<double>({1, 2, 3e9}), {}, int32,
+      CastOptions(), &result);
+  ASSERT_NE(string::npos, s.ToString().find("index 2 overflows"));
+
+  s = CastValues<FloatType>(vector<float>({NAN}), {}, int32, CastOptions(),
+      &result);
+  ASSERT_NE(string::npos, s.ToString().find("index 0 overflows"));
+
+  // The largest and smallest values are exact
+  ASSERT_OK(CastValues<DoubleType>(vector<double>({2147483647.0,
+              -2147483648.0}), {}, int32, CastOptions(), &result));
+  AssertValues<Int32Type>(*result, vector<int32_t>({2147483647, -2147483648}));
+  s = CastValues<DoubleType>(vector<double>({2147483648.0}), {}, int32,
+      CastOptions(), &result);
+  ASSERT_TRUE(s.IsInvalid());
+
+  // Unchecked, fractions truncate toward zero and out of range values
+  // saturate, with NaN converting to 0
+  CastOptions options;
+  options.check_overflow = false;
+  options.check_truncation = false;
+  ASSERT_OK(CastValues<DoubleType>(vector<double>({2.5, -2.5, 3e9, -3e9,
+              INFINITY, NAN}), {}, int32, options, &result));
+  AssertValues<Int32Type>(*result, vector<int32_t>({2, -2, 2147483647,
+              -2147483648, 2147483647, 0}));
+
+  ASSERT_OK(CastValues<FloatType>(vector<float>({-1.0f, 300.0f}), {},
+          TypePtr(new UInt8Type()), options, &result));
+  AssertValues<UInt8Type>(*result, vector<uint8_t>({0, 255}));
+
+  // Only truncation is checked
+  options.check_truncation = true;
+  ASSERT_OK(CastValues<DoubleType>(vector<double>({3e9}), {}, int32, options,
+          &result));
+  ASSERT_TRUE(CastValues<DoubleType>(vector<double>({0.5}), {}, int32,
+          options, &result).IsInvalid());
+}
+
+
+TEST_F(TestCast, TestToFloat) {
+  TypePtr float_type(new FloatType());
+  TypePtr double_type(new DoubleType());
+  unique_ptr<Array> result;
+
+  // int64 values with more than 53 significant bits are not exact doubles
+  int64_t big = (1LL << 53) + 1;
+  Status s = CastValues<Int64Type>(vector<int64_t>({1LL << 53, big}), {},
+      double_type, CastOptions(), &result);
+  ASSERT_NE(string::npos, s.ToString().find("index 1 truncates"));
+  ASSERT_OK(CastValues<Int64Type>(vector<int64_t>({
+              std::numeric_limits<int64_t>::lowest()}), {}, double_type,
+          CastOptions(), &result));
+
+  // The largest int64 rounds up to 2^63, which is out of its range
+  s = CastValues<Int64Type>(vector<int64_t>({
+          std::numeric_limits<int64_t>::max()}), {}, double_type,
+      CastOptions(), &result);
+  ASSERT_TRUE(s.IsInvalid());
+
+  CastOptions options;
+  options.check_truncation = false;
+  ASSERT_OK(CastValues<Int64Type>(vector<int64_t>({big}), {}, double_type,
+          options, &result));
+  AssertValues<DoubleType>(*result, vector<double>({9007199254740992.0}));
+
+  // Every int16 is an exact float
+  ASSERT_OK(CastValues<Int16Type>(vector<int16_t>({-32768, 32767}), {},
+          float_type, CastOptions(), &result));
+  AssertValues<FloatType>(*result, vector<float>({-32768.0f, 32767.0f}));
+
+  // double to float
+  s = CastValues<DoubleType>(vector<double>({1, 1e300}), {}, float_type,
+      CastOptions(), &result);
+  ASSERT_NE(string::npos, s.ToString().find("index 1 overflows"));
+  s = CastValues<DoubleType>(vector<double>({0.1}), {}, float_type,
+      CastOptions(), &result);
+  ASSERT_NE(string::npos, s.ToString().find("index 0 truncates"));
+
+  // Infinities and NaN are kept
+  ASSERT_OK(CastValues<DoubleType>(vector<double>({0.5, INFINITY, NAN}), {},
+          float_type, CastOptions(), &result));
+  const float* values =
+    static_cast<const FloatArray&>(*result).raw_data();
+  ASSERT_EQ(0.5f, values[0]);
+  ASSERT_TRUE(std::isinf(values[1]));
+  ASSERT_TRUE(std::isnan(values[2]));
+
+  options.check_overflow = false;
+  ASSERT_OK(CastValues<DoubleType>(vector<double>({1e300}), {}, float_type,
+          options, &result));
+  values = static_cast<const FloatArray&>(*result).raw_data();
+  ASSERT_TRUE(std::isinf(values[0]));
+}
+
+
+TEST_F(TestCast, TestZeroCopy) {
+  vector<int32_t> values = {1, 2, 3};
+  vector<uint8_t> nulls = {0, 1, 0};
+  Int32Array array(values.size(), to_buffer(values),
+      bytes_to_null_buffer(nulls.data(), nulls.size()));
+
+  Array* out;
+  ASSERT_OK(Cast(pool_.get(), array, TypePtr(new Int32Type()), CastOptions(),
+          &out));
+  unique_ptr<Array> same(out);
+  ASSERT_EQ(array.data(), static_cast<const Int32Array&>(*same).data());
+  ASSERT_EQ(array.nulls(), same->nulls());
+  ASSERT_TRUE(same->Equals(array));
+
+  ASSERT_OK(Cast(pool_.get(), array, TypePtr(new UInt32Type()), CastOptions(),
+          &out));
+  unique_ptr<Array> reinterpreted(out);
+  ASSERT_EQ(TypeEnum::UINT32, reinterpreted->type_enum());
+  ASSERT_EQ(array.data(),
+      static_cast<const UInt32Array&>(*reinterpreted).data());
+  ASSERT_TRUE(reinterpreted->IsNull(1));
+
+  // The checks still apply
+  values[2] = -1;
+  ASSERT_TRUE(Cast(pool_.get(), array, TypePtr(new UInt32Type()), CastOptions(),
+          &out).IsInvalid());
+
+  // Without nulls the output is not nullable
+  Int32Array no_nulls(values.size(), to_buffer(values));
+  ASSERT_OK(Cast(pool_.get(), no_nulls, TypePtr(new DoubleType()), CastOptions(),
+          &out));
+  unique_ptr<Array> widened(out);
+  ASSERT_FALSE(widened->type()->nullable);
+  AssertValues<DoubleType>(*widened, vector<double>({1, 2, -1}));
+}
+
+
+TEST_F(TestCast, TestListOffsets) {
+  StringBuilder builder(pool_.get(), TypePtr(new StringType()));
+  for (const char* value : {"a", "bb", "", "ccc"}) {
+    ASSERT_OK(builder.Append(string(value)));
+  }
+  ASSERT_OK(builder.AppendNull());
+  Array* out;
+  ASSERT_OK(builder.ToArray(&out));
+  unique_ptr<Array> strings(out);
+
+  ASSERT_OK(Cast(pool_.get(), *strings, TypePtr(new LargeStringType()),
+          CastOptions(), &out));
+  unique_ptr<Array> large(out);
+  ASSERT_OK(large->Validate());
+  ASSERT_EQ(TypeEnum::LARGE_STRING, large->type_enum());
+  const LargeStringArray& large_strings =
+    static_cast<const LargeStringArray&>(*large);
+  ASSERT_EQ(static_cast<const StringArray&>(*strings).values(),
+      large_strings.values());
+  ASSERT_EQ("ccc", large_strings.GetString(3));
+  ASSERT_TRUE(large_strings.IsNull(4));
+
+  ASSERT_OK(Cast(pool_.get(), *large, TypePtr(new StringType()),
+          CastOptions(), &out));
+  unique_ptr<Array> narrowed(out);
+  ASSERT_TRUE(narrowed->Equals(*strings));
+
+  // Lists of lists keep their value type
+  TypePtr list_type(new ListType(TypePtr(new Int32Type())));
+  ListArray lists(list_type, 0, nullptr,
+      ArrayPtr(new Int32Array(0, nullptr)));
+  ASSERT_OK(Cast(pool_.get(), lists, TypePtr(new LargeListType(
+                  TypePtr(new Int32Type()))), CastOptions(), &out));
+  unique_ptr<Array> large_lists(out);
+  ASSERT_EQ("large_list<int32>", large_lists->type()->ToString());
+
+  // The last offset does not fit in 32 bits
+  vector<int64_t> offsets = {0, static_cast<int64_t>(1) << 32};
+  vector<uint8_t> bytes = {'a'};
+  LargeStringArray too_large(1, to_buffer(offsets),
+      ArrayPtr(new UInt8Array(bytes.size(), to_buffer(bytes))));
+  ASSERT_TRUE(Cast(pool_.get(), too_large, TypePtr(new StringType()),
+          CastOptions(), &out).IsInvalid());
+  ASSERT_TRUE(Cast(pool_.get(), too_large, TypePtr(new LargeListType(
+                  TypePtr(new UInt8Type()))), CastOptions(),
+          &out).IsNotImplemented());
+}
+
+
+TEST_F(TestCast, TestNotImplemented) {
+  vector<uint8_t> values = {1, 0};
+  BooleanArray bools(values.size(), to_buffer(values));
+  Array* out;
+  ASSERT_TRUE(Cast(pool_.get(), bools, TypePtr(new Int32Type()), CastOptions(),
+          &out).IsNotImplemented());
+
+  Int32Array ints(0, nullptr);
+  ASSERT_TRUE(Cast(pool_.get(), ints, TypePtr(new BooleanType()), CastOptions(),
+          &out).IsNotImplemented());
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,337 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/cast.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "arrow/compute/kernel-util.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+// Overflow and truncation checks and the conversion of a single value, by
+// the kinds of the two types. kCanOverflow and kCanTruncate are false for
+// the pairs where the check can never fail, so that it is compiled out
+template <typename From, typename To,
+          bool kFromInteger = std::is_integral<From>::value,
+          bool kToInteger = std::is_integral<To>::value>
+struct Converter;
+
+template <typename From, typename To>
+struct Converter<From, To, true, true> {
+  // Every From fits if To has the same signedness and is at least as wide,
+  // or is signed and wider
+  static constexpr bool kCanOverflow = !(
+      (std::is_signed<From>::value == std::is_signed<To>::value &&
+          sizeof(To) >= sizeof(From)) ||
+      (!std::is_signed<From>::value && std::is_signed<To>::value &&
+          sizeof(To) > sizeof(From)));
+  static constexpr bool kCanTruncate = false;
+
+  bool Overflows(From v) const {
+    if (std::is_signed<From>::value && v < 0) {
+      return !std::is_signed<To>::value || static_cast<int64_t>(v) <
+        static_cast<int64_t>(std::numeric_limits<To>::lowest());
+    }
+    return static_cast<uint64_t>(v) >
+      static_cast<uint64_t>(std::numeric_limits<To>::max());
+  }
+
+  bool Truncates(From v) const { return false;}
+
+  // Out of range values wrap around
+  To Convert(From v) const { return static_cast<To>(v);}
+};
+
+template <typename From, typename To>
+struct Converter<From, To, false, true> {
+  static constexpr bool kCanOverflow = true;
+  static constexpr bool kCanTruncate = true;
+
+  // The range of To is [lo_, hi_); both bounds are powers of two (or 0),
+  // so exactly representable
+  Converter() :
+      lo_(static_cast<From>(std::numeric_limits<To>::lowest())),
+      hi_(std::ldexp(static_cast<From>(1), std::numeric_limits<To>::digits)) {}
+
+  // Also true for NaN
+  bool Overflows(From v) const { return !(v >= lo_ && v < hi_);}
+
+  bool Truncates(From v) const { return v != std::trunc(v);}
+
+  // Saturates, as converting an out of range value is undefined
+  To Convert(From v) const {
+    if (v >= lo_) {
+      return v < hi_ ? static_cast<To>(v) : std::numeric_limits<To>::max();
+    }
+    return v < lo_ ? std::numeric_limits<To>::lowest() : 0;
+  }
+
+  From lo_;
+  From hi_;
+};
+
+template <typename From, typename To>
+struct Converter<From, To, true, false> {
+  static constexpr bool kCanOverflow = false;
+  static constexpr bool kCanTruncate =
+    std::numeric_limits<From>::digits > std::numeric_limits<To>::digits;
+
+  // One past the largest From
+  Converter() :
+      limit_(std::ldexp(static_cast<To>(1),
+              std::numeric_limits<From>::digits)) {}
+
+  bool Overflows(From v) const { return false;}
+
+  // The conversion may round up to limit_, which cannot be converted back
+  bool Truncates(From v) const {
+    To d = static_cast<To>(v);
+    return !(d < limit_) || static_cast<From>(d) != v;
+  }
+
+  To Convert(From v) const { return static_cast<To>(v);}
+
+  To limit_;
+};
+
+template <typename From, typename To>
+struct Converter<From, To, false, false> {
+  static constexpr bool kCanOverflow = sizeof(To) < sizeof(From);
+  static constexpr bool kCanTruncate = sizeof(To) < sizeof(From);
+
+  bool Overflows(From v) const {
+    return std::isfinite(v) && std::isinf(static_cast<To>(v));
+  }
+
+  // NaN converts to NaN
+  bool Truncates(From v) const {
+    return v == v && static_cast<From>(static_cast<To>(v)) != v;
+  }
+
+  To Convert(From v) const { return static_cast<To>(v);}
+};
+
+// Check and convert the values 64 at a time; out may be nullptr to only
+// check them
+template <typename From, typename To>
+Status cast_values(const From* in, const uint8_t* null_bits, size_t length,
+    const CastOptions& options, const TypePtr& type, To* out) {
+  typedef Converter<From, To> ConverterType;
+  ConverterType converter;
+  bool check_overflow = ConverterType::kCanOverflow && options.check_overflow;
+  bool check_truncation = ConverterType::kCanTruncate &&
+    options.check_truncation;
+
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    if (check_overflow || check_truncation) {
+      uint64_t overflows = 0;
+      uint64_t truncates = 0;
+      for (size_t j = 0; j < n; ++j) {
+        overflows |= static_cast<uint64_t>(check_overflow &&
+            converter.Overflows(in[i + j])) << j;
+        truncates |= static_cast<uint64_t>(check_truncation &&
+            converter.Truncates(in[i + j])) << j;
+      }
+      uint64_t nulls = null_bits == nullptr ? 0 :
+        util::load_bits(null_bits, i, n);
+      overflows &= ~nulls;
+      truncates &= ~nulls;
+      if (overflows | truncates) {
+        int first = __builtin_ctzll(overflows | truncates);
+        return Status::Invalid("value at index " +
+            std::to_string(i + first) + " " +
+            ((overflows >> first) & 1 ? "overflows" : "truncates in") +
+            " a cast to " + type->ToString());
+      }
+    }
+    if (out != nullptr) {
+      for (size_t j = 0; j < n; ++j) {
+        out[i + j] = converter.Convert(in[i + j]);
+      }
+    }
+  }
+  return Status::OK();
+}
+
+template <typename FromType>
+struct CastToVisitor {
+  MemoryPool* pool;
+  const Array& values;
+  const CastOptions& options;
+  Array** out;
+
+  template <typename ToType>
+  Status Visit() {
+    typedef typename FromType::c_type From;
+    typedef typename ToType::c_type To;
+
+    const PrimitiveArrayImpl<FromType>& array =
+      static_cast<const PrimitiveArrayImpl<FromType>&>(values);
+    const From* in = array.raw_data();
+    size_t length = array.length();
+    TypePtr type(new ToType(array.null_bits() != nullptr));
+    Buffer* nulls = array.nulls();
+
+    // Same bits, possibly read with the other signedness
+    bool zero_copy = std::is_same<From, To>::value ||
+      (std::is_integral<From>::value && std::is_integral<To>::value &&
+          sizeof(From) == sizeof(To));
+    Buffer* data;
+    if (zero_copy) {
+      Status s = cast_values<From, To>(in, array.null_bits(), length, options,
+          type, nullptr);
+      RETURN_NOT_OK(s);
+      data = array.data();
+      if (data != nullptr) {
+        data->Incref();
+      }
+    } else {
+      RETURN_NOT_OK(pool->NewBuffer(length * sizeof(To), &data));
+      Status s = cast_values<From, To>(in, array.null_bits(), length,
+          options, type, reinterpret_cast<To*>(data->data()));
+      if (!s.ok()) {
+        data->Decref();
+        return s;
+      }
+    }
+
+    if (nulls != nullptr) {
+      nulls->Incref();
+    }
+    *out = new PrimitiveArrayImpl<ToType>(length, data, nulls);
+    return Status::OK();
+  }
+};
+
+struct CastFromVisitor {
+  MemoryPool* pool;
+  const Array& values;
+  TypeEnum to_type;
+  const CastOptions& options;
+  Array** out;
+
+  template <typename FromType>
+  Status Visit() {
+    CastToVisitor<FromType> visitor = {pool, values, options, out};
+    return visit_primitive(to_type, &visitor);
+  }
+};
+
+static inline bool is_numeric(TypeEnum type) {
+  return is_primitive(type) && type != TypeEnum::BOOL && !is_temporal(type);
+}
+
+// Rebuild the offsets of list with type To and wrap them, the null bitmap
+// and the values of list, which are shared, in a new array of type. Offsets
+// never decrease, so when the last one fits in To they all do
+template <typename From, typename To, typename ArrayType>
+Status cast_offsets(MemoryPool* pool, const BaseListArray<From>& list,
+    const TypePtr& type, Array** out) {
+  size_t length = list.length();
+  Buffer* offsets = nullptr;
+  if (length > 0) {
+    const From* in = list.offsets();
+    if (static_cast<int64_t>(in[length]) >
+        static_cast<int64_t>(std::numeric_limits<To>::max())) {
+      return Status::Invalid("list values do not fit in " +
+          std::to_string(sizeof(To) * 8) + "-bit offsets");
+    }
+    RETURN_NOT_OK(pool->NewBuffer((length + 1) * sizeof(To), &offsets));
+    To* raw_offsets = reinterpret_cast<To*>(offsets->data());
+    for (size_t i = 0; i <= length; ++i) {
+      raw_offsets[i] = static_cast<To>(in[i]);
+    }
+  }
+  Buffer* nulls = list.nulls();
+  if (nulls != nullptr) {
+    nulls->Incref();
+  }
+  ArrayType* result = new ArrayType();
+  result->Init(type, length, offsets, list.values(), nulls);
+  *out = result;
+  return Status::OK();
+}
+
+Status cast_list(MemoryPool* pool, const Array& values, TypeEnum to_type,
+    Array** out) {
+  bool nullable = values.type()->nullable;
+  switch (values.type_enum()) {
+    case TypeEnum::LIST:
+      if (to_type != TypeEnum::LARGE_LIST) break;
+      return cast_offsets<int32_t, int64_t, LargeListArray>(pool,
+          static_cast<const ListArray&>(values),
+          TypePtr(new LargeListType(
+                  static_cast<ListType*>(values.type().get())->value_type,
+                  nullable)), out);
+    case TypeEnum::LARGE_LIST:
+      if (to_type != TypeEnum::LIST) break;
+      return cast_offsets<int64_t, int32_t, ListArray>(pool,
+          static_cast<const LargeListArray&>(values),
+          TypePtr(new ListType(
+                  static_cast<LargeListType*>(values.type().get())->value_type,
+                  nullable)), out);
+    case TypeEnum::STRING:
+      if (to_type != TypeEnum::LARGE_STRING) break;
+      return cast_offsets<int32_t, int64_t, LargeStringArray>(pool,
+          static_cast<const StringArray&>(values),
+          TypePtr(new LargeStringType(nullable)), out);
+    case TypeEnum::LARGE_STRING:
+      if (to_type != TypeEnum::STRING) break;
+      return cast_offsets<int64_t, int32_t, StringArray>(pool,
+          static_cast<const LargeStringArray&>(values),
+          TypePtr(new StringType(nullable)), out);
+    default:
+      break;
+  }
+  return Status::NotImplemented("cast from " + values.type()->ToString());
+}
+
+static inline bool is_list(TypeEnum type) {
+  return type == TypeEnum::LIST || type == TypeEnum::LARGE_LIST ||
+    type == TypeEnum::STRING || type == TypeEnum::LARGE_STRING;
+}
+
+} // namespace
+
+Status Cast(MemoryPool* pool, const Array& values, const TypePtr& to_type,
+    const CastOptions& options, Array** out) {
+  if (is_list(values.type_enum())) {
+    return cast_list(pool, values, to_type->type, out);
+  }
+  if (!is_numeric(values.type_enum())) {
+    return Status::NotImplemented("cast from " + values.type()->ToString());
+  }
+  if (!is_numeric(to_type->type)) {
+    return Status::NotImplemented("cast to " + to_type->ToString());
+  }
+  CastFromVisitor visitor = {pool, values, to_type->type, options, out};
+  return visit_primitive(values.type_enum(), &visitor);
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,67 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_CAST_H
+#define ARROW_COMPUTE_CAST_H
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+struct CastOptions {
+  CastOptions() : check_overflow(true), check_truncation(true) {}
+
+  // Fail if a value is outside the range of the target type: an integer
+  // that does not fit, a floating point value whose integral part does not
+  // fit (or NaN) when cast to an integer, or a finite double that becomes
+  // infinite as a float. Unchecked, integers wrap around and floating point
+  // values saturate to the range of the target integer type, NaN giving 0
+  bool check_overflow;
+
+  // Fail if a value in range changes: a floating point value with a
+  // fractional part cast to an integer, or an integer or double that cannot
+  // be represented exactly in the target floating point type. Unchecked,
+  // fractions are truncated toward zero and the rest rounded to nearest
+  bool check_truncation;
+};
+
+// Convert the values of an integer or floating point array to to_type,
+// which may be any of the integer and floating point types. Null slots stay
+// null, and the output type is nullable exactly when values has nulls.
+//
+// Failed checks return Invalid, naming the index of the first non-null
+// value that overflows or truncates. The conversion loops run 64 values at
+// a time; for checked casts the values of a block are checked together
+// before they are converted. Casts to the same type, and between integer
+// types of the same width, do not copy: the output shares the buffers of
+// values, after the checks.
+//
+// Lists and strings convert between their 32-bit and 64-bit offset
+// variants: LIST and LARGE_LIST, STRING and LARGE_STRING. Only the offsets
+// are copied; the output shares the values and null bitmap of values.
+// Narrowing the offsets returns Invalid if the values do not fit in 32-bit
+// offsets, whatever the options. The caller owns the returned array
+Status Cast(MemoryPool* pool, const Array& values, const TypePtr& to_type,
+    const CastOptions& options, Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_CAST_H
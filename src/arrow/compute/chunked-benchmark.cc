@@ -0,0 +1,88 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/chunked-array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/chunked.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 24;
+static constexpr size_t kNumLookups = 1 << 20;
+
+static ChunkedArrayPtr MakeColumn(MemoryPool* pool, size_t chunk_length) {
+  std::vector<ArrayPtr> chunks;
+  for (size_t start = 0; start < kNumValues; start += chunk_length) {
+    Buffer* buf;
+    BENCHMARK_OK(pool->NewBuffer(chunk_length * sizeof(int32_t), &buf));
+    int32_t* values = reinterpret_cast<int32_t*>(buf->data());
+    for (size_t i = 0; i < chunk_length; ++i) {
+      values[i] = static_cast<int32_t>((start + i) % 1000);
+    }
+    chunks.push_back(ArrayPtr(new Int32Array(chunk_length, buf)));
+  }
+  return ChunkedArrayPtr(new ChunkedArray(TypePtr(new Int32Type(false)),
+          chunks));
+}
+
+static void BenchmarkChunkLength(MemoryPool* pool, size_t chunk_length) {
+  ChunkedArrayPtr column = MakeColumn(pool, chunk_length);
+  std::string suffix = "/chunk:" + std::to_string(chunk_length);
+
+  int64_t sum;
+  for (int num_threads : {1, 2, 4, 8}) {
+    benchmark::run(("ChunkedSum" + suffix + "/threads:" +
+            std::to_string(num_threads)).c_str(),
+        kNumValues * sizeof(int32_t), [&]() {
+          BENCHMARK_OK(ChunkedSum<Int32Type>(*column, num_threads, &sum));
+        });
+  }
+
+  // Random access through the chunk index
+  Random rng(random_seed());
+  std::vector<size_t> positions(kNumLookups);
+  for (size_t& i : positions) {
+    i = rng.Uniform(kNumValues);
+  }
+  size_t found = 0;
+  benchmark::run(("FindChunk" + suffix).c_str(),
+      kNumLookups * sizeof(size_t), [&]() {
+        for (size_t i : positions) {
+          found += column->FindChunk(i);
+        }
+      });
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkChunkLength(&pool, 1 << 12);
+  arrow::compute::BenchmarkChunkLength(&pool, 1 << 16);
+  arrow::compute::BenchmarkChunkLength(&pool, 1 << 20);
+  return 0;
+}
@@ -0,0 +1,153 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/chunked-array.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/aggregate.h"
+#include "arrow/compute/chunked.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestChunked : public TestBase {
+ public:
+  // Split values into chunks of up to max_chunk slots, of varying lengths,
+  // some of them empty
+  template <typename TypeClass, typename T>
+  ChunkedArrayPtr Split(const vector<T>& values, const vector<uint8_t>& nulls,
+      size_t max_chunk) {
+    std::vector<ArrayPtr> chunks;
+    size_t start = 0;
+    size_t step = 0;
+    while (start < values.size()) {
+      size_t length = std::min((step++ * 7919) % (max_chunk + 1),
+          values.size() - start);
+      Buffer* data;
+      EXPECT_OK(pool_->NewBuffer(length * sizeof(T), &data));
+      if (length > 0) {
+        memcpy(data->data(), values.data() + start, length * sizeof(T));
+      }
+      Buffer* nulls_buf = nullptr;
+      if (!nulls.empty() && length > 0) {
+        vector<uint8_t> chunk_nulls(nulls.begin() + start,
+            nulls.begin() + start + length);
+        nulls_buf = bytes_to_null_buffer(chunk_nulls.data(), length);
+      }
+      chunks.push_back(ArrayPtr(new PrimitiveArrayImpl<TypeClass>(length, data,
+                  nulls_buf)));
+      start += length;
+    }
+    return ChunkedArrayPtr(new ChunkedArray(TypePtr(new TypeClass()),
+            chunks));
+  }
+};
+
+
+TEST_F(TestChunked, TestAggregates) {
+  size_t n = 10000;
+  vector<int32_t> values;
+  vector<uint8_t> nulls;
+  randint<int32_t>(n, -1000000, 1000000, values);
+  random_nulls(n, 0.9, nulls);
+  Int32Array whole(n, to_buffer(values),
+      bytes_to_null_buffer(nulls.data(), n));
+
+  int64_t ex_sum;
+  int32_t ex_min, ex_max;
+  ASSERT_OK(Sum(whole, &ex_sum));
+  ASSERT_OK(Min(whole, &ex_min));
+  ASSERT_OK(Max(whole, &ex_max));
+
+  ChunkedArrayPtr column = Split<Int32Type>(values, nulls, 700);
+  ASSERT_TRUE(column->num_chunks() > 10);
+  for (int num_threads : {1, 3, 8, 100}) {
+    ASSERT_EQ(Count(whole), ChunkedCount(*column, num_threads));
+    int64_t sum;
+    ASSERT_OK(ChunkedSum<Int32Type>(*column, num_threads, &sum));
+    ASSERT_EQ(ex_sum, sum);
+    int32_t min, max;
+    ASSERT_OK(ChunkedMin<Int32Type>(*column, num_threads, &min));
+    ASSERT_OK(ChunkedMax<Int32Type>(*column, num_threads, &max));
+    ASSERT_EQ(ex_min, min);
+    ASSERT_EQ(ex_max, max);
+  }
+}
+
+
+TEST_F(TestChunked, TestEdgeCases) {
+  // Partial sums that fit, with a total that does not
+  int64_t big = std::numeric_limits<int64_t>::max();
+  vector<int64_t> values = {big, 1};
+  ChunkedArrayPtr column = Split<Int64Type>(values, {}, 1);
+  int64_t sum;
+  ASSERT_TRUE(ChunkedSum<Int64Type>(*column, 2, &sum).IsInvalid());
+
+  // A chunk whose own sum overflows, with a total that fits
+  vector<int64_t> first = {big, 1};
+  vector<int64_t> second = {-1};
+  ChunkedArray overflowing(TypePtr(new Int64Type()),
+      {ArrayPtr(new Int64Array(first.size(), to_buffer(first))),
+       ArrayPtr(new Int64Array(second.size(), to_buffer(second)))});
+  ASSERT_OK(ChunkedSum<Int64Type>(overflowing, 2, &sum));
+  ASSERT_EQ(big, sum);
+
+  // A chunk of only NaN does not hide the other chunks' values
+  vector<double> doubles = {NAN, 2.0, 1.0, NAN};
+  column = Split<DoubleType>(doubles, {}, 1);
+  double min, max;
+  ASSERT_OK(ChunkedMin<DoubleType>(*column, 4, &min));
+  ASSERT_OK(ChunkedMax<DoubleType>(*column, 4, &max));
+  ASSERT_EQ(1.0, min);
+  ASSERT_EQ(2.0, max);
+
+  vector<double> nans = {NAN, NAN};
+  column = Split<DoubleType>(nans, {}, 1);
+  ASSERT_OK(ChunkedMin<DoubleType>(*column, 2, &min));
+  ASSERT_TRUE(std::isnan(min));
+
+  // Only nulls, and no chunks at all
+  column = Split<DoubleType>(doubles, vector<uint8_t>(4, 1), 2);
+  ASSERT_TRUE(ChunkedMin<DoubleType>(*column, 2, &min).IsInvalid());
+  ChunkedArray empty(TypePtr(new Int32Type()), {});
+  ASSERT_EQ(0, ChunkedCount(empty, 4));
+  ASSERT_OK(ChunkedSum<Int32Type>(empty, 4, &sum));
+  ASSERT_EQ(0, sum);
+
+  // The wrong type
+  double dsum;
+  column = Split<Int64Type>(values, {}, 1);
+  ASSERT_TRUE(ChunkedSum<DoubleType>(*column, 1, &dsum).IsInvalid());
+}
+
+} // namespace compute
+
+} // namespace arrow
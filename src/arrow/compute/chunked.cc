@@ -0,0 +1,173 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/chunked.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "arrow/compute/aggregate-internal.h"
+#include "arrow/compute/kernel-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+// Call fn(c) for every chunk c, from up to num_threads threads that take
+// chunks in turn from a shared counter
+template <typename Fn>
+void for_each_chunk(const ChunkedArray& values, int num_threads, Fn fn) {
+  size_t num_chunks = values.num_chunks();
+  int threads = static_cast<int>(std::min<size_t>(
+          std::max(num_threads, 1), std::max<size_t>(num_chunks, 1)));
+  std::atomic<size_t> next(0);
+  parallel_for(threads, [&](int) {
+        for (size_t c = next++; c < num_chunks; c = next++) {
+          fn(c);
+        }
+      });
+}
+
+template <typename TypeClass>
+Status check_chunk_types(const ChunkedArray& values) {
+  for (const ArrayPtr& chunk : values.chunks()) {
+    if (chunk->type_enum() != TypeClass::type_enum) {
+      return Status::Invalid("chunk of type " + chunk->type()->ToString());
+    }
+  }
+  return Status::OK();
+}
+
+template <typename TypeClass>
+const PrimitiveArrayImpl<TypeClass>& chunk_of(const ChunkedArray& values,
+    size_t c) {
+  return static_cast<const PrimitiveArrayImpl<TypeClass>&>(*values.chunk(c));
+}
+
+template <typename TypeClass, bool kIsMin>
+Status ChunkedExtreme(const ChunkedArray& values, int num_threads,
+    typename TypeClass::c_type* out) {
+  typedef typename TypeClass::c_type T;
+  RETURN_NOT_OK(check_chunk_types<TypeClass>(values));
+
+  // Chunks without non-null values are skipped
+  size_t num_chunks = values.num_chunks();
+  std::vector<T> extremes(num_chunks);
+  std::vector<uint8_t> found(num_chunks, 0);
+  for_each_chunk(values, num_threads, [&](size_t c) {
+        const PrimitiveArrayImpl<TypeClass>& chunk =
+          chunk_of<TypeClass>(values, c);
+        if (Count(chunk) == 0) return;
+        Status s = kIsMin ? Min(chunk, &extremes[c]) :
+          Max(chunk, &extremes[c]);
+        found[c] = s.ok();
+      });
+
+  // A chunk's extreme is only NaN if all its values are, so NaNs are
+  // replaced by any other value, as in Min and Max
+  bool any = false;
+  T extreme = 0;
+  for (size_t c = 0; c < num_chunks; ++c) {
+    if (!found[c]) continue;
+    T value = extremes[c];
+    if (!any || extreme != extreme ||
+        (kIsMin ? value < extreme : value > extreme)) {
+      extreme = value;
+    }
+    any = true;
+  }
+  if (!any) {
+    return Status::Invalid("no non-null values");
+  }
+  *out = extreme;
+  return Status::OK();
+}
+
+} // namespace
+
+size_t ChunkedCount(const ChunkedArray& values, int num_threads) {
+  std::vector<size_t> counts(values.num_chunks());
+  for_each_chunk(values, num_threads, [&](size_t c) {
+        counts[c] = Count(*values.chunk(c));
+      });
+  size_t count = 0;
+  for (size_t chunk_count : counts) {
+    count += chunk_count;
+  }
+  return count;
+}
+
+template <typename TypeClass>
+Status ChunkedSum(const ChunkedArray& values, int num_threads,
+    typename sum_type<TypeClass>::type* out) {
+  typedef typename raw_sum_type<typename TypeClass::c_type>::type Raw;
+  RETURN_NOT_OK(check_chunk_types<TypeClass>(values));
+
+  // The chunk sums are kept unnarrowed, so that only the total must fit,
+  // as in Sum over the whole column
+  size_t num_chunks = values.num_chunks();
+  std::vector<Raw> sums(num_chunks);
+  for_each_chunk(values, num_threads, [&](size_t c) {
+        const PrimitiveArrayImpl<TypeClass>& chunk =
+          chunk_of<TypeClass>(values, c);
+        sums[c] = raw_sum(chunk.raw_data(), chunk.null_bits(),
+            chunk.length());
+      });
+
+  Raw sum = 0;
+  for (Raw chunk_sum : sums) {
+    sum += chunk_sum;
+  }
+  return narrow_sum(sum, out);
+}
+
+template <typename TypeClass>
+Status ChunkedMin(const ChunkedArray& values, int num_threads,
+    typename TypeClass::c_type* out) {
+  return ChunkedExtreme<TypeClass, true>(values, num_threads, out);
+}
+
+template <typename TypeClass>
+Status ChunkedMax(const ChunkedArray& values, int num_threads,
+    typename TypeClass::c_type* out) {
+  return ChunkedExtreme<TypeClass, false>(values, num_threads, out);
+}
+
+#define CHUNKED_INSTANTIATE(TypeClass)                                  \
+  template Status ChunkedSum<TypeClass>(const ChunkedArray&, int,       \
+      sum_type<TypeClass>::type*);                                      \
+  template Status ChunkedMin<TypeClass>(const ChunkedArray&, int,       \
+      TypeClass::c_type*);                                              \
+  template Status ChunkedMax<TypeClass>(const ChunkedArray&, int,       \
+      TypeClass::c_type*);
+
+CHUNKED_INSTANTIATE(Int8Type);
+CHUNKED_INSTANTIATE(UInt8Type);
+CHUNKED_INSTANTIATE(Int16Type);
+CHUNKED_INSTANTIATE(UInt16Type);
+CHUNKED_INSTANTIATE(Int32Type);
+CHUNKED_INSTANTIATE(UInt32Type);
+CHUNKED_INSTANTIATE(Int64Type);
+CHUNKED_INSTANTIATE(UInt64Type);
+CHUNKED_INSTANTIATE(FloatType);
+CHUNKED_INSTANTIATE(DoubleType);
+
+#undef CHUNKED_INSTANTIATE
+
+} // namespace compute
+
+} // namespace arrow
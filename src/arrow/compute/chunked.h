@@ -0,0 +1,58 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_CHUNKED_H
+#define ARROW_COMPUTE_CHUNKED_H
+
+#include <cstddef>
+
+#include "arrow/chunked-array.h"
+#include "arrow/compute/aggregate.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Aggregates of chunked columns, with the same semantics as those of
+// aggregate.h over the whole column.
+//
+// The chunks are shared between up to num_threads threads, which take the
+// next unprocessed chunk as they finish one, so chunks of uneven length
+// still keep every thread busy. Each chunk is aggregated by the
+// single-array kernel and the per-chunk results are combined in chunk
+// order, so the result does not depend on the number of threads. Nothing is
+// allocated from a MemoryPool. Returns Invalid if a chunk is not of
+// TypeClass
+
+// Number of non-null slots
+size_t ChunkedCount(const ChunkedArray& values, int num_threads);
+
+template <typename TypeClass>
+Status ChunkedSum(const ChunkedArray& values, int num_threads,
+    typename sum_type<TypeClass>::type* out);
+
+template <typename TypeClass>
+Status ChunkedMin(const ChunkedArray& values, int num_threads,
+    typename TypeClass::c_type* out);
+
+template <typename TypeClass>
+Status ChunkedMax(const ChunkedArray& values, int num_threads,
+    typename TypeClass::c_type* out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_CHUNKED_H
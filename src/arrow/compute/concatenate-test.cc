@@ -0,0 +1,201 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/concatenate.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestConcatenate : public TestBase {
+ public:
+  void SetUp() {
+    TestBase::SetUp();
+    // Chunk sizes chosen so that most boundaries are not byte aligned
+    sizes_ = {7, 0, 100, 13, 1, 1000, 64};
+  }
+
+  void ToArray(ArrayBuilder* builder, vector<unique_ptr<Array> >* holder) {
+    Array* out;
+    ASSERT_OK(builder->ToArray(&out));
+    holder->emplace_back(out);
+  }
+
+  void Check(const vector<unique_ptr<Array> >& chunks, const Array& expected) {
+    vector<Array*> arrays;
+    for (auto& chunk : chunks) {
+      arrays.push_back(chunk.get());
+    }
+    Array* out;
+    ASSERT_OK(Concatenate(pool_.get(), arrays, &out));
+    unique_ptr<Array> result(out);
+
+    ASSERT_EQ(expected.length(), result->length());
+    ASSERT_EQ(expected.type_enum(), result->type_enum());
+    ASSERT_TRUE(result->Equals(expected));
+  }
+
+ protected:
+  vector<size_t> sizes_;
+};
+
+
+TEST_F(TestConcatenate, TestPrimitive) {
+  TypePtr type(new Int32Type());
+  Int32Builder whole(pool_.get(), type);
+  vector<unique_ptr<Array> > chunks;
+
+  for (size_t size : sizes_) {
+    vector<int32_t> values;
+    vector<uint8_t> nulls;
+    randint<int32_t>(size, 0, 1000, values);
+    random_nulls(size, 0.3, nulls);
+
+    Int32Builder builder(pool_.get(), type);
+    ASSERT_OK(builder.Append(values.data(), size, nulls.data()));
+    ASSERT_OK(whole.Append(values.data(), size, nulls.data()));
+    ToArray(&builder, &chunks);
+  }
+
+  unique_ptr<Array> expected;
+  Array* out;
+  ASSERT_OK(whole.ToArray(&out));
+  expected.reset(out);
+
+  Check(chunks, *expected);
+}
+
+
+TEST_F(TestConcatenate, TestMixedNullability) {
+  vector<int64_t> values = {1, 2, 3, 4, 5};
+  vector<uint8_t> nulls = {0, 1, 0, 0, 1};
+  vector<uint8_t> no_nulls(values.size(), 0);
+
+  Int64Builder nn_builder(pool_.get(), TypePtr(new Int64Type(false)));
+  Int64Builder builder(pool_.get(), TypePtr(new Int64Type()));
+  Int64Builder whole(pool_.get(), TypePtr(new Int64Type()));
+
+  vector<unique_ptr<Array> > chunks;
+  ASSERT_OK(nn_builder.Append(values.data(), values.size()));
+  ToArray(&nn_builder, &chunks);
+  ASSERT_OK(builder.Append(values.data(), values.size(), nulls.data()));
+  ToArray(&builder, &chunks);
+
+  ASSERT_OK(whole.Append(values.data(), values.size(), no_nulls.data()));
+  ASSERT_OK(whole.Append(values.data(), values.size(), nulls.data()));
+  Array* out;
+  ASSERT_OK(whole.ToArray(&out));
+  unique_ptr<Array> expected(out);
+
+  Check(chunks, *expected);
+}
+
+
+TEST_F(TestConcatenate, TestString) {
+  vector<string> strings = {"a", "bb", "", "dddd", "ccc"};
+  TypePtr type(new StringType());
+
+  StringBuilder whole(pool_.get(), type);
+  vector<unique_ptr<Array> > chunks;
+  size_t k = 0;
+  for (size_t size : sizes_) {
+    StringBuilder builder(pool_.get(), type);
+    for (size_t i = 0; i < size; ++i, ++k) {
+      if (k % 7 == 3) {
+        ASSERT_OK(builder.AppendNull());
+        ASSERT_OK(whole.AppendNull());
+      } else {
+        ASSERT_OK(builder.Append(strings[k % strings.size()]));
+        ASSERT_OK(whole.Append(strings[k % strings.size()]));
+      }
+    }
+    ToArray(&builder, &chunks);
+  }
+
+  Array* out;
+  ASSERT_OK(whole.ToArray(&out));
+  unique_ptr<Array> expected(out);
+
+  Check(chunks, *expected);
+}
+
+
+TEST_F(TestConcatenate, TestList) {
+  TypePtr value_type(new Int32Type());
+  TypePtr type(new ListType(value_type));
+
+  ListBuilder whole(pool_.get(), type, new Int32Builder(pool_.get(), value_type));
+  Int32Builder* whole_values = static_cast<Int32Builder*>(whole.value_builder());
+
+  vector<unique_ptr<Array> > chunks;
+  int32_t k = 0;
+  for (size_t size : sizes_) {
+    ListBuilder builder(pool_.get(), type,
+        new Int32Builder(pool_.get(), value_type));
+    Int32Builder* values = static_cast<Int32Builder*>(builder.value_builder());
+    for (size_t i = 0; i < size; ++i, ++k) {
+      bool is_null = k % 5 == 2;
+      ASSERT_OK(builder.Append(is_null));
+      ASSERT_OK(whole.Append(is_null));
+      for (int32_t j = 0; j < k % 4; ++j) {
+        ASSERT_OK(values->Append(k + j, j == 1));
+        ASSERT_OK(whole_values->Append(k + j, j == 1));
+      }
+    }
+    ToArray(&builder, &chunks);
+  }
+
+  Array* out;
+  ASSERT_OK(whole.ToArray(&out));
+  unique_ptr<Array> expected(out);
+
+  Check(chunks, *expected);
+}
+
+
+TEST_F(TestConcatenate, TestErrors) {
+  vector<Array*> empty;
+  Array* out;
+  ASSERT_RAISES(Invalid, Concatenate(pool_.get(), empty, &out));
+
+  vector<int32_t> ints = {1, 2, 3};
+  vector<int64_t> longs = {1, 2, 3};
+  Int32Array a(ints.size(), to_buffer(ints));
+  Int64Array b(longs.size(), to_buffer(longs));
+  vector<Array*> arrays = {&a, &b};
+  ASSERT_RAISES(Invalid, Concatenate(pool_.get(), arrays, &out));
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,191 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/concatenate.h"
+
+#include <cstring>
+#include <limits>
+
+#include "arrow/compute/kernel-util.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+// A slice of slots [offset, offset + length) of some array. Concatenating
+// lists requires concatenating only the referenced part of each child
+struct ArrayRange {
+  const Array* array;
+  size_t offset;
+  size_t length;
+};
+
+Status ConcatenateRanges(MemoryPool* pool, const TypePtr& default_type,
+    const std::vector<ArrayRange>& ranges, Array** out);
+
+Status ConcatenateNulls(MemoryPool* pool, const std::vector<ArrayRange>& ranges,
+    size_t length, Buffer** out) {
+  RETURN_NOT_OK(allocate_nulls(pool, length, out));
+  uint8_t* bits = (*out)->data();
+
+  size_t position = 0;
+  for (const ArrayRange& range : ranges) {
+    if (range.array->null_bits() != nullptr) {
+      util::copy_bits(range.array->null_bits(), range.offset, range.length,
+          bits, position);
+    }
+    position += range.length;
+  }
+  return Status::OK();
+}
+
+Status ConcatenatePrimitive(MemoryPool* pool, const TypePtr& type,
+    const std::vector<ArrayRange>& ranges, size_t length, Buffer* nulls,
+    Array** out) {
+  size_t width = primitive_width(type->type);
+
+  Buffer* data;
+  RETURN_NOT_OK(pool->NewBuffer(length * width, &data));
+  uint8_t* dst = data->data();
+  for (const ArrayRange& range : ranges) {
+    const PrimitiveArray* array = static_cast<const PrimitiveArray*>(
+        range.array);
+    if (range.length > 0) {
+      memcpy(dst, array->data()->data() + range.offset * width,
+          range.length * width);
+      dst += range.length * width;
+    }
+  }
+  return make_primitive_array(type, length, data, nulls, out);
+}
+
+Status ConcatenateList(MemoryPool* pool, const TypePtr& type,
+    const std::vector<ArrayRange>& ranges, size_t length, Buffer* nulls,
+    Array** out) {
+  Buffer* offset_buf;
+  RETURN_NOT_OK(pool->NewBuffer((length + 1) * sizeof(int32_t), &offset_buf));
+  int32_t* dst = reinterpret_cast<int32_t*>(offset_buf->data());
+
+  std::vector<ArrayRange> child_ranges;
+  int64_t child_length = 0;
+  for (const ArrayRange& range : ranges) {
+    if (range.length == 0) continue;
+
+    const ListArray* list = static_cast<const ListArray*>(range.array);
+    const int32_t* src = list->offsets() + range.offset;
+    int32_t first = src[0];
+    int32_t range_child_length = src[range.length] - first;
+    if (child_length + range_child_length >
+        std::numeric_limits<int32_t>::max()) {
+      offset_buf->Decref();
+      return Status::Invalid("concatenated list values exceed int32 offsets");
+    }
+
+    // Shift every offset by the same amount; this loop vectorizes
+    int32_t delta = static_cast<int32_t>(child_length) - first;
+    for (size_t i = 0; i < range.length; ++i) {
+      dst[i] = src[i] + delta;
+    }
+    dst += range.length;
+
+    child_ranges.push_back({list->values().get(),
+          static_cast<size_t>(first), static_cast<size_t>(range_child_length)});
+    child_length += range_child_length;
+  }
+  *dst = static_cast<int32_t>(child_length);
+
+  TypePtr child_type;
+  if (type->type == TypeEnum::STRING) {
+    child_type = TypePtr(new UInt8Type(false));
+  } else {
+    child_type = static_cast<ListType*>(type.get())->value_type;
+  }
+
+  Array* child;
+  Status s = ConcatenateRanges(pool, child_type, child_ranges, &child);
+  if (!s.ok()) {
+    offset_buf->Decref();
+    return s;
+  }
+
+  if (type->type == TypeEnum::STRING) {
+    StringArray* result = new StringArray();
+    result->Init(type, length, offset_buf, ArrayPtr(child), nulls);
+    *out = result;
+  } else {
+    ListArray* result = new ListArray();
+    result->Init(type, length, offset_buf, ArrayPtr(child), nulls);
+    *out = result;
+  }
+  return Status::OK();
+}
+
+Status ConcatenateRanges(MemoryPool* pool, const TypePtr& default_type,
+    const std::vector<ArrayRange>& ranges, Array** out) {
+  // Prefer a nullable type so that nulls in any of the inputs survive
+  TypePtr type = default_type;
+  size_t length = 0;
+  for (const ArrayRange& range : ranges) {
+    if (range.array->type_enum() != type->type) {
+      return Status::Invalid("cannot concatenate arrays of different types");
+    }
+    if (range.array->nullable() && !type->nullable) {
+      type = range.array->type();
+    }
+    length += range.length;
+  }
+
+  Buffer* nulls = nullptr;
+  if (type->nullable) {
+    RETURN_NOT_OK(ConcatenateNulls(pool, ranges, length, &nulls));
+  }
+
+  Status s;
+  if (is_primitive(type->type)) {
+    s = ConcatenatePrimitive(pool, type, ranges, length, nulls, out);
+  } else if (type->type == TypeEnum::LIST || type->type == TypeEnum::STRING) {
+    s = ConcatenateList(pool, type, ranges, length, nulls, out);
+  } else {
+    s = Status::NotImplemented(type->ToString());
+  }
+  if (!s.ok() && nulls != nullptr) {
+    nulls->Decref();
+  }
+  return s;
+}
+
+} // namespace
+
+Status Concatenate(MemoryPool* pool, const std::vector<Array*>& arrays,
+    Array** out) {
+  if (arrays.empty()) {
+    return Status::Invalid("must concatenate at least one array");
+  }
+
+  std::vector<ArrayRange> ranges;
+  ranges.reserve(arrays.size());
+  for (const Array* array : arrays) {
+    ranges.push_back({array, 0, array->length()});
+  }
+  return ConcatenateRanges(pool, arrays[0]->type(), ranges, out);
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,43 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_CONCATENATE_H
+#define ARROW_COMPUTE_CONCATENATE_H
+
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Concatenate arrays of the same type into a single contiguous array whose
+// buffers are allocated from pool. Supports primitive, list and string
+// arrays (lists of any of these, recursively).
+//
+// The output is sized once up front: value buffers are memcpy'd, list offsets
+// are rebased onto the combined child array and null bitmaps are shifted into
+// place at arbitrary bit offsets. The output is nullable if any input is.
+// The caller owns the returned array
+Status Concatenate(MemoryPool* pool, const std::vector<Array*>& arrays,
+    Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_CONCATENATE_H
@@ -0,0 +1,153 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/dictionary.h"
+#include "arrow/types/dictionary.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/string.h"
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestDictionary : public TestBase {
+ public:
+  unique_ptr<StringArray> MakeStrings(const vector<string>& strings,
+      const vector<uint8_t>& is_null = {}) {
+    StringBuilder builder(pool_.get(), TypePtr(new StringType()));
+    for (size_t i = 0; i < strings.size(); ++i) {
+      if (!is_null.empty() && is_null[i]) {
+        EXPECT_OK(builder.AppendNull());
+      } else {
+        EXPECT_OK(builder.Append(strings[i]));
+      }
+    }
+    Array* out;
+    EXPECT_OK(builder.ToArray(&out));
+    return unique_ptr<StringArray>(static_cast<StringArray*>(out));
+  }
+
+  unique_ptr<DictionaryArray> Encode(const StringArray& values) {
+    Array* out;
+    EXPECT_OK(DictionaryEncode(pool_.get(), values, &out));
+    return unique_ptr<DictionaryArray>(static_cast<DictionaryArray*>(out));
+  }
+
+  unique_ptr<Array> Decode(const DictionaryArray& values) {
+    Array* out;
+    EXPECT_OK(DictionaryDecode(pool_.get(), values, &out));
+    return unique_ptr<Array>(out);
+  }
+};
+
+
+TEST_F(TestDictionary, TestType) {
+  TypePtr index_type(new Int16Type());
+  TypePtr value_type(new StringType());
+  DictionaryType type(index_type, value_type);
+
+  ASSERT_EQ(TypeEnum::DICTIONARY, type.type);
+  ASSERT_TRUE(type.nullable);
+  ASSERT_EQ(string("dictionary<string, int16>"), type.ToString());
+}
+
+
+TEST_F(TestDictionary, TestEncodeDecode) {
+  vector<string> strings = {"us", "de", "us", "", "fr", "de", "us", "xx", ""};
+  vector<uint8_t> is_null = {0, 0, 0, 0, 0, 0, 0, 1, 0};
+  auto values = MakeStrings(strings, is_null);
+
+  auto encoded = Encode(*values);
+  ASSERT_EQ(TypeEnum::DICTIONARY, encoded->type_enum());
+  ASSERT_EQ(values->length(), encoded->length());
+  ASSERT_TRUE(encoded->nullable());
+  ASSERT_EQ(TypeEnum::INT8, encoded->indices()->type_enum());
+
+  // Distinct values in order of first appearance
+  StringArray* dictionary =
+    static_cast<StringArray*>(encoded->dictionary().get());
+  vector<string> ex_dictionary = {"us", "de", "", "fr"};
+  ASSERT_EQ(ex_dictionary.size(), dictionary->length());
+  for (size_t i = 0; i < ex_dictionary.size(); ++i) {
+    ASSERT_EQ(ex_dictionary[i], dictionary->GetString(i));
+  }
+
+  vector<int32_t> ex_indices = {0, 1, 0, 2, 3, 1, 0, -1, 2};
+  for (size_t i = 0; i < ex_indices.size(); ++i) {
+    ASSERT_EQ(static_cast<bool>(is_null[i]), encoded->IsNull(i));
+    if (!is_null[i]) {
+      ASSERT_EQ(ex_indices[i], encoded->index(i));
+    }
+  }
+
+  auto decoded = Decode(*encoded);
+  ASSERT_TRUE(decoded->Equals(*values));
+}
+
+
+TEST_F(TestDictionary, TestIndexWidth) {
+  // 128 distinct values fit int8 indices, 129 need int16, 32769 need int32
+  for (size_t cardinality : {128, 129, 32769}) {
+    vector<string> strings;
+    for (size_t i = 0; i < cardinality * 2; ++i) {
+      strings.push_back(std::to_string(i % cardinality));
+    }
+    auto values = MakeStrings(strings);
+    auto encoded = Encode(*values);
+
+    TypeEnum expected = cardinality == 128 ? TypeEnum::INT8 :
+      cardinality == 129 ? TypeEnum::INT16 : TypeEnum::INT32;
+    ASSERT_EQ(expected, encoded->indices()->type_enum());
+    ASSERT_EQ(cardinality, encoded->dictionary()->length());
+    ASSERT_EQ(cardinality - 1, encoded->index(cardinality * 2 - 1));
+
+    auto decoded = Decode(*encoded);
+    ASSERT_TRUE(decoded->Equals(*values));
+  }
+}
+
+
+TEST_F(TestDictionary, TestEquals) {
+  auto left = Encode(*MakeStrings({"a", "b", "a", "c"}, {0, 0, 0, 1}));
+  auto right = Encode(*MakeStrings({"b", "a", "b", "a", "x"},
+          {0, 0, 0, 0, 1}));
+
+  // Different dictionaries, equal values
+  ASSERT_TRUE(left->RangeEquals(0, 4, 1, *right));
+  ASSERT_FALSE(left->RangeEquals(0, 3, 0, *right));
+  ASSERT_TRUE(left->RangeEquals(0, 1, 2, *left));
+  ASSERT_FALSE(left->RangeEquals(0, 2, 2, *left));
+  ASSERT_FALSE(left->Equals(*right));
+  ASSERT_TRUE(left->Equals(*left));
+}
+
+} // namespace compute
+
+} // namespace arrow
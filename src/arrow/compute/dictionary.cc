@@ -0,0 +1,131 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/dictionary.h"
+
+#include <limits>
+#include <memory>
+
+#include "arrow/builder.h"
+#include "arrow/compute/kernel-util.h"
+#include "arrow/compute/take.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+struct NarrowIndicesVisitor {
+  MemoryPool* pool;
+  const Int32Array& indices;
+  ArrayPtr out;
+
+  template <typename TypeClass>
+  Status Visit() {
+    typedef typename TypeClass::c_type T;
+    size_t n = indices.length();
+    Buffer* data;
+    RETURN_NOT_OK(pool->NewBuffer(n * sizeof(T), &data));
+    T* dst = reinterpret_cast<T*>(data->data());
+    const int32_t* src = indices.raw_data();
+    for (size_t i = 0; i < n; ++i) {
+      dst[i] = static_cast<T>(src[i]);
+    }
+
+    Buffer* nulls = indices.nulls();
+    if (nulls != nullptr) {
+      nulls->Incref();
+    }
+    out = ArrayPtr(new PrimitiveArrayImpl<TypeClass>(n, data, nulls));
+    return Status::OK();
+  }
+};
+
+TypeEnum index_type_for(size_t dictionary_size) {
+  if (dictionary_size <= static_cast<size_t>(
+          std::numeric_limits<int8_t>::max()) + 1) {
+    return TypeEnum::INT8;
+  } else if (dictionary_size <= static_cast<size_t>(
+          std::numeric_limits<int16_t>::max()) + 1) {
+    return TypeEnum::INT16;
+  }
+  return TypeEnum::INT32;
+}
+
+} // namespace
+
+Status DictionaryEncode(MemoryPool* pool, const StringArray& values,
+    Array** out) {
+  // Interned with int32 indices, without a cardinality limit
+  TypePtr type(new StringType(values.null_bits() != nullptr));
+  DictionaryStringBuilder builder(pool, type,
+      std::numeric_limits<size_t>::max());
+  for (size_t i = 0; i < values.length(); ++i) {
+    if (values.IsNull(i)) {
+      RETURN_NOT_OK(builder.AppendNull());
+    } else {
+      size_t length;
+      const uint8_t* data = values.GetValue(i, &length);
+      RETURN_NOT_OK(builder.Append(data, length));
+    }
+  }
+  Array* tmp;
+  RETURN_NOT_OK(builder.ToArray(&tmp));
+  std::unique_ptr<DictionaryArray> encoded(static_cast<DictionaryArray*>(tmp));
+
+  const ArrayPtr& dictionary = encoded->dictionary();
+  TypeEnum index_type = index_type_for(dictionary->length());
+  if (index_type == TypeEnum::INT32) {
+    *out = encoded.release();
+    return Status::OK();
+  }
+
+  NarrowIndicesVisitor visitor = {pool,
+                                  static_cast<const Int32Array&>(
+                                      *encoded->indices()),
+                                  nullptr};
+  RETURN_NOT_OK(visit_primitive(index_type, &visitor));
+  TypePtr dict_type(new DictionaryType(visitor.out->type(),
+          dictionary->type(), encoded->nullable()));
+  *out = new DictionaryArray(dict_type, visitor.out, dictionary);
+  return Status::OK();
+}
+Status DictionaryDecode(MemoryPool* pool, const DictionaryArray& values,
+    Array** out) {
+  const Array& indices = *values.indices();
+  if (indices.type_enum() == TypeEnum::INT32) {
+    return Take(pool, *values.dictionary(),
+        static_cast<const Int32Array&>(indices), out);
+  }
+
+  // Take gathers with int32 indices, so narrower ones are widened first
+  size_t n = values.length();
+  Buffer* data;
+  RETURN_NOT_OK(pool->NewBuffer(n * sizeof(int32_t), &data));
+  int32_t* dst = reinterpret_cast<int32_t*>(data->data());
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = values.IsNull(i) ? 0 : values.index(i);
+  }
+  Buffer* nulls = indices.nulls();
+  if (nulls != nullptr) {
+    nulls->Incref();
+  }
+  Int32Array wide(n, data, nulls);
+  return Take(pool, *values.dictionary(), wide, out);
+}
+
+} // namespace compute
+
+} // namespace arrow
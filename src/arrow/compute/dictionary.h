@@ -0,0 +1,45 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_DICTIONARY_H
+#define ARROW_COMPUTE_DICTIONARY_H
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types/dictionary.h"
+#include "arrow/types/string.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Encode values as a DictionaryArray whose dictionary is a StringArray of
+// the distinct non-null values in order of first appearance. The indices
+// are the narrowest of int8, int16 and int32 that can address the
+// dictionary, and are null where values are null. The caller owns the
+// returned array
+Status DictionaryEncode(MemoryPool* pool, const StringArray& values,
+    Array** out);
+
+// Expand a DictionaryArray into a plain array of its value type. Null slots
+// stay null. The caller owns the returned array
+Status DictionaryDecode(MemoryPool* pool, const DictionaryArray& values,
+    Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_DICTIONARY_H
@@ -0,0 +1,99 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/expression.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+template <typename TypeClass>
+static PrimitiveArrayImpl<TypeClass>* MakeArray(MemoryPool* pool,
+    bool with_nulls) {
+  typedef typename TypeClass::c_type T;
+  Random rng(random_seed());
+  std::vector<T> values(kNumValues);
+  std::vector<uint8_t> nulls((kNumValues + 7) / 8, 0);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = static_cast<T>(rng.Uniform(1000));
+    util::set_bit(nulls.data(), i, rng.Uniform(10) == 0);
+  }
+  return new PrimitiveArrayImpl<TypeClass>(kNumValues,
+      benchmark::make_buffer(pool, values),
+      with_nulls ? benchmark::make_buffer(pool, nulls) : nullptr);
+}
+
+// (a + b) * c < d, evaluated fused in one pass, and unfused one operator
+// at a time with an intermediate array per operator
+template <typename TypeClass>
+static void BenchmarkType(MemoryPool* pool, const std::string& label,
+    bool with_nulls) {
+  typedef PrimitiveArrayImpl<TypeClass> ArrayType;
+  std::unique_ptr<ArrayType> a(MakeArray<TypeClass>(pool, with_nulls));
+  std::unique_ptr<ArrayType> b(MakeArray<TypeClass>(pool, with_nulls));
+  std::unique_ptr<ArrayType> c(MakeArray<TypeClass>(pool, with_nulls));
+  std::unique_ptr<ArrayType> d(MakeArray<TypeClass>(pool, with_nulls));
+  size_t bytes = 4 * kNumValues * sizeof(typename TypeClass::c_type);
+  std::string suffix = label + (with_nulls ? "/nulls" : "/no-nulls");
+
+  benchmark::run(("Fused/" + suffix).c_str(), bytes, [&]() {
+        Buffer* mask;
+        BENCHMARK_OK(EvaluateMask(pool, (column(*a) + column(*b)) *
+                column(*c) < column(*d), &mask));
+        mask->Decref();
+      });
+
+  benchmark::run(("Unfused/" + suffix).c_str(), bytes, [&]() {
+        Array* sum;
+        BENCHMARK_OK(Evaluate(pool, column(*a) + column(*b), &sum));
+        std::unique_ptr<ArrayType> sum_owner(static_cast<ArrayType*>(sum));
+        Array* product;
+        BENCHMARK_OK(Evaluate(pool, column(*sum_owner) * column(*c),
+                &product));
+        std::unique_ptr<ArrayType> product_owner(
+            static_cast<ArrayType*>(product));
+        Buffer* mask;
+        BENCHMARK_OK(EvaluateMask(pool, column(*product_owner) < column(*d),
+                &mask));
+        mask->Decref();
+      });
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  for (bool with_nulls : {false, true}) {
+    arrow::compute::BenchmarkType<arrow::Int32Type>(&pool, "int32",
+        with_nulls);
+    arrow::compute::BenchmarkType<arrow::DoubleType>(&pool, "double",
+        with_nulls);
+  }
+  return 0;
+}
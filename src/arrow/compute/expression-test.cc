@@ -0,0 +1,175 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/expression.h"
+#include "arrow/compute/filter.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/bit-util.h"
+
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestExpression : public TestBase {
+ public:
+  template <typename E>
+  unique_ptr<Array> Eval(const Expr<E>& expr) {
+    Array* out;
+    EXPECT_OK(Evaluate(pool_.get(), expr, &out));
+    return unique_ptr<Array>(out);
+  }
+
+  template <typename E>
+  Buffer* Mask(const Expr<E>& expr) {
+    Buffer* out;
+    EXPECT_OK(EvaluateMask(pool_.get(), expr, &out));
+    return out;
+  }
+};
+
+
+TEST_F(TestExpression, TestArithmetic) {
+  // Lengths around the 64-slot blocks
+  for (size_t n : {1, 63, 64, 65, 1000}) {
+    vector<int32_t> a, b, c;
+    randint<int32_t>(n, -1000, 1000, a);
+    randint<int32_t>(n, -1000, 1000, b);
+    randint<int32_t>(n, -1000, 1000, c);
+    vector<uint8_t> a_nulls, c_nulls;
+    random_nulls(n, 0.8, a_nulls);
+    random_nulls(n, 0.7, c_nulls);
+
+    Int32Array a_array(n, to_buffer(a), bytes_to_null_buffer(a_nulls.data(),
+            n));
+    Int32Array b_array(n, to_buffer(b));
+    Int32Array c_array(n, to_buffer(c), bytes_to_null_buffer(c_nulls.data(),
+            n));
+
+    unique_ptr<Array> out = Eval(
+        (column(a_array) + column(b_array)) * 3 - column(c_array));
+    const Int32Array& result = static_cast<const Int32Array&>(*out);
+    ASSERT_EQ(n, result.length());
+    ASSERT_EQ(TypeEnum::INT32, result.type_enum());
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(a_nulls[i] || c_nulls[i], result.IsNull(i)) << i;
+      if (!result.IsNull(i)) {
+        ASSERT_EQ((a[i] + b[i]) * 3 - c[i], result.Value(i)) << i;
+      }
+    }
+  }
+}
+
+TEST_F(TestExpression, TestNoNulls) {
+  vector<double> a = {1.5, -2.0, 3.25};
+  DoubleArray a_array(a.size(), to_buffer(a));
+
+  unique_ptr<Array> out = Eval(2.0 * column(a_array) + 1.0);
+  const DoubleArray& result = static_cast<const DoubleArray&>(*out);
+  ASSERT_EQ(nullptr, result.null_bits());
+  ASSERT_FALSE(result.nullable());
+  ASSERT_EQ(4.0, result.Value(0));
+  ASSERT_EQ(-3.0, result.Value(1));
+  ASSERT_EQ(7.5, result.Value(2));
+}
+
+TEST_F(TestExpression, TestWrapAround) {
+  vector<int32_t> a = {std::numeric_limits<int32_t>::max(),
+                       std::numeric_limits<int32_t>::min()};
+  Int32Array a_array(a.size(), to_buffer(a));
+  unique_ptr<Array> sum = Eval(column(a_array) + 1);
+  ASSERT_EQ(std::numeric_limits<int32_t>::min(),
+      static_cast<const Int32Array&>(*sum).Value(0));
+  unique_ptr<Array> difference = Eval(column(a_array) - 1);
+  ASSERT_EQ(std::numeric_limits<int32_t>::max(),
+      static_cast<const Int32Array&>(*difference).Value(1));
+
+  // Small unsigned types are not promoted to int
+  vector<uint16_t> b = {65535, 300};
+  UInt16Array b_array(b.size(), to_buffer(b));
+  unique_ptr<Array> square = Eval(column(b_array) * column(b_array));
+  const UInt16Array& squares = static_cast<const UInt16Array&>(*square);
+  ASSERT_EQ(1, squares.Value(0));
+  ASSERT_EQ(static_cast<uint16_t>(90000), squares.Value(1));
+}
+
+TEST_F(TestExpression, TestComparisonMask) {
+  for (size_t n : {1, 64, 100, 1000}) {
+    vector<int64_t> a, b;
+    randint<int64_t>(n, -100, 100, a);
+    randint<int64_t>(n, -100, 100, b);
+    vector<uint8_t> b_nulls;
+    random_nulls(n, 0.9, b_nulls);
+    Int64Array a_array(n, to_buffer(a));
+    Int64Array b_array(n, to_buffer(b), bytes_to_null_buffer(b_nulls.data(),
+            n));
+
+    Buffer* mask = Mask((column(a_array) + 10 < column(b_array)) |
+        (column(a_array) == 0));
+    for (size_t i = 0; i < n; ++i) {
+      bool expected = !b_nulls[i] && (a[i] + 10 < b[i] || a[i] == 0);
+      ASSERT_EQ(expected, util::get_bit(mask->data(), i)) << i;
+    }
+    mask->Decref();
+  }
+}
+
+TEST_F(TestExpression, TestMaskFeedsFilter) {
+  vector<float> prices = {1.0f, 12.5f, 7.0f, 30.0f, 11.0f};
+  vector<int32_t> quantities = {5, 2, 1, 8, 0};
+  FloatArray price_array(prices.size(), to_buffer(prices));
+  Int32Array quantity_array(quantities.size(), to_buffer(quantities));
+
+  // WHERE price > 10 AND quantity >= 1
+  Buffer* mask = Mask((column(price_array) > 10.0f) &
+      (column(quantity_array) >= 1));
+  Array* out;
+  ASSERT_OK(Filter(pool_.get(), price_array, mask->data(), &out));
+  mask->Decref();
+  unique_ptr<FloatArray> selected(static_cast<FloatArray*>(out));
+  ASSERT_EQ(2, selected->length());
+  ASSERT_EQ(12.5f, selected->Value(0));
+  ASSERT_EQ(30.0f, selected->Value(1));
+}
+
+TEST_F(TestExpression, TestLengthMismatch) {
+  vector<int32_t> a = {1, 2, 3};
+  vector<int32_t> b = {1, 2};
+  Int32Array a_array(a.size(), to_buffer(a));
+  Int32Array b_array(b.size(), to_buffer(b));
+  Array* out;
+  ASSERT_TRUE(Evaluate(pool_.get(), column(a_array) + column(b_array),
+          &out).IsInvalid());
+  Buffer* mask;
+  ASSERT_TRUE(EvaluateMask(pool_.get(), column(a_array) < column(b_array),
+          &mask).IsInvalid());
+}
+
+} // namespace compute
+
+} // namespace arrow
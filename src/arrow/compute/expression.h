@@ -0,0 +1,374 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_EXPRESSION_H
+#define ARROW_COMPUTE_EXPRESSION_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Elementwise arithmetic and comparisons over primitive arrays, fused at
+// compile time. An expression such as
+//
+//   (column(a) + column(b)) * 3 < column(c)
+//
+// builds a tree of small objects whose types encode the whole computation,
+// and Evaluate / EvaluateMask run it in one pass over the inputs with no
+// intermediate arrays. The inputs are processed 64 slots at a time: the
+// values of a block come from one inlined loop, which the compiler can
+// vectorize, and the null bits of the block are the OR of the null bits of
+// every column in the expression, computed a 64-bit word at a time.
+//
+// Both sides of an operator must have the same value type; a scalar takes
+// the type of the other side. Integer arithmetic wraps around on overflow.
+// The columns are referenced, not copied, so they must outlive the
+// expression
+
+// The type class of arrays of c_type T
+template <typename T> struct type_class_for {};
+template <> struct type_class_for<uint8_t> { typedef UInt8Type type;};
+template <> struct type_class_for<int8_t> { typedef Int8Type type;};
+template <> struct type_class_for<uint16_t> { typedef UInt16Type type;};
+template <> struct type_class_for<int16_t> { typedef Int16Type type;};
+template <> struct type_class_for<uint32_t> { typedef UInt32Type type;};
+template <> struct type_class_for<int32_t> { typedef Int32Type type;};
+template <> struct type_class_for<uint64_t> { typedef UInt64Type type;};
+template <> struct type_class_for<int64_t> { typedef Int64Type type;};
+template <> struct type_class_for<float> { typedef FloatType type;};
+template <> struct type_class_for<double> { typedef DoubleType type;};
+
+// Base class of every expression node
+template <typename Derived>
+struct Expr {
+  const Derived& derived() const { return static_cast<const Derived&>(*this);}
+};
+
+// Length of an expression without columns
+static constexpr size_t kAnyLength = std::numeric_limits<size_t>::max();
+
+// Every expression node provides:
+//
+//   value_type Value(size_t i) const;  the value of slot i
+//   uint64_t NullWord(size_t i, size_t n) const;
+//       the null bits of slots [i, i + n), n <= 64
+//   bool has_nulls() const;  false if no slot can be null
+//   bool MatchLength(size_t* length) const;
+//       false if the columns are not all *length slots long; a *length of
+//       kAnyLength is set to the length of the first column
+
+template <typename TypeClass>
+class ColumnExpr : public Expr<ColumnExpr<TypeClass> > {
+ public:
+  typedef typename TypeClass::c_type value_type;
+
+  explicit ColumnExpr(const PrimitiveArrayImpl<TypeClass>& array) :
+      data_(array.raw_data()),
+      null_bits_(array.null_bits()),
+      length_(array.length()) {}
+
+  value_type Value(size_t i) const { return data_[i];}
+
+  uint64_t NullWord(size_t i, size_t n) const {
+    return null_bits_ == nullptr ? 0 : util::load_bits(null_bits_, i, n);
+  }
+
+  bool has_nulls() const { return null_bits_ != nullptr;}
+
+  bool MatchLength(size_t* length) const {
+    if (*length == kAnyLength) {
+      *length = length_;
+    }
+    return *length == length_;
+  }
+
+ private:
+  const value_type* data_;
+  const uint8_t* null_bits_;
+  size_t length_;
+};
+
+template <typename T>
+class ScalarExpr : public Expr<ScalarExpr<T> > {
+ public:
+  typedef T value_type;
+
+  explicit ScalarExpr(T value) : value_(value) {}
+
+  T Value(size_t i) const { return value_;}
+  uint64_t NullWord(size_t i, size_t n) const { return 0;}
+  bool has_nulls() const { return false;}
+  bool MatchLength(size_t* length) const { return true;}
+
+ private:
+  T value_;
+};
+
+template <typename Op, typename L, typename R>
+class BinaryExpr : public Expr<BinaryExpr<Op, L, R> > {
+ public:
+  static_assert(std::is_same<typename L::value_type,
+      typename R::value_type>::value,
+      "both operands must have the same value type");
+  typedef typename Op::template result<typename L::value_type>::type
+  value_type;
+
+  BinaryExpr(const L& left, const R& right) : left_(left), right_(right) {}
+
+  value_type Value(size_t i) const {
+    return Op::Apply(left_.Value(i), right_.Value(i));
+  }
+
+  uint64_t NullWord(size_t i, size_t n) const {
+    return left_.NullWord(i, n) | right_.NullWord(i, n);
+  }
+
+  bool has_nulls() const { return left_.has_nulls() || right_.has_nulls();}
+
+  bool MatchLength(size_t* length) const {
+    return left_.MatchLength(length) && right_.MatchLength(length);
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+template <typename TypeClass>
+ColumnExpr<TypeClass> column(const PrimitiveArrayImpl<TypeClass>& array) {
+  return ColumnExpr<TypeClass>(array);
+}
+
+template <typename T>
+ScalarExpr<T> scalar(T value) {
+  return ScalarExpr<T>(value);
+}
+
+// ----------------------------------------------------------------------
+// Operators
+
+// Integers are computed in an unsigned type at least as wide as unsigned
+// int, where overflow is defined (and small types are not promoted to int)
+template <typename T>
+struct wrapping_type {
+  typedef typename std::common_type<typename std::make_unsigned<T>::type,
+                                    unsigned int>::type type;
+};
+
+#define EXPR_ARITHMETIC_OP(NAME, OP)                                    \
+  struct NAME {                                                         \
+    template <typename T> struct result { typedef T type;};             \
+                                                                        \
+    template <typename T>                                               \
+    static typename std::enable_if<std::is_integral<T>::value, T>::type \
+    Apply(T a, T b) {                                                   \
+      typedef typename wrapping_type<T>::type W;                        \
+      return static_cast<T>(static_cast<W>(a) OP static_cast<W>(b));    \
+    }                                                                   \
+                                                                        \
+    template <typename T>                                               \
+    static typename std::enable_if<!std::is_integral<T>::value, T>::type \
+    Apply(T a, T b) {                                                   \
+      return a OP b;                                                    \
+    }                                                                   \
+  };
+
+#define EXPR_COMPARISON_OP(NAME, OP)                                    \
+  struct NAME {                                                         \
+    template <typename T> struct result { typedef bool type;};          \
+                                                                        \
+    template <typename T>                                               \
+    static bool Apply(T a, T b) { return a OP b;}                       \
+  };
+
+// Logical operators combine comparisons; like every other operator they
+// are null if either side is null
+#define EXPR_LOGICAL_OP(NAME, OP)                                       \
+  struct NAME {                                                         \
+    template <typename T> struct result {                               \
+      static_assert(std::is_same<T, bool>::value,                       \
+          "logical operators take comparisons");                        \
+      typedef bool type;                                                \
+    };                                                                  \
+                                                                        \
+    static bool Apply(bool a, bool b) { return a OP b;}                 \
+  };
+
+EXPR_ARITHMETIC_OP(AddOp, +);
+EXPR_ARITHMETIC_OP(SubtractOp, -);
+EXPR_ARITHMETIC_OP(MultiplyOp, *);
+
+EXPR_COMPARISON_OP(EqualOp, ==);
+EXPR_COMPARISON_OP(NotEqualOp, !=);
+EXPR_COMPARISON_OP(LessOp, <);
+EXPR_COMPARISON_OP(LessEqualOp, <=);
+EXPR_COMPARISON_OP(GreaterOp, >);
+EXPR_COMPARISON_OP(GreaterEqualOp, >=);
+
+EXPR_LOGICAL_OP(AndOp, &);
+EXPR_LOGICAL_OP(OrOp, |);
+
+#undef EXPR_ARITHMETIC_OP
+#undef EXPR_COMPARISON_OP
+#undef EXPR_LOGICAL_OP
+
+// Overloads of OP for two expressions and for an expression and a scalar
+// of its value type, on either side
+#define EXPR_OPERATOR(OP, Op)                                           \
+  template <typename L, typename R>                                     \
+  BinaryExpr<Op, L, R> operator OP(const Expr<L>& l, const Expr<R>& r) { \
+    return BinaryExpr<Op, L, R>(l.derived(), r.derived());              \
+  }                                                                     \
+                                                                        \
+  template <typename L>                                                 \
+  BinaryExpr<Op, L, ScalarExpr<typename L::value_type> >                \
+  operator OP(const Expr<L>& l, typename L::value_type r) {             \
+    return BinaryExpr<Op, L, ScalarExpr<typename L::value_type> >(      \
+        l.derived(), ScalarExpr<typename L::value_type>(r));            \
+  }                                                                     \
+                                                                        \
+  template <typename R>                                                 \
+  BinaryExpr<Op, ScalarExpr<typename R::value_type>, R>                 \
+  operator OP(typename R::value_type l, const Expr<R>& r) {             \
+    return BinaryExpr<Op, ScalarExpr<typename R::value_type>, R>(       \
+        ScalarExpr<typename R::value_type>(l), r.derived());            \
+  }
+
+EXPR_OPERATOR(+, AddOp);
+EXPR_OPERATOR(-, SubtractOp);
+EXPR_OPERATOR(*, MultiplyOp);
+
+EXPR_OPERATOR(==, EqualOp);
+EXPR_OPERATOR(!=, NotEqualOp);
+EXPR_OPERATOR(<, LessOp);
+EXPR_OPERATOR(<=, LessEqualOp);
+EXPR_OPERATOR(>, GreaterOp);
+EXPR_OPERATOR(>=, GreaterEqualOp);
+
+EXPR_OPERATOR(&, AndOp);
+EXPR_OPERATOR(|, OrOp);
+
+#undef EXPR_OPERATOR
+
+// ----------------------------------------------------------------------
+// Evaluation
+
+template <typename E>
+Status expression_length(const E& expr, size_t* length) {
+  *length = kAnyLength;
+  if (!expr.MatchLength(length)) {
+    return Status::Invalid("columns of different lengths");
+  }
+  if (*length == kAnyLength) {
+    return Status::Invalid("expression without columns");
+  }
+  return Status::OK();
+}
+
+static inline Status allocate_expression_bitmap(MemoryPool* pool,
+    size_t length, Buffer** out) {
+  size_t nbytes = (length + 7) / 8;
+  RETURN_NOT_OK(pool->NewBuffer(nbytes, out));
+  memset((*out)->data(), 0, nbytes);
+  return Status::OK();
+}
+
+// Evaluate an arithmetic expression into a new array allocated from pool,
+// whose slots are null where any column of the expression is. The caller
+// owns the returned array
+template <typename E>
+Status Evaluate(MemoryPool* pool, const Expr<E>& expr, Array** out) {
+  typedef typename E::value_type T;
+  static_assert(!std::is_same<T, bool>::value,
+      "comparisons are evaluated with EvaluateMask");
+  typedef typename type_class_for<T>::type TypeClass;
+  const E& e = expr.derived();
+
+  size_t length;
+  RETURN_NOT_OK(expression_length(e, &length));
+
+  Buffer* data;
+  RETURN_NOT_OK(pool->NewBuffer(length * sizeof(T), &data));
+  Buffer* nulls = nullptr;
+  if (e.has_nulls()) {
+    Status s = allocate_expression_bitmap(pool, length, &nulls);
+    if (!s.ok()) {
+      data->Decref();
+      return s;
+    }
+  }
+
+  T* values = reinterpret_cast<T*>(data->data());
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    for (size_t j = 0; j < n; ++j) {
+      values[i + j] = e.Value(i + j);
+    }
+    if (nulls != nullptr) {
+      util::store_bits(nulls->data(), i, e.NullWord(i, n), n);
+    }
+  }
+
+  *out = new PrimitiveArrayImpl<TypeClass>(length, data, nulls);
+  return Status::OK();
+}
+
+// Evaluate a boolean expression (comparisons, combined with & and |) into a
+// new bitmap allocated from pool, with one bit per slot that is set where
+// the expression is true and not null. The bitmap is a selection for
+// Filter. The caller owns the returned buffer
+template <typename E>
+Status EvaluateMask(MemoryPool* pool, const Expr<E>& expr, Buffer** out) {
+  static_assert(std::is_same<typename E::value_type, bool>::value,
+      "arithmetic expressions are evaluated with Evaluate");
+  const E& e = expr.derived();
+
+  size_t length;
+  RETURN_NOT_OK(expression_length(e, &length));
+
+  Buffer* mask;
+  RETURN_NOT_OK(allocate_expression_bitmap(pool, length, &mask));
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t word = 0;
+    for (size_t j = 0; j < n; ++j) {
+      word |= static_cast<uint64_t>(e.Value(i + j)) << j;
+    }
+    if (e.has_nulls()) {
+      word &= ~e.NullWord(i, n);
+    }
+    util::store_bits(mask->data(), i, word, n);
+  }
+
+  *out = mask;
+  return Status::OK();
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_EXPRESSION_H
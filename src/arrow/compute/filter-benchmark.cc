@@ -0,0 +1,92 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/filter.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/string.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+// Each slot is selected with probability 1 / one_in
+static std::vector<uint8_t> MakeSelection(uint32_t one_in) {
+  Random rng(random_seed());
+  std::vector<uint8_t> selection((kNumValues + 7) / 8, 0);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    util::set_bit(selection.data(), i, rng.OneIn(one_in));
+  }
+  return selection;
+}
+
+static void BenchmarkFilter(MemoryPool* pool, const Array& values,
+    const std::string& label, size_t bytes_per_value) {
+  for (uint32_t one_in : {1, 2, 10, 100}) {
+    std::vector<uint8_t> selection = MakeSelection(one_in);
+
+    std::string name = "Filter/" + label + "/1in" + std::to_string(one_in);
+    benchmark::run(name.c_str(), kNumValues * bytes_per_value, [&]() {
+          Array* out;
+          BENCHMARK_OK(Filter(pool, values, selection.data(), &out));
+          delete out;
+        });
+  }
+}
+
+static void BenchmarkInt64(MemoryPool* pool) {
+  std::vector<int64_t> values(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = static_cast<int64_t>(i * 7);
+  }
+  Int64Array array(kNumValues, benchmark::make_buffer(pool, values));
+  BenchmarkFilter(pool, array, "int64", sizeof(int64_t));
+}
+
+static void BenchmarkString(MemoryPool* pool) {
+  // Strings of 0 to 15 bytes
+  std::vector<int32_t> offsets(kNumValues + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < kNumValues; ++i) {
+    offsets[i + 1] = offsets[i] + static_cast<int32_t>(i % 16);
+  }
+  std::vector<uint8_t> chars(offsets[kNumValues], 'x');
+
+  ArrayPtr bytes(new UInt8Array(chars.size(),
+          benchmark::make_buffer(pool, chars)));
+  StringArray array(kNumValues, benchmark::make_buffer(pool, offsets), bytes);
+  BenchmarkFilter(pool, array, "string", 8 + sizeof(int32_t));
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkInt64(&pool);
+  arrow::compute::BenchmarkString(&pool);
+  return 0;
+}
@@ -0,0 +1,229 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/filter.h"
+#include "arrow/types/boolean.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+#include "arrow/util/bit-util.h"
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestFilter : public TestBase {
+ public:
+  // Select each slot with the given probability
+  void MakeSelection(size_t length, double probability) {
+    vector<uint8_t> bytes;
+    random_nulls(length, 1 - probability, bytes);
+    MakeSelection(bytes);
+  }
+
+  void MakeSelection(const vector<uint8_t>& bytes) {
+    selected_ = bytes;
+    selection_.assign((bytes.size() + 7) / 8, 0);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      util::set_bit(selection_.data(), i, bytes[i] != 0);
+    }
+  }
+
+  void DoFilter(const Array& values) {
+    Array* out;
+    ASSERT_OK(Filter(pool_.get(), values, selection_.data(), &out));
+    result_.reset(out);
+
+    size_t expected = 0;
+    for (uint8_t s : selected_) expected += s != 0;
+    ASSERT_EQ(expected, result_->length());
+  }
+
+  // Indices of the selected slots, in order
+  vector<size_t> SelectedIndices() {
+    vector<size_t> indices;
+    for (size_t i = 0; i < selected_.size(); ++i) {
+      if (selected_[i]) indices.push_back(i);
+    }
+    return indices;
+  }
+
+ protected:
+  vector<uint8_t> selected_;
+  vector<uint8_t> selection_;
+  unique_ptr<Array> result_;
+};
+
+
+TEST_F(TestFilter, TestPrimitive) {
+  size_t n = 1000;
+  vector<int64_t> values;
+  vector<uint8_t> nulls;
+  randint<int64_t>(n, -1000, 1000, values);
+  random_nulls(n, 0.2, nulls);
+  Int64Array array(n, to_buffer(values), bytes_to_null_buffer(nulls.data(), n));
+
+  // Sparse, mixed and nearly full selections, the latter with whole words
+  // selected
+  for (double probability : {0.01, 0.5, 0.99, 1.0}) {
+    MakeSelection(n, probability);
+    DoFilter(array);
+
+    Int64Array* result = static_cast<Int64Array*>(result_.get());
+    ASSERT_TRUE(result->nullable());
+    vector<size_t> indices = SelectedIndices();
+    for (size_t i = 0; i < indices.size(); ++i) {
+      ASSERT_EQ(static_cast<bool>(nulls[indices[i]]), result->IsNull(i));
+      ASSERT_EQ(values[indices[i]], result->Value(i));
+    }
+  }
+}
+
+
+TEST_F(TestFilter, TestNonNullable) {
+  vector<int32_t> values = {10, 11, 12, 13, 14};
+  Int32Array array(values.size(), to_buffer(values));
+
+  MakeSelection({1, 0, 0, 1, 1});
+  DoFilter(array);
+
+  ASSERT_FALSE(result_->nullable());
+  Int32Array* result = static_cast<Int32Array*>(result_.get());
+  ASSERT_EQ(10, result->Value(0));
+  ASSERT_EQ(13, result->Value(1));
+  ASSERT_EQ(14, result->Value(2));
+
+  MakeSelection({0, 0, 0, 0, 0});
+  DoFilter(array);
+}
+
+
+TEST_F(TestFilter, TestString) {
+  size_t n = 500;
+  vector<string> strings(n);
+  vector<uint8_t> is_null;
+  random_nulls(n, 0.1, is_null);
+
+  StringBuilder builder(pool_.get(), TypePtr(new StringType()));
+  for (size_t i = 0; i < n; ++i) {
+    strings[i] = string(i % 7, 'a' + i % 26);
+    if (is_null[i]) {
+      ASSERT_OK(builder.AppendNull());
+    } else {
+      ASSERT_OK(builder.Append(strings[i]));
+    }
+  }
+  Array* tmp;
+  ASSERT_OK(builder.ToArray(&tmp));
+  unique_ptr<Array> array(tmp);
+
+  // Both the sparse (gather) and dense (run copy) strategies
+  for (double probability : {0.05, 0.8}) {
+    MakeSelection(n, probability);
+    DoFilter(*array);
+
+    StringArray* result = static_cast<StringArray*>(result_.get());
+    vector<size_t> indices = SelectedIndices();
+    for (size_t i = 0; i < indices.size(); ++i) {
+      ASSERT_EQ(static_cast<bool>(is_null[indices[i]]), result->IsNull(i));
+      if (!is_null[indices[i]]) {
+        ASSERT_EQ(strings[indices[i]], result->GetString(i));
+      }
+    }
+  }
+}
+
+
+TEST_F(TestFilter, TestList) {
+  TypePtr value_type(new Int32Type());
+  TypePtr type(new ListType(value_type));
+  ListBuilder builder(pool_.get(), type,
+      new Int32Builder(pool_.get(), value_type));
+  Int32Builder* vb = static_cast<Int32Builder*>(builder.value_builder());
+
+  // [[0], [1, 2], null, [3, 4, 5], [], [6]]
+  vector<vector<int32_t> > lists = {{0}, {1, 2}, {}, {3, 4, 5}, {}, {6}};
+  for (size_t i = 0; i < lists.size(); ++i) {
+    ASSERT_OK(builder.Append(i == 2));
+    for (int32_t v : lists[i]) {
+      ASSERT_OK(vb->Append(v));
+    }
+  }
+  Array* tmp;
+  ASSERT_OK(builder.ToArray(&tmp));
+  unique_ptr<Array> array(tmp);
+
+  MakeSelection({0, 1, 1, 1, 0, 1});
+  DoFilter(*array);
+
+  ListArray* result = static_cast<ListArray*>(result_.get());
+  Int32Array* values = static_cast<Int32Array*>(result->values().get());
+  vector<int32_t> ex_offsets = {0, 2, 2, 5, 6};
+  vector<int32_t> ex_values = {1, 2, 3, 4, 5, 6};
+  for (size_t i = 0; i < ex_offsets.size(); ++i) {
+    ASSERT_EQ(ex_offsets[i], result->offset(i));
+  }
+  ASSERT_EQ(ex_values.size(), values->length());
+  for (size_t i = 0; i < ex_values.size(); ++i) {
+    ASSERT_EQ(ex_values[i], values->Value(i));
+  }
+  ASSERT_FALSE(result->IsNull(0));
+  ASSERT_TRUE(result->IsNull(1));
+  ASSERT_FALSE(result->IsNull(2));
+}
+
+
+TEST_F(TestFilter, TestBooleanMask) {
+  vector<int32_t> values = {10, 11, 12, 13, 14};
+  Int32Array array(values.size(), to_buffer(values));
+
+  // Null mask slots are not selected
+  vector<uint8_t> mask_values = {1, 1, 0, 1, 1};
+  vector<uint8_t> mask_nulls = {0, 1, 0, 0, 0};
+  BooleanArray mask(mask_values.size(), to_buffer(mask_values),
+      bytes_to_null_buffer(mask_nulls.data(), mask_nulls.size()));
+
+  Array* out;
+  ASSERT_OK(Filter(pool_.get(), array, mask, &out));
+  unique_ptr<Array> result_holder(out);
+
+  Int32Array* result = static_cast<Int32Array*>(out);
+  ASSERT_EQ(3, result->length());
+  ASSERT_EQ(10, result->Value(0));
+  ASSERT_EQ(13, result->Value(1));
+  ASSERT_EQ(14, result->Value(2));
+
+  BooleanArray short_mask(2, to_buffer(mask_values));
+  ASSERT_RAISES(Invalid, Filter(pool_.get(), array, short_mask, &out));
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,234 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/filter.h"
+
+#include <cstring>
+
+#include "arrow/compute/kernel-util.h"
+#include "arrow/compute/take.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+// Variable-length arrays with fewer than 1 in kSparseRatio slots selected are
+// filtered by gathering the selected indices rather than copying runs
+static constexpr size_t kSparseRatio = 8;
+
+static constexpr uint64_t kAllSelected = ~static_cast<uint64_t>(0);
+
+template <typename T>
+void FilterValues(const T* values, const uint8_t* selection, size_t length,
+    T* out) {
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t word = util::load_bits(selection, i, n);
+    if (word == kAllSelected) {
+      memcpy(out, values + i, 64 * sizeof(T));
+      out += 64;
+      continue;
+    }
+    while (word != 0) {
+      *out++ = values[i + __builtin_ctzll(word)];
+      word &= word - 1;
+    }
+  }
+}
+
+// out must be zeroed
+void FilterNulls(const uint8_t* nulls, const uint8_t* selection, size_t length,
+    uint8_t* out) {
+  size_t position = 0;
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t word = util::load_bits(selection, i, n);
+    if (word == kAllSelected) {
+      util::copy_bits(nulls, i, 64, out, position);
+      position += 64;
+      continue;
+    }
+    while (word != 0) {
+      util::set_bit(out, position++,
+          util::get_bit(nulls, i + __builtin_ctzll(word)));
+      word &= word - 1;
+    }
+  }
+}
+
+struct FilterPrimitiveVisitor {
+  MemoryPool* pool;
+  const Array& values;
+  const uint8_t* selection;
+  size_t selected;
+  Buffer* data;
+
+  template <typename TypeClass>
+  Status Visit() {
+    typedef typename TypeClass::c_type T;
+    RETURN_NOT_OK(pool->NewBuffer(selected * sizeof(T), &data));
+
+    const auto& typed = static_cast<const PrimitiveArrayImpl<TypeClass>&>(values);
+    FilterValues(typed.raw_data(), selection, values.length(),
+        reinterpret_cast<T*>(data->data()));
+    return Status::OK();
+  }
+};
+
+Status FilterByIndices(MemoryPool* pool, const Array& values,
+    const uint8_t* selection, size_t selected, Array** out) {
+  Buffer* index_buf;
+  RETURN_NOT_OK(pool->NewBuffer(selected * sizeof(int32_t), &index_buf));
+  int32_t* idx = reinterpret_cast<int32_t*>(index_buf->data());
+
+  for (size_t i = 0; i < values.length(); i += 64) {
+    size_t n = values.length() - i < 64 ? values.length() - i : 64;
+    uint64_t word = util::load_bits(selection, i, n);
+    while (word != 0) {
+      *idx++ = static_cast<int32_t>(i + __builtin_ctzll(word));
+      word &= word - 1;
+    }
+  }
+
+  Int32Array indices(selected, index_buf);
+  return Take(pool, values, indices, out);
+}
+
+// Copy each run of selected slots: the offsets are rebased per run, and the
+// child is filtered recursively with a selection covering the runs' values
+Status FilterListRuns(MemoryPool* pool, const Array& values,
+    const uint8_t* selection, size_t selected, const TypePtr& type,
+    Buffer* nulls, Array** out) {
+  const ListArray& list = static_cast<const ListArray&>(values);
+  const Array& child = *list.values();
+
+  Buffer* offset_buf;
+  RETURN_NOT_OK(pool->NewBuffer((selected + 1) * sizeof(int32_t),
+          &offset_buf));
+  Buffer* child_selection;
+  Status s = allocate_nulls(pool, child.length(), &child_selection);
+  if (!s.ok()) {
+    offset_buf->Decref();
+    return s;
+  }
+
+  int32_t* dst = reinterpret_cast<int32_t*>(offset_buf->data());
+  uint8_t* child_bits = child_selection->data();
+  const int32_t* offsets = list.offsets();
+  int32_t position = 0;
+  util::visit_set_runs(selection, values.length(),
+      [&](size_t start, size_t length) {
+        const int32_t* src = offsets + start;
+        int32_t delta = position - src[0];
+        for (size_t i = 0; i < length; ++i) {
+          dst[i] = src[i] + delta;
+        }
+        dst += length;
+
+        int32_t child_length = src[length] - src[0];
+        util::set_bits(child_bits, src[0], child_length);
+        position += child_length;
+      });
+  *dst = position;
+
+  Array* child_out;
+  s = Filter(pool, child, child_bits, &child_out);
+  child_selection->Decref();
+  if (!s.ok()) {
+    offset_buf->Decref();
+    return s;
+  }
+
+  if (type->type == TypeEnum::STRING) {
+    StringArray* result = new StringArray();
+    result->Init(type, selected, offset_buf, ArrayPtr(child_out), nulls);
+    *out = result;
+  } else {
+    ListArray* result = new ListArray();
+    result->Init(type, selected, offset_buf, ArrayPtr(child_out), nulls);
+    *out = result;
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+Status Filter(MemoryPool* pool, const Array& values, const uint8_t* selection,
+    Array** out) {
+  TypeEnum type_enum = values.type_enum();
+  bool is_list = type_enum == TypeEnum::LIST || type_enum == TypeEnum::STRING;
+  if (!is_primitive(type_enum) && !is_list) {
+    return Status::NotImplemented(values.type()->ToString());
+  }
+
+  size_t length = values.length();
+  size_t selected = util::count_set_bits(selection, 0, length);
+  if (is_list && selected * kSparseRatio < length) {
+    return FilterByIndices(pool, values, selection, selected, out);
+  }
+
+  Buffer* nulls = nullptr;
+  TypePtr type = values.type();
+  if (values.nullable() || values.null_bits() != nullptr) {
+    RETURN_NOT_OK(allocate_nulls(pool, selected, &nulls));
+    if (values.null_bits() != nullptr) {
+      FilterNulls(values.null_bits(), selection, length, nulls->data());
+    }
+    type = nullable_type(type);
+  }
+
+  Status s;
+  if (is_list) {
+    s = FilterListRuns(pool, values, selection, selected, type, nulls, out);
+  } else {
+    FilterPrimitiveVisitor visitor = {pool, values, selection, selected,
+                                      nullptr};
+    s = visit_primitive(type_enum, &visitor);
+    if (s.ok()) {
+      s = make_primitive_array(type, selected, visitor.data, nulls, out);
+    }
+  }
+  if (!s.ok() && nulls != nullptr) {
+    nulls->Decref();
+  }
+  return s;
+}
+
+Status Filter(MemoryPool* pool, const Array& values, const BooleanArray& mask,
+    Array** out) {
+  if (mask.length() != values.length()) {
+    return Status::Invalid("filter mask must be the same length as the values");
+  }
+
+  Buffer* selection;
+  RETURN_NOT_OK(allocate_nulls(pool, mask.length(), &selection));
+  uint8_t* bits = selection->data();
+  const uint8_t* mask_values = mask.raw_data();
+  for (size_t i = 0; i < mask.length(); ++i) {
+    util::set_bit(bits, i, mask_values[i] != 0 && !mask.IsNull(i));
+  }
+
+  Status s = Filter(pool, values, bits, out);
+  selection->Decref();
+  return s;
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,52 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_FILTER_H
+#define ARROW_COMPUTE_FILTER_H
+
+#include <cstdint>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types/boolean.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Compact values down to the slots whose bit is set in the selection
+// bitmap, which has one bit per slot of values. Supports primitive, list and
+// string arrays; null bits are compacted along with the values.
+//
+// The output length is computed with popcount so every buffer is allocated
+// exactly once. Primitive values are compacted one 64-slot selection word at
+// a time: all-selected words are block copied and partially selected words
+// are compacted index by index. Variable-length arrays use the overall
+// selectivity: dense selections copy each run of selected slots as a block,
+// sparse ones gather the selected indices. The caller owns the returned
+// array
+Status Filter(MemoryPool* pool, const Array& values, const uint8_t* selection,
+    Array** out);
+
+// As above, with the selection given as a boolean array of the same length
+// as values. Slots where the mask is null are not selected
+Status Filter(MemoryPool* pool, const Array& values, const BooleanArray& mask,
+    Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_FILTER_H
@@ -0,0 +1,99 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/compute/group-by.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/string.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumRows = 1 << 20;
+
+static const std::vector<Aggregate> kAggregates = {
+  {AggregateFunction::COUNT, 0},
+  {AggregateFunction::SUM, 0},
+  {AggregateFunction::MIN, 0},
+  {AggregateFunction::MAX, 0}
+};
+
+static void BenchmarkGroupBy(MemoryPool* pool, const std::string& name,
+    const std::vector<TypePtr>& key_types, const std::vector<Array*>& keys,
+    Array* values) {
+  benchmark::run(name.c_str(), kNumRows * sizeof(int64_t), [&]() {
+        GroupBy group_by(pool, key_types, {values->type()}, kAggregates);
+        BENCHMARK_OK(group_by.Init());
+        BENCHMARK_OK(group_by.Consume(keys, {values}));
+        std::vector<ArrayPtr> out_keys, aggregates;
+        BENCHMARK_OK(group_by.Finish(&out_keys, &aggregates));
+      });
+}
+
+// int32, int64, string and (int32, string) keys drawn from num_groups
+// distinct values, summing int64 values
+static void BenchmarkCardinality(MemoryPool* pool, size_t num_groups) {
+  Random rng(random_seed());
+  std::vector<int32_t> draws(kNumRows);
+  std::vector<int64_t> wide(kNumRows);
+  std::vector<int64_t> values(kNumRows);
+  StringBuilder strings(pool, TypePtr(new StringType(false)));
+  for (size_t i = 0; i < kNumRows; ++i) {
+    draws[i] = rng.Uniform(num_groups);
+    wide[i] = static_cast<int64_t>(draws[i]) * 0x100000001LL;
+    values[i] = rng.Uniform(1000);
+    BENCHMARK_OK(strings.Append("key-" + std::to_string(draws[i])));
+  }
+
+  Int32Array int32_keys(kNumRows, benchmark::make_buffer(pool, draws));
+  Int64Array int64_keys(kNumRows, benchmark::make_buffer(pool, wide));
+  Array* string_keys;
+  BENCHMARK_OK(strings.ToArray(&string_keys));
+  std::unique_ptr<Array> string_owner(string_keys);
+  Int64Array value_array(kNumRows, benchmark::make_buffer(pool, values));
+
+  std::string suffix = "/groups:" + std::to_string(num_groups);
+  BenchmarkGroupBy(pool, "GroupBy/int32" + suffix, {int32_keys.type()},
+      {&int32_keys}, &value_array);
+  BenchmarkGroupBy(pool, "GroupBy/int64" + suffix, {int64_keys.type()},
+      {&int64_keys}, &value_array);
+  BenchmarkGroupBy(pool, "GroupBy/string" + suffix, {string_keys->type()},
+      {string_keys}, &value_array);
+  BenchmarkGroupBy(pool, "GroupBy/int32,string" + suffix,
+      {int32_keys.type(), string_keys->type()}, {&int32_keys, string_keys},
+      &value_array);
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  // From a table that fits in L1 to one well beyond the last level cache
+  for (size_t num_groups : {16, 1024, 65536, 1 << 20}) {
+    arrow::compute::BenchmarkCardinality(&pool, num_groups);
+  }
+  return 0;
+}
@@ -0,0 +1,418 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/group-by.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+
+using std::pair;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestGroupBy : public TestBase {
+ public:
+  unique_ptr<StringArray> MakeStrings(const vector<string>& strings,
+      const vector<uint8_t>& is_null) {
+    StringBuilder builder(pool_.get(), TypePtr(new StringType()));
+    for (size_t i = 0; i < strings.size(); ++i) {
+      if (is_null[i]) {
+        EXPECT_OK(builder.AppendNull());
+      } else {
+        EXPECT_OK(builder.Append(strings[i]));
+      }
+    }
+    Array* out;
+    EXPECT_OK(builder.ToArray(&out));
+    return unique_ptr<StringArray>(static_cast<StringArray*>(out));
+  }
+};
+
+static const vector<Aggregate> kAllAggregates = {
+  {AggregateFunction::COUNT, 0},
+  {AggregateFunction::SUM, 0},
+  {AggregateFunction::MIN, 0},
+  {AggregateFunction::MAX, 0}
+};
+
+template <typename TypeClass, typename T>
+unique_ptr<Array> MakeArray(const vector<T>& values, vector<uint8_t>* nulls) {
+  return unique_ptr<Array>(new PrimitiveArrayImpl<TypeClass>(values.size(),
+          to_buffer(values), nulls->empty() ? nullptr :
+          bytes_to_null_buffer(nulls->data(), nulls->size())));
+}
+
+// Aggregate the int32 values of each row by key with std::map and compare
+// with the output of GroupBy, whose groups must come in order of first
+// appearance. Key is any ordered type holding the key of a row
+template <typename Key>
+void CheckGroups(const vector<Key>& row_keys, const vector<int32_t>& values,
+    const vector<uint8_t>& value_nulls, const vector<Key>& group_keys,
+    const vector<ArrayPtr>& aggregates) {
+  struct Expected {
+    int64_t count;
+    int64_t sum;
+    int32_t min;
+    int32_t max;
+  };
+  std::map<Key, Expected> expected;
+  vector<Key> order;
+  for (size_t i = 0; i < row_keys.size(); ++i) {
+    auto it = expected.find(row_keys[i]);
+    if (it == expected.end()) {
+      it = expected.insert({row_keys[i], Expected{0, 0,
+              std::numeric_limits<int32_t>::max(),
+              std::numeric_limits<int32_t>::min()}}).first;
+      order.push_back(row_keys[i]);
+    }
+    if (value_nulls[i]) continue;
+    Expected& e = it->second;
+    ++e.count;
+    e.sum += values[i];
+    e.min = std::min(e.min, values[i]);
+    e.max = std::max(e.max, values[i]);
+  }
+
+  ASSERT_EQ(order.size(), group_keys.size());
+  ASSERT_EQ(4, aggregates.size());
+  const Int64Array& counts = static_cast<const Int64Array&>(*aggregates[0]);
+  const Int64Array& sums = static_cast<const Int64Array&>(*aggregates[1]);
+  const Int32Array& mins = static_cast<const Int32Array&>(*aggregates[2]);
+  const Int32Array& maxs = static_cast<const Int32Array&>(*aggregates[3]);
+  for (size_t g = 0; g < order.size(); ++g) {
+    ASSERT_TRUE(order[g] == group_keys[g]) << g;
+    const Expected& e = expected[order[g]];
+    ASSERT_EQ(e.count, counts.Value(g));
+    ASSERT_EQ(e.sum, sums.Value(g));
+    ASSERT_EQ(e.count == 0, mins.IsNull(g));
+    ASSERT_EQ(e.count == 0, maxs.IsNull(g));
+    if (e.count > 0) {
+      ASSERT_EQ(e.min, mins.Value(g));
+      ASSERT_EQ(e.max, maxs.Value(g));
+    }
+  }
+}
+
+// Batch lengths spanning several passes, a single row and an empty batch
+static const vector<size_t> kBatchLengths = {3000, 1, 0, 1500};
+
+template <typename TypeClass>
+void CheckPrimitiveKeys(MemoryPool* pool) {
+  typedef typename TypeClass::c_type T;
+  typedef pair<bool, T> Key;
+
+  GroupBy group_by(pool, {TypePtr(new TypeClass())},
+      {TypePtr(new Int32Type())}, kAllAggregates);
+  ASSERT_OK(group_by.Init());
+
+  vector<Key> row_keys;
+  vector<int32_t> all_values;
+  vector<uint8_t> all_value_nulls;
+  for (size_t n : kBatchLengths) {
+    vector<T> keys;
+    randint<T>(n, 0, 100, keys);
+    vector<uint8_t> key_nulls;
+    random_nulls(n, 0.95, key_nulls);
+    vector<int32_t> values;
+    randint<int32_t>(n, -1000, 1000, values);
+    vector<uint8_t> value_nulls;
+    random_nulls(n, 0.8, value_nulls);
+
+    unique_ptr<Array> key_array = MakeArray<TypeClass>(keys, &key_nulls);
+    unique_ptr<Array> value_array = MakeArray<Int32Type>(values,
+        &value_nulls);
+    ASSERT_OK(group_by.Consume({key_array.get()}, {value_array.get()}));
+
+    for (size_t i = 0; i < n; ++i) {
+      row_keys.push_back(key_nulls[i] ? Key(true, 0) : Key(false, keys[i]));
+    }
+    all_values.insert(all_values.end(), values.begin(), values.end());
+    all_value_nulls.insert(all_value_nulls.end(), value_nulls.begin(),
+        value_nulls.end());
+  }
+
+  vector<ArrayPtr> keys, aggregates;
+  size_t num_groups = group_by.num_groups();
+  ASSERT_OK(group_by.Finish(&keys, &aggregates));
+  ASSERT_EQ(0, group_by.num_groups());
+  ASSERT_EQ(1, keys.size());
+  ASSERT_EQ(num_groups, keys[0]->length());
+
+  const PrimitiveArrayImpl<TypeClass>& key_array =
+    static_cast<const PrimitiveArrayImpl<TypeClass>&>(*keys[0]);
+  vector<Key> group_keys;
+  for (size_t g = 0; g < key_array.length(); ++g) {
+    group_keys.push_back(key_array.IsNull(g) ? Key(true, 0) :
+        Key(false, key_array.Value(g)));
+  }
+  CheckGroups(row_keys, all_values, all_value_nulls, group_keys, aggregates);
+}
+
+TEST_F(TestGroupBy, TestInt32Keys) {
+  CheckPrimitiveKeys<Int32Type>(pool_.get());
+}
+
+TEST_F(TestGroupBy, TestInt64Keys) {
+  CheckPrimitiveKeys<Int64Type>(pool_.get());
+}
+
+TEST_F(TestGroupBy, TestEncodedPrimitiveKeys) {
+  // Neither int32 nor int64, so the keys are encoded as byte strings
+  CheckPrimitiveKeys<Int16Type>(pool_.get());
+  CheckPrimitiveKeys<UInt64Type>(pool_.get());
+}
+
+TEST_F(TestGroupBy, TestStringKeys) {
+  typedef pair<bool, string> Key;
+  GroupBy group_by(pool_.get(), {TypePtr(new StringType())},
+      {TypePtr(new Int32Type())}, kAllAggregates);
+  ASSERT_OK(group_by.Init());
+
+  vector<Key> row_keys;
+  vector<int32_t> all_values;
+  vector<uint8_t> all_value_nulls;
+  for (size_t n : kBatchLengths) {
+    vector<int32_t> draws;
+    randint<int32_t>(n, 0, 200, draws);
+    vector<string> strings;
+    for (int32_t draw : draws) {
+      // Includes the empty string, which must not be confused with null
+      strings.push_back(string(draw % 7, 'a' + draw % 26));
+    }
+    vector<uint8_t> key_nulls;
+    random_nulls(n, 0.95, key_nulls);
+    vector<int32_t> values;
+    randint<int32_t>(n, -1000, 1000, values);
+    vector<uint8_t> value_nulls;
+    random_nulls(n, 0.8, value_nulls);
+
+    unique_ptr<StringArray> key_array = MakeStrings(strings, key_nulls);
+    unique_ptr<Array> value_array = MakeArray<Int32Type>(values,
+        &value_nulls);
+    ASSERT_OK(group_by.Consume({key_array.get()}, {value_array.get()}));
+
+    for (size_t i = 0; i < n; ++i) {
+      row_keys.push_back(key_nulls[i] ? Key(true, "") : Key(false,
+              strings[i]));
+    }
+    all_values.insert(all_values.end(), values.begin(), values.end());
+    all_value_nulls.insert(all_value_nulls.end(), value_nulls.begin(),
+        value_nulls.end());
+  }
+
+  vector<ArrayPtr> keys, aggregates;
+  ASSERT_OK(group_by.Finish(&keys, &aggregates));
+  const StringArray& key_array = static_cast<const StringArray&>(*keys[0]);
+  vector<Key> group_keys;
+  for (size_t g = 0; g < key_array.length(); ++g) {
+    group_keys.push_back(key_array.IsNull(g) ? Key(true, "") :
+        Key(false, key_array.GetString(g)));
+  }
+  CheckGroups(row_keys, all_values, all_value_nulls, group_keys, aggregates);
+}
+
+TEST_F(TestGroupBy, TestMultiColumnKeys) {
+  // (null flag, int32 key, null flag, string key)
+  typedef pair<pair<bool, int32_t>, pair<bool, string> > Key;
+  GroupBy group_by(pool_.get(),
+      {TypePtr(new Int32Type()), TypePtr(new StringType())},
+      {TypePtr(new Int32Type())}, kAllAggregates);
+  ASSERT_OK(group_by.Init());
+
+  vector<Key> row_keys;
+  vector<int32_t> all_values;
+  vector<uint8_t> all_value_nulls;
+  for (size_t n : kBatchLengths) {
+    vector<int32_t> ints;
+    randint<int32_t>(n, 0, 10, ints);
+    vector<int32_t> draws;
+    randint<int32_t>(n, 0, 50, draws);
+    vector<string> strings;
+    for (int32_t draw : draws) {
+      strings.push_back(string(draw % 5, 'a' + draw % 10));
+    }
+    vector<uint8_t> int_nulls;
+    random_nulls(n, 0.9, int_nulls);
+    vector<uint8_t> string_nulls;
+    random_nulls(n, 0.9, string_nulls);
+    vector<int32_t> values;
+    randint<int32_t>(n, -1000, 1000, values);
+    vector<uint8_t> value_nulls;
+    random_nulls(n, 0.8, value_nulls);
+
+    unique_ptr<Array> int_array = MakeArray<Int32Type>(ints, &int_nulls);
+    unique_ptr<StringArray> string_array = MakeStrings(strings,
+        string_nulls);
+    unique_ptr<Array> value_array = MakeArray<Int32Type>(values,
+        &value_nulls);
+    ASSERT_OK(group_by.Consume({int_array.get(), string_array.get()},
+            {value_array.get()}));
+
+    for (size_t i = 0; i < n; ++i) {
+      row_keys.push_back(Key(
+              int_nulls[i] ? pair<bool, int32_t>(true, 0) :
+              pair<bool, int32_t>(false, ints[i]),
+              string_nulls[i] ? pair<bool, string>(true, "") :
+              pair<bool, string>(false, strings[i])));
+    }
+    all_values.insert(all_values.end(), values.begin(), values.end());
+    all_value_nulls.insert(all_value_nulls.end(), value_nulls.begin(),
+        value_nulls.end());
+  }
+
+  vector<ArrayPtr> keys, aggregates;
+  ASSERT_OK(group_by.Finish(&keys, &aggregates));
+  ASSERT_EQ(2, keys.size());
+  const Int32Array& int_keys = static_cast<const Int32Array&>(*keys[0]);
+  const StringArray& string_keys = static_cast<const StringArray&>(*keys[1]);
+  vector<Key> group_keys;
+  for (size_t g = 0; g < int_keys.length(); ++g) {
+    group_keys.push_back(Key(
+            int_keys.IsNull(g) ? pair<bool, int32_t>(true, 0) :
+            pair<bool, int32_t>(false, int_keys.Value(g)),
+            string_keys.IsNull(g) ? pair<bool, string>(true, "") :
+            pair<bool, string>(false, string_keys.GetString(g))));
+  }
+  CheckGroups(row_keys, all_values, all_value_nulls, group_keys, aggregates);
+}
+
+TEST_F(TestGroupBy, TestFloatingValues) {
+  // NaN is ignored by MIN and MAX unless a group has nothing else
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  vector<int32_t> keys = {0, 1, 0, 1, 2, 0};
+  vector<double> values = {nan, nan, 2.5, nan, 1.0, -1.0};
+  vector<uint8_t> key_nulls, value_nulls;
+
+  GroupBy group_by(pool_.get(), {TypePtr(new Int32Type())},
+      {TypePtr(new DoubleType())}, kAllAggregates);
+  ASSERT_OK(group_by.Init());
+  unique_ptr<Array> key_array = MakeArray<Int32Type>(keys, &key_nulls);
+  unique_ptr<Array> value_array = MakeArray<DoubleType>(values,
+      &value_nulls);
+  ASSERT_OK(group_by.Consume({key_array.get()}, {value_array.get()}));
+
+  vector<ArrayPtr> out_keys, aggregates;
+  ASSERT_OK(group_by.Finish(&out_keys, &aggregates));
+  const DoubleArray& sums = static_cast<const DoubleArray&>(*aggregates[1]);
+  const DoubleArray& mins = static_cast<const DoubleArray&>(*aggregates[2]);
+  const DoubleArray& maxs = static_cast<const DoubleArray&>(*aggregates[3]);
+  ASSERT_EQ(3, sums.length());
+  ASSERT_TRUE(std::isnan(sums.Value(0)));
+  ASSERT_EQ(-1.0, mins.Value(0));
+  ASSERT_EQ(2.5, maxs.Value(0));
+  ASSERT_TRUE(std::isnan(mins.Value(1)));
+  ASSERT_TRUE(std::isnan(maxs.Value(1)));
+  ASSERT_EQ(1.0, sums.Value(2));
+  ASSERT_EQ(1.0, mins.Value(2));
+}
+
+TEST_F(TestGroupBy, TestSumOverflow) {
+  int64_t max = std::numeric_limits<int64_t>::max();
+  vector<int32_t> keys = {0, 1, 0};
+  vector<int64_t> values = {max, 1, 1};
+  vector<uint8_t> no_nulls;
+
+  GroupBy group_by(pool_.get(), {TypePtr(new Int32Type())},
+      {TypePtr(new Int64Type())}, {{AggregateFunction::SUM, 0}});
+  ASSERT_OK(group_by.Init());
+  unique_ptr<Array> key_array = MakeArray<Int32Type>(keys, &no_nulls);
+  unique_ptr<Array> value_array = MakeArray<Int64Type>(values, &no_nulls);
+  Status s = group_by.Consume({key_array.get()}, {value_array.get()});
+  ASSERT_TRUE(s.IsInvalid());
+}
+
+TEST_F(TestGroupBy, TestReuseAfterFinish) {
+  vector<int64_t> keys = {5, 6, 5};
+  vector<uint8_t> no_nulls;
+  unique_ptr<Array> key_array = MakeArray<Int64Type>(keys, &no_nulls);
+
+  GroupBy group_by(pool_.get(), {TypePtr(new Int64Type())},
+      {TypePtr(new Int64Type())}, {{AggregateFunction::COUNT, 0}});
+  ASSERT_OK(group_by.Init());
+
+  vector<ArrayPtr> out_keys, aggregates;
+  ASSERT_OK(group_by.Finish(&out_keys, &aggregates));
+  ASSERT_EQ(0, out_keys[0]->length());
+  ASSERT_EQ(0, aggregates[0]->length());
+
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_OK(group_by.Consume({key_array.get()}, {key_array.get()}));
+    ASSERT_EQ(2, group_by.num_groups());
+    ASSERT_OK(group_by.Finish(&out_keys, &aggregates));
+    const Int64Array& counts = static_cast<const Int64Array&>(*aggregates[0]);
+    ASSERT_EQ(2, counts.length());
+    ASSERT_EQ(2, counts.Value(0));
+    ASSERT_EQ(1, counts.Value(1));
+  }
+}
+
+TEST_F(TestGroupBy, TestInvalid) {
+  TypePtr int32(new Int32Type());
+  GroupBy no_keys(pool_.get(), {}, {int32}, {});
+  ASSERT_TRUE(no_keys.Init().IsInvalid());
+
+  GroupBy out_of_range(pool_.get(), {int32}, {int32},
+      {{AggregateFunction::SUM, 1}});
+  ASSERT_TRUE(out_of_range.Init().IsInvalid());
+
+  TypePtr list(new ListType(int32));
+  GroupBy list_keys(pool_.get(), {list}, {int32}, {});
+  ASSERT_TRUE(list_keys.Init().IsNotImplemented());
+
+  GroupBy string_sum(pool_.get(), {int32}, {TypePtr(new StringType())},
+      {{AggregateFunction::SUM, 0}});
+  ASSERT_TRUE(string_sum.Init().IsNotImplemented());
+
+  vector<int32_t> keys = {1, 2};
+  vector<uint8_t> no_nulls;
+  unique_ptr<Array> key_array = MakeArray<Int32Type>(keys, &no_nulls);
+  GroupBy group_by(pool_.get(), {int32}, {int32},
+      {{AggregateFunction::COUNT, 0}});
+  ASSERT_TRUE(group_by.Consume({key_array.get()},
+          {key_array.get()}).IsInvalid());
+  ASSERT_OK(group_by.Init());
+
+  // Wrong number of columns, and a value column of another type
+  ASSERT_TRUE(group_by.Consume({key_array.get()}, {}).IsInvalid());
+  vector<int64_t> wide = {1, 2};
+  unique_ptr<Array> wide_array = MakeArray<Int64Type>(wide, &no_nulls);
+  ASSERT_TRUE(group_by.Consume({key_array.get()},
+          {wide_array.get()}).IsInvalid());
+}
+
+} // namespace compute
+
+} // namespace arrow
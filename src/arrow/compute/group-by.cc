@@ -0,0 +1,373 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/group-by.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "arrow/builder.h"
+#include "arrow/compute/aggregate.h"
+#include "arrow/compute/group-table.h"
+#include "arrow/compute/kernel-util.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+static inline bool is_null(const uint8_t* null_bits, size_t i) {
+  return null_bits != nullptr && util::get_bit(null_bits, i);
+}
+
+template <typename TypeClass>
+const typename TypeClass::c_type* raw_values(const Array& values) {
+  return static_cast<const PrimitiveArrayImpl<TypeClass>&>(values).raw_data();
+}
+
+template <typename TypeClass>
+using BuilderFor = PrimitiveBuilder<TypeClass, PrimitiveArrayImpl<TypeClass> >;
+
+} // namespace
+
+// ----------------------------------------------------------------------
+// Accumulators
+
+// The state of one aggregate for every group
+class GroupAccumulator {
+ public:
+  virtual ~GroupAccumulator() {}
+
+  // Update the groups of the rows [offset, offset + length) of values;
+  // group_ids has one entry per row, all less than num_groups
+  virtual Status Consume(const Array& values, size_t offset, size_t length,
+      const int32_t* group_ids, size_t num_groups) = 0;
+
+  // Build an array with the aggregate of each of the first num_groups
+  // groups, then reset all groups
+  virtual Status Finish(MemoryPool* pool, size_t num_groups,
+      ArrayPtr* out) = 0;
+};
+
+namespace {
+
+template <typename TypeClass>
+Status finish_values(MemoryPool* pool, const TypePtr& type,
+    std::vector<typename TypeClass::c_type>* values, uint8_t* null_bytes,
+    ArrayPtr* out) {
+  BuilderFor<TypeClass> builder(pool, storage_type(type));
+  RETURN_NOT_OK(builder.Append(values->data(), values->size(), null_bytes));
+  Array* result;
+  RETURN_NOT_OK(builder.ToArray(&result));
+  out->reset(result);
+  if (is_temporal(type->type)) {
+    RETURN_NOT_OK(retype_primitive_array(type, *result, &result));
+    out->reset(result);
+  }
+  values->clear();
+  return Status::OK();
+}
+
+class CountAccumulator : public GroupAccumulator {
+ public:
+  virtual Status Consume(const Array& values, size_t offset, size_t length,
+      const int32_t* group_ids, size_t num_groups) {
+    counts_.resize(num_groups, 0);
+    const uint8_t* null_bits = values.null_bits();
+    if (null_bits == nullptr) {
+      for (size_t i = 0; i < length; ++i) {
+        ++counts_[group_ids[i]];
+      }
+    } else {
+      for (size_t i = 0; i < length; ++i) {
+        counts_[group_ids[i]] += !util::get_bit(null_bits, offset + i);
+      }
+    }
+    return Status::OK();
+  }
+
+  virtual Status Finish(MemoryPool* pool, size_t num_groups, ArrayPtr* out) {
+    counts_.resize(num_groups, 0);
+    return finish_values<Int64Type>(pool, TypePtr(new Int64Type(false)),
+        &counts_, nullptr, out);
+  }
+
+ private:
+  std::vector<int64_t> counts_;
+};
+
+// The type class of the array of sums of type Acc
+template <typename Acc> struct sum_type_class {};
+template <> struct sum_type_class<int64_t> { typedef Int64Type type;};
+template <> struct sum_type_class<uint64_t> { typedef UInt64Type type;};
+template <> struct sum_type_class<double> { typedef DoubleType type;};
+
+// Add value to *sum, returning true on overflow
+template <typename Acc>
+static inline bool add_overflows(Acc* sum, Acc value) {
+  return __builtin_add_overflow(*sum, value, sum);
+}
+
+static inline bool add_overflows(double* sum, double value) {
+  *sum += value;
+  return false;
+}
+
+template <typename TypeClass>
+class SumAccumulator : public GroupAccumulator {
+ public:
+  typedef typename TypeClass::c_type T;
+  typedef typename sum_type<TypeClass>::type Acc;
+
+  virtual Status Consume(const Array& values, size_t offset, size_t length,
+      const int32_t* group_ids, size_t num_groups) {
+    sums_.resize(num_groups, 0);
+    const T* data = raw_values<TypeClass>(values) + offset;
+    const uint8_t* null_bits = values.null_bits();
+    bool overflow = false;
+    for (size_t i = 0; i < length; ++i) {
+      if (!is_null(null_bits, offset + i)) {
+        overflow |= add_overflows(&sums_[group_ids[i]],
+            static_cast<Acc>(data[i]));
+      }
+    }
+    if (overflow) {
+      return Status::Invalid("integer sum overflows");
+    }
+    return Status::OK();
+  }
+
+  virtual Status Finish(MemoryPool* pool, size_t num_groups, ArrayPtr* out) {
+    typedef typename sum_type_class<Acc>::type OutType;
+    sums_.resize(num_groups, 0);
+    return finish_values<OutType>(pool, TypePtr(new OutType(false)), &sums_,
+        nullptr, out);
+  }
+
+ private:
+  std::vector<Acc> sums_;
+};
+
+// NaNs are ignored unless a group has nothing else, as in compute::Min
+template <typename TypeClass, bool kIsMin>
+class ExtremeAccumulator : public GroupAccumulator {
+ public:
+  typedef typename TypeClass::c_type T;
+
+  explicit ExtremeAccumulator(const TypePtr& type) :
+      type_(nullable_type(type)) {}
+
+  virtual Status Consume(const Array& values, size_t offset, size_t length,
+      const int32_t* group_ids, size_t num_groups) {
+    extremes_.resize(num_groups, 0);
+    seen_.resize(num_groups, 0);
+    const T* data = raw_values<TypeClass>(values) + offset;
+    const uint8_t* null_bits = values.null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      if (is_null(null_bits, offset + i)) continue;
+      int32_t group = group_ids[i];
+      T value = data[i];
+      T& extreme = extremes_[group];
+      if (!seen_[group] || (kIsMin ? value < extreme : value > extreme) ||
+          extreme != extreme) {
+        extreme = value;
+      }
+      seen_[group] = 1;
+    }
+    return Status::OK();
+  }
+
+  virtual Status Finish(MemoryPool* pool, size_t num_groups, ArrayPtr* out) {
+    extremes_.resize(num_groups, 0);
+    seen_.resize(num_groups, 0);
+    for (uint8_t& seen : seen_) {
+      seen = !seen;
+    }
+    RETURN_NOT_OK(finish_values<TypeClass>(pool, type_, &extremes_,
+            seen_.data(), out));
+    seen_.clear();
+    return Status::OK();
+  }
+
+ private:
+  TypePtr type_;
+  std::vector<T> extremes_;
+  std::vector<uint8_t> seen_;
+};
+
+struct MakeAccumulatorVisitor {
+  AggregateFunction function;
+  const TypePtr& type;
+  std::unique_ptr<GroupAccumulator>* out;
+
+  template <typename TypeClass>
+  Status Visit() {
+    switch (function) {
+      case AggregateFunction::SUM:
+        out->reset(new SumAccumulator<TypeClass>());
+        break;
+      case AggregateFunction::MIN:
+        out->reset(new ExtremeAccumulator<TypeClass, true>(type));
+        break;
+      case AggregateFunction::MAX:
+        out->reset(new ExtremeAccumulator<TypeClass, false>(type));
+        break;
+      default:
+        return Status::NotImplemented("aggregate function");
+    }
+    return Status::OK();
+  }
+};
+
+Status make_accumulator(AggregateFunction function, const TypePtr& type,
+    std::unique_ptr<GroupAccumulator>* out) {
+  if (function == AggregateFunction::COUNT) {
+    out->reset(new CountAccumulator());
+    return Status::OK();
+  }
+  // Sums of dates or times have no meaning
+  if (function == AggregateFunction::SUM && is_temporal(type->type)) {
+    return Status::NotImplemented(type->ToString());
+  }
+  MakeAccumulatorVisitor visitor = {function, type, out};
+  Status s = visit_primitive(type->type, &visitor);
+  if (!s.ok()) {
+    return Status::NotImplemented(type->ToString());
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------
+// GroupBy
+
+GroupBy::GroupBy(MemoryPool* pool, const std::vector<TypePtr>& key_types,
+    const std::vector<TypePtr>& value_types,
+    const std::vector<Aggregate>& aggregates) :
+    pool_(pool),
+    key_types_(key_types),
+    value_types_(value_types),
+    aggregates_(aggregates) {}
+
+GroupBy::~GroupBy() {}
+
+Status GroupBy::Init() {
+  RETURN_NOT_OK(make_group_table(key_types_, &table_));
+
+  accumulators_.clear();
+  for (const Aggregate& aggregate : aggregates_) {
+    if (aggregate.column >= value_types_.size()) {
+      return Status::Invalid("aggregated column out of range");
+    }
+    std::unique_ptr<GroupAccumulator> accumulator;
+    RETURN_NOT_OK(make_accumulator(aggregate.function,
+            value_types_[aggregate.column], &accumulator));
+    accumulators_.push_back(std::move(accumulator));
+  }
+
+  hashes_.resize(kGroupByBatchSize);
+  group_ids_.resize(kGroupByBatchSize);
+  return Status::OK();
+}
+
+Status GroupBy::Consume(const std::vector<Array*>& keys,
+    const std::vector<Array*>& values) {
+  if (!table_) {
+    return Status::Invalid("GroupBy is not initialized");
+  }
+  if (keys.size() != key_types_.size() ||
+      values.size() != value_types_.size()) {
+    return Status::Invalid("wrong number of columns");
+  }
+  size_t length = keys[0]->length();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i]->length() != length ||
+        keys[i]->type_enum() != key_types_[i]->type) {
+      return Status::Invalid("key column does not match the key type");
+    }
+    if (!key_types_[i]->nullable && keys[i]->null_bits() != nullptr &&
+        util::count_set_bits(keys[i]->null_bits(), 0, length) > 0) {
+      return Status::Invalid("null key for a non-nullable key type");
+    }
+  }
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i]->length() != length ||
+        values[i]->type_enum() != value_types_[i]->type) {
+      return Status::Invalid("value column does not match the value type");
+    }
+  }
+
+  for (size_t offset = 0; offset < length; offset += kGroupByBatchSize) {
+    size_t n = std::min(kGroupByBatchSize, length - offset);
+    table_->Hash(keys, offset, n, hashes_.data());
+    table_->Probe(keys, offset, n, hashes_.data(), group_ids_.data());
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+      RETURN_NOT_OK(accumulators_[i]->Consume(*values[aggregates_[i].column],
+              offset, n, group_ids_.data(), table_->num_groups()));
+    }
+  }
+  return Status::OK();
+}
+
+size_t GroupBy::num_groups() const {
+  return table_ ? table_->num_groups() : 0;
+}
+
+Status GroupBy::Finish(std::vector<ArrayPtr>* keys,
+    std::vector<ArrayPtr>* aggregates) {
+  if (!table_) {
+    return Status::Invalid("GroupBy is not initialized");
+  }
+
+  std::vector<std::unique_ptr<ArrayBuilder> > builders;
+  std::vector<ArrayBuilder*> raw_builders;
+  // Temporal keys are built as their storage type, which is what the group
+  // table appends, and given back their type below
+  for (const TypePtr& type : key_types_) {
+    ArrayBuilder* builder;
+    RETURN_NOT_OK(make_builder(pool_, storage_type(type), &builder));
+    builders.emplace_back(builder);
+    raw_builders.push_back(builder);
+  }
+
+  size_t num_groups = table_->num_groups();
+  RETURN_NOT_OK(table_->Finish(raw_builders));
+
+  keys->clear();
+  for (size_t i = 0; i < builders.size(); ++i) {
+    Array* key;
+    RETURN_NOT_OK(builders[i]->ToArray(&key));
+    keys->push_back(ArrayPtr(key));
+    if (is_temporal(key_types_[i]->type)) {
+      RETURN_NOT_OK(retype_primitive_array(key_types_[i], *key, &key));
+      keys->back().reset(key);
+    }
+  }
+
+  aggregates->clear();
+  for (auto& accumulator : accumulators_) {
+    ArrayPtr result;
+    RETURN_NOT_OK(accumulator->Finish(pool_, num_groups, &result));
+    aggregates->push_back(result);
+  }
+  return Status::OK();
+}
+
+} // namespace compute
+
+} // namespace arrow
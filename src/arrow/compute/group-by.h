@@ -0,0 +1,135 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_GROUP_BY_H
+#define ARROW_COMPUTE_GROUP_BY_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types.h"
+#include "arrow/util/macros.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+enum class AggregateFunction {
+  // Number of non-null values, as int64
+  COUNT,
+
+  // Sum of the non-null values, widened as in compute/aggregate.h. Integer
+  // sums that overflow are an error
+  SUM,
+
+  // Smallest / largest non-null value, null for groups without one
+  MIN,
+  MAX
+};
+
+struct Aggregate {
+  AggregateFunction function;
+
+  // Index of the aggregated column among the value columns
+  size_t column;
+};
+
+class GroupTable;
+class GroupAccumulator;
+
+// Number of rows hashed, probed and aggregated per pass
+static constexpr size_t kGroupByBatchSize = 1024;
+
+// Hash aggregation: groups rows by the values of one or more key columns
+// and computes aggregates of the value columns per group, i.e.
+//
+//   SELECT keys..., AGG(values[column])... GROUP BY keys...
+//
+// The input may arrive as any number of batches, each a set of key and value
+// columns of the same length; groups are numbered in order of first
+// appearance across batches, and Finish returns one row per group in that
+// order. A null key is a key like any other, so all the rows whose key is
+// null form one group.
+//
+// Batches are processed kGroupByBatchSize rows at a time in three passes:
+// the keys of all the rows are hashed, then the hash table is probed for the
+// group id of each row, then each aggregate is updated from the group ids.
+// The probe pass prefetches the slots of the rows ahead of it. Single int32,
+// int64 and string keys use hash tables specialized for them, which store
+// the keys inline in the slots; dates, timestamps and times share them as
+// their storage. Any other key (several columns, or a single column of
+// another primitive type) is encoded into a byte string per row
+//
+// Usage:
+//
+//   GroupBy group_by(pool, {key_type}, {value_type},
+//       {{AggregateFunction::SUM, 0}});
+//   RETURN_NOT_OK(group_by.Init());
+//   for (...) {
+//     RETURN_NOT_OK(group_by.Consume({keys}, {values}));
+//   }
+//   RETURN_NOT_OK(group_by.Finish(&keys, &sums));
+class GroupBy {
+ public:
+  GroupBy(MemoryPool* pool, const std::vector<TypePtr>& key_types,
+      const std::vector<TypePtr>& value_types,
+      const std::vector<Aggregate>& aggregates);
+
+  ~GroupBy();
+
+  // Returns NotImplemented for key or value types that are not supported:
+  // keys may be primitive, temporal or strings, and the aggregated values
+  // primitive (COUNT accepts any type; MIN and MAX also temporal values)
+  Status Init();
+
+  // Add a batch of rows. The columns must match the types given to the
+  // constructor and all have the same length. After an error, such as an
+  // integer sum overflowing, the aggregates are no longer meaningful
+  Status Consume(const std::vector<Array*>& keys,
+      const std::vector<Array*>& values);
+
+  // Number of distinct keys so far
+  size_t num_groups() const;
+
+  // Build one array per key column and one per aggregate, each with a slot
+  // per group, and reset to no groups. Key arrays have the key types, so a
+  // null key requires a nullable key type
+  Status Finish(std::vector<ArrayPtr>* keys,
+      std::vector<ArrayPtr>* aggregates);
+
+ private:
+  MemoryPool* pool_;
+  std::vector<TypePtr> key_types_;
+  std::vector<TypePtr> value_types_;
+  std::vector<Aggregate> aggregates_;
+
+  std::unique_ptr<GroupTable> table_;
+  std::vector<std::unique_ptr<GroupAccumulator> > accumulators_;
+
+  // Scratch space for one batch
+  std::vector<uint64_t> hashes_;
+  std::vector<int32_t> group_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(GroupBy);
+};
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_GROUP_BY_H
@@ -0,0 +1,513 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/group-table.h"
+
+#include <cstring>
+
+#include "arrow/compute/kernel-util.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/hash-util.h"
+#include "arrow/util/string-hash-table.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+// While probing, the slots of the rows this far ahead are prefetched
+static constexpr size_t kPrefetchDistance = 16;
+
+static inline bool is_null(const uint8_t* null_bits, size_t i) {
+  return null_bits != nullptr && util::get_bit(null_bits, i);
+}
+
+template <typename TypeClass>
+const typename TypeClass::c_type* raw_values(const Array& values) {
+  return static_cast<const PrimitiveArrayImpl<TypeClass>&>(values).raw_data();
+}
+
+template <typename TypeClass>
+using BuilderFor = PrimitiveBuilder<TypeClass, PrimitiveArrayImpl<TypeClass> >;
+
+template <typename TypeClass>
+class IntegerGroupTable : public GroupTable {
+ public:
+  typedef typename TypeClass::c_type T;
+
+  IntegerGroupTable() {
+    Reset();
+  }
+
+  virtual void Hash(const std::vector<Array*>& keys, size_t offset,
+      size_t length, uint64_t* hashes) {
+    const T* data = raw_values<TypeClass>(*keys[0]) + offset;
+    for (size_t i = 0; i < length; ++i) {
+      hashes[i] = util::hash_word(util::kHashSeed,
+          static_cast<uint64_t>(data[i]));
+    }
+  }
+
+  virtual void Probe(const std::vector<Array*>& keys, size_t offset,
+      size_t length, const uint64_t* hashes, int32_t* group_ids) {
+    const T* data = raw_values<TypeClass>(*keys[0]);
+    const uint8_t* null_bits = keys[0]->null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      if (i + kPrefetchDistance < length) {
+        __builtin_prefetch(slots_.data() +
+            (hashes[i + kPrefetchDistance] & mask_));
+      }
+      if (is_null(null_bits, offset + i)) {
+        if (null_group_ == kNoGroup) {
+          null_group_ = AddGroup(0);
+        }
+        group_ids[i] = null_group_;
+      } else {
+        group_ids[i] = GetOrInsert(hashes[i], data[offset + i]);
+      }
+    }
+  }
+
+  virtual void Find(const std::vector<Array*>& keys, size_t offset,
+      size_t length, const uint64_t* hashes, int32_t* group_ids) {
+    const T* data = raw_values<TypeClass>(*keys[0]);
+    const uint8_t* null_bits = keys[0]->null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      if (i + kPrefetchDistance < length) {
+        __builtin_prefetch(slots_.data() +
+            (hashes[i + kPrefetchDistance] & mask_));
+      }
+      group_ids[i] = is_null(null_bits, offset + i) ? null_group_ :
+        slots_[FindSlot(hashes[i], data[offset + i])].group;
+    }
+  }
+
+  virtual size_t num_groups() const { return keys_.size();}
+
+  virtual Status Finish(const std::vector<ArrayBuilder*>& builders) {
+    BuilderFor<TypeClass>* builder = static_cast<BuilderFor<TypeClass>*>(
+        builders[0]);
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      RETURN_NOT_OK(builder->Append(keys_[i],
+              static_cast<int32_t>(i) == null_group_));
+    }
+    Reset();
+    return Status::OK();
+  }
+
+ private:
+  struct Slot {
+    T key;
+    int32_t group;
+  };
+
+  void Reset() {
+    slots_.assign(64, Slot{0, kNoGroup});
+    mask_ = slots_.size() - 1;
+    keys_.clear();
+    num_slots_used_ = 0;
+    null_group_ = kNoGroup;
+  }
+
+  int32_t AddGroup(T key) {
+    keys_.push_back(key);
+    return static_cast<int32_t>(keys_.size() - 1);
+  }
+
+  // The slot holding the key, or the empty slot where it would go
+  size_t FindSlot(uint64_t hash, T key) const {
+    size_t pos = hash & mask_;
+    while (slots_[pos].group != kNoGroup && slots_[pos].key != key) {
+      pos = (pos + 1) & mask_;
+    }
+    return pos;
+  }
+
+  int32_t GetOrInsert(uint64_t hash, T key) {
+    size_t pos = FindSlot(hash, key);
+    if (slots_[pos].group != kNoGroup) {
+      return slots_[pos].group;
+    }
+    int32_t group = AddGroup(key);
+    slots_[pos].key = key;
+    slots_[pos].group = group;
+    if (++num_slots_used_ * 2 > slots_.size()) {
+      Grow();
+    }
+    return group;
+  }
+
+  void Grow() {
+    std::vector<Slot> old_slots(slots_.size() * 2, Slot{0, kNoGroup});
+    old_slots.swap(slots_);
+    mask_ = slots_.size() - 1;
+    for (const Slot& slot : old_slots) {
+      if (slot.group == kNoGroup) continue;
+      size_t pos = util::hash_word(util::kHashSeed,
+          static_cast<uint64_t>(slot.key)) & mask_;
+      while (slots_[pos].group != kNoGroup) {
+        pos = (pos + 1) & mask_;
+      }
+      slots_[pos] = slot;
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t mask_;
+  size_t num_slots_used_;
+
+  // The key of each group
+  std::vector<T> keys_;
+  int32_t null_group_;
+};
+
+// A single string key column, interned in a StringHashTable. The null group
+// is not in the table, so the string ids from the table are shifted past it
+class StringGroupTable : public GroupTable {
+ public:
+  StringGroupTable() : null_group_(kNoGroup) {}
+
+  virtual void Hash(const std::vector<Array*>& keys, size_t offset,
+      size_t length, uint64_t* hashes) {
+    const StringArray& strings = static_cast<const StringArray&>(*keys[0]);
+    const int32_t* offsets = strings.offsets();
+    const uint8_t* bytes = raw_values<UInt8Type>(*strings.values());
+    const uint8_t* null_bits = strings.null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      size_t row = offset + i;
+      hashes[i] = is_null(null_bits, row) ? 0 :
+        util::hash_bytes(util::kHashSeed, bytes + offsets[row],
+            offsets[row + 1] - offsets[row]);
+    }
+  }
+
+  virtual void Probe(const std::vector<Array*>& keys, size_t offset,
+      size_t length, const uint64_t* hashes, int32_t* group_ids) {
+    const StringArray& strings = static_cast<const StringArray&>(*keys[0]);
+    const int32_t* offsets = strings.offsets();
+    const uint8_t* bytes = raw_values<UInt8Type>(*strings.values());
+    const uint8_t* null_bits = strings.null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      if (i + kPrefetchDistance < length) {
+        table_.Prefetch(hashes[i + kPrefetchDistance]);
+      }
+      size_t row = offset + i;
+      if (is_null(null_bits, row)) {
+        if (null_group_ == kNoGroup) {
+          null_group_ = static_cast<int32_t>(num_groups());
+        }
+        group_ids[i] = null_group_;
+        continue;
+      }
+      int32_t id = table_.GetOrInsert(hashes[i], bytes + offsets[row],
+          offsets[row + 1] - offsets[row]);
+      group_ids[i] = GroupOf(id);
+    }
+  }
+
+  virtual void Find(const std::vector<Array*>& keys, size_t offset,
+      size_t length, const uint64_t* hashes, int32_t* group_ids) {
+    const StringArray& strings = static_cast<const StringArray&>(*keys[0]);
+    const int32_t* offsets = strings.offsets();
+    const uint8_t* bytes = raw_values<UInt8Type>(*strings.values());
+    const uint8_t* null_bits = strings.null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      if (i + kPrefetchDistance < length) {
+        table_.Prefetch(hashes[i + kPrefetchDistance]);
+      }
+      size_t row = offset + i;
+      if (is_null(null_bits, row)) {
+        group_ids[i] = null_group_;
+        continue;
+      }
+      int32_t id = table_.Get(hashes[i], bytes + offsets[row],
+          offsets[row + 1] - offsets[row]);
+      group_ids[i] = id == util::StringHashTable::kNotFound ? kNoGroup :
+        GroupOf(id);
+    }
+  }
+
+  virtual size_t num_groups() const {
+    return table_.size() + (null_group_ != kNoGroup);
+  }
+
+  virtual Status Finish(const std::vector<ArrayBuilder*>& builders) {
+    StringBuilder* builder = static_cast<StringBuilder*>(builders[0]);
+    const std::vector<int32_t>& offsets = table_.offsets();
+    const uint8_t* bytes = table_.bytes().data();
+    for (int32_t group = 0; group < static_cast<int32_t>(num_groups());
+         ++group) {
+      if (group == null_group_) {
+        RETURN_NOT_OK(builder->AppendNull());
+        continue;
+      }
+      int32_t id = group - (null_group_ != kNoGroup && group > null_group_);
+      RETURN_NOT_OK(builder->Append(bytes + offsets[id],
+              offsets[id + 1] - offsets[id]));
+    }
+    table_.Clear();
+    null_group_ = kNoGroup;
+    return Status::OK();
+  }
+
+ private:
+  int32_t GroupOf(int32_t id) const {
+    return id + (null_group_ != kNoGroup && id >= null_group_);
+  }
+
+  util::StringHashTable table_;
+  int32_t null_group_;
+};
+
+// Encodes the value of one key column in each row into the byte string
+// key of the row. Every encoding starts with a byte that is 1 for null
+class KeyEncoder {
+ public:
+  virtual ~KeyEncoder() {}
+
+  // Add the encoded size of each of the rows [offset, offset + length) to
+  // lengths
+  virtual void AddLengths(const Array& keys, size_t offset, size_t length,
+      int32_t* lengths) = 0;
+
+  // Encode each row at out + positions[i], advancing the positions
+  virtual void Encode(const Array& keys, size_t offset, size_t length,
+      uint8_t* out, int32_t* positions) = 0;
+
+  // Decode the key at *pos into builder, advancing *pos past it
+  virtual Status Decode(const uint8_t** pos, ArrayBuilder* builder) = 0;
+};
+
+// The bytes of the value; null values are encoded as zeros so that all
+// nulls compare equal
+template <typename TypeClass>
+class PrimitiveKeyEncoder : public KeyEncoder {
+ public:
+  typedef typename TypeClass::c_type T;
+
+  virtual void AddLengths(const Array& keys, size_t offset, size_t length,
+      int32_t* lengths) {
+    for (size_t i = 0; i < length; ++i) {
+      lengths[i] += 1 + sizeof(T);
+    }
+  }
+
+  virtual void Encode(const Array& keys, size_t offset, size_t length,
+      uint8_t* out, int32_t* positions) {
+    const T* data = raw_values<TypeClass>(keys);
+    const uint8_t* null_bits = keys.null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      uint8_t* pos = out + positions[i];
+      bool null = is_null(null_bits, offset + i);
+      T value = null ? 0 : data[offset + i];
+      pos[0] = null;
+      memcpy(pos + 1, &value, sizeof(T));
+      positions[i] += 1 + sizeof(T);
+    }
+  }
+
+  virtual Status Decode(const uint8_t** pos, ArrayBuilder* builder) {
+    T value;
+    memcpy(&value, *pos + 1, sizeof(T));
+    bool null = (*pos)[0];
+    *pos += 1 + sizeof(T);
+    return static_cast<BuilderFor<TypeClass>*>(builder)->Append(value, null);
+  }
+};
+
+// The int32 length of the string followed by its bytes
+class StringKeyEncoder : public KeyEncoder {
+ public:
+  virtual void AddLengths(const Array& keys, size_t offset, size_t length,
+      int32_t* lengths) {
+    const int32_t* offsets = static_cast<const StringArray&>(keys).offsets();
+    const uint8_t* null_bits = keys.null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      size_t row = offset + i;
+      lengths[i] += 1 + sizeof(int32_t) + (is_null(null_bits, row) ? 0 :
+          offsets[row + 1] - offsets[row]);
+    }
+  }
+
+  virtual void Encode(const Array& keys, size_t offset, size_t length,
+      uint8_t* out, int32_t* positions) {
+    const StringArray& strings = static_cast<const StringArray&>(keys);
+    const int32_t* offsets = strings.offsets();
+    const uint8_t* bytes = raw_values<UInt8Type>(*strings.values());
+    const uint8_t* null_bits = strings.null_bits();
+    for (size_t i = 0; i < length; ++i) {
+      size_t row = offset + i;
+      uint8_t* pos = out + positions[i];
+      bool null = is_null(null_bits, row);
+      int32_t value_length = null ? 0 : offsets[row + 1] - offsets[row];
+      pos[0] = null;
+      memcpy(pos + 1, &value_length, sizeof(int32_t));
+      if (value_length > 0) {
+        memcpy(pos + 1 + sizeof(int32_t), bytes + offsets[row], value_length);
+      }
+      positions[i] += 1 + sizeof(int32_t) + value_length;
+    }
+  }
+
+  virtual Status Decode(const uint8_t** pos, ArrayBuilder* builder) {
+    int32_t value_length;
+    memcpy(&value_length, *pos + 1, sizeof(int32_t));
+    bool null = (*pos)[0];
+    const uint8_t* value = *pos + 1 + sizeof(int32_t);
+    *pos = value + value_length;
+    StringBuilder* strings = static_cast<StringBuilder*>(builder);
+    return null ? strings->AppendNull() : strings->Append(value, value_length);
+  }
+};
+
+struct MakeKeyEncoderVisitor {
+  std::unique_ptr<KeyEncoder>* out;
+
+  template <typename TypeClass>
+  Status Visit() {
+    out->reset(new PrimitiveKeyEncoder<TypeClass>());
+    return Status::OK();
+  }
+};
+
+// Any number of key columns of any supported type. The keys of each row are
+// encoded into one byte string, which is interned in a StringHashTable
+class EncodedGroupTable : public GroupTable {
+ public:
+  explicit EncodedGroupTable(
+      std::vector<std::unique_ptr<KeyEncoder> >* encoders) :
+      encoders_(std::move(*encoders)) {}
+
+  // Encodes the rows into rows_, then hashes them
+  virtual void Hash(const std::vector<Array*>& keys, size_t offset,
+      size_t length, uint64_t* hashes) {
+    row_offsets_.assign(length + 1, 0);
+    for (size_t i = 0; i < encoders_.size(); ++i) {
+      encoders_[i]->AddLengths(*keys[i], offset, length,
+          row_offsets_.data() + 1);
+    }
+    for (size_t i = 0; i < length; ++i) {
+      row_offsets_[i + 1] += row_offsets_[i];
+    }
+
+    rows_.resize(row_offsets_[length]);
+    positions_.assign(row_offsets_.begin(), row_offsets_.end() - 1);
+    for (size_t i = 0; i < encoders_.size(); ++i) {
+      encoders_[i]->Encode(*keys[i], offset, length, rows_.data(),
+          positions_.data());
+    }
+
+    for (size_t i = 0; i < length; ++i) {
+      hashes[i] = util::hash_bytes(util::kHashSeed, row(i), row_length(i));
+    }
+  }
+
+  virtual void Probe(const std::vector<Array*>& keys, size_t offset,
+      size_t length, const uint64_t* hashes, int32_t* group_ids) {
+    for (size_t i = 0; i < length; ++i) {
+      if (i + kPrefetchDistance < length) {
+        table_.Prefetch(hashes[i + kPrefetchDistance]);
+      }
+      group_ids[i] = table_.GetOrInsert(hashes[i], row(i), row_length(i));
+    }
+  }
+
+  virtual void Find(const std::vector<Array*>& keys, size_t offset,
+      size_t length, const uint64_t* hashes, int32_t* group_ids) {
+    for (size_t i = 0; i < length; ++i) {
+      if (i + kPrefetchDistance < length) {
+        table_.Prefetch(hashes[i + kPrefetchDistance]);
+      }
+      int32_t id = table_.Get(hashes[i], row(i), row_length(i));
+      group_ids[i] = id == util::StringHashTable::kNotFound ? kNoGroup : id;
+    }
+  }
+
+  virtual size_t num_groups() const { return table_.size();}
+
+  virtual Status Finish(const std::vector<ArrayBuilder*>& builders) {
+    const std::vector<int32_t>& offsets = table_.offsets();
+    for (size_t group = 0; group < table_.size(); ++group) {
+      const uint8_t* pos = table_.bytes().data() + offsets[group];
+      for (size_t i = 0; i < encoders_.size(); ++i) {
+        RETURN_NOT_OK(encoders_[i]->Decode(&pos, builders[i]));
+      }
+    }
+    table_.Clear();
+    return Status::OK();
+  }
+
+ private:
+  const uint8_t* row(size_t i) const { return rows_.data() + row_offsets_[i];}
+  size_t row_length(size_t i) const {
+    return row_offsets_[i + 1] - row_offsets_[i];
+  }
+
+  std::vector<std::unique_ptr<KeyEncoder> > encoders_;
+  util::StringHashTable table_;
+
+  // The encoded rows of the current batch
+  std::vector<uint8_t> rows_;
+  std::vector<int32_t> row_offsets_;
+  std::vector<int32_t> positions_;
+};
+
+} // namespace
+
+Status make_group_table(const std::vector<TypePtr>& key_types,
+    std::unique_ptr<GroupTable>* out) {
+  if (key_types.empty()) {
+    return Status::Invalid("no key columns");
+  }
+  if (key_types.size() == 1) {
+    switch (key_types[0]->type) {
+      case TypeEnum::INT32:
+      case TypeEnum::DATE:
+        out->reset(new IntegerGroupTable<Int32Type>());
+        return Status::OK();
+      case TypeEnum::INT64:
+      case TypeEnum::TIMESTAMP:
+      case TypeEnum::TIME:
+        out->reset(new IntegerGroupTable<Int64Type>());
+        return Status::OK();
+      case TypeEnum::STRING:
+        out->reset(new StringGroupTable());
+        return Status::OK();
+      default:
+        break;
+    }
+  }
+
+  std::vector<std::unique_ptr<KeyEncoder> > encoders(key_types.size());
+  for (size_t i = 0; i < key_types.size(); ++i) {
+    TypeEnum type = key_types[i]->type;
+    if (type == TypeEnum::STRING) {
+      encoders[i].reset(new StringKeyEncoder());
+    } else if (is_primitive(type) && type != TypeEnum::BOOL) {
+      MakeKeyEncoderVisitor visitor = {&encoders[i]};
+      RETURN_NOT_OK(visit_primitive(type, &visitor));
+    } else {
+      return Status::NotImplemented(key_types[i]->ToString());
+    }
+  }
+  out->reset(new EncodedGroupTable(&encoders));
+  return Status::OK();
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,76 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Hash tables mapping keys to dense group ids, shared by the hash-based
+// kernels (group-by, join). Not part of the public API
+
+#ifndef ARROW_COMPUTE_GROUP_TABLE_H
+#define ARROW_COMPUTE_GROUP_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/types.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr int32_t kNoGroup = -1;
+
+// Maps keys to group ids, which are numbered from 0 in order of first
+// appearance. Keys are looked up a batch of rows at a time: the rows are
+// hashed first, then the table is probed with the hashes. A null key is a
+// key like any other
+class GroupTable {
+ public:
+  virtual ~GroupTable() {}
+
+  // Hash the keys of the rows [offset, offset + length)
+  virtual void Hash(const std::vector<Array*>& keys, size_t offset,
+      size_t length, uint64_t* hashes) = 0;
+
+  // Look up the group id of each row hashed by the last call to Hash,
+  // adding a group for each new key
+  virtual void Probe(const std::vector<Array*>& keys, size_t offset,
+      size_t length, const uint64_t* hashes, int32_t* group_ids) = 0;
+
+  // As Probe, but without adding groups: the group id of a new key is
+  // kNoGroup
+  virtual void Find(const std::vector<Array*>& keys, size_t offset,
+      size_t length, const uint64_t* hashes, int32_t* group_ids) = 0;
+
+  virtual size_t num_groups() const = 0;
+
+  // Append the key of each group, in group order, to the builders of the
+  // key columns, then remove all groups
+  virtual Status Finish(const std::vector<ArrayBuilder*>& builders) = 0;
+};
+
+// A table for keys of the given types. Single int32, int64 and string keys
+// get tables specialized for them; any other keys are encoded into a byte
+// string per row. Returns NotImplemented for key types other than primitive
+// (except boolean) and string
+Status make_group_table(const std::vector<TypePtr>& key_types,
+    std::unique_ptr<GroupTable>* out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_GROUP_TABLE_H
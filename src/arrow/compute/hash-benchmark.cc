@@ -0,0 +1,103 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/hash.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/string.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/hash-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+static void BenchmarkHash(MemoryPool* pool, const std::vector<Array*>& columns,
+    const std::string& label, size_t bytes) {
+  std::string name = "Hash/" + label;
+  benchmark::run(name.c_str(), bytes, [&]() {
+        Array* out;
+        BENCHMARK_OK(Hash(pool, columns, &out));
+        delete out;
+      });
+}
+
+// Raw CRC32C throughput of the instruction and of the fallback
+static void BenchmarkCrc32c() {
+  std::vector<uint8_t> data(kNumValues * 8, 0x5A);
+  uint32_t crc = 0;
+  if (util::kHardwareCrc32c) {
+    benchmark::run("crc32c/sse4.2", data.size(), [&]() {
+          crc = util::crc32c(crc, data.data(), data.size());
+          benchmark::do_not_optimize(crc);
+        });
+  }
+  benchmark::run("crc32c/portable", data.size(), [&]() {
+        crc = util::crc32c_portable(crc, data.data(), data.size());
+        benchmark::do_not_optimize(crc);
+      });
+}
+
+static void BenchmarkColumns(MemoryPool* pool) {
+  Random rng(random_seed());
+  std::vector<int64_t> int64_values(kNumValues);
+  std::vector<int32_t> int32_values(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    int64_values[i] = static_cast<int64_t>(rng.Next64());
+    int32_values[i] = static_cast<int32_t>(rng.Next());
+  }
+  Int64Array int64_array(kNumValues,
+      benchmark::make_buffer(pool, int64_values));
+  Int32Array int32_array(kNumValues,
+      benchmark::make_buffer(pool, int32_values));
+
+  // Strings of 0 to 31 bytes
+  std::vector<int32_t> offsets(kNumValues + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < kNumValues; ++i) {
+    offsets[i + 1] = offsets[i] + static_cast<int32_t>(i % 32);
+  }
+  std::vector<uint8_t> chars(offsets[kNumValues], 'x');
+  ArrayPtr bytes(new UInt8Array(chars.size(),
+          benchmark::make_buffer(pool, chars)));
+  StringArray string_array(kNumValues, benchmark::make_buffer(pool, offsets),
+      bytes);
+
+  BenchmarkHash(pool, {&int64_array}, "int64", kNumValues * 8);
+  BenchmarkHash(pool, {&int32_array}, "int32", kNumValues * 4);
+  BenchmarkHash(pool, {&string_array}, "string",
+      chars.size() + kNumValues * 4);
+  BenchmarkHash(pool, {&int64_array, &int32_array, &string_array},
+      "int64+int32+string", chars.size() + kNumValues * 16);
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkCrc32c();
+  arrow::compute::BenchmarkColumns(&pool);
+  return 0;
+}
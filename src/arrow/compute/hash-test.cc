@@ -0,0 +1,184 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/hash.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestHash : public TestBase {
+ public:
+  unique_ptr<UInt64Array> DoHash(const vector<Array*>& columns) {
+    Array* out;
+    EXPECT_OK(Hash(pool_.get(), columns, &out));
+    EXPECT_EQ(columns[0]->length(), out->length());
+    return unique_ptr<UInt64Array>(static_cast<UInt64Array*>(out));
+  }
+
+  unique_ptr<Array> MakeStrings(const vector<string>& strings,
+      const vector<uint8_t>& is_null = {}) {
+    StringBuilder builder(pool_.get(), TypePtr(new StringType()));
+    for (size_t i = 0; i < strings.size(); ++i) {
+      if (!is_null.empty() && is_null[i]) {
+        EXPECT_OK(builder.AppendNull());
+      } else {
+        EXPECT_OK(builder.Append(strings[i]));
+      }
+    }
+    Array* out;
+    EXPECT_OK(builder.ToArray(&out));
+    return unique_ptr<Array>(out);
+  }
+};
+
+
+TEST_F(TestHash, TestPrimitive) {
+  vector<int64_t> values = {1, 2, 1, 1000000, 2, 0};
+  vector<uint8_t> nulls = {0, 0, 0, 0, 0, 1};
+  Int64Array array(values.size(), to_buffer(values),
+      bytes_to_null_buffer(nulls.data(), nulls.size()));
+
+  auto hashes = DoHash({&array});
+  ASSERT_FALSE(hashes->nullable());
+  ASSERT_EQ(hashes->Value(0), hashes->Value(2));
+  ASSERT_EQ(hashes->Value(1), hashes->Value(4));
+  ASSERT_NE(hashes->Value(0), hashes->Value(1));
+  ASSERT_NE(hashes->Value(0), hashes->Value(3));
+  ASSERT_NE(hashes->Value(5), hashes->Value(0));
+}
+
+
+TEST_F(TestHash, TestNullsIgnoreValues) {
+  vector<int32_t> values1 = {5, 6};
+  vector<int32_t> values2 = {7, 6};
+  vector<uint8_t> nulls = {1, 0};
+  Int32Array array1(2, to_buffer(values1), bytes_to_null_buffer(nulls.data(), 2));
+  Int32Array array2(2, to_buffer(values2), bytes_to_null_buffer(nulls.data(), 2));
+
+  auto hashes1 = DoHash({&array1});
+  auto hashes2 = DoHash({&array2});
+  ASSERT_EQ(hashes1->Value(0), hashes2->Value(0));
+  ASSERT_EQ(hashes1->Value(1), hashes2->Value(1));
+
+  // The data underneath a null string is also ignored
+  auto strings1 = MakeStrings({"", "x"}, {1, 0});
+  auto strings2 = MakeStrings({"abc", "x"}, {1, 0});
+  ASSERT_EQ(DoHash({strings1.get()})->Value(0),
+      DoHash({strings2.get()})->Value(0));
+}
+
+
+TEST_F(TestHash, TestDouble) {
+  vector<double> values = {0.5, 1.5, 0.5, -0.5};
+  DoubleArray array(values.size(), to_buffer(values));
+
+  auto hashes = DoHash({&array});
+  ASSERT_EQ(hashes->Value(0), hashes->Value(2));
+  ASSERT_NE(hashes->Value(0), hashes->Value(1));
+  ASSERT_NE(hashes->Value(0), hashes->Value(3));
+}
+
+
+TEST_F(TestHash, TestString) {
+  auto array = MakeStrings({"apple", "", "a much longer string value", "apple",
+                            "", "appl"}, {0, 0, 0, 0, 1, 0});
+
+  auto hashes = DoHash({array.get()});
+  ASSERT_EQ(hashes->Value(0), hashes->Value(3));
+  ASSERT_NE(hashes->Value(0), hashes->Value(5));
+  ASSERT_NE(hashes->Value(1), hashes->Value(4));
+  ASSERT_NE(hashes->Value(0), hashes->Value(2));
+}
+
+
+TEST_F(TestHash, TestList) {
+  TypePtr value_type(new Int32Type());
+  TypePtr type(new ListType(value_type));
+  ListBuilder builder(pool_.get(), type,
+      new Int32Builder(pool_.get(), value_type));
+  Int32Builder* vb = static_cast<Int32Builder*>(builder.value_builder());
+
+  // [[1, 2], [1], [1, 2], [], null, [2, 1]]
+  vector<vector<int32_t> > lists = {{1, 2}, {1}, {1, 2}, {}, {}, {2, 1}};
+  for (size_t i = 0; i < lists.size(); ++i) {
+    ASSERT_OK(builder.Append(i == 4));
+    for (int32_t v : lists[i]) {
+      ASSERT_OK(vb->Append(v));
+    }
+  }
+  Array* tmp;
+  ASSERT_OK(builder.ToArray(&tmp));
+  unique_ptr<Array> array(tmp);
+
+  auto hashes = DoHash({array.get()});
+  ASSERT_EQ(hashes->Value(0), hashes->Value(2));
+  ASSERT_NE(hashes->Value(0), hashes->Value(1));
+  ASSERT_NE(hashes->Value(0), hashes->Value(5));
+  ASSERT_NE(hashes->Value(3), hashes->Value(4));
+}
+
+
+TEST_F(TestHash, TestMultipleColumns) {
+  auto left = MakeStrings({"ab", "a", "ab"});
+  auto right = MakeStrings({"c", "bc", "c"});
+  vector<int32_t> ints = {1, 1, 2};
+  Int32Array int_column(ints.size(), to_buffer(ints));
+
+  auto hashes = DoHash({left.get(), right.get()});
+  ASSERT_NE(hashes->Value(0), hashes->Value(1));
+  ASSERT_EQ(hashes->Value(0), hashes->Value(2));
+
+  auto three = DoHash({left.get(), right.get(), &int_column});
+  ASSERT_NE(three->Value(0), three->Value(2));
+  ASSERT_NE(three->Value(0), hashes->Value(0));
+
+  // Column order matters
+  auto reversed = DoHash({right.get(), left.get()});
+  ASSERT_NE(hashes->Value(0), reversed->Value(0));
+}
+
+
+TEST_F(TestHash, TestInvalid) {
+  vector<int32_t> ints = {1, 1, 2};
+  Int32Array three(3, to_buffer(ints));
+  Int32Array two(2, to_buffer(ints));
+  Array* out;
+  ASSERT_RAISES(Invalid, Hash(pool_.get(), {&three, &two}, &out));
+  ASSERT_RAISES(Invalid, Hash(pool_.get(), vector<Array*>(), &out));
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,162 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/hash.h"
+
+#include <vector>
+
+#include "arrow/compute/kernel-util.h"
+#include "arrow/types/list.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/hash-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+// Mixed into the hash in place of the value of a null slot
+static constexpr uint64_t kNullHash = 0xB5AD4ECEDA1CE2A9ULL;
+
+Status HashInto(const Array& values, uint64_t* hashes);
+
+struct HashPrimitiveVisitor {
+  const Array& values;
+  uint64_t* hashes;
+
+  template <typename TypeClass>
+  Status Visit() {
+    typedef typename TypeClass::c_type T;
+    typedef typename util::uint_for_width<sizeof(T)>::type Bits;
+
+    const T* data = static_cast<const PrimitiveArrayImpl<TypeClass>&>(
+        values).raw_data();
+    const uint8_t* null_bits = values.null_bits();
+    size_t n = values.length();
+    if (null_bits == nullptr) {
+      for (size_t i = 0; i < n; ++i) {
+        Bits bits;
+        memcpy(&bits, data + i, sizeof(T));
+        hashes[i] = util::hash_word(hashes[i], bits);
+      }
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        Bits bits;
+        memcpy(&bits, data + i, sizeof(T));
+        hashes[i] = util::hash_word(hashes[i],
+            util::get_bit(null_bits, i) ? kNullHash : bits);
+      }
+    }
+    return Status::OK();
+  }
+};
+
+void HashStrings(const ListArray& values, uint64_t* hashes) {
+  const int32_t* offsets = values.offsets();
+  const uint8_t* bytes = static_cast<const UInt8Array&>(
+      *values.values()).raw_data();
+  const uint8_t* null_bits = values.null_bits();
+  for (size_t i = 0; i < values.length(); ++i) {
+    if (null_bits != nullptr && util::get_bit(null_bits, i)) {
+      hashes[i] = util::hash_word(hashes[i], kNullHash);
+    } else {
+      hashes[i] = util::hash_bytes(hashes[i], bytes + offsets[i],
+          offsets[i + 1] - offsets[i]);
+    }
+  }
+}
+
+// Each list hashes the hashes of its child values, followed by its length
+Status HashLists(const ListArray& values, uint64_t* hashes) {
+  const Array& child = *values.values();
+  std::vector<uint64_t> child_hashes(child.length(), util::kHashSeed);
+  RETURN_NOT_OK(HashInto(child, child_hashes.data()));
+
+  const int32_t* offsets = values.offsets();
+  const uint8_t* null_bits = values.null_bits();
+  for (size_t i = 0; i < values.length(); ++i) {
+    if (null_bits != nullptr && util::get_bit(null_bits, i)) {
+      hashes[i] = util::hash_word(hashes[i], kNullHash);
+      continue;
+    }
+    uint64_t hash = hashes[i];
+    for (int32_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+      hash = util::hash_word(hash, child_hashes[j]);
+    }
+    hashes[i] = util::hash_word(hash, offsets[i + 1] - offsets[i]);
+  }
+  return Status::OK();
+}
+
+// Mix each slot of values into the corresponding hash
+Status HashInto(const Array& values, uint64_t* hashes) {
+  switch (values.type_enum()) {
+    case TypeEnum::STRING:
+      HashStrings(static_cast<const ListArray&>(values), hashes);
+      return Status::OK();
+    case TypeEnum::LIST:
+      return HashLists(static_cast<const ListArray&>(values), hashes);
+    default:
+      break;
+  }
+
+  HashPrimitiveVisitor visitor = {values, hashes};
+  Status s = visit_primitive(values.type_enum(), &visitor);
+  if (!s.ok()) {
+    return Status::NotImplemented(values.type()->ToString());
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+Status Hash(MemoryPool* pool, const Array& values, Array** out) {
+  std::vector<Array*> columns = {const_cast<Array*>(&values)};
+  return Hash(pool, columns, out);
+}
+
+Status Hash(MemoryPool* pool, const std::vector<Array*>& columns,
+    Array** out) {
+  if (columns.empty()) {
+    return Status::Invalid("no columns to hash");
+  }
+  size_t length = columns[0]->length();
+  for (Array* column : columns) {
+    if (column->length() != length) {
+      return Status::Invalid("hashed columns must have the same length");
+    }
+  }
+
+  Buffer* data;
+  RETURN_NOT_OK(pool->NewBuffer(length * sizeof(uint64_t), &data));
+  uint64_t* hashes = reinterpret_cast<uint64_t*>(data->data());
+  for (size_t i = 0; i < length; ++i) {
+    hashes[i] = util::kHashSeed;
+  }
+  for (Array* column : columns) {
+    Status s = HashInto(*column, hashes);
+    if (!s.ok()) {
+      data->Decref();
+      return s;
+    }
+  }
+
+  *out = new UInt64Array(length, data);
+  return Status::OK();
+}
+
+} // namespace compute
+
+} // namespace arrow
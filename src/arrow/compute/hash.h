@@ -0,0 +1,49 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_HASH_H
+#define ARROW_COMPUTE_HASH_H
+
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Hash every slot of values into a new non-nullable UInt64Array allocated
+// from pool. Supports primitive, list and string arrays.
+//
+// Hashing is built on CRC32C (util/hash-util.h), which uses the SSE4.2 crc32
+// instruction when the build enables it and a table-driven fallback
+// otherwise; both give identical hashes. Primitive values are hashed by
+// their bit pattern, strings by their bytes and lists by the hashes of
+// their child values. Every null slot hashes to the same value regardless of
+// the data underneath it. The caller owns the returned array
+Status Hash(MemoryPool* pool, const Array& values, Array** out);
+
+// Hash each row across several columns of the same length: every column's
+// value in a row is mixed into the hash of the previous columns, so the
+// result depends on the order of the columns
+Status Hash(MemoryPool* pool, const std::vector<Array*>& columns,
+    Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_HASH_H
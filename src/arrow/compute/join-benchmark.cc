@@ -0,0 +1,78 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/join.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumProbeRows = 1 << 20;
+
+static Buffer* MakeKeys(MemoryPool* pool, size_t length, size_t num_keys) {
+  Random rng(random_seed());
+  Buffer* buf;
+  BENCHMARK_OK(pool->NewBuffer(length * sizeof(int32_t), &buf));
+  int32_t* keys = reinterpret_cast<int32_t*>(buf->data());
+  for (size_t i = 0; i < length; ++i) {
+    keys[i] = rng.Uniform(num_keys);
+  }
+  return buf;
+}
+
+// Inner join of kNumProbeRows fact rows against a dimension table of
+// num_build_rows distinct int32 keys, with and without partitioning
+static void BenchmarkBuildSize(MemoryPool* pool, size_t num_build_rows) {
+  Int32Array build(num_build_rows, MakeKeys(pool, num_build_rows,
+          num_build_rows));
+  Int32Array probe(kNumProbeRows, MakeKeys(pool, kNumProbeRows,
+          num_build_rows));
+  TypePtr key_type(new Int32Type(false));
+
+  for (int bits : {0, kAutoPartitionBits}) {
+    std::string name = "HashJoin/build:" + std::to_string(num_build_rows) +
+      (bits == 0 ? "/unpartitioned" : "/partitioned");
+    benchmark::run(name.c_str(), kNumProbeRows * sizeof(int32_t), [&]() {
+          HashJoin join(pool, {key_type}, JoinType::INNER, bits);
+          BENCHMARK_OK(join.Build({&build}));
+          Array* left;
+          Array* right;
+          BENCHMARK_OK(join.Probe({&probe}, &left, &right));
+          delete left;
+          delete right;
+        });
+  }
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  for (size_t num_build_rows : {1024, 65536, 1 << 20}) {
+    arrow::compute::BenchmarkBuildSize(&pool, num_build_rows);
+  }
+  return 0;
+}
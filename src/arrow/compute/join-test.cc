@@ -0,0 +1,325 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/join.h"
+#include "arrow/compute/take.h"
+#include "arrow/types/boolean.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/string.h"
+
+using std::pair;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+// A left and a right row index, -1 for a null right index
+typedef pair<int32_t, int32_t> RowPair;
+
+static const vector<JoinType> kJoinTypes = {JoinType::INNER,
+  JoinType::LEFT_OUTER, JoinType::LEFT_SEMI, JoinType::LEFT_ANTI};
+
+// No partitioning, a forced number of partitions, and the automatic choice
+static const vector<int> kPartitionBits = {0, 3, kAutoPartitionBits};
+
+// The key columns of a table together with the key of each row, as a
+// comparable value for the nested loop join; null_keys[i] is nonzero if the
+// key of row i has a null in any column
+struct KeyTable {
+  vector<unique_ptr<Array> > columns;
+  vector<string> keys;
+  vector<uint8_t> null_keys;
+
+  vector<Array*> arrays() const {
+    vector<Array*> out;
+    for (auto& column : columns) {
+      out.push_back(column.get());
+    }
+    return out;
+  }
+};
+
+class TestHashJoin : public TestBase {
+ public:
+  unique_ptr<Array> MakeStrings(const vector<string>& strings,
+      const vector<uint8_t>& is_null) {
+    StringBuilder builder(pool_.get(), TypePtr(new StringType()));
+    for (size_t i = 0; i < strings.size(); ++i) {
+      if (is_null[i]) {
+        EXPECT_OK(builder.AppendNull());
+      } else {
+        EXPECT_OK(builder.Append(strings[i]));
+      }
+    }
+    Array* out;
+    EXPECT_OK(builder.ToArray(&out));
+    return unique_ptr<Array>(out);
+  }
+
+  // num_keys distinct keys per column, which are null with probability
+  // null_probability. Columns are "int32", "int64" or "string"
+  void MakeKeys(const vector<string>& column_types, size_t length,
+      int32_t num_keys, double null_probability, KeyTable* table) {
+    table->keys.assign(length, "");
+    table->null_keys.assign(length, 0);
+    for (const string& column_type : column_types) {
+      vector<int32_t> draws;
+      randint<int32_t>(length, 0, num_keys, draws);
+      vector<uint8_t> nulls;
+      random_nulls(length, 1 - null_probability, nulls);
+      Buffer* null_buffer = length == 0 ? nullptr :
+        bytes_to_null_buffer(nulls.data(), length);
+      if (column_type == "int32") {
+        table->columns.emplace_back(new Int32Array(length, to_buffer(draws),
+                null_buffer));
+      } else if (column_type == "int64") {
+        wide_.emplace_back(new vector<int64_t>(draws.begin(), draws.end()));
+        for (int64_t& value : *wide_.back()) {
+          value = value * 0x100000001LL - 7;
+        }
+        table->columns.emplace_back(new Int64Array(length,
+                to_buffer(*wide_.back()), null_buffer));
+      } else {
+        vector<string> strings;
+        for (int32_t draw : draws) {
+          // One distinct string per draw, including the empty string
+          strings.push_back(draw == 0 ? "" :
+              string(draw % 3, 'x') + std::to_string(draw));
+        }
+        table->columns.push_back(MakeStrings(strings, nulls));
+        if (null_buffer != nullptr) {
+          null_buffer->Decref();
+        }
+      }
+      for (size_t i = 0; i < length; ++i) {
+        table->keys[i] += std::to_string(draws[i]) + ",";
+        table->null_keys[i] |= nulls[i];
+      }
+      int_keys_.push_back(std::move(draws));
+    }
+  }
+
+  vector<RowPair> NestedLoopJoin(const KeyTable& left, const KeyTable& right,
+      JoinType join_type) {
+    vector<RowPair> out;
+    for (size_t i = 0; i < left.keys.size(); ++i) {
+      size_t num_matches = 0;
+      for (size_t j = 0; j < right.keys.size(); ++j) {
+        if (left.null_keys[i] || right.null_keys[j] ||
+            left.keys[i] != right.keys[j]) {
+          continue;
+        }
+        ++num_matches;
+        if (join_type == JoinType::INNER ||
+            join_type == JoinType::LEFT_OUTER) {
+          out.push_back(RowPair(i, j));
+        }
+      }
+      if ((num_matches == 0 && (join_type == JoinType::LEFT_OUTER ||
+                  join_type == JoinType::LEFT_ANTI)) ||
+          (num_matches > 0 && join_type == JoinType::LEFT_SEMI)) {
+        out.push_back(RowPair(i, -1));
+      }
+    }
+    return out;
+  }
+
+  vector<RowPair> Probe(HashJoin* join, const KeyTable& left) {
+    Array* left_out;
+    Array* right_out;
+    EXPECT_OK(join->Probe(left.arrays(), &left_out, &right_out));
+    unique_ptr<Int32Array> left_indices(static_cast<Int32Array*>(left_out));
+    unique_ptr<Int32Array> right_indices(static_cast<Int32Array*>(right_out));
+
+    vector<RowPair> out;
+    for (size_t i = 0; i < left_indices->length(); ++i) {
+      EXPECT_FALSE(left_indices->IsNull(i));
+      int32_t right = -1;
+      if (right_indices && !right_indices->IsNull(i)) {
+        right = right_indices->Value(i);
+      }
+      out.push_back(RowPair(left_indices->Value(i), right));
+    }
+    return out;
+  }
+
+  void CheckJoins(const vector<string>& column_types) {
+    TypePtr int32(new Int32Type());
+    vector<TypePtr> key_types;
+    for (const string& column_type : column_types) {
+      key_types.push_back(column_type == "int32" ? int32 :
+          column_type == "int64" ? TypePtr(new Int64Type()) :
+          TypePtr(new StringType()));
+    }
+
+    KeyTable right, left;
+    MakeKeys(column_types, 2000, 40, 0.05, &right);
+    MakeKeys(column_types, 3000, 50, 0.05, &left);
+    for (JoinType join_type : kJoinTypes) {
+      vector<RowPair> expected = NestedLoopJoin(left, right, join_type);
+      for (int bits : kPartitionBits) {
+        HashJoin join(pool_.get(), key_types, join_type, bits);
+        ASSERT_OK(join.Build(right.arrays()));
+        vector<RowPair> actual = Probe(&join, left);
+        if (join.partition_bits() == 0) {
+          // Left row order, then right row order
+          ASSERT_EQ(expected, actual);
+        } else {
+          std::sort(actual.begin(), actual.end());
+          ASSERT_EQ(expected, actual);
+        }
+      }
+    }
+  }
+
+ protected:
+  // The arrays do not own their value buffers, which are kept alive here
+  vector<unique_ptr<vector<int64_t> > > wide_;
+  vector<vector<int32_t> > int_keys_;
+};
+
+
+TEST_F(TestHashJoin, TestInt32Keys) {
+  CheckJoins({"int32"});
+}
+
+TEST_F(TestHashJoin, TestInt64Keys) {
+  CheckJoins({"int64"});
+}
+
+TEST_F(TestHashJoin, TestStringKeys) {
+  CheckJoins({"string"});
+}
+
+TEST_F(TestHashJoin, TestMultiColumnKeys) {
+  CheckJoins({"int32", "string"});
+}
+
+TEST_F(TestHashJoin, TestAutoPartitioning) {
+  TypePtr int32(new Int32Type());
+  KeyTable small, large;
+  MakeKeys({"int32"}, 100, 1000, 0, &small);
+  MakeKeys({"int32"}, 100000, 1000, 0, &large);
+
+  HashJoin small_join(pool_.get(), {int32}, JoinType::INNER);
+  ASSERT_OK(small_join.Build(small.arrays()));
+  ASSERT_EQ(0, small_join.partition_bits());
+
+  HashJoin large_join(pool_.get(), {int32}, JoinType::INNER);
+  ASSERT_OK(large_join.Build(large.arrays()));
+  ASSERT_LT(0, large_join.partition_bits());
+
+  // Every large row matches the small rows with the same key
+  vector<RowPair> actual = Probe(&large_join, small);
+  std::sort(actual.begin(), actual.end());
+  ASSERT_EQ(NestedLoopJoin(small, large, JoinType::INNER), actual);
+}
+
+TEST_F(TestHashJoin, TestGatherWithTake) {
+  // Join orders (customer id, amount) with customers (id, name)
+  vector<int32_t> customer_ids = {10, 20, 30};
+  vector<int32_t> order_customers = {20, 40, 10, 20};
+  vector<int32_t> amounts = {5, 6, 7, 8};
+  Int32Array customers(customer_ids.size(), to_buffer(customer_ids));
+  unique_ptr<Array> names = MakeStrings({"ann", "bob", "cat"}, {0, 0, 0});
+  Int32Array orders(order_customers.size(), to_buffer(order_customers));
+  Int32Array order_amounts(amounts.size(), to_buffer(amounts));
+
+  HashJoin join(pool_.get(), {TypePtr(new Int32Type())},
+      JoinType::LEFT_OUTER);
+  ASSERT_OK(join.Build({&customers}));
+  Array* left_out;
+  Array* right_out;
+  ASSERT_OK(join.Probe({&orders}, &left_out, &right_out));
+  unique_ptr<Int32Array> left_indices(static_cast<Int32Array*>(left_out));
+  unique_ptr<Int32Array> right_indices(static_cast<Int32Array*>(right_out));
+
+  Array* out;
+  ASSERT_OK(Take(pool_.get(), order_amounts, *left_indices, &out));
+  unique_ptr<Int32Array> joined_amounts(static_cast<Int32Array*>(out));
+  ASSERT_OK(Take(pool_.get(), *names, *right_indices, &out));
+  unique_ptr<StringArray> joined_names(static_cast<StringArray*>(out));
+
+  ASSERT_EQ(4, joined_amounts->length());
+  vector<int32_t> expected_amounts = {5, 6, 7, 8};
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(expected_amounts[i], joined_amounts->Value(i));
+  }
+  ASSERT_EQ("bob", joined_names->GetString(0));
+  ASSERT_TRUE(joined_names->IsNull(1));
+  ASSERT_EQ("ann", joined_names->GetString(2));
+  ASSERT_EQ("bob", joined_names->GetString(3));
+}
+
+TEST_F(TestHashJoin, TestEmptySides) {
+  TypePtr int32(new Int32Type());
+  KeyTable empty, rows;
+  MakeKeys({"int32"}, 0, 10, 0, &empty);
+  MakeKeys({"int32"}, 10, 10, 0, &rows);
+
+  for (int bits : {0, 2}) {
+    HashJoin join(pool_.get(), {int32}, JoinType::LEFT_ANTI, bits);
+    ASSERT_OK(join.Build(empty.arrays()));
+    ASSERT_EQ(10, Probe(&join, rows).size());
+    ASSERT_EQ(0, Probe(&join, empty).size());
+  }
+}
+
+TEST_F(TestHashJoin, TestInvalid) {
+  TypePtr int32(new Int32Type());
+  vector<int32_t> values = {1, 2};
+  Int32Array keys(values.size(), to_buffer(values));
+  vector<int64_t> wide = {1, 2};
+  Int64Array wide_keys(wide.size(), to_buffer(wide));
+  Array* left_out;
+  Array* right_out;
+
+  HashJoin join(pool_.get(), {int32}, JoinType::INNER);
+  ASSERT_TRUE(join.Probe({&keys}, &left_out, &right_out).IsInvalid());
+  ASSERT_TRUE(join.Build({&wide_keys}).IsInvalid());
+  ASSERT_TRUE(join.Build({}).IsInvalid());
+  ASSERT_OK(join.Build({&keys}));
+  ASSERT_TRUE(join.Build({&keys}).IsInvalid());
+  ASSERT_TRUE(join.Probe({&wide_keys}, &left_out, &right_out).IsInvalid());
+
+  vector<uint8_t> flags = {0, 1};
+  BooleanArray bool_keys(flags.size(), to_buffer(flags));
+  HashJoin bool_join(pool_.get(), {TypePtr(new BooleanType())},
+      JoinType::INNER);
+  ASSERT_TRUE(bool_join.Build({&bool_keys}).IsNotImplemented());
+
+  HashJoin bad_bits(pool_.get(), {int32}, JoinType::INNER, 40);
+  ASSERT_TRUE(bad_bits.Build({&keys}).IsInvalid());
+}
+
+} // namespace compute
+
+} // namespace arrow
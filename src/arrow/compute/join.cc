@@ -0,0 +1,347 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/join.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "arrow/builder.h"
+#include "arrow/compute/group-table.h"
+#include "arrow/compute/hash.h"
+#include "arrow/compute/take.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+// Number of rows hashed and probed per pass
+static constexpr size_t kBatchSize = 1024;
+
+// Estimated bytes of hash table per build row: the slots, at most half
+// full, and the row lists
+static constexpr size_t kBytesPerBuildRow = 48;
+
+static constexpr int kMaxPartitionBits = 12;
+
+static inline bool any_null(const std::vector<Array*>& keys, size_t i) {
+  for (Array* key : keys) {
+    if (key->null_bits() != nullptr && util::get_bit(key->null_bits(), i)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Order the rows by partition, the top bits of the hashes of their keys: the
+// rows of partition p are (*rows)[(*offsets)[p], (*offsets)[p + 1]), in
+// increasing order
+Status partition_rows(MemoryPool* pool, const std::vector<Array*>& keys,
+    int bits, std::vector<int32_t>* rows, std::vector<int32_t>* offsets) {
+  Array* hash_array;
+  RETURN_NOT_OK(Hash(pool, keys, &hash_array));
+  std::unique_ptr<Array> hash_owner(hash_array);
+  const uint64_t* hashes = static_cast<UInt64Array*>(hash_array)->raw_data();
+  size_t length = hash_array->length();
+
+  int shift = 64 - bits;
+  offsets->assign((1 << bits) + 1, 0);
+  for (size_t i = 0; i < length; ++i) {
+    ++(*offsets)[(hashes[i] >> shift) + 1];
+  }
+  for (size_t p = 1; p < offsets->size(); ++p) {
+    (*offsets)[p] += (*offsets)[p - 1];
+  }
+  std::vector<int32_t> cursors(offsets->begin(), offsets->end() - 1);
+  rows->resize(length);
+  for (size_t i = 0; i < length; ++i) {
+    (*rows)[cursors[hashes[i] >> shift]++] = static_cast<int32_t>(i);
+  }
+  return Status::OK();
+}
+
+// Gather the given rows of each key column
+Status take_rows(MemoryPool* pool, const std::vector<Array*>& keys,
+    const int32_t* rows, size_t length,
+    std::vector<std::unique_ptr<Array> >* out) {
+  Int32Array indices(length, new Buffer(reinterpret_cast<uint8_t*>(
+              const_cast<int32_t*>(rows)), length * sizeof(int32_t), false));
+  out->clear();
+  for (Array* key : keys) {
+    Array* taken;
+    RETURN_NOT_OK(Take(pool, *key, indices, &taken));
+    out->emplace_back(taken);
+  }
+  return Status::OK();
+}
+
+Status finish_indices(MemoryPool* pool, std::vector<int32_t>* indices,
+    std::vector<uint8_t>* nulls, Array** out) {
+  Int32Builder builder(pool, TypePtr(new Int32Type(nulls != nullptr)));
+  RETURN_NOT_OK(builder.Append(indices->data(), indices->size(),
+          nulls == nullptr ? nullptr : nulls->data()));
+  return builder.ToArray(out);
+}
+
+} // namespace
+
+// The table of one partition, and the build rows of each group in it:
+// rows[offsets[g], offsets[g + 1]), in increasing order. Build rows with a
+// null in their key are left out, so the groups of such keys are empty
+struct HashJoin::Partition {
+  std::unique_ptr<GroupTable> table;
+  std::vector<int32_t> offsets;
+  std::vector<int32_t> rows;
+};
+
+HashJoin::HashJoin(MemoryPool* pool, const std::vector<TypePtr>& key_types,
+    JoinType join_type, int partition_bits) :
+    pool_(pool),
+    key_types_(key_types),
+    join_type_(join_type),
+    partition_bits_(partition_bits) {}
+
+HashJoin::~HashJoin() {}
+
+Status HashJoin::CheckKeys(const std::vector<Array*>& keys) const {
+  if (keys.size() != key_types_.size()) {
+    return Status::Invalid("wrong number of key columns");
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i]->length() != keys[0]->length() ||
+        keys[i]->type_enum() != key_types_[i]->type) {
+      return Status::Invalid("key column does not match the key type");
+    }
+  }
+  if (keys[0]->length() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return Status::Invalid("too many rows for int32 row indices");
+  }
+  return Status::OK();
+}
+
+Status HashJoin::Build(const std::vector<Array*>& keys) {
+  if (!partitions_.empty()) {
+    return Status::Invalid("the build side is already loaded");
+  }
+  if (key_types_.empty()) {
+    return Status::Invalid("no key columns");
+  }
+  RETURN_NOT_OK(CheckKeys(keys));
+
+  size_t length = keys[0]->length();
+  if (partition_bits_ == kAutoPartitionBits) {
+    partition_bits_ = 0;
+    while (partition_bits_ < kMaxPartitionBits &&
+        (length * kBytesPerBuildRow >> partition_bits_) > kJoinPartitionBytes) {
+      ++partition_bits_;
+    }
+  } else if (partition_bits_ < 0 || partition_bits_ > kMaxPartitionBits) {
+    return Status::Invalid("partition bits out of range");
+  }
+
+  if (partition_bits_ == 0) {
+    partitions_.emplace_back(new Partition());
+    return BuildPartition(keys, nullptr, partitions_[0].get());
+  }
+
+  std::vector<int32_t> rows, offsets;
+  RETURN_NOT_OK(partition_rows(pool_, keys, partition_bits_, &rows,
+          &offsets));
+  for (size_t p = 0; p + 1 < offsets.size(); ++p) {
+    const int32_t* row_ids = rows.data() + offsets[p];
+    std::vector<std::unique_ptr<Array> > taken;
+    RETURN_NOT_OK(take_rows(pool_, keys, row_ids, offsets[p + 1] - offsets[p],
+            &taken));
+    std::vector<Array*> partition_keys;
+    for (auto& key : taken) {
+      partition_keys.push_back(key.get());
+    }
+    partitions_.emplace_back(new Partition());
+    RETURN_NOT_OK(BuildPartition(partition_keys, row_ids,
+            partitions_.back().get()));
+  }
+  return Status::OK();
+}
+
+// row_ids maps the rows of keys to rows of the build side; nullptr if they
+// are the same
+Status HashJoin::BuildPartition(const std::vector<Array*>& keys,
+    const int32_t* row_ids, Partition* partition) {
+  RETURN_NOT_OK(make_group_table(key_types_, &partition->table));
+  GroupTable* table = partition->table.get();
+
+  size_t length = keys[0]->length();
+  std::vector<uint64_t> hashes(kBatchSize);
+  std::vector<int32_t> group_ids(length);
+  for (size_t offset = 0; offset < length; offset += kBatchSize) {
+    size_t n = std::min(kBatchSize, length - offset);
+    table->Hash(keys, offset, n, hashes.data());
+    table->Probe(keys, offset, n, hashes.data(), group_ids.data() + offset);
+  }
+
+  // Counting sort of the rows by group
+  std::vector<int32_t>& offsets = partition->offsets;
+  offsets.assign(table->num_groups() + 1, 0);
+  for (size_t i = 0; i < length; ++i) {
+    if (!any_null(keys, i)) {
+      ++offsets[group_ids[i] + 1];
+    }
+  }
+  for (size_t g = 1; g < offsets.size(); ++g) {
+    offsets[g] += offsets[g - 1];
+  }
+  std::vector<int32_t> cursors(offsets.begin(), offsets.end() - 1);
+  partition->rows.resize(offsets.back());
+  for (size_t i = 0; i < length; ++i) {
+    if (!any_null(keys, i)) {
+      partition->rows[cursors[group_ids[i]]++] = row_ids == nullptr ?
+        static_cast<int32_t>(i) : row_ids[i];
+    }
+  }
+  return Status::OK();
+}
+
+// Appends the joined rows to left_, right_ and right_nulls_. row_ids maps
+// the rows of keys to rows of the probe batch; nullptr if they are the same
+template <JoinType kJoinType>
+void HashJoin::ProbePartition(const std::vector<Array*>& keys,
+    const int32_t* row_ids, Partition* partition) {
+  GroupTable* table = partition->table.get();
+  const int32_t* offsets = partition->offsets.data();
+  const int32_t* rows = partition->rows.data();
+
+  size_t length = keys[0]->length();
+  uint64_t hashes[kBatchSize];
+  int32_t group_ids[kBatchSize];
+  for (size_t offset = 0; offset < length; offset += kBatchSize) {
+    size_t n = std::min(kBatchSize, length - offset);
+    table->Hash(keys, offset, n, hashes);
+    table->Find(keys, offset, n, hashes, group_ids);
+
+    for (size_t i = 0; i < n; ++i) {
+      int32_t left = row_ids == nullptr ? static_cast<int32_t>(offset + i) :
+        row_ids[offset + i];
+      int32_t begin = 0;
+      int32_t end = 0;
+      if (group_ids[i] != kNoGroup) {
+        begin = offsets[group_ids[i]];
+        end = offsets[group_ids[i] + 1];
+      }
+
+      switch (kJoinType) {
+        case JoinType::INNER:
+        case JoinType::LEFT_OUTER:
+          for (int32_t j = begin; j < end; ++j) {
+            left_.push_back(left);
+            right_.push_back(rows[j]);
+          }
+          if (kJoinType == JoinType::LEFT_OUTER) {
+            right_nulls_.resize(right_.size(), 0);
+            if (begin == end) {
+              left_.push_back(left);
+              right_.push_back(0);
+              right_nulls_.push_back(1);
+            }
+          }
+          break;
+        case JoinType::LEFT_SEMI:
+          if (begin != end) {
+            left_.push_back(left);
+          }
+          break;
+        case JoinType::LEFT_ANTI:
+          if (begin == end) {
+            left_.push_back(left);
+          }
+          break;
+      }
+    }
+  }
+}
+
+Status HashJoin::Probe(const std::vector<Array*>& keys, Array** left_indices,
+    Array** right_indices) {
+  if (partitions_.empty()) {
+    return Status::Invalid("the build side is not loaded");
+  }
+  RETURN_NOT_OK(CheckKeys(keys));
+
+  left_.clear();
+  right_.clear();
+  right_nulls_.clear();
+
+  auto probe = [&](const std::vector<Array*>& partition_keys,
+      const int32_t* row_ids, Partition* partition) {
+    switch (join_type_) {
+      case JoinType::INNER:
+        ProbePartition<JoinType::INNER>(partition_keys, row_ids, partition);
+        break;
+      case JoinType::LEFT_OUTER:
+        ProbePartition<JoinType::LEFT_OUTER>(partition_keys, row_ids,
+            partition);
+        break;
+      case JoinType::LEFT_SEMI:
+        ProbePartition<JoinType::LEFT_SEMI>(partition_keys, row_ids,
+            partition);
+        break;
+      case JoinType::LEFT_ANTI:
+        ProbePartition<JoinType::LEFT_ANTI>(partition_keys, row_ids,
+            partition);
+        break;
+    }
+  };
+
+  if (partition_bits_ == 0) {
+    probe(keys, nullptr, partitions_[0].get());
+  } else {
+    std::vector<int32_t> rows, offsets;
+    RETURN_NOT_OK(partition_rows(pool_, keys, partition_bits_, &rows,
+            &offsets));
+    for (size_t p = 0; p + 1 < offsets.size(); ++p) {
+      size_t n = offsets[p + 1] - offsets[p];
+      if (n == 0) continue;
+      const int32_t* row_ids = rows.data() + offsets[p];
+      std::vector<std::unique_ptr<Array> > taken;
+      RETURN_NOT_OK(take_rows(pool_, keys, row_ids, n, &taken));
+      std::vector<Array*> partition_keys;
+      for (auto& key : taken) {
+        partition_keys.push_back(key.get());
+      }
+      probe(partition_keys, row_ids, partitions_[p].get());
+    }
+  }
+
+  RETURN_NOT_OK(finish_indices(pool_, &left_, nullptr, left_indices));
+  if (join_type_ == JoinType::LEFT_SEMI || join_type_ == JoinType::LEFT_ANTI) {
+    *right_indices = nullptr;
+    return Status::OK();
+  }
+  Status s = finish_indices(pool_, &right_,
+      join_type_ == JoinType::LEFT_OUTER ? &right_nulls_ : nullptr,
+      right_indices);
+  if (!s.ok()) {
+    delete *left_indices;
+    return s;
+  }
+  return Status::OK();
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,138 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_JOIN_H
+#define ARROW_COMPUTE_JOIN_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types.h"
+#include "arrow/util/macros.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+enum class JoinType {
+  // Every pair of a left and a right row with equal keys
+  INNER,
+
+  // As INNER, plus every left row without a match, paired with a null
+  // right index
+  LEFT_OUTER,
+
+  // Every left row with at least one match, once
+  LEFT_SEMI,
+
+  // Every left row without a match
+  LEFT_ANTI
+};
+
+// Let HashJoin choose the number of partitions from the size of the build
+// side
+static constexpr int kAutoPartitionBits = -1;
+
+// The build side is partitioned when its hash table would be larger than
+// this, about the size of an L2 cache
+static constexpr size_t kJoinPartitionBytes = 256 * 1024;
+
+// Equi-join of the rows of two tables on one or more key columns. The right
+// side, usually the smaller (dimension) table, is loaded into a hash table
+// with Build, then batches of left rows are probed against it. Rows whose
+// key has a null in any column match nothing, as in SQL.
+//
+// Probe does not produce joined rows but the row indices that make them up:
+// the i-th output row joins left row left_indices[i] with right row
+// right_indices[i]. The columns of the result are then gathered with Take.
+//
+// Left rows are probed in batches, the keys of a whole batch being hashed
+// before the table is probed, using the hash tables of the group-by engine
+// (compute/group-by.h). Once the build side is too large for the cache, it
+// is radix partitioned by the high bits of the row hashes into tables that
+// fit, and each probe batch is partitioned the same way, so that every
+// partition is probed while its table is cached. Without partitioning the
+// output is in left row order; with it, the output is grouped by partition
+// and in left row order within each partition. Either way the matches of
+// one left row are in right row order.
+//
+// Usage:
+//
+//   HashJoin join(pool, {key_type}, JoinType::INNER);
+//   RETURN_NOT_OK(join.Build({right_keys}));
+//   for (...) {
+//     RETURN_NOT_OK(join.Probe({left_keys}, &left_indices, &right_indices));
+//     RETURN_NOT_OK(Take(pool, left_values, *left_indices, &out_left));
+//     RETURN_NOT_OK(Take(pool, right_values, *right_indices, &out_right));
+//   }
+class HashJoin {
+ public:
+  // partition_bits is the log2 of the number of partitions, 0 for none, or
+  // kAutoPartitionBits
+  HashJoin(MemoryPool* pool, const std::vector<TypePtr>& key_types,
+      JoinType join_type, int partition_bits = kAutoPartitionBits);
+
+  ~HashJoin();
+
+  // Load the right side. May be called once. Returns NotImplemented for
+  // key types other than primitive (except boolean) and string
+  Status Build(const std::vector<Array*>& keys);
+
+  // Join a batch of left rows. left_indices are the rows of this batch and
+  // right_indices rows of the build side, both as non-nullable Int32Arrays,
+  // except that the right indices of unmatched LEFT_OUTER rows are null.
+  // For LEFT_SEMI and LEFT_ANTI joins there are no right indices and
+  // *right_indices is set to nullptr. The caller owns the returned arrays
+  Status Probe(const std::vector<Array*>& keys, Array** left_indices,
+      Array** right_indices);
+
+  // The number of partitions is 1 << partition_bits(); known after Build
+  int partition_bits() const { return partition_bits_;}
+
+ private:
+  struct Partition;
+
+  Status BuildPartition(const std::vector<Array*>& keys,
+      const int32_t* row_ids, Partition* partition);
+
+  template <JoinType kJoinType>
+  void ProbePartition(const std::vector<Array*>& keys,
+      const int32_t* row_ids, Partition* partition);
+
+  Status CheckKeys(const std::vector<Array*>& keys) const;
+
+  MemoryPool* pool_;
+  std::vector<TypePtr> key_types_;
+  JoinType join_type_;
+  int partition_bits_;
+
+  std::vector<std::unique_ptr<Partition> > partitions_;
+
+  // The output of the current Probe
+  std::vector<int32_t> left_;
+  std::vector<int32_t> right_;
+  std::vector<uint8_t> right_nulls_;
+
+  DISALLOW_COPY_AND_ASSIGN(HashJoin);
+};
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_JOIN_H
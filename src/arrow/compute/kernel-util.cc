@@ -0,0 +1,165 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/kernel-util.h"
+
+#include <cstring>
+
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+struct WidthVisitor {
+  size_t width;
+
+  template <typename TypeClass>
+  Status Visit() {
+    width = sizeof(typename TypeClass::c_type);
+    return Status::OK();
+  }
+};
+
+struct MakeArrayVisitor {
+  const TypePtr& type;
+  size_t length;
+  Buffer* data;
+  Buffer* nulls;
+  Array** out;
+
+  template <typename TypeClass>
+  Status Visit() {
+    PrimitiveArray* result;
+    switch (type->type) {
+      case TypeEnum::DATE:
+        result = new DateArray();
+        break;
+      case TypeEnum::TIMESTAMP:
+        result = new TimestampArray();
+        break;
+      case TypeEnum::TIME:
+        result = new TimeArray();
+        break;
+      default:
+        result = new PrimitiveArrayImpl<TypeClass>();
+        break;
+    }
+    result->Init(type, length, data, nulls);
+    *out = result;
+    return Status::OK();
+  }
+};
+
+struct NullableTypeVisitor {
+  TypePtr out;
+
+  template <typename TypeClass>
+  Status Visit() {
+    out = TypePtr(new TypeClass(true));
+    return Status::OK();
+  }
+};
+
+} // namespace
+
+size_t primitive_width(TypeEnum type) {
+  WidthVisitor visitor;
+  if (!visit_primitive(type, &visitor).ok()) {
+    return 0;
+  }
+  return visitor.width;
+}
+
+Status make_primitive_array(const TypePtr& type, size_t length, Buffer* data,
+    Buffer* nulls, Array** out) {
+  MakeArrayVisitor visitor = {type, length, data, nulls, out};
+  return visit_primitive(type->type, &visitor);
+}
+
+Status retype_primitive_array(const TypePtr& type, const Array& values,
+    Array** out) {
+  const auto& primitive = static_cast<const PrimitiveArray&>(values);
+  Buffer* data = primitive.data();
+  Buffer* nulls = primitive.nulls();
+  if (data != nullptr) data->Incref();
+  if (nulls != nullptr) nulls->Incref();
+  Status s = make_primitive_array(type, values.length(), data, nulls, out);
+  if (!s.ok()) {
+    if (data != nullptr) data->Decref();
+    if (nulls != nullptr) nulls->Decref();
+  }
+  return s;
+}
+
+TypePtr storage_type(const TypePtr& type) {
+  switch (type->type) {
+    case TypeEnum::DATE:
+      return TypePtr(new Int32Type(type->nullable));
+    case TypeEnum::TIMESTAMP:
+    case TypeEnum::TIME:
+      return TypePtr(new Int64Type(type->nullable));
+    default:
+      return type;
+  }
+}
+
+TypePtr nullable_type(const TypePtr& type) {
+  if (type->nullable) {
+    return type;
+  }
+  switch (type->type) {
+    case TypeEnum::STRING:
+      return TypePtr(new StringType(true));
+    case TypeEnum::LARGE_STRING:
+      return TypePtr(new LargeStringType(true));
+    case TypeEnum::LIST:
+      return TypePtr(new ListType(
+              static_cast<ListType*>(type.get())->value_type, true));
+    case TypeEnum::LARGE_LIST:
+      return TypePtr(new LargeListType(
+              static_cast<LargeListType*>(type.get())->value_type, true));
+    case TypeEnum::DATE:
+      return TypePtr(new DateType(
+              static_cast<DateType*>(type.get())->unit, true));
+    case TypeEnum::TIMESTAMP:
+      return TypePtr(new TimestampType(
+              static_cast<TimestampType*>(type.get())->unit, true));
+    case TypeEnum::TIME:
+      return TypePtr(new TimeType(
+              static_cast<TimeType*>(type.get())->unit, true));
+    default:
+      break;
+  }
+  NullableTypeVisitor visitor;
+  if (visit_primitive(type->type, &visitor).ok()) {
+    return visitor.out;
+  }
+  return type;
+}
+
+Status allocate_nulls(MemoryPool* pool, size_t length, Buffer** out) {
+  size_t nbytes = util::ceil_byte(length) / 8;
+  RETURN_NOT_OK(pool->NewBuffer(nbytes, out));
+  memset((*out)->data(), 0, nbytes);
+  return Status::OK();
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,140 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Helpers shared by the compute kernels
+
+#ifndef ARROW_COMPUTE_KERNEL_UTIL_H
+#define ARROW_COMPUTE_KERNEL_UTIL_H
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types.h"
+
+#include "arrow/types/boolean.h"
+#include "arrow/types/datetime.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+#define PRIMITIVE_VISIT_CASE(ENUM, TypeClass)           \
+    case TypeEnum::ENUM:                                \
+      return visitor->template Visit<TypeClass>();
+
+// Call visitor->Visit<TypeClass>() with the primitive type class that
+// corresponds to type. Dates, timestamps and times are visited as their
+// int32 or int64 storage. Returns NotImplemented for any other type
+template <typename Visitor>
+Status visit_primitive(TypeEnum type, Visitor* visitor) {
+  switch (type) {
+    PRIMITIVE_VISIT_CASE(UINT8, UInt8Type);
+    PRIMITIVE_VISIT_CASE(INT8, Int8Type);
+    PRIMITIVE_VISIT_CASE(UINT16, UInt16Type);
+    PRIMITIVE_VISIT_CASE(INT16, Int16Type);
+    PRIMITIVE_VISIT_CASE(UINT32, UInt32Type);
+    PRIMITIVE_VISIT_CASE(INT32, Int32Type);
+    PRIMITIVE_VISIT_CASE(UINT64, UInt64Type);
+    PRIMITIVE_VISIT_CASE(INT64, Int64Type);
+    PRIMITIVE_VISIT_CASE(BOOL, BooleanType);
+    PRIMITIVE_VISIT_CASE(FLOAT, FloatType);
+    PRIMITIVE_VISIT_CASE(DOUBLE, DoubleType);
+    PRIMITIVE_VISIT_CASE(DATE, Int32Type);
+    PRIMITIVE_VISIT_CASE(TIMESTAMP, Int64Type);
+    PRIMITIVE_VISIT_CASE(TIME, Int64Type);
+    default:
+      return Status::NotImplemented("not a primitive type");
+  }
+}
+
+#undef PRIMITIVE_VISIT_CASE
+
+static inline bool is_primitive(TypeEnum type) {
+  switch (type) {
+    case TypeEnum::UINT8:
+    case TypeEnum::INT8:
+    case TypeEnum::UINT16:
+    case TypeEnum::INT16:
+    case TypeEnum::UINT32:
+    case TypeEnum::INT32:
+    case TypeEnum::UINT64:
+    case TypeEnum::INT64:
+    case TypeEnum::BOOL:
+    case TypeEnum::FLOAT:
+    case TypeEnum::DOUBLE:
+    case TypeEnum::DATE:
+    case TypeEnum::TIMESTAMP:
+    case TypeEnum::TIME:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static inline bool is_temporal(TypeEnum type) {
+  return type == TypeEnum::DATE || type == TypeEnum::TIMESTAMP ||
+    type == TypeEnum::TIME;
+}
+
+// Run fn(0) ... fn(num_threads - 1), fn(0) on the calling thread
+template <typename Fn>
+void parallel_for(int num_threads, Fn fn) {
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_threads; ++t) {
+    threads.emplace_back(fn, t);
+  }
+  fn(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Width in bytes of a single value of a primitive type, or 0 if the type is
+// not primitive
+size_t primitive_width(TypeEnum type);
+
+// Create a PrimitiveArrayImpl of the concrete class matching type, stealing
+// the references to data and nulls. Temporal arrays keep type and its unit
+Status make_primitive_array(const TypePtr& type, size_t length, Buffer* data,
+    Buffer* nulls, Array** out);
+
+// An array of type sharing the buffers of values, which must be a primitive
+// array with the same storage. Used to give temporal arrays built with the
+// builder of their storage type back their type
+Status retype_primitive_array(const TypePtr& type, const Array& values,
+    Array** out);
+
+// The int32 or int64 type a temporal type is stored as, with the same
+// nullability, or type itself if it is not temporal
+TypePtr storage_type(const TypePtr& type);
+
+// type itself if it is nullable, otherwise an otherwise identical nullable
+// type. For kernels whose output may contain nulls not present in the input
+TypePtr nullable_type(const TypePtr& type);
+
+// Allocate a null bitmap for length slots with every slot marked not null
+Status allocate_nulls(MemoryPool* pool, size_t length, Buffer** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_KERNEL_UTIL_H
@@ -0,0 +1,100 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/aggregate.h"
+#include "arrow/compute/filter.h"
+#include "arrow/compute/run-end.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+// Sorted int64 values in runs of run_length, as a plain and a run-end
+// encoded array, summed, filtered and compared both ways
+static void BenchmarkRuns(MemoryPool* pool, size_t run_length) {
+  Buffer* buf;
+  BENCHMARK_OK(pool->NewBuffer(kNumValues * sizeof(int64_t), &buf));
+  int64_t* values = reinterpret_cast<int64_t*>(buf->data());
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = i / run_length;
+  }
+  Int64Array plain(kNumValues, buf);
+
+  Array* out;
+  BENCHMARK_OK(RunEndEncode(pool, plain, &out));
+  std::unique_ptr<Array> encoded(out);
+  const RunEndArray& runs = static_cast<const RunEndArray&>(*encoded);
+
+  Random rng(random_seed());
+  std::vector<uint8_t> selection((kNumValues + 7) / 8, 0);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    util::set_bit(selection.data(), i, rng.Uniform(100) < 50);
+  }
+
+  std::string suffix = "/run:" + std::to_string(run_length);
+  size_t bytes = kNumValues * sizeof(int64_t);
+  int64_t sum;
+  benchmark::run(("Sum/plain" + suffix).c_str(), bytes, [&]() {
+        BENCHMARK_OK(Sum(plain, &sum));
+      });
+  benchmark::run(("Sum/run_end" + suffix).c_str(), bytes, [&]() {
+        BENCHMARK_OK(RunEndSum<Int64Type>(runs, &sum));
+      });
+  benchmark::run(("Filter/plain" + suffix).c_str(), bytes, [&]() {
+        BENCHMARK_OK(Filter(pool, plain, selection.data(), &out));
+        delete out;
+      });
+  benchmark::run(("Filter/run_end" + suffix).c_str(), bytes, [&]() {
+        BENCHMARK_OK(RunEndFilter(pool, runs, selection.data(), &out));
+        delete out;
+      });
+  benchmark::run(("Compare/run_end" + suffix).c_str(), bytes, [&]() {
+        BENCHMARK_OK(RunEndCompare<Int64Type>(pool, runs,
+                CompareOperator::LESS, 100, &out));
+        delete out;
+      });
+  benchmark::run(("Encode" + suffix).c_str(), bytes, [&]() {
+        BENCHMARK_OK(RunEndEncode(pool, plain, &out));
+        delete out;
+      });
+  benchmark::run(("Decode" + suffix).c_str(), bytes, [&]() {
+        BENCHMARK_OK(RunEndDecode(pool, runs, &out));
+        delete out;
+      });
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  for (size_t run_length : {1, 16, 1024}) {
+    arrow::compute::BenchmarkRuns(&pool, run_length);
+  }
+  return 0;
+}
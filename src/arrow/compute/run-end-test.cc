@@ -0,0 +1,344 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/filter.h"
+#include "arrow/compute/run-end.h"
+#include "arrow/types/boolean.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/run-end.h"
+#include "arrow/types/string.h"
+#include "arrow/util/bit-util.h"
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestRunEnd : public TestBase {
+ public:
+  // Values in runs of random length up to max_run, with whole runs null
+  // with the given probability
+  void MakeRuns(size_t length, int max_run, double null_probability) {
+    values_.clear();
+    nulls_.clear();
+    while (values_.size() < length) {
+      vector<int32_t> draw;
+      randint<int32_t>(2, 0, 1000, draw);
+      int run_length = 1 + draw[0] % max_run;
+      bool is_null = draw[1] < null_probability * 1000;
+      for (int i = 0; i < run_length && values_.size() < length; ++i) {
+        values_.push_back(draw[0]);
+        nulls_.push_back(is_null);
+      }
+    }
+  }
+
+  unique_ptr<Array> Encode(const Array& values) {
+    Array* out;
+    EXPECT_OK(RunEndEncode(pool_.get(), values, &out));
+    return unique_ptr<Array>(out);
+  }
+
+  unique_ptr<Array> Decode(const Array& values) {
+    Array* out;
+    EXPECT_OK(RunEndDecode(pool_.get(),
+            static_cast<const RunEndArray&>(values), &out));
+    return unique_ptr<Array>(out);
+  }
+
+ protected:
+  vector<int32_t> values_;
+  vector<uint8_t> nulls_;
+};
+
+
+TEST_F(TestRunEnd, TestBuilder) {
+  TypePtr type(new RunEndType(TypePtr(new DoubleType())));
+  ArrayBuilder* tmp;
+  ASSERT_OK(make_builder(pool_.get(), type, &tmp));
+  unique_ptr<RunEndBuilder<DoubleType> > builder(
+      static_cast<RunEndBuilder<DoubleType>*>(tmp));
+
+  // NaNs form a run, 0 and -0 do not
+  ASSERT_OK(builder->Append(1.5));
+  ASSERT_OK(builder->Append(1.5));
+  ASSERT_OK(builder->AppendNull());
+  ASSERT_OK(builder->AppendNull());
+  ASSERT_OK(builder->AppendRun(NAN, 3));
+  ASSERT_OK(builder->Append(NAN));
+  ASSERT_OK(builder->Append(0.0));
+  ASSERT_OK(builder->Append(-0.0));
+  vector<double> more = {-0.0, 2, 2, 2};
+  vector<uint8_t> more_nulls = {0, 0, 1, 1};
+  ASSERT_OK(builder->Append(more.data(), more.size(), more_nulls.data()));
+  ASSERT_EQ(14, builder->length());
+  ASSERT_EQ(7, builder->num_runs());
+
+  Array* out;
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<RunEndArray> array(static_cast<RunEndArray*>(out));
+  ASSERT_OK(array->Validate());
+  ASSERT_EQ(14, array->length());
+  ASSERT_EQ(7, array->num_runs());
+  vector<int32_t> ex_run_ends = {2, 4, 8, 9, 11, 12, 14};
+  for (size_t r = 0; r < ex_run_ends.size(); ++r) {
+    ASSERT_EQ(ex_run_ends[r], array->run_end(r));
+  }
+  ASSERT_EQ(2, array->FindRun(5));
+  ASSERT_EQ(3, array->FindRun(8));
+  ASSERT_EQ(6, array->FindRun(13));
+
+  const DoubleArray& values = static_cast<const DoubleArray&>(
+      *array->values());
+  ASSERT_TRUE(values.IsNull(1));
+  ASSERT_TRUE(values.IsNull(6));
+  ASSERT_TRUE(std::isnan(values.Value(2)));
+  ASSERT_EQ(2, values.Value(5));
+
+  // The builder is reset by ToArray
+  ASSERT_EQ(0, builder->length());
+  ASSERT_OK(builder->ToArray(&out));
+  unique_ptr<Array> empty(out);
+  ASSERT_EQ(0, empty->length());
+  ASSERT_OK(empty->Validate());
+}
+
+
+TEST_F(TestRunEnd, TestEncodeDecode) {
+  for (int max_run : {1, 5, 100}) {
+    MakeRuns(1000, max_run, 0.2);
+    Int32Array plain(values_.size(), to_buffer(values_),
+        bytes_to_null_buffer(nulls_.data(), nulls_.size()));
+    unique_ptr<Array> encoded = Encode(plain);
+    ASSERT_OK(encoded->Validate());
+    ASSERT_EQ(plain.length(), encoded->length());
+
+    unique_ptr<Array> decoded = Decode(*encoded);
+    ASSERT_TRUE(decoded->Equals(plain));
+
+    // Without nulls the encoding is maximal
+    Int32Array no_nulls(values_.size(), to_buffer(values_));
+    encoded = Encode(no_nulls);
+    size_t runs = 1;
+    for (size_t i = 1; i < values_.size(); ++i) {
+      runs += values_[i] != values_[i - 1];
+    }
+    ASSERT_EQ(runs, static_cast<RunEndArray&>(*encoded).num_runs());
+    ASSERT_TRUE(Decode(*encoded)->Equals(no_nulls));
+  }
+}
+
+
+TEST_F(TestRunEnd, TestDecodeStrings) {
+  vector<int32_t> offsets = {0, 1, 3};
+  vector<char> chars = {'a', 'b', 'c'};
+  ArrayPtr strings(new StringArray(2, to_buffer(offsets),
+          ArrayPtr(new UInt8Array(chars.size(), to_buffer(chars)))));
+  vector<int32_t> run_ends = {3, 5};
+  RunEndArray array(TypePtr(new RunEndType(strings->type())),
+      ArrayPtr(new Int32Array(2, to_buffer(run_ends))), strings);
+  ASSERT_OK(array.Validate());
+
+  unique_ptr<Array> decoded = Decode(array);
+  const StringArray& result = static_cast<const StringArray&>(*decoded);
+  vector<string> expected = {"a", "a", "a", "bc", "bc"};
+  ASSERT_EQ(expected.size(), result.length());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], result.GetString(i));
+  }
+}
+
+
+TEST_F(TestRunEnd, TestRangeEquals) {
+  // The same slots split into runs differently
+  vector<int32_t> values = {1, 2};
+  vector<int32_t> split_values = {1, 1, 2};
+  vector<int32_t> run_ends = {3, 5};
+  vector<int32_t> split_run_ends = {1, 3, 5};
+  TypePtr type(new RunEndType(TypePtr(new Int32Type())));
+  RunEndArray left(type, ArrayPtr(new Int32Array(2, to_buffer(run_ends))),
+      ArrayPtr(new Int32Array(2, to_buffer(values))));
+  RunEndArray right(type, ArrayPtr(new Int32Array(3,
+              to_buffer(split_run_ends))),
+      ArrayPtr(new Int32Array(3, to_buffer(split_values))));
+  ASSERT_OK(left.Validate());
+  ASSERT_OK(right.Validate());
+  ASSERT_TRUE(left.Equals(right));
+  ASSERT_TRUE(right.Equals(left));
+  ASSERT_TRUE(left.RangeEquals(1, 4, 1, right));
+
+  split_values[2] = 3;
+  ASSERT_FALSE(left.Equals(right));
+  ASSERT_TRUE(left.RangeEquals(0, 3, 0, right));
+  ASSERT_FALSE(left.RangeEquals(2, 4, 2, right));
+}
+
+
+TEST_F(TestRunEnd, TestValidate) {
+  TypePtr type(new RunEndType(TypePtr(new Int32Type())));
+  vector<int32_t> values = {1, 2, 3};
+  vector<vector<int32_t> > bad_run_ends = {{0, 2, 3}, {2, 2, 3}, {3, 2, 5}};
+  for (const vector<int32_t>& run_ends : bad_run_ends) {
+    RunEndArray array(type, ArrayPtr(new Int32Array(3, to_buffer(run_ends))),
+        ArrayPtr(new Int32Array(3, to_buffer(values))));
+    ASSERT_TRUE(array.Validate().IsInvalid());
+  }
+
+  // One value per run
+  vector<int32_t> run_ends = {1, 2};
+  RunEndArray mismatched(type, ArrayPtr(new Int32Array(2,
+              to_buffer(run_ends))),
+      ArrayPtr(new Int32Array(3, to_buffer(values))));
+  ASSERT_TRUE(mismatched.Validate().IsInvalid());
+
+  vector<int64_t> wide_run_ends = {1, 2, 3};
+  RunEndArray wide(type, ArrayPtr(new Int64Array(3,
+              to_buffer(wide_run_ends))),
+      ArrayPtr(new Int32Array(3, to_buffer(values))));
+  ASSERT_TRUE(wide.Validate().IsInvalid());
+}
+
+
+TEST_F(TestRunEnd, TestSum) {
+  MakeRuns(2000, 50, 0.3);
+  Int32Array plain(values_.size(), to_buffer(values_),
+      bytes_to_null_buffer(nulls_.data(), nulls_.size()));
+  unique_ptr<Array> encoded = Encode(plain);
+  const RunEndArray& runs = static_cast<const RunEndArray&>(*encoded);
+
+  int64_t expected = 0;
+  for (size_t i = 0; i < values_.size(); ++i) {
+    if (!nulls_[i]) expected += values_[i];
+  }
+  int64_t sum;
+  ASSERT_OK(RunEndSum<Int32Type>(runs, &sum));
+  ASSERT_EQ(expected, sum);
+
+  // The wrong type
+  double dsum;
+  ASSERT_TRUE(RunEndSum<DoubleType>(runs, &dsum).IsInvalid());
+
+  // A long run of a large value overflows
+  RunEndBuilder<Int64Type> builder(pool_.get(),
+      TypePtr(new RunEndType(TypePtr(new Int64Type()))));
+  ASSERT_OK(builder.AppendRun(std::numeric_limits<int64_t>::max() / 2, 3));
+  Array* out;
+  ASSERT_OK(builder.ToArray(&out));
+  unique_ptr<Array> big(out);
+  ASSERT_TRUE(RunEndSum<Int64Type>(static_cast<RunEndArray&>(*big),
+          &sum).IsInvalid());
+
+  RunEndBuilder<DoubleType> double_builder(pool_.get(),
+      TypePtr(new RunEndType(TypePtr(new DoubleType()))));
+  ASSERT_OK(double_builder.AppendRun(0.5, 7));
+  ASSERT_OK(double_builder.AppendRun(2, 3));
+  ASSERT_OK(double_builder.ToArray(&out));
+  unique_ptr<Array> doubles(out);
+  ASSERT_OK(RunEndSum<DoubleType>(static_cast<RunEndArray&>(*doubles),
+          &dsum));
+  ASSERT_DOUBLE_EQ(9.5, dsum);
+}
+
+
+TEST_F(TestRunEnd, TestCompare) {
+  MakeRuns(1000, 20, 0.2);
+  Int32Array plain(values_.size(), to_buffer(values_),
+      bytes_to_null_buffer(nulls_.data(), nulls_.size()));
+  unique_ptr<Array> encoded = Encode(plain);
+  const RunEndArray& runs = static_cast<const RunEndArray&>(*encoded);
+
+  for (CompareOperator op : {CompareOperator::EQUAL,
+          CompareOperator::NOT_EQUAL, CompareOperator::LESS,
+          CompareOperator::LESS_EQUAL, CompareOperator::GREATER,
+          CompareOperator::GREATER_EQUAL}) {
+    Array* out;
+    ASSERT_OK(RunEndCompare<Int32Type>(pool_.get(), runs, op,
+            values_[500], &out));
+    unique_ptr<Array> result(out);
+    ASSERT_OK(result->Validate());
+
+    // The run ends are shared
+    const RunEndArray& result_runs = static_cast<const RunEndArray&>(*result);
+    ASSERT_EQ(runs.run_ends(), result_runs.run_ends());
+
+    unique_ptr<Array> decoded = Decode(*result);
+    const BooleanArray& bools = static_cast<const BooleanArray&>(*decoded);
+    for (size_t i = 0; i < values_.size(); ++i) {
+      ASSERT_EQ(static_cast<bool>(nulls_[i]), bools.IsNull(i));
+      if (nulls_[i]) continue;
+      int32_t v = values_[i];
+      int32_t s = values_[500];
+      bool expected = false;
+      switch (op) {
+        case CompareOperator::EQUAL: expected = v == s; break;
+        case CompareOperator::NOT_EQUAL: expected = v != s; break;
+        case CompareOperator::LESS: expected = v < s; break;
+        case CompareOperator::LESS_EQUAL: expected = v <= s; break;
+        case CompareOperator::GREATER: expected = v > s; break;
+        case CompareOperator::GREATER_EQUAL: expected = v >= s; break;
+      }
+      ASSERT_EQ(expected, static_cast<bool>(bools.Value(i))) << i;
+    }
+  }
+}
+
+
+TEST_F(TestRunEnd, TestFilter) {
+  MakeRuns(1000, 30, 0.2);
+  Int32Array plain(values_.size(), to_buffer(values_),
+      bytes_to_null_buffer(nulls_.data(), nulls_.size()));
+  unique_ptr<Array> encoded = Encode(plain);
+
+  for (double probability : {0.0, 0.05, 0.5, 1.0}) {
+    vector<uint8_t> bytes;
+    random_nulls(values_.size(), 1 - probability, bytes);
+    vector<uint8_t> selection((bytes.size() + 7) / 8, 0);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      util::set_bit(selection.data(), i, bytes[i] != 0);
+    }
+
+    Array* out;
+    ASSERT_OK(RunEndFilter(pool_.get(),
+            static_cast<const RunEndArray&>(*encoded), selection.data(),
+            &out));
+    unique_ptr<Array> result(out);
+    ASSERT_OK(result->Validate());
+
+    ASSERT_OK(Filter(pool_.get(), plain, selection.data(), &out));
+    unique_ptr<Array> expected(out);
+    ASSERT_TRUE(Decode(*result)->Equals(*expected));
+  }
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,295 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/run-end.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "arrow/builder.h"
+#include "arrow/compute/kernel-util.h"
+#include "arrow/compute/take.h"
+#include "arrow/types/boolean.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+static inline bool is_null(const uint8_t* null_bits, size_t i) {
+  return null_bits != nullptr && util::get_bit(null_bits, i);
+}
+
+template <typename TypeClass>
+const PrimitiveArrayImpl<TypeClass>& run_values(const RunEndArray& values) {
+  return static_cast<const PrimitiveArrayImpl<TypeClass>&>(*values.values());
+}
+
+Status make_int32_array(MemoryPool* pool, const std::vector<int32_t>& values,
+    ArrayPtr* out) {
+  Buffer* buf;
+  RETURN_NOT_OK(pool->NewBuffer(values.size() * sizeof(int32_t), &buf));
+  if (!values.empty()) {
+    memcpy(buf->data(), values.data(), values.size() * sizeof(int32_t));
+  }
+  out->reset(new Int32Array(values.size(), buf));
+  return Status::OK();
+}
+
+struct EncodeVisitor {
+  MemoryPool* pool;
+  const Array& values;
+  Array** out;
+
+  template <typename TypeClass>
+  Status Visit() {
+    const auto& array = static_cast<const PrimitiveArrayImpl<TypeClass>&>(
+        values);
+    const typename TypeClass::c_type* data = array.raw_data();
+    const uint8_t* null_bits = array.null_bits();
+
+    // The builder merges equal neighbours into runs
+    RunEndBuilder<TypeClass> builder(pool,
+        TypePtr(new RunEndType(values.type())));
+    if (null_bits == nullptr) {
+      RETURN_NOT_OK(builder.Append(data, array.length()));
+    } else {
+      for (size_t i = 0; i < array.length(); ++i) {
+        RETURN_NOT_OK(builder.Append(data[i], util::get_bit(null_bits, i)));
+      }
+    }
+    return builder.ToArray(out);
+  }
+};
+
+struct DecodeVisitor {
+  MemoryPool* pool;
+  const RunEndArray& values;
+  Array** out;
+
+  template <typename TypeClass>
+  Status Visit() {
+    typedef typename TypeClass::c_type T;
+    const PrimitiveArrayImpl<TypeClass>& array = run_values<TypeClass>(values);
+    const T* data = array.raw_data();
+    const uint8_t* null_bits = array.null_bits();
+    size_t length = values.length();
+
+    Buffer* out_data;
+    RETURN_NOT_OK(pool->NewBuffer(length * sizeof(T), &out_data));
+    Buffer* out_nulls = nullptr;
+    if (null_bits != nullptr) {
+      Status s = allocate_nulls(pool, length, &out_nulls);
+      if (!s.ok()) {
+        out_data->Decref();
+        return s;
+      }
+    }
+
+    T* out_values = reinterpret_cast<T*>(out_data->data());
+    for (size_t r = 0; r < values.num_runs(); ++r) {
+      size_t start = values.run_start(r);
+      size_t end = values.run_end(r);
+      std::fill(out_values + start, out_values + end, data[r]);
+      if (is_null(null_bits, r)) {
+        util::set_bits(out_nulls->data(), start, end - start);
+      }
+    }
+    *out = new PrimitiveArrayImpl<TypeClass>(length, out_data, out_nulls);
+    return Status::OK();
+  }
+};
+
+// Add value * count to *sum, returning true on overflow
+template <typename Acc>
+static inline bool add_product_overflows(Acc* sum, Acc value, Acc count) {
+  Acc product;
+  return __builtin_mul_overflow(value, count, &product) ||
+    __builtin_add_overflow(*sum, product, sum);
+}
+
+static inline bool add_product_overflows(double* sum, double value,
+    double count) {
+  *sum += value * count;
+  return false;
+}
+
+template <typename T, typename Op>
+void compare_runs(const T* data, size_t num_runs, T scalar, Op op,
+    uint8_t* out) {
+  for (size_t r = 0; r < num_runs; ++r) {
+    out[r] = op(data[r], scalar);
+  }
+}
+
+} // namespace
+
+Status RunEndEncode(MemoryPool* pool, const Array& values, Array** out) {
+  // The run value builder would drop the unit
+  if (is_temporal(values.type_enum())) {
+    return Status::NotImplemented(values.type()->ToString());
+  }
+  EncodeVisitor visitor = {pool, values, out};
+  return visit_primitive(values.type_enum(), &visitor);
+}
+
+Status RunEndDecode(MemoryPool* pool, const RunEndArray& values,
+    Array** out) {
+  const Array& run_values = *values.values();
+  if (is_primitive(run_values.type_enum()) &&
+      !is_temporal(run_values.type_enum())) {
+    DecodeVisitor visitor = {pool, values, out};
+    return visit_primitive(run_values.type_enum(), &visitor);
+  }
+
+  // Gather the run value of every slot
+  Buffer* index_buf;
+  RETURN_NOT_OK(pool->NewBuffer(values.length() * sizeof(int32_t),
+          &index_buf));
+  int32_t* run_indices = reinterpret_cast<int32_t*>(index_buf->data());
+  for (size_t r = 0; r < values.num_runs(); ++r) {
+    std::fill(run_indices + values.run_start(r),
+        run_indices + values.run_end(r), static_cast<int32_t>(r));
+  }
+  Int32Array indices(values.length(), index_buf);
+  return Take(pool, run_values, indices, out);
+}
+
+template <typename TypeClass>
+Status RunEndSum(const RunEndArray& values,
+    typename sum_type<TypeClass>::type* out) {
+  typedef typename sum_type<TypeClass>::type Acc;
+  if (values.values()->type_enum() != TypeClass::type_enum) {
+    return Status::Invalid("run values are " +
+        values.values()->type()->ToString());
+  }
+  const PrimitiveArrayImpl<TypeClass>& array = run_values<TypeClass>(values);
+  const typename TypeClass::c_type* data = array.raw_data();
+  const uint8_t* null_bits = array.null_bits();
+
+  Acc sum = 0;
+  bool overflow = false;
+  for (size_t r = 0; r < values.num_runs(); ++r) {
+    if (is_null(null_bits, r)) continue;
+    overflow |= add_product_overflows(&sum, static_cast<Acc>(data[r]),
+        static_cast<Acc>(values.run_end(r) - values.run_start(r)));
+  }
+  if (overflow) {
+    return Status::Invalid("integer sum overflows");
+  }
+  *out = sum;
+  return Status::OK();
+}
+
+template <typename TypeClass>
+Status RunEndCompare(MemoryPool* pool, const RunEndArray& values,
+    CompareOperator op, typename TypeClass::c_type scalar, Array** out) {
+  typedef typename TypeClass::c_type T;
+  if (values.values()->type_enum() != TypeClass::type_enum) {
+    return Status::Invalid("run values are " +
+        values.values()->type()->ToString());
+  }
+  const PrimitiveArrayImpl<TypeClass>& array = run_values<TypeClass>(values);
+  const T* data = array.raw_data();
+  size_t num_runs = values.num_runs();
+
+  Buffer* out_data;
+  RETURN_NOT_OK(pool->NewBuffer(num_runs, &out_data));
+  uint8_t* results = out_data->data();
+  switch (op) {
+    case CompareOperator::EQUAL:
+      compare_runs(data, num_runs, scalar, std::equal_to<T>(), results);
+      break;
+    case CompareOperator::NOT_EQUAL:
+      compare_runs(data, num_runs, scalar, std::not_equal_to<T>(), results);
+      break;
+    case CompareOperator::LESS:
+      compare_runs(data, num_runs, scalar, std::less<T>(), results);
+      break;
+    case CompareOperator::LESS_EQUAL:
+      compare_runs(data, num_runs, scalar, std::less_equal<T>(), results);
+      break;
+    case CompareOperator::GREATER:
+      compare_runs(data, num_runs, scalar, std::greater<T>(), results);
+      break;
+    case CompareOperator::GREATER_EQUAL:
+      compare_runs(data, num_runs, scalar, std::greater_equal<T>(), results);
+      break;
+  }
+
+  // The results share the null runs, and the run ends, of values
+  Buffer* nulls = array.nulls();
+  if (nulls != nullptr) {
+    nulls->Incref();
+  }
+  ArrayPtr result_values(new BooleanArray(num_runs, out_data, nulls));
+  *out = new RunEndArray(TypePtr(new RunEndType(result_values->type(),
+              values.type()->nullable)), values.run_ends(), result_values);
+  return Status::OK();
+}
+
+Status RunEndFilter(MemoryPool* pool, const RunEndArray& values,
+    const uint8_t* selection, Array** out) {
+  std::vector<int32_t> kept_runs;
+  std::vector<int32_t> run_ends;
+  size_t length = 0;
+  for (size_t r = 0; r < values.num_runs(); ++r) {
+    size_t start = values.run_start(r);
+    size_t selected = util::count_set_bits(selection, start,
+        values.run_end(r) - start);
+    if (selected > 0) {
+      length += selected;
+      kept_runs.push_back(r);
+      run_ends.push_back(length);
+    }
+  }
+
+  ArrayPtr run_indices;
+  RETURN_NOT_OK(make_int32_array(pool, kept_runs, &run_indices));
+  Array* kept_values;
+  RETURN_NOT_OK(Take(pool, *values.values(),
+          static_cast<const Int32Array&>(*run_indices), &kept_values));
+  ArrayPtr result_values(kept_values);
+  ArrayPtr result_run_ends;
+  RETURN_NOT_OK(make_int32_array(pool, run_ends, &result_run_ends));
+  *out = new RunEndArray(values.type(), result_run_ends, result_values);
+  return Status::OK();
+}
+
+#define RUN_END_INSTANTIATE(TypeClass)                                  \
+  template Status RunEndSum<TypeClass>(const RunEndArray&,              \
+      sum_type<TypeClass>::type*);                                      \
+  template Status RunEndCompare<TypeClass>(MemoryPool*,                 \
+      const RunEndArray&, CompareOperator, TypeClass::c_type, Array**);
+
+RUN_END_INSTANTIATE(Int8Type);
+RUN_END_INSTANTIATE(UInt8Type);
+RUN_END_INSTANTIATE(Int16Type);
+RUN_END_INSTANTIATE(UInt16Type);
+RUN_END_INSTANTIATE(Int32Type);
+RUN_END_INSTANTIATE(UInt32Type);
+RUN_END_INSTANTIATE(Int64Type);
+RUN_END_INSTANTIATE(UInt64Type);
+RUN_END_INSTANTIATE(FloatType);
+RUN_END_INSTANTIATE(DoubleType);
+
+#undef RUN_END_INSTANTIATE
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,81 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_RUN_END_H
+#define ARROW_COMPUTE_RUN_END_H
+
+#include <cstdint>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/aggregate.h"
+#include "arrow/types/run-end.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Kernels on run-end encoded arrays. Apart from the encoding and decoding,
+// they do work per run rather than per slot, so their cost depends on the
+// number of runs and not on the length
+
+// Encode a primitive array as a RunEndArray with one run per maximal
+// stretch of bitwise equal values or of nulls. Temporal arrays are not
+// supported. The caller owns the returned array
+Status RunEndEncode(MemoryPool* pool, const Array& values, Array** out);
+
+// Expand a RunEndArray into a plain array of its value type. Slots of null
+// runs are null. Primitive values are filled run by run; other value types
+// are gathered with Take. The caller owns the returned array
+Status RunEndDecode(MemoryPool* pool, const RunEndArray& values, Array** out);
+
+// Sum of the non-null slots, each run adding its value times its length.
+// Integer sums are exact, and Invalid is returned if the sum does not fit in
+// the widened type. Returns Invalid if the values are not of TypeClass
+template <typename TypeClass>
+Status RunEndSum(const RunEndArray& values,
+    typename sum_type<TypeClass>::type* out);
+
+enum class CompareOperator {
+  EQUAL,
+  NOT_EQUAL,
+  LESS,
+  LESS_EQUAL,
+  GREATER,
+  GREATER_EQUAL
+};
+
+// Compare every slot with a scalar, as a RunEndArray of booleans that
+// shares the run ends of values, so that only one comparison is made per
+// run. Null runs are null. Adjacent runs may have the same result, as the
+// runs are not merged. Returns Invalid if the values are not of TypeClass.
+// The caller owns the returned array
+template <typename TypeClass>
+Status RunEndCompare(MemoryPool* pool, const RunEndArray& values,
+    CompareOperator op, typename TypeClass::c_type scalar, Array** out);
+
+// Keep the slots whose bit is set in the selection bitmap, which has one
+// bit per slot of values. Each run is cut down to its number of selected
+// slots, counted with popcount, and runs with none are dropped. The values
+// of the remaining runs are gathered with Take. The caller owns the
+// returned array
+Status RunEndFilter(MemoryPool* pool, const RunEndArray& values,
+    const uint8_t* selection, Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_RUN_END_H
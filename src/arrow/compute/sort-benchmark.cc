@@ -0,0 +1,102 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/sort.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+template <typename ArrayType, typename T>
+static void BenchmarkSort(MemoryPool* pool, const std::vector<T>& values,
+    const std::string& label) {
+  ArrayType array(values.size(), benchmark::make_buffer(pool, values));
+  size_t bytes = values.size() * sizeof(T);
+
+  // The approach being replaced: copy out and comparison sort
+  benchmark::run(("std::sort/" + label).c_str(), bytes, [&]() {
+        std::vector<T> copy(array.raw_data(), array.raw_data() + values.size());
+        std::sort(copy.begin(), copy.end());
+      });
+
+  for (int num_threads : {1, 4}) {
+    SortOptions options;
+    options.num_threads = num_threads;
+    std::string suffix = label + "/threads:" + std::to_string(num_threads);
+
+    benchmark::run(("Sort/" + suffix).c_str(), bytes, [&]() {
+          Array* out;
+          BENCHMARK_OK(Sort(pool, array, options, &out));
+          delete out;
+        });
+    benchmark::run(("ArgSort/" + suffix).c_str(), bytes, [&]() {
+          Array* out;
+          BENCHMARK_OK(ArgSort(pool, array, options, &out));
+          delete out;
+        });
+  }
+}
+
+static void BenchmarkInt32(MemoryPool* pool) {
+  Random rng(random_seed());
+  std::vector<int32_t> values(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = static_cast<int32_t>(rng.Next()) - (1 << 30);
+  }
+  BenchmarkSort<Int32Array>(pool, values, "int32");
+}
+
+static void BenchmarkInt64(MemoryPool* pool) {
+  Random rng(random_seed());
+  std::vector<int64_t> values(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = static_cast<int64_t>(rng.Next64());
+  }
+  BenchmarkSort<Int64Array>(pool, values, "int64");
+}
+
+static void BenchmarkDouble(MemoryPool* pool) {
+  Random rng(random_seed());
+  std::vector<double> values(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = rng.Normal(0, 1000);
+  }
+  BenchmarkSort<DoubleArray>(pool, values, "double");
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkInt32(&pool);
+  arrow::compute::BenchmarkInt64(&pool);
+  arrow::compute::BenchmarkDouble(&pool);
+  return 0;
+}
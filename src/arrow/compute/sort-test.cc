@@ -0,0 +1,183 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/sort.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestSort : public TestBase {
+ public:
+  void DoSort(const Array& values) {
+    Array* out;
+    ASSERT_OK(Sort(pool_.get(), values, options_, &out));
+    sorted_.reset(out);
+    ASSERT_OK(ArgSort(pool_.get(), values, options_, &out));
+    indices_.reset(static_cast<Int32Array*>(out));
+    ASSERT_EQ(values.length(), sorted_->length());
+    ASSERT_EQ(values.length(), indices_->length());
+  }
+
+ protected:
+  SortOptions options_;
+  unique_ptr<Array> sorted_;
+  unique_ptr<Int32Array> indices_;
+};
+
+
+template <typename ArrayType, typename T>
+void CheckSorted(const vector<T>& values, const vector<uint8_t>& nulls,
+    bool nulls_first, const Array& sorted, const Int32Array& indices) {
+  // The expected order of the non-null values is that of a stable sort
+  vector<int32_t> expected;
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (nulls.empty() || !nulls[i]) expected.push_back(i);
+  }
+  std::stable_sort(expected.begin(), expected.end(),
+      [&](int32_t a, int32_t b) { return values[a] < values[b]; });
+  vector<int32_t> null_indices;
+  for (size_t i = 0; i < nulls.size(); ++i) {
+    if (nulls[i]) null_indices.push_back(i);
+  }
+  expected.insert(nulls_first ? expected.begin() : expected.end(),
+      null_indices.begin(), null_indices.end());
+
+  const ArrayType& typed = static_cast<const ArrayType&>(sorted);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], indices.Value(i));
+    bool is_null = !nulls.empty() && nulls[expected[i]];
+    ASSERT_EQ(is_null, sorted.IsNull(i));
+    if (!is_null) {
+      ASSERT_EQ(values[expected[i]], typed.Value(i));
+    }
+  }
+}
+
+
+TEST_F(TestSort, TestInt32) {
+  size_t n = 1000;
+  vector<int32_t> values;
+  randint<int32_t>(n, -100, 100, values);
+  Int32Array array(n, to_buffer(values));
+
+  DoSort(array);
+  ASSERT_FALSE(sorted_->nullable());
+  CheckSorted<Int32Array>(values, {}, false, *sorted_, *indices_);
+}
+
+
+TEST_F(TestSort, TestInt64Extremes) {
+  vector<int64_t> values = {0, std::numeric_limits<int64_t>::max(), -1,
+                            std::numeric_limits<int64_t>::min(), 1, 1 << 20};
+  Int64Array array(values.size(), to_buffer(values));
+
+  DoSort(array);
+  CheckSorted<Int64Array>(values, {}, false, *sorted_, *indices_);
+}
+
+
+TEST_F(TestSort, TestUInt8) {
+  vector<uint8_t> values = {200, 3, 255, 0, 3, 17};
+  UInt8Array array(values.size(), to_buffer(values));
+
+  DoSort(array);
+  CheckSorted<UInt8Array>(values, {}, false, *sorted_, *indices_);
+}
+
+
+TEST_F(TestSort, TestNulls) {
+  size_t n = 1000;
+  vector<int64_t> values;
+  vector<uint8_t> nulls;
+  randint<int64_t>(n, -1000000000, 1000000000, values);
+  random_nulls(n, 0.2, nulls);
+  Int64Array array(n, to_buffer(values), bytes_to_null_buffer(nulls.data(), n));
+
+  for (bool nulls_first : {false, true}) {
+    options_.nulls_first = nulls_first;
+    DoSort(array);
+    ASSERT_TRUE(sorted_->nullable());
+    CheckSorted<Int64Array>(values, nulls, nulls_first, *sorted_, *indices_);
+  }
+}
+
+
+TEST_F(TestSort, TestDouble) {
+  double inf = std::numeric_limits<double>::infinity();
+  vector<double> values = {1.5, -0.5, inf, -inf, 0.0, -1e300, 1e-300, -2.5,
+                           1.5, 42.0};
+  DoubleArray array(values.size(), to_buffer(values));
+
+  DoSort(array);
+  CheckSorted<DoubleArray>(values, {}, false, *sorted_, *indices_);
+}
+
+
+TEST_F(TestSort, TestNaN) {
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  vector<double> values = {nan, 1.0, -nan, -1.0};
+  DoubleArray array(values.size(), to_buffer(values));
+
+  DoSort(array);
+  DoubleArray* sorted = static_cast<DoubleArray*>(sorted_.get());
+  ASSERT_EQ(-1.0, sorted->Value(0));
+  ASSERT_EQ(1.0, sorted->Value(1));
+  ASSERT_TRUE(std::isnan(sorted->Value(2)));
+  ASSERT_TRUE(std::isnan(sorted->Value(3)));
+
+  // NaNs keep their relative order
+  vector<int32_t> expected = {3, 1, 0, 2};
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], indices_->Value(i));
+  }
+}
+
+
+TEST_F(TestSort, TestParallel) {
+  // Large enough for the parallel path, with many equal keys so that
+  // stability across thread chunks is exercised
+  size_t n = kParallelSortMinLength + 12345;
+  vector<float> values;
+  vector<uint8_t> nulls;
+  randint<float>(n, -5000, 5000, values);
+  random_nulls(n, 0.1, nulls);
+  FloatArray array(n, to_buffer(values), bytes_to_null_buffer(nulls.data(), n));
+
+  options_.num_threads = 4;
+  DoSort(array);
+  CheckSorted<FloatArray>(values, nulls, false, *sorted_, *indices_);
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,286 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/sort.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "arrow/compute/kernel-util.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+static constexpr size_t kRadixBits = 8;
+static constexpr size_t kRadixSize = 1 << kRadixBits;
+
+// Maps a value to an unsigned key whose unsigned order is the value order
+template <typename T, typename Enable = void>
+struct SortKey {};
+
+template <typename T>
+struct SortKey<T, typename std::enable_if<std::is_unsigned<T>::value>::type> {
+  typedef T type;
+
+  static type Encode(T value) { return value; }
+  static T Decode(type key) { return key; }
+};
+
+// Flipping the sign bit moves negative values below positive ones
+template <typename T>
+struct SortKey<T, typename std::enable_if<std::is_integral<T>::value &&
+                                          std::is_signed<T>::value>::type> {
+  typedef typename std::make_unsigned<T>::type type;
+  static constexpr type kSignBit = static_cast<type>(1) << (sizeof(T) * 8 - 1);
+
+  static type Encode(T value) { return static_cast<type>(value) ^ kSignBit; }
+  static T Decode(type key) { return static_cast<T>(key ^ kSignBit); }
+};
+
+// Positive floats order like their bit patterns once the sign bit is set.
+// Negative floats order in reverse, so all of their bits are flipped. Every
+// NaN is mapped to the largest key
+template <typename T>
+struct SortKey<T, typename std::enable_if<
+                    std::is_floating_point<T>::value>::type> {
+  typedef typename util::uint_for_width<sizeof(T)>::type type;
+  static constexpr type kSignBit = static_cast<type>(1) << (sizeof(T) * 8 - 1);
+
+  static type Encode(T value) {
+    if (value != value) {
+      return ~static_cast<type>(0);
+    }
+    type bits;
+    memcpy(&bits, &value, sizeof(T));
+    return (bits & kSignBit) ? ~bits : bits | kSignBit;
+  }
+
+  static T Decode(type key) {
+    type bits = (key & kSignBit) ? key ^ kSignBit : ~key;
+    T value;
+    memcpy(&value, &bits, sizeof(T));
+    return value;
+  }
+};
+
+template <typename K>
+inline size_t digit(K key, size_t pass) {
+  return (key >> (pass * kRadixBits)) & (kRadixSize - 1);
+}
+
+// LSD radix sort of keys, carrying the indices along when indices is not
+// null. The scratch buffers must be as long as keys. With more than one
+// thread the input is split into contiguous chunks: each thread counts the
+// digits of its chunk, and since chunk t's values of a digit are placed after
+// those of chunks 0 .. t-1, every pass remains stable
+template <typename K>
+void RadixSort(K* keys, K* scratch_keys, uint32_t* indices,
+    uint32_t* scratch_indices, size_t n, int num_threads) {
+  static constexpr size_t kPasses = sizeof(K) * 8 / kRadixBits;
+  if (n < 2) return;
+
+  // Digit counts of every pass, from a single read of the keys, to find the
+  // passes on which all keys share a digit
+  std::vector<size_t> counts(kPasses * kRadixSize, 0);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+      ++counts[pass * kRadixSize + digit(keys[i], pass)];
+    }
+  }
+
+  std::vector<size_t> offsets(num_threads * kRadixSize);
+  K* src = keys;
+  K* dst = scratch_keys;
+  uint32_t* src_idx = indices;
+  uint32_t* dst_idx = scratch_indices;
+  for (size_t pass = 0; pass < kPasses; ++pass) {
+    const size_t* pass_counts = counts.data() + pass * kRadixSize;
+    if (pass_counts[digit(src[0], pass)] == n) continue;
+
+    if (num_threads == 1) {
+      size_t position = 0;
+      for (size_t b = 0; b < kRadixSize; ++b) {
+        offsets[b] = position;
+        position += pass_counts[b];
+      }
+    } else {
+      parallel_for(num_threads, [&](int t) {
+            size_t* chunk_counts = offsets.data() + t * kRadixSize;
+            std::fill(chunk_counts, chunk_counts + kRadixSize, 0);
+            size_t end = n * (t + 1) / num_threads;
+            for (size_t i = n * t / num_threads; i < end; ++i) {
+              ++chunk_counts[digit(src[i], pass)];
+            }
+          });
+      size_t position = 0;
+      for (size_t b = 0; b < kRadixSize; ++b) {
+        for (int t = 0; t < num_threads; ++t) {
+          size_t count = offsets[t * kRadixSize + b];
+          offsets[t * kRadixSize + b] = position;
+          position += count;
+        }
+      }
+    }
+
+    parallel_for(num_threads, [&](int t) {
+          size_t* chunk_offsets = offsets.data() + t * kRadixSize;
+          size_t end = n * (t + 1) / num_threads;
+          for (size_t i = n * t / num_threads; i < end; ++i) {
+            size_t j = chunk_offsets[digit(src[i], pass)]++;
+            dst[j] = src[i];
+            if (src_idx != nullptr) {
+              dst_idx[j] = src_idx[i];
+            }
+          }
+        });
+    std::swap(src, dst);
+    std::swap(src_idx, dst_idx);
+  }
+
+  if (src != keys) {
+    memcpy(keys, src, n * sizeof(K));
+    if (indices != nullptr) {
+      memcpy(indices, src_idx, n * sizeof(uint32_t));
+    }
+  }
+}
+
+struct SortVisitor {
+  MemoryPool* pool;
+  const Array& values;
+  const SortOptions& options;
+  bool arg_sort;
+  Array* out;
+
+  template <typename TypeClass>
+  Status Visit() {
+    typedef typename TypeClass::c_type T;
+    typedef SortKey<T> Key;
+    typedef typename Key::type K;
+
+    size_t n = values.length();
+    const T* data = static_cast<const PrimitiveArrayImpl<TypeClass>&>(
+        values).raw_data();
+    const uint8_t* null_bits = values.null_bits();
+    size_t num_nulls = null_bits == nullptr ? 0 :
+      util::count_set_bits(null_bits, 0, n);
+    size_t num_values = n - num_nulls;
+
+    // The non-null values are sorted apart from the nulls
+    std::vector<K> keys(num_values);
+    std::vector<K> scratch_keys(num_values);
+    std::vector<uint32_t> indices(arg_sort ? num_values : 0);
+    std::vector<uint32_t> scratch_indices(indices.size());
+    for (size_t i = 0, j = 0; i < n; ++i) {
+      if (null_bits != nullptr && util::get_bit(null_bits, i)) continue;
+      keys[j] = Key::Encode(data[i]);
+      if (arg_sort) {
+        indices[j] = static_cast<uint32_t>(i);
+      }
+      ++j;
+    }
+
+    int num_threads = n >= kParallelSortMinLength ? options.num_threads : 1;
+    RadixSort(keys.data(), scratch_keys.data(),
+        arg_sort ? indices.data() : nullptr,
+        arg_sort ? scratch_indices.data() : nullptr, num_values,
+        num_threads > 1 ? num_threads : 1);
+
+    size_t value_start = options.nulls_first ? num_nulls : 0;
+    size_t null_start = options.nulls_first ? 0 : num_values;
+    if (arg_sort) {
+      return MakeIndices(indices, value_start, null_start, num_nulls);
+    }
+
+    Buffer* data_buf;
+    RETURN_NOT_OK(pool->NewBuffer(n * sizeof(T), &data_buf));
+    T* sorted = reinterpret_cast<T*>(data_buf->data());
+    for (size_t j = 0; j < num_values; ++j) {
+      sorted[value_start + j] = Key::Decode(keys[j]);
+    }
+    std::fill(sorted + null_start, sorted + null_start + num_nulls, T());
+
+    Buffer* nulls = nullptr;
+    TypePtr type = values.type();
+    if (values.nullable() || null_bits != nullptr) {
+      Status s = allocate_nulls(pool, n, &nulls);
+      if (!s.ok()) {
+        data_buf->Decref();
+        return s;
+      }
+      util::set_bits(nulls->data(), null_start, num_nulls);
+      type = nullable_type(type);
+    }
+    return make_primitive_array(type, n, data_buf, nulls, &out);
+  }
+
+  Status MakeIndices(const std::vector<uint32_t>& indices, size_t value_start,
+      size_t null_start, size_t num_nulls) {
+    size_t n = values.length();
+    Buffer* data_buf;
+    RETURN_NOT_OK(pool->NewBuffer(n * sizeof(int32_t), &data_buf));
+    int32_t* dst = reinterpret_cast<int32_t*>(data_buf->data());
+    memcpy(dst + value_start, indices.data(),
+        indices.size() * sizeof(uint32_t));
+
+    const uint8_t* null_bits = values.null_bits();
+    util::visit_set_runs(null_bits, num_nulls > 0 ? n : 0,
+        [&](size_t start, size_t length) {
+          for (size_t i = 0; i < length; ++i) {
+            dst[null_start++] = static_cast<int32_t>(start + i);
+          }
+        });
+    out = new Int32Array(n, data_buf);
+    return Status::OK();
+  }
+};
+
+Status DoSort(MemoryPool* pool, const Array& values,
+    const SortOptions& options, bool arg_sort, Array** out) {
+  if (!is_primitive(values.type_enum())) {
+    return Status::NotImplemented(values.type()->ToString());
+  }
+  if (arg_sort && values.length() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return Status::Invalid("too many values to sort with int32 indices");
+  }
+
+  SortVisitor visitor = {pool, values, options, arg_sort, nullptr};
+  RETURN_NOT_OK(visit_primitive(values.type_enum(), &visitor));
+  *out = visitor.out;
+  return Status::OK();
+}
+
+} // namespace
+
+Status Sort(MemoryPool* pool, const Array& values, const SortOptions& options,
+    Array** out) {
+  return DoSort(pool, values, options, false, out);
+}
+
+Status ArgSort(MemoryPool* pool, const Array& values,
+    const SortOptions& options, Array** out) {
+  return DoSort(pool, values, options, true, out);
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,63 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_SORT_H
+#define ARROW_COMPUTE_SORT_H
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Arrays at least this long are split between the threads requested in
+// SortOptions; shorter arrays are always sorted on the calling thread
+static constexpr size_t kParallelSortMinLength = 1 << 20;
+
+struct SortOptions {
+  SortOptions() : nulls_first(false), num_threads(1) {}
+
+  // Whether null slots are placed before or after all non-null values
+  bool nulls_first;
+
+  // Number of threads used for arrays of at least kParallelSortMinLength
+  int num_threads;
+};
+
+// Sort the values of a primitive array in ascending order into a new array
+// allocated from pool.
+//
+// Values are sorted with a least-significant-digit radix sort on 8-bit
+// digits, so the sort is stable and takes one pass per byte of the value
+// width; passes on which every value has the same digit are skipped. Signed
+// integers and floating point values are first mapped to unsigned keys with
+// the same ordering. For floating point values -0.0 sorts before 0.0 and
+// NaNs sort after +inf. The caller owns the returned array
+Status Sort(MemoryPool* pool, const Array& values, const SortOptions& options,
+    Array** out);
+
+// The permutation that sorts values, as an Int32Array of indices into
+// values, such that Take(values, indices) is the output of Sort. Equal values
+// and nulls keep their original relative order. The caller owns the
+// returned array
+Status ArgSort(MemoryPool* pool, const Array& values,
+    const SortOptions& options, Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_SORT_H
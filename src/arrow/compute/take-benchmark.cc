@@ -0,0 +1,108 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/take.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/string.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+static constexpr size_t kNumIndices = 1 << 20;
+
+// Index patterns: in order, runs of neighbouring rows starting at random
+// positions (as produced by joins on clustered keys), and uniformly random
+static std::vector<int32_t> MakeIndices(const std::string& pattern) {
+  Random rng(random_seed());
+  std::vector<int32_t> indices(kNumIndices);
+  if (pattern == "sequential") {
+    for (size_t i = 0; i < kNumIndices; ++i) {
+      indices[i] = static_cast<int32_t>(i);
+    }
+  } else if (pattern == "clustered") {
+    size_t i = 0;
+    while (i < kNumIndices) {
+      int32_t start = rng.Uniform(kNumValues - 64);
+      for (int32_t j = 0; j < 32 && i < kNumIndices; ++j) {
+        indices[i++] = start + j;
+      }
+    }
+  } else {
+    for (size_t i = 0; i < kNumIndices; ++i) {
+      indices[i] = rng.Uniform(kNumValues);
+    }
+  }
+  return indices;
+}
+
+static void BenchmarkTake(MemoryPool* pool, const Array& values,
+    const std::string& label, size_t bytes_per_value) {
+  for (const char* pattern : {"sequential", "clustered", "random"}) {
+    std::vector<int32_t> index_values = MakeIndices(pattern);
+    Int32Array indices(kNumIndices, benchmark::make_buffer(pool, index_values));
+
+    std::string name = "Take/" + label + "/" + pattern;
+    benchmark::run(name.c_str(), kNumIndices * bytes_per_value, [&]() {
+          Array* out;
+          BENCHMARK_OK(Take(pool, values, indices, &out));
+          delete out;
+        });
+  }
+}
+
+static void BenchmarkInt64(MemoryPool* pool) {
+  std::vector<int64_t> values(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    values[i] = static_cast<int64_t>(i * 7);
+  }
+  Int64Array array(kNumValues, benchmark::make_buffer(pool, values));
+  BenchmarkTake(pool, array, "int64", sizeof(int64_t));
+}
+
+static void BenchmarkString(MemoryPool* pool) {
+  // Strings of 0 to 15 bytes
+  std::vector<int32_t> offsets(kNumValues + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < kNumValues; ++i) {
+    offsets[i + 1] = offsets[i] + static_cast<int32_t>(i % 16);
+  }
+  std::vector<uint8_t> chars(offsets[kNumValues], 'x');
+
+  ArrayPtr bytes(new UInt8Array(chars.size(),
+          benchmark::make_buffer(pool, chars)));
+  StringArray array(kNumValues, benchmark::make_buffer(pool, offsets), bytes);
+  BenchmarkTake(pool, array, "string", 8 + sizeof(int32_t));
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkInt64(&pool);
+  arrow::compute::BenchmarkString(&pool);
+  return 0;
+}
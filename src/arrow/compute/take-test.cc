@@ -0,0 +1,260 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/take.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestTake : public TestBase {
+ public:
+  void MakeIndices(const vector<int32_t>& indices,
+      const vector<uint8_t>& nulls = {}) {
+    index_values_ = indices;
+    index_nulls_ = nulls;
+    Buffer* null_buf = nulls.empty() ? nullptr :
+      bytes_to_null_buffer(index_nulls_.data(), index_nulls_.size());
+    indices_.reset(new Int32Array(indices.size(), to_buffer(index_values_),
+            null_buf));
+  }
+
+  void DoTake(const Array& values) {
+    Array* out;
+    ASSERT_OK(Take(pool_.get(), values, *indices_, &out));
+    result_.reset(out);
+    ASSERT_EQ(indices_->length(), result_->length());
+  }
+
+  bool IndexIsNull(size_t i) {
+    return !index_nulls_.empty() && index_nulls_[i];
+  }
+
+ protected:
+  vector<int32_t> index_values_;
+  vector<uint8_t> index_nulls_;
+  unique_ptr<Int32Array> indices_;
+  unique_ptr<Array> result_;
+};
+
+
+TEST_F(TestTake, TestPrimitive) {
+  size_t n = 1000;
+  vector<int64_t> values;
+  vector<uint8_t> nulls;
+  randint<int64_t>(n, -1000, 1000, values);
+  random_nulls(n, 0.2, nulls);
+  Int64Array array(n, to_buffer(values), bytes_to_null_buffer(nulls.data(), n));
+
+  vector<int32_t> indices;
+  randint<int32_t>(5000, 0, n, indices);
+  MakeIndices(indices);
+  DoTake(array);
+
+  Int64Array* result = static_cast<Int64Array*>(result_.get());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_EQ(static_cast<bool>(nulls[indices[i]]), result->IsNull(i));
+    if (!nulls[indices[i]]) {
+      ASSERT_EQ(values[indices[i]], result->Value(i));
+    }
+  }
+}
+
+
+TEST_F(TestTake, TestLargePrimitive) {
+  // Large enough that the prefetching path is taken
+  size_t n = 1 << 17;
+  vector<double> values(n);
+  for (size_t i = 0; i < n; ++i) {
+    values[i] = i * 0.5;
+  }
+  DoubleArray array(n, to_buffer(values));
+
+  vector<int32_t> indices;
+  randint<int32_t>(n, 0, n, indices);
+  MakeIndices(indices);
+  DoTake(array);
+
+  ASSERT_FALSE(result_->nullable());
+  DoubleArray* result = static_cast<DoubleArray*>(result_.get());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_EQ(values[indices[i]], result->Value(i));
+  }
+}
+
+
+TEST_F(TestTake, TestNullIndices) {
+  vector<int32_t> values = {10, 11, 12, 13};
+  Int32Array array(values.size(), to_buffer(values));
+
+  // The null index holds a garbage value that must not be dereferenced
+  MakeIndices({3, 1000000, 0, 0}, {0, 1, 0, 0});
+  DoTake(array);
+
+  ASSERT_TRUE(result_->nullable());
+  Int32Array* result = static_cast<Int32Array*>(result_.get());
+  ASSERT_FALSE(result->IsNull(0));
+  ASSERT_TRUE(result->IsNull(1));
+  ASSERT_EQ(13, result->Value(0));
+  ASSERT_EQ(10, result->Value(2));
+}
+
+
+TEST_F(TestTake, TestOutOfBounds) {
+  vector<int32_t> values = {10, 11, 12, 13};
+  Int32Array array(values.size(), to_buffer(values));
+  Array* out;
+
+  MakeIndices({0, 4});
+  ASSERT_RAISES(Invalid, Take(pool_.get(), array, *indices_, &out));
+
+  MakeIndices({0, -1});
+  ASSERT_RAISES(Invalid, Take(pool_.get(), array, *indices_, &out));
+
+  // Null indices read nothing, so they may index into an empty array
+  vector<int32_t> empty;
+  Int32Array empty_array(0, to_buffer(empty));
+  MakeIndices({7, -3}, {1, 1});
+  DoTake(empty_array);
+  ASSERT_TRUE(result_->IsNull(0));
+  ASSERT_TRUE(result_->IsNull(1));
+
+  MakeIndices({7, 0}, {1, 0});
+  ASSERT_RAISES(Invalid, Take(pool_.get(), empty_array, *indices_, &out));
+}
+
+
+TEST_F(TestTake, TestString) {
+  vector<string> strings = {"a", "bb", "", "dddd", "ccc", "eeeee"};
+  vector<uint8_t> is_null = {0, 0, 0, 1, 0, 0};
+
+  StringBuilder builder(pool_.get(), TypePtr(new StringType()));
+  for (size_t i = 0; i < strings.size(); ++i) {
+    if (is_null[i]) {
+      ASSERT_OK(builder.AppendNull());
+    } else {
+      ASSERT_OK(builder.Append(strings[i]));
+    }
+  }
+  Array* tmp;
+  ASSERT_OK(builder.ToArray(&tmp));
+  unique_ptr<Array> array(tmp);
+
+  MakeIndices({5, 0, 3, 2, 1, 4, 4, 0}, {0, 0, 0, 0, 1, 0, 0, 0});
+  DoTake(*array);
+
+  StringArray* result = static_cast<StringArray*>(result_.get());
+  for (size_t i = 0; i < index_values_.size(); ++i) {
+    bool expect_null = IndexIsNull(i) || is_null[index_values_[i]];
+    ASSERT_EQ(expect_null, result->IsNull(i));
+    if (!expect_null) {
+      ASSERT_EQ(strings[index_values_[i]], result->GetString(i));
+    } else {
+      ASSERT_EQ(0, result->value_length(i));
+    }
+  }
+}
+
+
+TEST_F(TestTake, TestLongStringNullIndices) {
+  // Enough bytes to take the prefetching path, with garbage in the null
+  // index slots that must not be used to read the offsets
+  StringBuilder builder(pool_.get(), TypePtr(new StringType()));
+  string value(1024, 'x');
+  for (int i = 0; i < 512; ++i) {
+    ASSERT_OK(builder.Append(value));
+  }
+  Array* tmp;
+  ASSERT_OK(builder.ToArray(&tmp));
+  unique_ptr<Array> array(tmp);
+
+  vector<int32_t> indices;
+  vector<uint8_t> nulls;
+  for (int i = 0; i < 512; ++i) {
+    bool is_null = i % 3 == 0;
+    indices.push_back(is_null ? 1 << 30 : 511 - i);
+    nulls.push_back(is_null);
+  }
+  MakeIndices(indices, nulls);
+  DoTake(*array);
+
+  StringArray* result = static_cast<StringArray*>(result_.get());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_EQ(static_cast<bool>(nulls[i]), result->IsNull(i));
+    if (!nulls[i]) {
+      ASSERT_EQ(value, result->GetString(i));
+    }
+  }
+}
+
+
+TEST_F(TestTake, TestList) {
+  TypePtr value_type(new Int32Type());
+  TypePtr type(new ListType(value_type));
+  ListBuilder builder(pool_.get(), type,
+      new Int32Builder(pool_.get(), value_type));
+  Int32Builder* vb = static_cast<Int32Builder*>(builder.value_builder());
+
+  // [[0], [1, 2], null, [3, 4, 5], []]
+  vector<vector<int32_t> > lists = {{0}, {1, 2}, {}, {3, 4, 5}, {}};
+  for (size_t i = 0; i < lists.size(); ++i) {
+    ASSERT_OK(builder.Append(i == 2));
+    for (int32_t v : lists[i]) {
+      ASSERT_OK(vb->Append(v));
+    }
+  }
+  Array* tmp;
+  ASSERT_OK(builder.ToArray(&tmp));
+  unique_ptr<Array> array(tmp);
+
+  MakeIndices({3, 2, 1, 4, 3});
+  DoTake(*array);
+
+  ListArray* result = static_cast<ListArray*>(result_.get());
+  Int32Array* values = static_cast<Int32Array*>(result->values().get());
+  vector<int32_t> ex_offsets = {0, 3, 3, 5, 5, 8};
+  vector<int32_t> ex_values = {3, 4, 5, 1, 2, 3, 4, 5};
+  for (size_t i = 0; i < ex_offsets.size(); ++i) {
+    ASSERT_EQ(ex_offsets[i], result->offset(i));
+  }
+  ASSERT_EQ(ex_values.size(), values->length());
+  for (size_t i = 0; i < ex_values.size(); ++i) {
+    ASSERT_EQ(ex_values[i], values->Value(i));
+  }
+  ASSERT_TRUE(result->IsNull(1));
+  ASSERT_FALSE(result->IsNull(0));
+}
+
+} // namespace compute
+
+} // namespace arrow
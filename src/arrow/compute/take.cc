@@ -0,0 +1,284 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/take.h"
+
+#include <cstring>
+#include <limits>
+
+#include "arrow/compute/kernel-util.h"
+#include "arrow/types/list.h"
+#include "arrow/types/string.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+// Random reads are prefetched this many slots ahead once the source no
+// longer fits comfortably in L2
+static constexpr size_t kPrefetchDistance = 16;
+static constexpr size_t kPrefetchMinBytes = 256 * 1024;
+
+Status CheckBounds(const Int32Array& indices, size_t length) {
+  const int32_t* idx = indices.raw_data();
+  const uint8_t* index_nulls = indices.null_bits();
+  size_t n = indices.length();
+
+  // Negative indices wrap around to large unsigned values. Null indices
+  // read nothing, so only the non-null ones must be in bounds
+  uint32_t max_index = 0;
+  bool any_valid = n > 0;
+  if (index_nulls == nullptr) {
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t index = static_cast<uint32_t>(idx[i]);
+      max_index = index > max_index ? index : max_index;
+    }
+  } else {
+    any_valid = false;
+    for (size_t i = 0; i < n; ++i) {
+      bool is_null = util::get_bit(index_nulls, i);
+      uint32_t index = is_null ? 0 : static_cast<uint32_t>(idx[i]);
+      max_index = index > max_index ? index : max_index;
+      any_valid |= !is_null;
+    }
+  }
+  if (any_valid && max_index >= length) {
+    return Status::Invalid("take index out of bounds");
+  }
+  return Status::OK();
+}
+
+Status TakeNulls(MemoryPool* pool, const Array& values,
+    const Int32Array& indices, Buffer** out) {
+  *out = nullptr;
+  const uint8_t* value_nulls = values.null_bits();
+  const uint8_t* index_nulls = indices.null_bits();
+  if (!values.nullable() && value_nulls == nullptr && index_nulls == nullptr) {
+    return Status::OK();
+  }
+
+  RETURN_NOT_OK(allocate_nulls(pool, indices.length(), out));
+  uint8_t* bits = (*out)->data();
+  const int32_t* idx = indices.raw_data();
+  for (size_t i = 0; i < indices.length(); ++i) {
+    bool is_null = (index_nulls != nullptr && util::get_bit(index_nulls, i)) ||
+      (value_nulls != nullptr && util::get_bit(value_nulls, idx[i]));
+    util::set_bit(bits, i, is_null);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+void TakeValues(const T* values, size_t num_values, const int32_t* idx,
+    const uint8_t* index_nulls, size_t n, T* out) {
+  if (index_nulls != nullptr) {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = util::get_bit(index_nulls, i) ? T() : values[idx[i]];
+    }
+    return;
+  }
+
+  size_t i = 0;
+  if (num_values * sizeof(T) >= kPrefetchMinBytes) {
+    for (; i + kPrefetchDistance < n; ++i) {
+      __builtin_prefetch(values + idx[i + kPrefetchDistance]);
+      out[i] = values[idx[i]];
+    }
+  }
+  for (; i < n; ++i) {
+    out[i] = values[idx[i]];
+  }
+}
+
+struct TakePrimitiveVisitor {
+  MemoryPool* pool;
+  const Array& values;
+  const Int32Array& indices;
+  Buffer* data;
+
+  template <typename TypeClass>
+  Status Visit() {
+    typedef typename TypeClass::c_type T;
+    size_t n = indices.length();
+    RETURN_NOT_OK(pool->NewBuffer(n * sizeof(T), &data));
+
+    const auto& typed = static_cast<const PrimitiveArrayImpl<TypeClass>&>(values);
+    TakeValues(typed.raw_data(), values.length(), indices.raw_data(),
+        indices.null_bits(), n, reinterpret_cast<T*>(data->data()));
+    return Status::OK();
+  }
+};
+
+// First pass over variable-length values: the output offsets, from which the
+// total child length is known before anything is copied
+Status TakeOffsets(MemoryPool* pool, const ListArray& values,
+    const Int32Array& indices, Buffer** out) {
+  size_t n = indices.length();
+  RETURN_NOT_OK(pool->NewBuffer((n + 1) * sizeof(int32_t), out));
+  int32_t* dst = reinterpret_cast<int32_t*>((*out)->data());
+
+  const int32_t* offsets = values.offsets();
+  const int32_t* idx = indices.raw_data();
+  const uint8_t* index_nulls = indices.null_bits();
+  bool prefetch = values.length() * sizeof(int32_t) >= kPrefetchMinBytes &&
+    index_nulls == nullptr;
+
+  int64_t position = 0;
+  dst[0] = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (prefetch && i + kPrefetchDistance < n) {
+      __builtin_prefetch(offsets + idx[i + kPrefetchDistance]);
+    }
+    if (index_nulls == nullptr || !util::get_bit(index_nulls, i)) {
+      position += offsets[idx[i] + 1] - offsets[idx[i]];
+    }
+    dst[i + 1] = static_cast<int32_t>(position);
+  }
+  if (position > std::numeric_limits<int32_t>::max()) {
+    (*out)->Decref();
+    return Status::Invalid("taken list values exceed int32 offsets");
+  }
+  return Status::OK();
+}
+
+Status TakeStringBytes(MemoryPool* pool, const StringArray& values,
+    const Int32Array& indices, const int32_t* out_offsets, Array** out) {
+  size_t n = indices.length();
+  size_t total = out_offsets[n];
+
+  Buffer* bytes;
+  RETURN_NOT_OK(pool->NewBuffer(total, &bytes));
+  uint8_t* dst = bytes->data();
+
+  const int32_t* offsets = values.offsets();
+  const uint8_t* src = static_cast<const UInt8Array*>(
+      values.values().get())->raw_data();
+  const int32_t* idx = indices.raw_data();
+  // Null indices hold garbage, which must not reach the offsets read
+  bool prefetch = total >= kPrefetchMinBytes &&
+    indices.null_bits() == nullptr;
+
+  for (size_t i = 0; i < n; ++i) {
+    size_t length = out_offsets[i + 1] - out_offsets[i];
+    if (prefetch && i + kPrefetchDistance < n) {
+      __builtin_prefetch(src + offsets[idx[i + kPrefetchDistance]]);
+    }
+    if (length > 0) {
+      memcpy(dst + out_offsets[i], src + offsets[idx[i]], length);
+    }
+  }
+  *out = new UInt8Array(total, bytes);
+  return Status::OK();
+}
+
+Status TakeListValues(MemoryPool* pool, const ListArray& values,
+    const Int32Array& indices, const int32_t* out_offsets, Array** out) {
+  // Expand each taken slot into the indices of its child values and gather
+  // the child recursively
+  size_t n = indices.length();
+  size_t total = out_offsets[n];
+
+  Buffer* child_index_buf;
+  RETURN_NOT_OK(pool->NewBuffer(total * sizeof(int32_t), &child_index_buf));
+  int32_t* child_idx = reinterpret_cast<int32_t*>(child_index_buf->data());
+
+  const int32_t* offsets = values.offsets();
+  const int32_t* idx = indices.raw_data();
+  for (size_t i = 0; i < n; ++i) {
+    int32_t length = out_offsets[i + 1] - out_offsets[i];
+    int32_t start = length > 0 ? offsets[idx[i]] : 0;
+    for (int32_t j = 0; j < length; ++j) {
+      *child_idx++ = start + j;
+    }
+  }
+
+  Int32Array child_indices(total, child_index_buf);
+  return Take(pool, *values.values(), child_indices, out);
+}
+
+Status TakeList(MemoryPool* pool, const Array& values,
+    const Int32Array& indices, const TypePtr& type, Buffer* nulls,
+    Array** out) {
+  const ListArray& list = static_cast<const ListArray&>(values);
+
+  Buffer* offsets;
+  RETURN_NOT_OK(TakeOffsets(pool, list, indices, &offsets));
+  const int32_t* out_offsets = reinterpret_cast<const int32_t*>(
+      offsets->data());
+
+  Array* child;
+  Status s;
+  if (type->type == TypeEnum::STRING) {
+    s = TakeStringBytes(pool, static_cast<const StringArray&>(values), indices,
+        out_offsets, &child);
+  } else {
+    s = TakeListValues(pool, list, indices, out_offsets, &child);
+  }
+  if (!s.ok()) {
+    offsets->Decref();
+    return s;
+  }
+
+  size_t n = indices.length();
+  if (type->type == TypeEnum::STRING) {
+    StringArray* result = new StringArray();
+    result->Init(type, n, offsets, ArrayPtr(child), nulls);
+    *out = result;
+  } else {
+    ListArray* result = new ListArray();
+    result->Init(type, n, offsets, ArrayPtr(child), nulls);
+    *out = result;
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+Status Take(MemoryPool* pool, const Array& values, const Int32Array& indices,
+    Array** out) {
+  TypeEnum type_enum = values.type_enum();
+  bool is_list = type_enum == TypeEnum::LIST || type_enum == TypeEnum::STRING;
+  if (!is_primitive(type_enum) && !is_list) {
+    return Status::NotImplemented(values.type()->ToString());
+  }
+  RETURN_NOT_OK(CheckBounds(indices, values.length()));
+
+  Buffer* nulls;
+  RETURN_NOT_OK(TakeNulls(pool, values, indices, &nulls));
+  TypePtr type = nulls == nullptr ? values.type() :
+    nullable_type(values.type());
+
+  Status s;
+  if (is_list) {
+    s = TakeList(pool, values, indices, type, nulls, out);
+  } else {
+    TakePrimitiveVisitor visitor = {pool, values, indices, nullptr};
+    s = visit_primitive(type_enum, &visitor);
+    if (s.ok()) {
+      s = make_primitive_array(type, indices.length(), visitor.data, nulls,
+          out);
+    }
+  }
+  if (!s.ok() && nulls != nullptr) {
+    nulls->Decref();
+  }
+  return s;
+}
+
+} // namespace compute
+
+} // namespace arrow
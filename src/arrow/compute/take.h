@@ -0,0 +1,43 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_TAKE_H
+#define ARROW_COMPUTE_TAKE_H
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Gather values[indices[i]] for every slot i of indices into a new array
+// allocated from pool. Supports primitive, list and string arrays.
+//
+// An output slot is null if either the index or the value it refers to is
+// null. Returns Invalid if a non-null index is out of bounds. On large
+// inputs the source values are software-prefetched a few slots ahead of the
+// copy. Variable-length values are gathered in two passes: the output
+// offsets are computed first so that the value buffer is allocated once.
+// The caller owns the returned array
+Status Take(MemoryPool* pool, const Array& values, const Int32Array& indices,
+    Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_TAKE_H
@@ -0,0 +1,85 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/temporal.h"
+#include "arrow/types/datetime.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+// Millisecond timestamps spread over about 60 years around the epoch
+static void BenchmarkTemporal(MemoryPool* pool) {
+  Random rng(random_seed());
+  std::vector<int64_t> millis(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    millis[i] = static_cast<int64_t>(rng.Uniform64(2000000000000ULL)) -
+      1000000000000LL;
+  }
+  TimestampArray values(TypePtr(new TimestampType(TimestampType::Unit::MILLI,
+              false)), kNumValues, benchmark::make_buffer(pool, millis));
+  size_t bytes = kNumValues * sizeof(int64_t);
+
+  benchmark::run("ConvertUnit ms to ns", bytes, [&]() {
+        Array* out;
+        BENCHMARK_OK(ConvertUnit(pool, values, TimestampType::Unit::NANO,
+                &out));
+        delete out;
+      });
+  benchmark::run("ConvertUnit ms to s", bytes, [&]() {
+        Array* out;
+        BENCHMARK_OK(ConvertUnit(pool, values, TimestampType::Unit::SECOND,
+                &out));
+        delete out;
+      });
+  benchmark::run("ExtractField year", bytes, [&]() {
+        Array* out;
+        BENCHMARK_OK(ExtractField(pool, values, TemporalField::YEAR, &out));
+        delete out;
+      });
+  benchmark::run("ExtractField day", bytes, [&]() {
+        Array* out;
+        BENCHMARK_OK(ExtractField(pool, values, TemporalField::DAY, &out));
+        delete out;
+      });
+  benchmark::run("ExtractField hour", bytes, [&]() {
+        Array* out;
+        BENCHMARK_OK(ExtractField(pool, values, TemporalField::HOUR, &out));
+        delete out;
+      });
+  benchmark::run("Truncate to minutes", bytes, [&]() {
+        Array* out;
+        BENCHMARK_OK(Truncate(pool, values, 60000, &out));
+        delete out;
+      });
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkTemporal(&pool);
+  return 0;
+}
@@ -0,0 +1,458 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <time.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/group-by.h"
+#include "arrow/compute/sort.h"
+#include "arrow/compute/take.h"
+#include "arrow/compute/temporal.h"
+#include "arrow/types/datetime.h"
+#include "arrow/types/integer.h"
+#include "arrow/util/random.h"
+
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+static const TemporalField kFields[] = {
+  TemporalField::YEAR, TemporalField::MONTH, TemporalField::DAY,
+  TemporalField::HOUR, TemporalField::MINUTE, TemporalField::SECOND};
+
+// The fields of seconds since the epoch, from the C library
+static vector<int32_t> gmtime_fields(int64_t seconds) {
+  time_t t = static_cast<time_t>(seconds);
+  struct tm parts;
+  gmtime_r(&t, &parts);
+  return {parts.tm_year + 1900, parts.tm_mon + 1, parts.tm_mday,
+      parts.tm_hour, parts.tm_min, parts.tm_sec};
+}
+
+static int64_t floor_div(int64_t v, int64_t d) {
+  int64_t q = v / d;
+  return q * d > v ? q - 1 : q;
+}
+
+class TestTemporal : public TestBase {
+ public:
+  template <typename ArrayType, typename TypeClass, typename T>
+  ArrayType* MakeArray(typename TypeClass::Unit unit, const vector<T>& values,
+      const vector<uint8_t>& nulls = {}) {
+    TypePtr type(new TypeClass(unit, !nulls.empty()));
+    return new ArrayType(type, values.size(), to_buffer(values),
+        nulls.empty() ? nullptr :
+        bytes_to_null_buffer(const_cast<uint8_t*>(nulls.data()),
+            nulls.size()));
+  }
+
+  TimestampArray* MakeTimestamps(TimestampType::Unit unit,
+      const vector<int64_t>& values, const vector<uint8_t>& nulls = {}) {
+    return MakeArray<TimestampArray, TimestampType>(unit, values, nulls);
+  }
+
+  // Extract every field of values, and check them against the fields of
+  // the seconds in expected_seconds
+  void CheckFields(const Array& values,
+      const vector<int64_t>& expected_seconds) {
+    for (size_t f = 0; f < 6; ++f) {
+      Array* tmp;
+      ASSERT_OK(ExtractField(pool_.get(), values, kFields[f], &tmp));
+      unique_ptr<Array> result(tmp);
+      TypeEnum int32_type = Int32Type::type_enum;
+      ASSERT_EQ(int32_type, result->type_enum());
+      ASSERT_EQ(values.length(), result->length());
+      const int32_t* out = static_cast<Int32Array&>(*result).raw_data();
+      for (size_t i = 0; i < values.length(); ++i) {
+        ASSERT_EQ(gmtime_fields(expected_seconds[i])[f], out[i])
+          << "field " << f << " of " << expected_seconds[i];
+      }
+    }
+  }
+};
+
+TEST_F(TestTemporal, TestExtractKnownDates) {
+  // 1970-01-01 00:00:00, 1969-12-31 23:59:59, leap days in 2000 and 1600
+  // (a multiple of 400) and the day after the non-leap 1900-02-28
+  vector<int64_t> seconds = {0, -1, 951831930, -11670912001, -2203891200,
+    1735625228};
+  vector<int32_t> expected[] = {
+    {1970, 1, 1, 0, 0, 0},
+    {1969, 12, 31, 23, 59, 59},
+    {2000, 2, 29, 13, 45, 30},
+    {1600, 2, 29, 23, 59, 59},
+    {1900, 3, 1, 0, 0, 0},
+    {2024, 12, 31, 6, 7, 8}};
+
+  vector<int64_t> millis;
+  for (int64_t v : seconds) {
+    millis.push_back(v * 1000 + 999);
+  }
+  unique_ptr<TimestampArray> values(MakeTimestamps(TimestampType::Unit::MILLI,
+          millis));
+  for (size_t f = 0; f < 6; ++f) {
+    Array* tmp;
+    ASSERT_OK(ExtractField(pool_.get(), *values, kFields[f], &tmp));
+    unique_ptr<Array> result(tmp);
+    const int32_t* out = static_cast<Int32Array&>(*result).raw_data();
+    for (size_t i = 0; i < seconds.size(); ++i) {
+      ASSERT_EQ(expected[i][f], out[i]) << "field " << f << " of " << i;
+    }
+  }
+}
+
+TEST_F(TestTemporal, TestExtractMatchesGmtime) {
+  Random rng(random_seed());
+  const size_t length = 10000;
+
+  // Seconds within about 3000 years of the epoch
+  vector<int64_t> seconds;
+  for (size_t i = 0; i < length; ++i) {
+    seconds.push_back(static_cast<int64_t>(rng.Next64() % 200000000000ULL) -
+        100000000000LL);
+  }
+  unique_ptr<TimestampArray> values(MakeTimestamps(TimestampType::Unit::SECOND,
+          seconds));
+  CheckFields(*values, seconds);
+
+  // Nanoseconds over their whole range, 1677 to 2262
+  vector<int64_t> nanos;
+  vector<int64_t> nano_seconds;
+  for (size_t i = 0; i < length; ++i) {
+    nanos.push_back(static_cast<int64_t>((rng.Next64() << 2) ^ rng.Next()));
+    nano_seconds.push_back(floor_div(nanos.back(), 1000000000));
+  }
+  nanos.push_back(std::numeric_limits<int64_t>::min());
+  nano_seconds.push_back(floor_div(nanos.back(), 1000000000));
+  nanos.push_back(std::numeric_limits<int64_t>::max());
+  nano_seconds.push_back(floor_div(nanos.back(), 1000000000));
+  values.reset(MakeTimestamps(TimestampType::Unit::NANO, nanos));
+  CheckFields(*values, nano_seconds);
+}
+
+TEST_F(TestTemporal, TestExtractDate) {
+  Random rng(random_seed());
+  vector<int32_t> days;
+  for (int i = 0; i < 10000; ++i) {
+    days.push_back(static_cast<int32_t>(rng.Uniform(2000000)) - 1000000);
+  }
+  days.push_back(0);
+  days.push_back(-1);
+  unique_ptr<DateArray> values(MakeArray<DateArray, DateType>(
+          DateType::Unit::DAY, days));
+
+  for (size_t f = 0; f < 3; ++f) {
+    Array* tmp;
+    ASSERT_OK(ExtractField(pool_.get(), *values, kFields[f], &tmp));
+    unique_ptr<Array> result(tmp);
+    const int32_t* out = static_cast<Int32Array&>(*result).raw_data();
+    for (size_t i = 0; i < days.size(); ++i) {
+      ASSERT_EQ(gmtime_fields(days[i] * 86400LL)[f], out[i]) << days[i];
+    }
+  }
+
+  Array* out;
+  ASSERT_RAISES(NotImplemented, ExtractField(pool_.get(), *values,
+          TemporalField::HOUR, &out));
+  values.reset(MakeArray<DateArray, DateType>(DateType::Unit::MONTH, days));
+  ASSERT_RAISES(NotImplemented, ExtractField(pool_.get(), *values,
+          TemporalField::YEAR, &out));
+}
+
+TEST_F(TestTemporal, TestExtractTime) {
+  // 00:00:00.000, 23:59:59.999 and 12:34:56.789
+  vector<int64_t> millis = {0, 86399999, 45296789};
+  unique_ptr<TimeArray> values(MakeArray<TimeArray, TimeType>(
+          TimeType::Unit::MILLI, millis));
+  vector<int32_t> expected[] = {{0, 0, 0}, {23, 59, 59}, {12, 34, 56}};
+  for (size_t f = 3; f < 6; ++f) {
+    Array* tmp;
+    ASSERT_OK(ExtractField(pool_.get(), *values, kFields[f], &tmp));
+    unique_ptr<Array> result(tmp);
+    const int32_t* out = static_cast<Int32Array&>(*result).raw_data();
+    for (size_t i = 0; i < millis.size(); ++i) {
+      ASSERT_EQ(expected[i][f - 3], out[i]) << i;
+    }
+  }
+
+  Array* out;
+  ASSERT_RAISES(NotImplemented, ExtractField(pool_.get(), *values,
+          TemporalField::DAY, &out));
+  Int64Array ints(millis.size(), to_buffer(millis));
+  ASSERT_RAISES(NotImplemented, ExtractField(pool_.get(), ints,
+          TemporalField::HOUR, &out));
+}
+
+TEST_F(TestTemporal, TestExtractKeepsNulls) {
+  vector<int64_t> millis = {0, 86400000, 2 * 86400000};
+  vector<uint8_t> nulls = {0, 1, 0};
+  unique_ptr<TimestampArray> values(MakeTimestamps(TimestampType::Unit::MILLI,
+          millis, nulls));
+  Array* tmp;
+  ASSERT_OK(ExtractField(pool_.get(), *values, TemporalField::DAY, &tmp));
+  unique_ptr<Array> result(tmp);
+  ASSERT_TRUE(result->type()->nullable);
+  ASSERT_EQ(values->nulls(), result->nulls());
+  for (size_t i = 0; i < millis.size(); ++i) {
+    ASSERT_EQ(nulls[i] != 0, result->IsNull(i));
+  }
+  ASSERT_EQ(3, static_cast<Int32Array&>(*result).raw_data()[2]);
+}
+
+TEST_F(TestTemporal, TestConvertUnit) {
+  vector<int64_t> seconds = {0, 1, -1, 1735625228};
+  unique_ptr<TimestampArray> values(MakeTimestamps(TimestampType::Unit::SECOND,
+          seconds));
+
+  // Up to nanoseconds and back
+  Array* tmp;
+  ASSERT_OK(ConvertUnit(pool_.get(), *values, TimestampType::Unit::NANO,
+          &tmp));
+  unique_ptr<TimestampArray> nanos(static_cast<TimestampArray*>(tmp));
+  ASSERT_TRUE(nanos->unit() == TimestampType::Unit::NANO);
+  for (size_t i = 0; i < seconds.size(); ++i) {
+    ASSERT_EQ(seconds[i] * 1000000000, nanos->raw_data()[i]);
+  }
+  ASSERT_FALSE(nanos->Equals(*values));
+
+  ASSERT_OK(ConvertUnit(pool_.get(), *nanos, TimestampType::Unit::SECOND,
+          &tmp));
+  unique_ptr<Array> back(tmp);
+  ASSERT_TRUE(back->Equals(*values));
+
+  // Coarser units round toward negative infinity
+  vector<int64_t> micros = {1999, -1, -1000, -1001};
+  values.reset(MakeTimestamps(TimestampType::Unit::MICRO, micros));
+  ASSERT_OK(ConvertUnit(pool_.get(), *values, TimestampType::Unit::MILLI,
+          &tmp));
+  unique_ptr<TimestampArray> millis(static_cast<TimestampArray*>(tmp));
+  vector<int64_t> expected = {1, -1, -1, -2};
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], millis->raw_data()[i]) << i;
+  }
+
+  // The same unit shares the values
+  ASSERT_OK(ConvertUnit(pool_.get(), *values, TimestampType::Unit::MICRO,
+          &tmp));
+  unique_ptr<TimestampArray> same(static_cast<TimestampArray*>(tmp));
+  ASSERT_EQ(values->data(), same->data());
+  ASSERT_TRUE(same->Equals(*values));
+}
+
+TEST_F(TestTemporal, TestConvertUnitTime) {
+  vector<int64_t> millis = {0, 86399999};
+  unique_ptr<TimeArray> values(MakeArray<TimeArray, TimeType>(
+          TimeType::Unit::MILLI, millis));
+  Array* tmp;
+  ASSERT_OK(ConvertUnit(pool_.get(), *values, TimeType::Unit::SECOND, &tmp));
+  unique_ptr<TimeArray> seconds(static_cast<TimeArray*>(tmp));
+  ASSERT_EQ(TypeEnum::TIME, seconds->type_enum());
+  ASSERT_EQ(0, seconds->raw_data()[0]);
+  ASSERT_EQ(86399, seconds->raw_data()[1]);
+
+  vector<int32_t> days = {1};
+  DateArray dates(TypePtr(new DateType()), days.size(), to_buffer(days));
+  ASSERT_RAISES(NotImplemented, ConvertUnit(pool_.get(), dates,
+          TimestampType::Unit::SECOND, &tmp));
+}
+
+TEST_F(TestTemporal, TestConvertUnitOverflow) {
+  const int64_t kMax = std::numeric_limits<int64_t>::max() / 1000;
+  vector<int64_t> seconds(100, 0);
+  seconds[10] = kMax;
+  seconds[70] = kMax + 1;
+  seconds[80] = -kMax - 1;
+  vector<uint8_t> nulls(100, 0);
+  unique_ptr<TimestampArray> values(MakeTimestamps(TimestampType::Unit::SECOND,
+          seconds, nulls));
+
+  Array* tmp;
+  Status status = ConvertUnit(pool_.get(), *values,
+      TimestampType::Unit::MILLI, &tmp);
+  ASSERT_TRUE(status.IsInvalid());
+  ASSERT_NE(std::string::npos, status.ToString().find("index 70"))
+    << status.ToString();
+
+  // Null slots are not checked
+  nulls[70] = 1;
+  nulls[80] = 1;
+  values.reset(MakeTimestamps(TimestampType::Unit::SECOND, seconds, nulls));
+  ASSERT_OK(ConvertUnit(pool_.get(), *values, TimestampType::Unit::MILLI,
+          &tmp));
+  unique_ptr<TimestampArray> millis(static_cast<TimestampArray*>(tmp));
+  ASSERT_EQ(kMax * 1000, millis->raw_data()[10]);
+  ASSERT_TRUE(millis->IsNull(70));
+}
+
+TEST_F(TestTemporal, TestTruncate) {
+  Random rng(random_seed());
+  vector<int64_t> millis;
+  for (int i = 0; i < 10000; ++i) {
+    millis.push_back(static_cast<int64_t>(rng.Next64()) - (1LL << 61));
+  }
+  millis.push_back(0);
+  millis.push_back(-1);
+  unique_ptr<TimestampArray> values(MakeTimestamps(TimestampType::Unit::MILLI,
+          millis));
+
+  vector<int64_t> buckets = {1, 7, 1000, 60000, 86400000, 1000000007,
+    1LL << 40, (1LL << 61) + 1};
+  for (int64_t bucket : buckets) {
+    Array* tmp;
+    ASSERT_OK(Truncate(pool_.get(), *values, bucket, &tmp));
+    unique_ptr<TimestampArray> result(static_cast<TimestampArray*>(tmp));
+    ASSERT_EQ(values->type(), result->type());
+    for (size_t i = 0; i < millis.size(); ++i) {
+      ASSERT_EQ(floor_div(millis[i], bucket) * bucket, result->raw_data()[i])
+        << millis[i] << " " << bucket;
+    }
+  }
+
+  Array* out;
+  ASSERT_RAISES(Invalid, Truncate(pool_.get(), *values, 0, &out));
+  ASSERT_RAISES(Invalid, Truncate(pool_.get(), *values, -60000, &out));
+}
+
+TEST_F(TestTemporal, TestTruncateOverflow) {
+  // The bucket of the smallest timestamp starts before it, out of range
+  const int64_t kMin = std::numeric_limits<int64_t>::min();
+  vector<int64_t> millis(100, 0);
+  millis[20] = kMin + 100;
+  millis[50] = kMin;
+  vector<uint8_t> nulls(100, 0);
+  unique_ptr<TimestampArray> values(MakeTimestamps(TimestampType::Unit::MILLI,
+          millis, nulls));
+
+  Array* tmp;
+  Status status = Truncate(pool_.get(), *values, 60000, &tmp);
+  ASSERT_TRUE(status.IsInvalid());
+  ASSERT_NE(std::string::npos, status.ToString().find("index 20"))
+    << status.ToString();
+
+  // A bucket that divides the smallest value keeps it in range, and null
+  // slots are not checked
+  ASSERT_OK(Truncate(pool_.get(), *values, 1024, &tmp));
+  unique_ptr<Array> result(tmp);
+  ASSERT_EQ(kMin, static_cast<TimestampArray&>(*result).raw_data()[50]);
+  ASSERT_EQ(kMin, static_cast<TimestampArray&>(*result).raw_data()[20]);
+
+  nulls[20] = 1;
+  nulls[50] = 1;
+  values.reset(MakeTimestamps(TimestampType::Unit::MILLI, millis, nulls));
+  ASSERT_OK(Truncate(pool_.get(), *values, 60000, &tmp));
+  result.reset(tmp);
+  ASSERT_TRUE(result->IsNull(20));
+}
+
+TEST_F(TestTemporal, TestTruncateDate) {
+  // Weeks starting on Thursday, the weekday of 1970-01-01
+  vector<int32_t> days = {0, 6, 7, -1, -7, -8,
+    std::numeric_limits<int32_t>::min()};
+  vector<uint8_t> nulls = {0, 0, 0, 0, 0, 0, 1};
+  unique_ptr<DateArray> values(MakeArray<DateArray, DateType>(
+          DateType::Unit::DAY, days, nulls));
+  Array* tmp;
+  ASSERT_OK(Truncate(pool_.get(), *values, 7, &tmp));
+  unique_ptr<DateArray> result(static_cast<DateArray*>(tmp));
+  vector<int32_t> expected = {0, 0, 7, -7, -7, -14};
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], result->raw_data()[i]) << i;
+  }
+  ASSERT_TRUE(result->IsNull(6));
+
+  // The smallest date has no week start in range
+  nulls[6] = 0;
+  values.reset(MakeArray<DateArray, DateType>(DateType::Unit::DAY, days,
+          nulls));
+  ASSERT_RAISES(Invalid, Truncate(pool_.get(), *values, 7, &tmp));
+}
+
+TEST_F(TestTemporal, TestTruncateGroupBy) {
+  // Count the events of each minute and find the last one
+  vector<int64_t> millis = {61000, 1000, 119999, 59999, 120000, -1, 60000};
+  unique_ptr<TimestampArray> values(MakeTimestamps(TimestampType::Unit::MILLI,
+          millis));
+  Array* tmp;
+  ASSERT_OK(Truncate(pool_.get(), *values, 60000, &tmp));
+  unique_ptr<Array> minutes(tmp);
+
+  GroupBy group_by(pool_.get(), {minutes->type()}, {values->type()},
+      {{AggregateFunction::COUNT, 0}, {AggregateFunction::MAX, 0}});
+  ASSERT_OK(group_by.Init());
+  ASSERT_OK(group_by.Consume({minutes.get()}, {values.get()}));
+  vector<ArrayPtr> keys;
+  vector<ArrayPtr> aggregates;
+  ASSERT_OK(group_by.Finish(&keys, &aggregates));
+
+  // Groups come in order of first appearance, and the keys and maxima keep
+  // the unit of the timestamps
+  vector<int64_t> expected_keys = {60000, 0, 120000, -60000};
+  vector<int64_t> expected_counts = {3, 2, 1, 1};
+  vector<int64_t> expected_max = {119999, 59999, 120000, -1};
+  ASSERT_EQ(minutes->type(), keys[0]->type());
+  const auto& key_array = static_cast<const TimestampArray&>(*keys[0]);
+  const auto& max_array = static_cast<const TimestampArray&>(*aggregates[1]);
+  ASSERT_EQ(TimestampType::Unit::MILLI, key_array.unit());
+  ASSERT_EQ(TimestampType::Unit::MILLI, max_array.unit());
+  ASSERT_EQ(expected_keys.size(), key_array.length());
+  for (size_t g = 0; g < expected_keys.size(); ++g) {
+    ASSERT_EQ(expected_keys[g], key_array.raw_data()[g]) << g;
+    ASSERT_EQ(expected_counts[g],
+        static_cast<const Int64Array&>(*aggregates[0]).raw_data()[g]) << g;
+    ASSERT_EQ(expected_max[g], max_array.raw_data()[g]) << g;
+  }
+
+  // Timestamps have no sum
+  GroupBy sums(pool_.get(), {minutes->type()}, {values->type()},
+      {{AggregateFunction::SUM, 0}});
+  ASSERT_RAISES(NotImplemented, sums.Init());
+}
+
+TEST_F(TestTemporal, TestKernelsKeepUnit) {
+  vector<int64_t> seconds = {30, 10, 20};
+  unique_ptr<TimeArray> values(MakeArray<TimeArray, TimeType>(
+          TimeType::Unit::SECOND, seconds));
+
+  Array* tmp;
+  ASSERT_OK(Sort(pool_.get(), *values, SortOptions(), &tmp));
+  unique_ptr<TimeArray> sorted(static_cast<TimeArray*>(tmp));
+  ASSERT_EQ(values->type(), sorted->type());
+  ASSERT_EQ(10, sorted->raw_data()[0]);
+  ASSERT_EQ(30, sorted->raw_data()[2]);
+
+  vector<int32_t> index_values = {2, 0};
+  Int32Array indices(index_values.size(), to_buffer(index_values));
+  ASSERT_OK(Take(pool_.get(), *values, indices, &tmp));
+  unique_ptr<TimeArray> taken(static_cast<TimeArray*>(tmp));
+  ASSERT_EQ(TimeType::Unit::SECOND, taken->unit());
+  ASSERT_EQ(20, taken->raw_data()[0]);
+  ASSERT_EQ(30, taken->raw_data()[1]);
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,423 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/temporal.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "arrow/types/integer.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace compute {
+
+namespace {
+
+constexpr int64_t kSecondsPerDay = 86400;
+
+// Quotient rounded toward negative infinity. The correction is a compare, so
+// with a constant divisor this compiles to a multiply and no branches
+template <int64_t kDivisor>
+inline int64_t floor_div(int64_t v) {
+  int64_t q = v / kDivisor;
+  return q - static_cast<int64_t>(q * kDivisor > v);
+}
+
+// The remainder of floor_div, in [0, kDivisor). Taken from the truncated
+// remainder, since multiplying back the quotient overflows near INT64_MIN
+template <int64_t kDivisor>
+inline int64_t floor_mod(int64_t v) {
+  int64_t r = v % kDivisor;
+  return r + (kDivisor & -static_cast<int64_t>(r < 0));
+}
+
+// Civil date of a number of days since 1970-01-01, after Howard Hinnant's
+// days_from_civil inverse. The year starts in March so that the leap day
+// comes last, and the days of each 400-year era are a fixed 146097
+inline void civil_from_days(int64_t days, int64_t* year, int64_t* month,
+    int64_t* day) {
+  // Days since 0000-03-01
+  int64_t z = days + 719468;
+  int64_t era = floor_div<146097>(z);
+  uint32_t doe = static_cast<uint32_t>(z - era * 146097);
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  // Months from March, [0, 11]
+  uint32_t mp = (5 * doy + 2) / 153;
+  uint32_t m = mp + 3 - 12 * static_cast<uint32_t>(mp >= 10);
+  *year = static_cast<int64_t>(yoe) + era * 400 +
+    static_cast<int64_t>(m <= 2);
+  *month = m;
+  *day = doy - (153 * mp + 2) / 5 + 1;
+}
+
+template <typename T, typename Op>
+void transform(const T* in, size_t length, int32_t* out, Op op) {
+  for (size_t i = 0; i < length; ++i) {
+    out[i] = static_cast<int32_t>(op(in[i]));
+  }
+}
+
+// Field of values with kPerSecond units per second and kPerDay per day
+template <int64_t kPerDay, int64_t kPerSecond, typename T>
+void extract_values(const T* in, size_t length, TemporalField field,
+    int32_t* out) {
+  switch (field) {
+    case TemporalField::YEAR:
+      transform(in, length, out, [](T v) {
+            int64_t year, month, day;
+            civil_from_days(floor_div<kPerDay>(v), &year, &month, &day);
+            return year;
+          });
+      break;
+    case TemporalField::MONTH:
+      transform(in, length, out, [](T v) {
+            int64_t year, month, day;
+            civil_from_days(floor_div<kPerDay>(v), &year, &month, &day);
+            return month;
+          });
+      break;
+    case TemporalField::DAY:
+      transform(in, length, out, [](T v) {
+            int64_t year, month, day;
+            civil_from_days(floor_div<kPerDay>(v), &year, &month, &day);
+            return day;
+          });
+      break;
+    case TemporalField::HOUR:
+      transform(in, length, out, [](T v) {
+            return floor_mod<kPerDay>(v) / (kPerSecond * 3600);
+          });
+      break;
+    case TemporalField::MINUTE:
+      transform(in, length, out, [](T v) {
+            return floor_mod<kPerSecond * 3600>(v) / (kPerSecond * 60);
+          });
+      break;
+    case TemporalField::SECOND:
+      transform(in, length, out, [](T v) {
+            return floor_mod<kPerSecond * 60>(v) / kPerSecond;
+          });
+      break;
+  }
+}
+
+template <int64_t kPerSecond>
+void extract_clock_values(const int64_t* in, size_t length,
+    TemporalField field, int32_t* out) {
+  extract_values<kPerSecond * kSecondsPerDay, kPerSecond>(in, length, field,
+      out);
+}
+
+void extract_clock(const int64_t* in, size_t length, TimestampType::Unit unit,
+    TemporalField field, int32_t* out) {
+  switch (unit) {
+    case TimestampType::Unit::SECOND:
+      extract_clock_values<1>(in, length, field, out);
+      break;
+    case TimestampType::Unit::MILLI:
+      extract_clock_values<1000>(in, length, field, out);
+      break;
+    case TimestampType::Unit::MICRO:
+      extract_clock_values<1000000>(in, length, field, out);
+      break;
+    case TimestampType::Unit::NANO:
+      extract_clock_values<1000000000>(in, length, field, out);
+      break;
+  }
+}
+
+// Multiply by kFactor, returning Invalid naming the first non-null value
+// that overflows int64. The checks of 64 values are gathered in a mask
+template <int64_t kFactor>
+Status multiply_values(const int64_t* in, const uint8_t* null_bits,
+    size_t length, const TypePtr& type, int64_t* out) {
+  constexpr int64_t kMax = std::numeric_limits<int64_t>::max() / kFactor;
+  constexpr int64_t kMin = std::numeric_limits<int64_t>::min() / kFactor;
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t overflows = 0;
+    for (size_t j = 0; j < n; ++j) {
+      int64_t v = in[i + j];
+      overflows |= static_cast<uint64_t>((v > kMax) | (v < kMin)) << j;
+      // Unsigned, so that the overflowing values wrap instead of being
+      // undefined
+      out[i + j] = static_cast<int64_t>(static_cast<uint64_t>(v) * kFactor);
+    }
+    if (null_bits != nullptr) {
+      overflows &= ~util::load_bits(null_bits, i, n);
+    }
+    if (overflows) {
+      return Status::Invalid("value at index " +
+          std::to_string(i + __builtin_ctzll(overflows)) +
+          " overflows a conversion to " + type->ToString());
+    }
+  }
+  return Status::OK();
+}
+
+template <int64_t kFactor>
+void divide_values(const int64_t* in, size_t length, int64_t* out) {
+  for (size_t i = 0; i < length; ++i) {
+    out[i] = floor_div<kFactor>(in[i]);
+  }
+}
+
+// Scale by 1000^steps, multiplying for positive steps and dividing for
+// negative ones
+Status convert_values(const int64_t* in, const uint8_t* null_bits,
+    size_t length, int steps, const TypePtr& type, int64_t* out) {
+  switch (steps) {
+    case 1:
+      return multiply_values<1000>(in, null_bits, length, type, out);
+    case 2:
+      return multiply_values<1000000>(in, null_bits, length, type, out);
+    case 3:
+      return multiply_values<1000000000>(in, null_bits, length, type, out);
+    case -1:
+      divide_values<1000>(in, length, out);
+      break;
+    case -2:
+      divide_values<1000000>(in, length, out);
+      break;
+    case -3:
+      divide_values<1000000000>(in, length, out);
+      break;
+    default:
+      break;
+  }
+  return Status::OK();
+}
+
+// Remainders of division by a divisor fixed for a whole array. The quotient
+// estimated with the reciprocal m = (2^64 - 1) / d is at most one short, which
+// a compare corrects, so a value costs a multiply instead of a division
+class Reciprocal {
+ public:
+  explicit Reciprocal(uint64_t divisor)
+      : divisor_(divisor),
+        multiplier_(std::numeric_limits<uint64_t>::max() / divisor) {}
+
+  uint64_t Mod(uint64_t v) const {
+    uint64_t q = static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(v) * multiplier_) >> 64);
+    uint64_t r = v - q * divisor_;
+    return r - divisor_ * static_cast<uint64_t>(r >= divisor_);
+  }
+
+ private:
+  uint64_t divisor_;
+  uint64_t multiplier_;
+};
+
+// Floor each value to a multiple of bucket. A value is biased by 2^63 to
+// make it unsigned, and the remainder of the bias taken back out. Returns
+// Invalid naming the first non-null value whose multiple is below the range
+// of T: for int64 the subtraction wraps, which shows as a remainder larger
+// than the biased value
+template <typename T>
+Status truncate_values(const T* in, const uint8_t* null_bits, size_t length,
+    int64_t bucket, const TypePtr& type, int64_t* out) {
+  const uint64_t kBias = static_cast<uint64_t>(1) << 63;
+  const int64_t kMin = std::numeric_limits<T>::min();
+  Reciprocal reciprocal(bucket);
+  int64_t bias_mod = static_cast<int64_t>(reciprocal.Mod(kBias));
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t overflows = 0;
+    for (size_t j = 0; j < n; ++j) {
+      int64_t v = in[i + j];
+      uint64_t biased = static_cast<uint64_t>(v) ^ kBias;
+      int64_t r = static_cast<int64_t>(reciprocal.Mod(biased)) - bias_mod;
+      r += bucket & -static_cast<int64_t>(r < 0);
+      int64_t truncated = static_cast<int64_t>(static_cast<uint64_t>(v) - r);
+      overflows |= static_cast<uint64_t>(
+          (biased < static_cast<uint64_t>(r)) | (truncated < kMin)) << j;
+      out[i + j] = truncated;
+    }
+    if (null_bits != nullptr) {
+      overflows &= ~util::load_bits(null_bits, i, n);
+    }
+    if (overflows) {
+      return Status::Invalid("value at index " +
+          std::to_string(i + __builtin_ctzll(overflows)) +
+          " truncates out of the range of " + type->ToString());
+    }
+  }
+  return Status::OK();
+}
+
+// The values of a timestamp or time array
+const int64_t* raw_values(const Array& values) {
+  if (values.type_enum() == TypeEnum::TIMESTAMP) {
+    return static_cast<const TimestampArray&>(values).raw_data();
+  }
+  return static_cast<const TimeArray&>(values).raw_data();
+}
+
+// The null bitmap of values, with a new reference for the output
+Buffer* share_nulls(const Array& values) {
+  Buffer* nulls = values.nulls();
+  if (nulls != nullptr) {
+    nulls->Incref();
+  }
+  return nulls;
+}
+
+template <typename TypeClass>
+Status convert_unit(MemoryPool* pool, const Array& values,
+    TimestampType::Unit unit, Array** out) {
+  const TemporalArray<TypeClass>& array =
+    static_cast<const TemporalArray<TypeClass>&>(values);
+  size_t length = array.length();
+  TypePtr type(new TypeClass(unit, values.type()->nullable));
+
+  Buffer* data;
+  int steps = static_cast<int>(unit) - static_cast<int>(array.unit());
+  if (steps == 0) {
+    data = array.data();
+    if (data != nullptr) {
+      data->Incref();
+    }
+  } else {
+    RETURN_NOT_OK(pool->NewBuffer(length * sizeof(int64_t), &data));
+    Status s = convert_values(array.raw_data(), array.null_bits(), length,
+        steps, type, reinterpret_cast<int64_t*>(data->data()));
+    if (!s.ok()) {
+      data->Decref();
+      return s;
+    }
+  }
+  *out = new TemporalArray<TypeClass>(type, length, data,
+      share_nulls(values));
+  return Status::OK();
+}
+
+} // namespace
+
+Status ConvertUnit(MemoryPool* pool, const Array& values,
+    TimestampType::Unit unit, Array** out) {
+  switch (values.type_enum()) {
+    case TypeEnum::TIMESTAMP:
+      return convert_unit<TimestampType>(pool, values, unit, out);
+    case TypeEnum::TIME:
+      return convert_unit<TimeType>(pool, values, unit, out);
+    default:
+      return Status::NotImplemented("unit conversion of " +
+          values.type()->ToString());
+  }
+}
+
+Status ExtractField(MemoryPool* pool, const Array& values,
+    TemporalField field, Array** out) {
+  bool calendar_field = field == TemporalField::YEAR ||
+    field == TemporalField::MONTH || field == TemporalField::DAY;
+  bool supported;
+  switch (values.type_enum()) {
+    case TypeEnum::DATE:
+      supported = calendar_field &&
+        static_cast<const DateArray&>(values).unit() == DateType::Unit::DAY;
+      break;
+    case TypeEnum::TIMESTAMP:
+      supported = true;
+      break;
+    case TypeEnum::TIME:
+      supported = !calendar_field;
+      break;
+    default:
+      supported = false;
+      break;
+  }
+  if (!supported) {
+    return Status::NotImplemented("field extraction from " +
+        values.type()->ToString());
+  }
+
+  size_t length = values.length();
+  Buffer* data;
+  RETURN_NOT_OK(pool->NewBuffer(length * sizeof(int32_t), &data));
+  int32_t* result = reinterpret_cast<int32_t*>(data->data());
+  if (values.type_enum() == TypeEnum::DATE) {
+    extract_values<1, 1>(static_cast<const DateArray&>(values).raw_data(),
+        length, field, result);
+  } else {
+    TimestampType::Unit unit = values.type_enum() == TypeEnum::TIMESTAMP ?
+      static_cast<const TimestampArray&>(values).unit() :
+      static_cast<const TimeArray&>(values).unit();
+    extract_clock(raw_values(values), length, unit, field, result);
+  }
+  *out = new Int32Array(length, data, share_nulls(values));
+  return Status::OK();
+}
+
+Status Truncate(MemoryPool* pool, const Array& values, int64_t bucket,
+    Array** out) {
+  if (bucket <= 0) {
+    return Status::Invalid("truncation bucket must be positive, got " +
+        std::to_string(bucket));
+  }
+  size_t length = values.length();
+  switch (values.type_enum()) {
+    case TypeEnum::TIMESTAMP:
+    case TypeEnum::TIME:
+      {
+        Buffer* data;
+        RETURN_NOT_OK(pool->NewBuffer(length * sizeof(int64_t), &data));
+        Status s = truncate_values(raw_values(values), values.null_bits(),
+            length, bucket, values.type(),
+            reinterpret_cast<int64_t*>(data->data()));
+        if (!s.ok()) {
+          data->Decref();
+          return s;
+        }
+        if (values.type_enum() == TypeEnum::TIMESTAMP) {
+          *out = new TimestampArray(values.type(), length, data,
+              share_nulls(values));
+        } else {
+          *out = new TimeArray(values.type(), length, data,
+              share_nulls(values));
+        }
+        return Status::OK();
+      }
+    case TypeEnum::DATE:
+      {
+        // Truncated in int64, then narrowed back
+        const DateArray& array = static_cast<const DateArray&>(values);
+        std::vector<int64_t> truncated(length);
+        RETURN_NOT_OK(truncate_values(array.raw_data(), array.null_bits(),
+                length, bucket, values.type(), truncated.data()));
+
+        Buffer* data;
+        RETURN_NOT_OK(pool->NewBuffer(length * sizeof(int32_t), &data));
+        int32_t* result = reinterpret_cast<int32_t*>(data->data());
+        for (size_t i = 0; i < length; ++i) {
+          result[i] = static_cast<int32_t>(truncated[i]);
+        }
+        *out = new DateArray(values.type(), length, data,
+            share_nulls(values));
+        return Status::OK();
+      }
+    default:
+      return Status::NotImplemented("truncation of " +
+          values.type()->ToString());
+  }
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,71 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_TEMPORAL_H
+#define ARROW_COMPUTE_TEMPORAL_H
+
+#include <cstdint>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types/datetime.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Kernels on date, timestamp and time arrays. Dates and timestamps are in
+// UTC and the proleptic Gregorian calendar. Null slots stay null, and the
+// outputs share the null bitmap of their input. The loops have no branches
+// on the values: divisions by the units are by compile-time constants, and
+// the calendar arithmetic uses selects. The caller owns the returned arrays
+
+enum class TemporalField {
+  YEAR,
+  MONTH,
+  DAY,
+  HOUR,
+  MINUTE,
+  SECOND
+};
+
+// Convert a timestamp or time array to unit. Converting to a coarser unit
+// rounds toward negative infinity, so that a value stays in the second
+// (millisecond, ...) it falls in; converting to a finer one returns Invalid
+// if a non-null value overflows int64. The same unit shares the values
+Status ConvertUnit(MemoryPool* pool, const Array& values,
+    TimestampType::Unit unit, Array** out);
+
+// Extract a calendar or clock field as an Int32Array: months and days count
+// from 1. Timestamps have every field, dates in days the calendar ones and
+// times the clock ones; other combinations return NotImplemented
+Status ExtractField(MemoryPool* pool, const Array& values,
+    TemporalField field, Array** out);
+
+// Round every value of a timestamp, time or date array down to a multiple
+// of bucket, in the units of the array: 60000 makes one-minute buckets of
+// millisecond timestamps. The bucket is the same for every value, so
+// instead of a division per value the remainder is found by multiplying
+// with its reciprocal. Returns Invalid if bucket is not positive or the
+// multiple of a non-null value is below the range of its storage, int64 or
+// int32 for dates
+Status Truncate(MemoryPool* pool, const Array& values, int64_t bucket,
+    Array** out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_TEMPORAL_H
@@ -0,0 +1,93 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/compute/union.h"
+#include "arrow/types/floating.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/union.h"
+#include "arrow/util/benchmark-util.h"
+#include "arrow/util/random.h"
+
+namespace arrow {
+
+namespace compute {
+
+static constexpr size_t kNumValues = 1 << 22;
+
+// Split a union of num_children double children whose type codes are
+// uniformly random, which defeats branch prediction on the type code
+static void BenchmarkSplit(MemoryPool* pool, size_t num_children,
+    bool dense) {
+  Random rng(random_seed());
+  std::vector<int16_t> codes(kNumValues);
+  std::vector<std::vector<int32_t> > child_slots(num_children);
+  std::vector<int32_t> offsets(kNumValues);
+  for (size_t i = 0; i < kNumValues; ++i) {
+    codes[i] = static_cast<int16_t>(rng.Uniform(num_children));
+    offsets[i] = static_cast<int32_t>(child_slots[codes[i]].size());
+    child_slots[codes[i]].push_back(0);
+  }
+
+  std::vector<TypePtr> child_types;
+  std::vector<ArrayPtr> children;
+  for (size_t c = 0; c < num_children; ++c) {
+    size_t length = dense ? child_slots[c].size() : kNumValues;
+    std::vector<double> values(length);
+    child_types.push_back(TypePtr(new DoubleType(false)));
+    children.push_back(ArrayPtr(new DoubleArray(length,
+                benchmark::make_buffer(pool, values))));
+  }
+
+  ArrayPtr types(new Int16Array(kNumValues,
+          benchmark::make_buffer(pool, codes)));
+  std::unique_ptr<UnionArray> values;
+  if (dense) {
+    values.reset(new DenseUnionArray(
+            TypePtr(new DenseUnionType(child_types)), types,
+            ArrayPtr(new Int32Array(kNumValues,
+                    benchmark::make_buffer(pool, offsets))),
+            children));
+  } else {
+    values.reset(new SparseUnionArray(
+            TypePtr(new SparseUnionType(child_types)), types, children));
+  }
+
+  std::string name = std::string(dense ? "dense" : "sparse") + " " +
+    std::to_string(num_children) + " children";
+  benchmark::run(("SplitUnion " + name).c_str(),
+      kNumValues * sizeof(int16_t), [&]() {
+        std::vector<UnionSelection> selections;
+        BENCHMARK_OK(SplitUnion(pool, *values, &selections));
+      });
+}
+
+} // namespace compute
+
+} // namespace arrow
+
+int main(int argc, char** argv) {
+  arrow::MemoryPool pool;
+  arrow::compute::BenchmarkSplit(&pool, 2, false);
+  arrow::compute::BenchmarkSplit(&pool, 5, false);
+  arrow::compute::BenchmarkSplit(&pool, 5, true);
+  arrow::compute::BenchmarkSplit(&pool, 16, true);
+  return 0;
+}
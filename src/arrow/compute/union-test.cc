@@ -0,0 +1,187 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/memory.h"
+#include "arrow/test-util.h"
+
+#include "arrow/compute/take.h"
+#include "arrow/compute/union.h"
+#include "arrow/types/integer.h"
+#include "arrow/types/union.h"
+
+using std::unique_ptr;
+using std::vector;
+
+namespace arrow {
+
+namespace compute {
+
+class TestSplitUnion : public TestBase {
+ public:
+  // A union of int32 and int64 children, whose slot i holds i in child
+  // codes[i]
+  void Make(bool dense, const vector<int16_t>& codes) {
+    TypePtr int32_type(new Int32Type());
+    TypePtr int64_type(new Int64Type());
+    TypePtr type;
+    if (dense) {
+      type.reset(new DenseUnionType({int32_type, int64_type}));
+    } else {
+      type.reset(new SparseUnionType({int32_type, int64_type}));
+    }
+    ArrayBuilder* tmp;
+    ASSERT_OK(make_builder(pool_.get(), type, &tmp));
+    unique_ptr<UnionBuilder> builder(static_cast<UnionBuilder*>(tmp));
+    Int32Builder* ints = static_cast<Int32Builder*>(builder->child(0));
+    Int64Builder* longs = static_cast<Int64Builder*>(builder->child(1));
+
+    for (size_t i = 0; i < codes.size(); ++i) {
+      if (dense) {
+        ASSERT_OK(static_cast<DenseUnionBuilder*>(tmp)->Append(codes[i]));
+      } else {
+        ASSERT_OK(static_cast<SparseUnionBuilder*>(tmp)->Append(codes[i]));
+      }
+      if (codes[i] == 0) {
+        ASSERT_OK(ints->Append(static_cast<int32_t>(i)));
+      } else {
+        ASSERT_OK(longs->Append(static_cast<int64_t>(i)));
+      }
+    }
+    Array* out;
+    ASSERT_OK(builder->ToArray(&out));
+    values_.reset(static_cast<UnionArray*>(out));
+    ASSERT_OK(values_->Validate());
+  }
+
+  void Check(const vector<int16_t>& codes) {
+    vector<UnionSelection> selections;
+    ASSERT_OK(SplitUnion(pool_.get(), *values_, &selections));
+    ASSERT_EQ(2, selections.size());
+
+    vector<int32_t> ex_slots[2];
+    for (size_t i = 0; i < codes.size(); ++i) {
+      ex_slots[codes[i]].push_back(static_cast<int32_t>(i));
+    }
+    for (size_t c = 0; c < 2; ++c) {
+      const Int32Array& slots =
+        static_cast<const Int32Array&>(*selections[c].slots);
+      ASSERT_EQ(ex_slots[c].size(), slots.length());
+      for (size_t j = 0; j < slots.length(); ++j) {
+        ASSERT_EQ(ex_slots[c][j], slots.Value(j));
+      }
+
+      // Gathering the child by the indices gives each slot's value, which
+      // is its position
+      const Int32Array& indices =
+        static_cast<const Int32Array&>(*selections[c].child_indices);
+      Array* out;
+      ASSERT_OK(Take(pool_.get(), *values_->child(c), indices, &out));
+      unique_ptr<Array> taken(out);
+      for (size_t j = 0; j < slots.length(); ++j) {
+        int64_t value = c == 0 ?
+          static_cast<const Int32Array&>(*taken).Value(j) :
+          static_cast<const Int64Array&>(*taken).Value(j);
+        ASSERT_EQ(slots.Value(j), value);
+      }
+    }
+  }
+
+ protected:
+  unique_ptr<UnionArray> values_;
+};
+
+TEST_F(TestSplitUnion, TestDense) {
+  vector<int16_t> codes;
+  for (size_t i = 0; i < 1000; ++i) {
+    codes.push_back(i % 3 == 0 || i % 7 == 0);
+  }
+  Make(true, codes);
+  Check(codes);
+}
+
+TEST_F(TestSplitUnion, TestSparse) {
+  vector<int16_t> codes;
+  for (size_t i = 0; i < 1000; ++i) {
+    codes.push_back(i % 5 == 0);
+  }
+  Make(false, codes);
+  Check(codes);
+
+  // The child indices of sparse unions are the slots
+  vector<UnionSelection> selections;
+  ASSERT_OK(SplitUnion(pool_.get(), *values_, &selections));
+  ASSERT_EQ(selections[1].slots, selections[1].child_indices);
+}
+
+TEST_F(TestSplitUnion, TestEdgeCases) {
+  // Empty, and a child without any slots
+  Make(true, {});
+  Check({});
+  Make(false, {1, 1, 1});
+  Check({1, 1, 1});
+
+  // Type codes past the children
+  vector<int16_t> codes = {0, 2, 0};
+  vector<int32_t> values = {1, 2, 3};
+  TypePtr type(new SparseUnionType({TypePtr(new Int32Type(false))}));
+  SparseUnionArray bad(type, ArrayPtr(new Int16Array(3, to_buffer(codes))),
+      {ArrayPtr(new Int32Array(3, to_buffer(values)))});
+  vector<UnionSelection> selections;
+  ASSERT_RAISES(Invalid, SplitUnion(pool_.get(), bad, &selections));
+}
+
+TEST_F(TestSplitUnion, TestManyChildren) {
+  // More children than count passes, to use the histogram
+  size_t num_children = 20;
+  vector<TypePtr> child_types;
+  vector<ArrayPtr> children;
+  vector<int32_t> values(100);
+  vector<int16_t> codes(100);
+  for (size_t i = 0; i < codes.size(); ++i) {
+    codes[i] = static_cast<int16_t>((i * 7) % num_children);
+  }
+  for (size_t c = 0; c < num_children; ++c) {
+    child_types.push_back(TypePtr(new Int32Type(false)));
+    children.push_back(ArrayPtr(new Int32Array(values.size(),
+                to_buffer(values))));
+  }
+  TypePtr type(new SparseUnionType(child_types));
+  SparseUnionArray array(type, ArrayPtr(new Int16Array(codes.size(),
+              to_buffer(codes))), children);
+  ASSERT_OK(array.Validate());
+
+  vector<UnionSelection> selections;
+  ASSERT_OK(SplitUnion(pool_.get(), array, &selections));
+  ASSERT_EQ(num_children, selections.size());
+  for (size_t c = 0; c < num_children; ++c) {
+    const Int32Array& slots =
+      static_cast<const Int32Array&>(*selections[c].slots);
+    ASSERT_EQ(5, slots.length());
+    for (size_t j = 0; j < slots.length(); ++j) {
+      ASSERT_EQ(c, codes[slots.Value(j)]);
+    }
+  }
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,112 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/compute/union.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "arrow/types/integer.h"
+
+namespace arrow {
+
+namespace compute {
+
+// Up to this many children, the slots of each child are counted with a
+// separate pass over the type codes, in which the comparisons are summed
+// without branching so that the loop vectorizes. Past it, a single
+// histogram pass is cheaper
+static constexpr size_t kMaxCountPasses = 8;
+
+static void count_type_codes(const int16_t* codes, size_t length,
+    std::vector<size_t>* counts) {
+  size_t num_children = counts->size();
+  if (num_children <= kMaxCountPasses) {
+    for (size_t c = 0; c < num_children; ++c) {
+      int16_t code = static_cast<int16_t>(c);
+      size_t count = 0;
+      for (size_t i = 0; i < length; ++i) {
+        count += codes[i] == code;
+      }
+      (*counts)[c] = count;
+    }
+    return;
+  }
+  for (size_t i = 0; i < length; ++i) {
+    uint16_t code = static_cast<uint16_t>(codes[i]);
+    if (code < num_children) ++(*counts)[code];
+  }
+}
+
+static Status new_int32_array(MemoryPool* pool, size_t length, ArrayPtr* out,
+    int32_t** data) {
+  Buffer* buf;
+  RETURN_NOT_OK(pool->NewBuffer(length * sizeof(int32_t), &buf));
+  out->reset(new Int32Array(length, buf));
+  *data = reinterpret_cast<int32_t*>(buf->data());
+  return Status::OK();
+}
+
+Status SplitUnion(MemoryPool* pool, const UnionArray& values,
+    std::vector<UnionSelection>* out) {
+  size_t num_children = values.num_children();
+  size_t length = values.length();
+  const int16_t* codes = values.raw_types();
+  const int32_t* offsets = values.raw_offsets();
+
+  std::vector<size_t> counts(num_children);
+  count_type_codes(codes, length, &counts);
+  size_t total = 0;
+  for (size_t count : counts) {
+    total += count;
+  }
+  if (total != length) {
+    return Status::Invalid("union type code out of range");
+  }
+
+  std::vector<UnionSelection> selections(num_children);
+  std::vector<int32_t*> slots(num_children);
+  std::vector<int32_t*> indices(num_children);
+  for (size_t c = 0; c < num_children; ++c) {
+    RETURN_NOT_OK(new_int32_array(pool, counts[c], &selections[c].slots,
+            &slots[c]));
+    if (offsets == nullptr) {
+      selections[c].child_indices = selections[c].slots;
+    } else {
+      RETURN_NOT_OK(new_int32_array(pool, counts[c],
+              &selections[c].child_indices, &indices[c]));
+    }
+  }
+
+  // Every slot is written through the cursor of its child, so the type code
+  // selects an address rather than a branch
+  if (offsets == nullptr) {
+    for (size_t i = 0; i < length; ++i) {
+      *slots[codes[i]]++ = static_cast<int32_t>(i);
+    }
+  } else {
+    for (size_t i = 0; i < length; ++i) {
+      int16_t code = codes[i];
+      *slots[code]++ = static_cast<int32_t>(i);
+      *indices[code]++ = offsets[i];
+    }
+  }
+
+  out->swap(selections);
+  return Status::OK();
+}
+
+} // namespace compute
+
+} // namespace arrow
@@ -0,0 +1,54 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_COMPUTE_UNION_H
+#define ARROW_COMPUTE_UNION_H
+
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/memory.h"
+#include "arrow/types/union.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace compute {
+
+// The slots of a union array that hold values of one of its children
+struct UnionSelection {
+  // The union slots, in increasing order, as a non-nullable Int32Array
+  ArrayPtr slots;
+
+  // For each of those slots, the position of its value in the child. For
+  // sparse unions this is slots itself
+  ArrayPtr child_indices;
+};
+
+// Split a union into one selection per child, so that each child can be
+// processed on its own without branching on the type code of every slot:
+// for example gathered with Take(child, child_indices), with the results
+// scattered back to slots.
+//
+// The slots of each child are counted first, so that every selection is
+// allocated once, then written in a single branch-free pass over the type
+// codes. Returns Invalid if a type code is not one of the children
+Status SplitUnion(MemoryPool* pool, const UnionArray& values,
+    std::vector<UnionSelection>* out);
+
+} // namespace compute
+
+} // namespace arrow
+
+#endif // ARROW_COMPUTE_UNION_H
@@ -0,0 +1,66 @@
+// Copyright 2015 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_STATISTICS_H
+#define ARROW_STATISTICS_H
+
+#include <cstddef>
+#include <memory>
+
+namespace arrow {
+
+// Zone-map statistics of an array, computed by the builders while values are
+// appended. A reader can test a predicate against them and skip the whole
+// array without touching its buffers. An array without statistics may hold
+// any values
+struct ArrayStatistics {
+  ArrayStatistics(size_t null_count, bool has_min_max)
+      : null_count(null_count),
+        has_min_max(has_min_max) {}
+
+  virtual ~ArrayStatistics() {}
+
+  size_t null_count;
+
+  // False when the array has no non-null values other than NaN, so that no
+  // comparison with a value can be true for any slot
+  bool has_min_max;
+};
+
+typedef std::shared_ptr<ArrayStatistics> StatisticsPtr;
+
+
+// The smallest and largest non-null values of an array of c_type T, with
+// NaN ignored. Strings (T = std::string) compare bytewise
+template <typename T>
+struct TypedStatistics : public ArrayStatistics {
+  TypedStatistics(size_t null_count, bool has_min_max, const T& min,
+      const T& max)
+      : ArrayStatistics(null_count, has_min_max),
+        min(min),
+        max(max) {}
+
+  // Whether a non-null value v with lo <= v <= hi may be in the array. When
+  // false, the array can be skipped
+  bool MayOverlap(const T& lo, const T& hi) const {
+    return has_min_max && !(max < lo || hi < min);
+  }
+
+  T min;
+  T max;
+};
+
+} // namespace arrow
+
+#endif // ARROW_STATISTICS_H
@@ -19,10 +19,12 @@
 #include "arrow/types.h"
 
 #include "arrow/types/boolean.h"
+#include "arrow/types/datetime.h"
 #include "arrow/types/floating.h"
 #include "arrow/types/integer.h"
 #include "arrow/types/list.h"
 #include "arrow/types/string.h"
+#include "arrow/types/struct.h"
 
 using std::string;
 
@@ -134,4 +136,41 @@ TEST(TypesTest, TestListType) {
   ASSERT_EQ(lt2.ToString(), string("list<list<string>>"));
 }
 
+TEST(TypesTest, TestLargeTypes) {
+  LargeStringType str;
+  ASSERT_EQ(str.type, TypeEnum::LARGE_STRING);
+  ASSERT_EQ(str.ToString(), string("large_string"));
+
+  std::shared_ptr<DataType> st = std::make_shared<LargeStringType>();
+  LargeListType list_type(st, false);
+  ASSERT_EQ(list_type.type, TypeEnum::LARGE_LIST);
+  ASSERT_FALSE(list_type.nullable);
+  ASSERT_EQ(list_type.ToString(), string("large_list<large_string>"));
+}
+
+TEST(TypesTest, TestStructType) {
+  TypePtr int_type(new Int32Type());
+  TypePtr string_type(new StringType());
+  StructType struct_type({int_type, string_type});
+  ASSERT_EQ(struct_type.type, TypeEnum::STRUCT);
+  ASSERT_EQ(2, struct_type.num_children());
+  ASSERT_EQ(struct_type.ToString(), string("struct<int32, string>"));
+}
+
+TEST(TypesTest, TestTemporalTypes) {
+  DateType date;
+  ASSERT_EQ(date.type, TypeEnum::DATE);
+  ASSERT_EQ(date.ToString(), string("date<day>"));
+
+  TimestampType timestamp(TimestampType::Unit::NANO, false);
+  ASSERT_EQ(timestamp.type, TypeEnum::TIMESTAMP);
+  ASSERT_FALSE(timestamp.nullable);
+  ASSERT_EQ(timestamp.ToString(), string("timestamp<ns>"));
+
+  TimeType time;
+  ASSERT_EQ(time.type, TypeEnum::TIME);
+  ASSERT_EQ(time.ToString(), string("time<ms>"));
+  ASSERT_EQ(1000000, units_per_second(TimestampType::Unit::MICRO));
+}
+
 } // namespace arrow
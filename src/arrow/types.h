@@ -117,6 +117,9 @@ enum class TypeEnum: char {
   // Decimal value encoded as a text string
   DECIMAL_TEXT = 22,
 
+  // STRING with 64-bit offsets, for more than 2^31 - 1 bytes of characters
+  LARGE_STRING = 23,
+
   // A list of some logical data type
   LIST = 30,
 
@@ -127,6 +130,15 @@ enum class TypeEnum: char {
   DENSE_UNION = 32,
   SPARSE_UNION = 33,
 
+  // LIST with 64-bit offsets, for more than 2^31 - 1 child values
+  LARGE_LIST = 34,
+
+  // Integer indices into an array of distinct values
+  DICTIONARY = 40,
+
+  // Runs of equal values, stored as the end position and value of each run
+  RUN_END = 41,
+
   // Union<Null, Int32, Double, String, Bool>
   JSON_SCALAR = 50
 };
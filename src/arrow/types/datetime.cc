@@ -0,0 +1,57 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/types/datetime.h"
+
+#include <string>
+
+namespace arrow {
+
+static const char* unit_name(DateType::Unit unit) {
+  switch (unit) {
+    case DateType::Unit::MONTH:
+      return "month";
+    case DateType::Unit::YEAR:
+      return "year";
+    default:
+      return "day";
+  }
+}
+
+static const char* unit_name(TimestampType::Unit unit) {
+  switch (unit) {
+    case TimestampType::Unit::SECOND:
+      return "s";
+    case TimestampType::Unit::MICRO:
+      return "us";
+    case TimestampType::Unit::NANO:
+      return "ns";
+    default:
+      return "ms";
+  }
+}
+
+std::string DateType::ToString() const {
+  return std::string(name()) + "<" + unit_name(unit) + ">";
+}
+
+std::string TimestampType::ToString() const {
+  return std::string(name()) + "<" + unit_name(unit) + ">";
+}
+
+std::string TimeType::ToString() const {
+  return std::string(name()) + "<" + unit_name(unit) + ">";
+}
+
+} // namespace arrow
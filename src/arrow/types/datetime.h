@@ -15,7 +15,12 @@
 #ifndef ARROW_TYPES_DATETIME_H
 #define ARROW_TYPES_DATETIME_H
 
+#include <cstdint>
+#include <string>
+
+#include "arrow/array.h"
 #include "arrow/types.h"
+#include "arrow/types/integer.h"
 
 namespace arrow {
 
@@ -27,6 +32,10 @@ struct DateType : public DataType {
     YEAR = 2
   };
 
+  // Units since the UNIX epoch
+  typedef int32_t c_type;
+  typedef Int32Type storage_type;
+
   Unit unit;
 
   explicit DateType(Unit unit = Unit::DAY, bool nullable = true)
@@ -40,9 +49,7 @@ struct DateType : public DataType {
     return "date";
   }
 
-  // virtual std::string ToString() {
-  //   return name();
-  // }
+  virtual std::string ToString() const;
 };
 
 
@@ -55,6 +62,10 @@ struct TimestampType : public DataType {
     NANO = 3
   };
 
+  // Units since the UNIX epoch
+  typedef int64_t c_type;
+  typedef Int64Type storage_type;
+
   Unit unit;
 
   explicit TimestampType(Unit unit = Unit::MILLI, bool nullable = true)
@@ -68,11 +79,80 @@ struct TimestampType : public DataType {
     return "timestamp";
   }
 
-  // virtual std::string ToString() {
-  //   return name();
-  // }
+  virtual std::string ToString() const;
+};
+
+
+// Time of day, with the units of a timestamp
+struct TimeType : public DataType {
+
+  typedef TimestampType::Unit Unit;
+
+  // Units since midnight
+  typedef int64_t c_type;
+  typedef Int64Type storage_type;
+
+  Unit unit;
+
+  explicit TimeType(Unit unit = Unit::MILLI, bool nullable = true)
+      : DataType(TypeEnum::TIME, nullable),
+        unit(unit) {}
+
+  TimeType(const TimeType& other)
+      : TimeType(other.unit, other.nullable) {}
+
+  static char const *name() {
+    return "time";
+  }
+
+  virtual std::string ToString() const;
 };
 
+
+// Number of units of a timestamp or time per second
+static inline int64_t units_per_second(TimestampType::Unit unit) {
+  static constexpr int64_t kPerSecond[] = {1, 1000, 1000000, 1000000000};
+  return kPerSecond[static_cast<int>(unit)];
+}
+
+
+// Arrays of the temporal type TypeClass, stored as its c_type. Unlike other
+// primitive arrays they are created with their type, which carries the unit.
+// They are also arrays of their storage type, so kernels over int32 and int64
+// values read them unchanged
+template <typename TypeClass>
+class TemporalArray
+    : public PrimitiveArrayImpl<typename TypeClass::storage_type> {
+ public:
+  typedef PrimitiveArrayImpl<typename TypeClass::storage_type> StorageArray;
+
+  TemporalArray() : StorageArray() {}
+
+  TemporalArray(const TypePtr& type, size_t length, Buffer* data,
+      Buffer* nulls = nullptr) {
+    PrimitiveArray::Init(type, length, data, nulls);
+  }
+
+  typename TypeClass::Unit unit() const {
+    return static_cast<const TypeClass&>(*this->type_).unit;
+  }
+
+  // Values of different units are not equal, even if they are the same
+  // number
+  virtual bool RangeEquals(size_t start, size_t end, size_t other_start,
+      const Array& other) const {
+    if (this->type_enum() != other.type_enum()) return false;
+    if (unit() != static_cast<const TemporalArray&>(other).unit()) {
+      return false;
+    }
+    return StorageArray::RangeEquals(start, end, other_start, other);
+  }
+};
+
+typedef TemporalArray<DateType> DateArray;
+typedef TemporalArray<TimestampType> TimestampArray;
+typedef TemporalArray<TimeType> TimeArray;
+
 } // namespace arrow
 
 #endif // ARROW_TYPES_DATETIME_H
@@ -0,0 +1,136 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/types/dictionary.h"
+
+#include <sstream>
+#include <string>
+
+namespace arrow {
+
+std::string DictionaryType::ToString() const {
+  std::stringstream s;
+  s << "dictionary<" << value_type->ToString() << ", "
+    << index_type->ToString() << ">";
+  return s.str();
+}
+
+void DictionaryArray::Init(const TypePtr& type, const ArrayPtr& indices,
+    const ArrayPtr& dictionary) {
+  indices_ = indices;
+  dictionary_ = dictionary;
+
+  const PrimitiveArray& index_array =
+    static_cast<const PrimitiveArray&>(*indices);
+  raw_indices_ = index_array.data() == nullptr ? nullptr :
+    index_array.data()->data();
+  switch (indices->type_enum()) {
+    case TypeEnum::INT8:
+      index_width_ = 1;
+      break;
+    case TypeEnum::INT16:
+      index_width_ = 2;
+      break;
+    default:
+      index_width_ = 4;
+      break;
+  }
+
+  // Shares the null bitmap of the indices
+  Buffer* nulls = indices->nulls();
+  if (nulls != nullptr) {
+    nulls->Incref();
+  }
+  Array::Init(type, indices->length(), nulls);
+}
+
+// The position of the first non-null index outside [0, dictionary_length),
+// or length if there is none. A word of out of range bits is built per 64
+// indices without branching, then the null slots are masked out
+template <typename T>
+static size_t find_bad_index(const T* indices, const uint8_t* null_bits,
+    size_t length, size_t dictionary_length) {
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t bad = 0;
+    for (size_t j = 0; j < n; ++j) {
+      int64_t index = indices[i + j];
+      bad |= static_cast<uint64_t>(index < 0 ||
+          index >= static_cast<int64_t>(dictionary_length)) << j;
+    }
+    if (null_bits != nullptr) {
+      bad &= ~util::load_bits(null_bits, i, n);
+    }
+    if (bad != 0) {
+      return i + __builtin_ctzll(bad);
+    }
+  }
+  return length;
+}
+
+Status DictionaryArray::Validate() const {
+  RETURN_NOT_OK(indices_->Validate());
+  RETURN_NOT_OK(dictionary_->Validate());
+
+  size_t length = indices_->length();
+  size_t bad;
+  switch (indices_->type_enum()) {
+    case TypeEnum::INT8:
+      bad = find_bad_index(reinterpret_cast<const int8_t*>(raw_indices_),
+          null_bits_, length, dictionary_->length());
+      break;
+    case TypeEnum::INT16:
+      bad = find_bad_index(reinterpret_cast<const int16_t*>(raw_indices_),
+          null_bits_, length, dictionary_->length());
+      break;
+    case TypeEnum::INT32:
+      bad = find_bad_index(reinterpret_cast<const int32_t*>(raw_indices_),
+          null_bits_, length, dictionary_->length());
+      break;
+    default:
+      return Status::Invalid("dictionary indices must be int8, int16 or "
+          "int32, not " + indices_->type()->ToString());
+  }
+  if (bad < length) {
+    return Status::Invalid("index " + std::to_string(index(bad)) +
+        " at slot " + std::to_string(bad) + " is outside the dictionary");
+  }
+  return Status::OK();
+}
+
+bool DictionaryArray::RangeEquals(size_t start, size_t end,
+    size_t other_start, const Array& other) const {
+  if (this == &other && start == other_start) return true;
+  if (type_enum() != other.type_enum()) return false;
+
+  const DictionaryArray& o = static_cast<const DictionaryArray&>(other);
+  if (!util::bitmaps_equal(null_bits_, start, o.null_bits(), other_start,
+          end - start)) {
+    return false;
+  }
+
+  bool same_dictionary = dictionary_ == o.dictionary_;
+  for (size_t i = start, j = other_start; i < end; ++i, ++j) {
+    if (IsNull(i)) continue;
+    int32_t left = index(i);
+    int32_t right = o.index(j);
+    if (same_dictionary ? left != right :
+        !dictionary_->RangeEquals(left, left + 1, right, *o.dictionary_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace arrow
@@ -0,0 +1,96 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_TYPES_DICTIONARY_H
+#define ARROW_TYPES_DICTIONARY_H
+
+#include <string>
+
+#include "arrow/array.h"
+#include "arrow/types.h"
+
+namespace arrow {
+
+// Dictionary-encoded values: each slot holds an index into an array of
+// distinct values of value_type
+struct DictionaryType : public DataType {
+  // Signed integer type of the indices: int8, int16 or int32
+  TypePtr index_type;
+
+  TypePtr value_type;
+
+  DictionaryType(const TypePtr& index_type, const TypePtr& value_type,
+      bool nullable = true)
+      : DataType(TypeEnum::DICTIONARY, nullable),
+        index_type(index_type),
+        value_type(value_type) {}
+
+  static char const *name() {
+    return "dictionary";
+  }
+
+  virtual std::string ToString() const;
+};
+
+
+// The slots of the array are null wherever the indices are null; the
+// dictionary itself has no nulls
+class DictionaryArray : public Array {
+ public:
+  DictionaryArray() : Array(), raw_indices_(nullptr), index_width_(0) {}
+
+  DictionaryArray(const TypePtr& type, const ArrayPtr& indices,
+      const ArrayPtr& dictionary) {
+    Init(type, indices, dictionary);
+  }
+
+  void Init(const TypePtr& type, const ArrayPtr& indices,
+      const ArrayPtr& dictionary);
+
+  const ArrayPtr& indices() const { return indices_;}
+  const ArrayPtr& dictionary() const { return dictionary_;}
+
+  // The index of slot i into the dictionary, whatever the index type.
+  // Meaningless for null slots. Does *not* boundscheck
+  int32_t index(size_t i) const {
+    switch (index_width_) {
+      case 1:
+        return reinterpret_cast<const int8_t*>(raw_indices_)[i];
+      case 2:
+        return reinterpret_cast<const int16_t*>(raw_indices_)[i];
+      default:
+        return reinterpret_cast<const int32_t*>(raw_indices_)[i];
+    }
+  }
+
+  // Slots are compared by their dictionary values, so arrays with different
+  // dictionaries or index types can be equal
+  virtual bool RangeEquals(size_t start, size_t end, size_t other_start,
+      const Array& other) const;
+
+  // The indices must be int8, int16 or int32, and every non-null index must
+  // be a position in the dictionary
+  virtual Status Validate() const;
+
+ private:
+  ArrayPtr indices_;
+  ArrayPtr dictionary_;
+
+  const uint8_t* raw_indices_;
+  int index_width_;
+};
+
+} // namespace arrow
+
+#endif // ARROW_TYPES_DICTIONARY_H
@@ -15,12 +15,26 @@
 #ifndef ARROW_TYPES_JSON_H
 #define ARROW_TYPES_JSON_H
 
+#include <cstdint>
+#include <string>
+
 #include "arrow/types.h"
 
 namespace arrow {
 
+// A JSON scalar: null, int, string, double or bool. Stored as a union,
+// dense_type or sparse_type, whose children are of those types in the order
+// of their TypeCode
 struct JSONScalar : public DataType {
 
+  enum TypeCode : int16_t {
+    NA = 0,
+    INT32 = 1,
+    STRING = 2,
+    DOUBLE = 3,
+    BOOL = 4
+  };
+
   bool dense;
 
   static TypePtr dense_type;
@@ -29,6 +43,19 @@ struct JSONScalar : public DataType {
   explicit JSONScalar(bool dense = true, bool nullable = true)
       : DataType(TypeEnum::JSON_SCALAR, nullable),
         dense(dense) {}
+
+  // The union type the scalars are stored as
+  const TypePtr& storage_type() const {
+    return dense ? dense_type : sparse_type;
+  }
+
+  static char const *name() {
+    return "json";
+  }
+
+  virtual std::string ToString() const {
+    return name();
+  }
 };
 
 } // namespace arrow
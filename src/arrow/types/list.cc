@@ -25,4 +25,95 @@ std::string ListType::ToString() const {
   return s.str();
 }
 
+std::string LargeListType::ToString() const {
+  std::stringstream s;
+  s << "large_list<" << value_type->ToString() << ">";
+  return s.str();
+}
+
+// Check that offsets[0, length] never decrease and lie within
+// [0, values_length]. The comparisons are accumulated without branching so
+// that the loop vectorizes; the failing offset is only located on error
+template <typename offset_type>
+static Status validate_offsets(const offset_type* offsets, size_t length,
+    size_t values_length) {
+  bool decreasing = false;
+  for (size_t i = 0; i < length; ++i) {
+    decreasing |= offsets[i + 1] < offsets[i];
+  }
+  if (decreasing) {
+    size_t i = 1;
+    while (offsets[i] >= offsets[i - 1]) ++i;
+    return Status::Invalid("offset " + std::to_string(i) +
+        " is smaller than the offset before it");
+  }
+  if (offsets[0] < 0) {
+    return Status::Invalid("first offset is negative");
+  }
+  if (static_cast<size_t>(offsets[length]) > values_length) {
+    return Status::Invalid("last offset " + std::to_string(offsets[length]) +
+        " is past the end of the values");
+  }
+  return Status::OK();
+}
+
+template <typename offset_type>
+Status BaseListArray<offset_type>::Validate() const {
+  RETURN_NOT_OK(Array::Validate());
+  if (length_ > 0) {
+    size_t size = offset_buf_ == nullptr ? 0 : offset_buf_->size();
+    if (size / sizeof(offset_type) < length_ + 1) {
+      return Status::Invalid("offsets buffer is smaller than the array length");
+    }
+    if (!values_) {
+      return Status::Invalid("list has no values array");
+    }
+    RETURN_NOT_OK(validate_offsets(offsets_, length_, values_->length()));
+  }
+  return values_ ? values_->Validate() : Status::OK();
+}
+
+template <typename offset_type>
+bool BaseListArray<offset_type>::RangeEquals(size_t start, size_t end,
+    size_t other_start, const Array& other) const {
+  if (this == &other && start == other_start) return true;
+  if (type_enum() != other.type_enum()) return false;
+
+  const BaseListArray& o = static_cast<const BaseListArray&>(other);
+  size_t length = end - start;
+  if (!util::bitmaps_equal(null_bits_, start, o.null_bits(), other_start,
+          length)) {
+    return false;
+  }
+
+  // Consecutive non-null slots have adjacent value ranges, so after checking
+  // the slot lengths each run of non-null slots is compared with a single
+  // child RangeEquals call
+  size_t i = 0;
+  while (i < length) {
+    if (IsNull(start + i)) {
+      ++i;
+      continue;
+    }
+    size_t run_start = i;
+    while (i < length && !IsNull(start + i)) {
+      if (value_length(start + i) != o.value_length(other_start + i)) {
+        return false;
+      }
+      ++i;
+    }
+    offset_type begin = offsets_[start + run_start];
+    offset_type stop = offsets_[start + i];
+    if (begin != stop &&
+        !values_->RangeEquals(begin, stop,
+            o.offsets_[other_start + run_start], *o.values_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template class BaseListArray<int32_t>;
+template class BaseListArray<int64_t>;
+
 } // namespace arrow
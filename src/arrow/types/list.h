@@ -15,6 +15,7 @@
 #ifndef ARROW_TYPES_LIST_H
 #define ARROW_TYPES_LIST_H
 
+#include <cstdint>
 #include <string>
 
 #include "arrow/array.h"
@@ -39,16 +40,38 @@ struct ListType : public DataType {
 };
 
 
-class ListArray : public Array {
+// ListType with int64 offsets, for lists whose values do not fit in int32
+// offsets
+struct LargeListType : public DataType {
+  TypePtr value_type;
+
+  LargeListType(const TypePtr& value_type,
+      bool nullable = true)
+      : DataType(TypeEnum::LARGE_LIST, nullable),
+        value_type(value_type) {}
+
+  static char const *name() {
+    return "large_list";
+  }
+
+  virtual std::string ToString() const;
+};
+
+
+// An array of lists, whose slot i holds the values [offsets[i],
+// offsets[i + 1]) of the child array. offset_type is int32_t for ListArray
+// and int64_t for LargeListArray
+template <typename offset_type>
+class BaseListArray : public Array {
  public:
-  ListArray() : Array(), offset_buf_(nullptr), offsets_(nullptr) {}
+  BaseListArray() : Array(), offset_buf_(nullptr), offsets_(nullptr) {}
 
-  ListArray(const TypePtr& type, size_t length, Buffer* offsets,
+  BaseListArray(const TypePtr& type, size_t length, Buffer* offsets,
       const ArrayPtr& values, Buffer* nulls = nullptr) {
     Init(type, length, offsets, values, nulls);
   }
 
-  virtual ~ListArray() {
+  virtual ~BaseListArray() {
     if (offset_buf_ != nullptr) {
       offset_buf_->Decref();
     }
@@ -58,7 +81,7 @@ class ListArray : public Array {
       const ArrayPtr& values, Buffer* nulls = nullptr) {
     offset_buf_ = offsets;
     offsets_ = offsets == nullptr? nullptr :
-      reinterpret_cast<const int32_t*>(offset_buf_->data());
+      reinterpret_cast<const offset_type*>(offset_buf_->data());
 
     values_ = values;
     Array::Init(type, length, nulls);
@@ -68,20 +91,32 @@ class ListArray : public Array {
   // with this array.
   const ArrayPtr& values() const {return values_;}
 
-  const int32_t* offsets() const { return offsets_;}
+  const offset_type* offsets() const { return offsets_;}
 
-  int32_t offset(size_t i) const { return offsets_[i];}
+  offset_type offset(size_t i) const { return offsets_[i];}
 
   // Neither of these functions will perform boundschecking
-  int32_t value_offset(size_t i) { return offsets_[i];}
-  size_t value_length(size_t i) { return offsets_[i + 1] - offsets_[i];}
+  offset_type value_offset(size_t i) const { return offsets_[i];}
+  size_t value_length(size_t i) const { return offsets_[i + 1] - offsets_[i];}
+
+  // Two list slots are equal if they have the same length and their value
+  // ranges in the child arrays are equal
+  virtual bool RangeEquals(size_t start, size_t end, size_t other_start,
+      const Array& other) const;
+
+  // The offsets must start at or after 0, never decrease and end at or
+  // before the length of the values, which are validated in turn
+  virtual Status Validate() const;
 
  protected:
   Buffer* offset_buf_;
-  const int32_t* offsets_;
+  const offset_type* offsets_;
   ArrayPtr values_;
 };
 
+typedef BaseListArray<int32_t> ListArray;
+typedef BaseListArray<int64_t> LargeListArray;
+
 } // namespace arrow
 
 #endif // ARROW_TYPES_LIST_H
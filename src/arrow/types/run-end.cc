@@ -0,0 +1,114 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/types/run-end.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "arrow/types/integer.h"
+
+namespace arrow {
+
+std::string RunEndType::ToString() const {
+  std::stringstream s;
+  s << "run_end<" << value_type->ToString() << ">";
+  return s.str();
+}
+
+void RunEndArray::Init(const TypePtr& type, const ArrayPtr& run_ends,
+    const ArrayPtr& values) {
+  run_ends_ = run_ends;
+  values_ = values;
+
+  const PrimitiveArray& run_end_array =
+    static_cast<const PrimitiveArray&>(*run_ends);
+  raw_run_ends_ = run_end_array.data() == nullptr ? nullptr :
+    reinterpret_cast<const int32_t*>(run_end_array.data()->data());
+
+  size_t num_runs = run_ends->length();
+  Array::Init(type, num_runs == 0 ? 0 : raw_run_ends_[num_runs - 1], nullptr);
+
+  // Nulls are kept per run in the values
+  nullable_ = false;
+}
+
+size_t RunEndArray::FindRun(size_t i) const {
+  const int32_t* end = raw_run_ends_ + run_ends_->length();
+  return std::upper_bound(raw_run_ends_, end, static_cast<int32_t>(i)) -
+    raw_run_ends_;
+}
+
+bool RunEndArray::RangeEquals(size_t start, size_t end, size_t other_start,
+    const Array& other) const {
+  if (this == &other && start == other_start) return true;
+  if (type_enum() != other.type_enum()) return false;
+  if (start == end) return true;
+
+  // Walk both arrays a stretch at a time, where a stretch ends wherever a
+  // run of either side does, comparing one value per stretch
+  const RunEndArray& o = static_cast<const RunEndArray&>(other);
+  size_t r = FindRun(start);
+  size_t other_r = o.FindRun(other_start);
+  size_t i = start;
+  size_t j = other_start;
+  while (i < end) {
+    if (!values_->RangeEquals(r, r + 1, other_r, *o.values_)) {
+      return false;
+    }
+    size_t step = std::min<size_t>(run_end(r) - i, o.run_end(other_r) - j);
+    i += step;
+    j += step;
+    if (i == static_cast<size_t>(run_end(r))) ++r;
+    if (j == static_cast<size_t>(o.run_end(other_r))) ++other_r;
+  }
+  return true;
+}
+
+Status RunEndArray::Validate() const {
+  if (!run_ends_ || !values_) {
+    return Status::Invalid("run end array is missing a child array");
+  }
+  if (run_ends_->type_enum() != TypeEnum::INT32) {
+    return Status::Invalid("run ends must be int32, not " +
+        run_ends_->type()->ToString());
+  }
+  RETURN_NOT_OK(run_ends_->Validate());
+  RETURN_NOT_OK(values_->Validate());
+
+  size_t num_runs = run_ends_->length();
+  if (run_ends_->null_bits() != nullptr &&
+      util::count_set_bits(run_ends_->null_bits(), 0, num_runs) > 0) {
+    return Status::Invalid("run ends must not be null");
+  }
+  if (values_->length() != num_runs) {
+    return Status::Invalid("run end array has " + std::to_string(num_runs) +
+        " runs but " + std::to_string(values_->length()) + " values");
+  }
+  if (num_runs == 0) return Status::OK();
+
+  // Accumulated without branching so that the loop vectorizes
+  bool increasing = raw_run_ends_[0] > 0;
+  for (size_t r = 1; r < num_runs; ++r) {
+    increasing &= raw_run_ends_[r] > raw_run_ends_[r - 1];
+  }
+  if (!increasing) {
+    return Status::Invalid("run ends must be positive and strictly "
+        "increasing");
+  }
+  return Status::OK();
+}
+
+} // namespace arrow
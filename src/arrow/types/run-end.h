@@ -0,0 +1,89 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_TYPES_RUN_END_H
+#define ARROW_TYPES_RUN_END_H
+
+#include <string>
+
+#include "arrow/array.h"
+#include "arrow/types.h"
+
+namespace arrow {
+
+// Run-end encoded values: consecutive equal slots are stored once, as a run
+// of value_type
+struct RunEndType : public DataType {
+  TypePtr value_type;
+
+  explicit RunEndType(const TypePtr& value_type, bool nullable = true)
+      : DataType(TypeEnum::RUN_END, nullable),
+        value_type(value_type) {}
+
+  static char const *name() {
+    return "run_end";
+  }
+
+  virtual std::string ToString() const;
+};
+
+
+// Run r covers the slots [run_start(r), run_end(r)) and holds values[r]. The
+// run ends are a non-nullable Int32Array, strictly increasing, and the last
+// one is the length of the array; values has one slot per run.
+//
+// A null run is a null slot of values. There is no null bitmap per slot, so
+// IsNull is always false: look up the run with FindRun instead
+class RunEndArray : public Array {
+ public:
+  RunEndArray() : Array(), raw_run_ends_(nullptr) {}
+
+  RunEndArray(const TypePtr& type, const ArrayPtr& run_ends,
+      const ArrayPtr& values) {
+    Init(type, run_ends, values);
+  }
+
+  void Init(const TypePtr& type, const ArrayPtr& run_ends,
+      const ArrayPtr& values);
+
+  const ArrayPtr& run_ends() const { return run_ends_;}
+  const ArrayPtr& values() const { return values_;}
+
+  size_t num_runs() const { return run_ends_->length();}
+
+  int32_t run_start(size_t r) const {
+    return r == 0 ? 0 : raw_run_ends_[r - 1];
+  }
+  int32_t run_end(size_t r) const { return raw_run_ends_[r];}
+
+  // The run holding slot i, found by binary search. Does *not* boundscheck
+  size_t FindRun(size_t i) const;
+
+  // Slots are compared by the values of their runs, so arrays that split
+  // the same slots into runs differently can be equal
+  virtual bool RangeEquals(size_t start, size_t end, size_t other_start,
+      const Array& other) const;
+
+  virtual Status Validate() const;
+
+ protected:
+  ArrayPtr run_ends_;
+  ArrayPtr values_;
+
+  const int32_t* raw_run_ends_;
+};
+
+} // namespace arrow
+
+#endif // ARROW_TYPES_RUN_END_H
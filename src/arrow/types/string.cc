@@ -17,6 +17,8 @@
 #include <sstream>
 #include <string>
 
+#include "arrow/util/utf8.h"
+
 namespace arrow {
 
 std::string CharType::ToString() const {
@@ -32,4 +34,45 @@ std::string VarcharType::ToString() const {
   return s.str();
 }
 
+template <typename TypeClass>
+Status BaseStringArray<TypeClass>::Validate() const {
+  const ArrayPtr& values = this->values_;
+  if (values && values->type_enum() != TypeEnum::UINT8) {
+    return Status::Invalid("string values must be uint8, not " +
+        values->type()->ToString());
+  }
+  return ListArrayType::Validate();
+}
+
+template <typename TypeClass>
+Status BaseStringArray<TypeClass>::ValidateUtf8() const {
+  size_t length = this->length_;
+  const offset_type* offsets = this->offsets_;
+  if (length == 0) return Status::OK();
+
+  // Check all the bytes at once, then that no slot starts in the middle of
+  // a character. Only on failure are the slots checked one by one, to find
+  // the first bad one
+  offset_type end = offsets[length];
+  bool valid = util::validate_utf8(raw_bytes_ + offsets[0],
+      end - offsets[0]);
+  for (size_t i = 1; i < length; ++i) {
+    offset_type pos = offsets[i];
+    valid &= pos == end || (raw_bytes_[pos] & 0xC0) != 0x80;
+  }
+  if (valid) return Status::OK();
+
+  for (size_t i = 0; i < length; ++i) {
+    size_t nbytes;
+    const uint8_t* str = GetValue(i, &nbytes);
+    if (!util::validate_utf8(str, nbytes)) {
+      return Status::Invalid("invalid UTF-8 in string " + std::to_string(i));
+    }
+  }
+  return Status::Invalid("invalid UTF-8");
+}
+
+template class BaseStringArray<StringType>;
+template class BaseStringArray<LargeStringType>;
+
 } // namespace arrow
@@ -15,6 +15,7 @@
 #ifndef ARROW_TYPES_STRING_H
 #define ARROW_TYPES_STRING_H
 
+#include <cstdint>
 #include <string>
 
 #include "arrow/array.h"
@@ -61,6 +62,7 @@ struct VarcharType : public DataType {
 
 // String is a logical type consisting of a physical list of 1-byte values
 struct StringType : public DataType {
+  typedef int32_t offset_type;
 
   explicit StringType(bool nullable = true)
       : DataType(TypeEnum::STRING, nullable) {}
@@ -82,21 +84,56 @@ struct StringType : public DataType {
 };
 
 
+// StringType with int64 offsets, for columns of more than 2^31 - 1 bytes
+struct LargeStringType : public DataType {
+  typedef int64_t offset_type;
+
+  explicit LargeStringType(bool nullable = true)
+      : DataType(TypeEnum::LARGE_STRING, nullable) {}
+
+  LargeStringType(const LargeStringType& other)
+      : LargeStringType(other.nullable) {}
+
+  static char const *name() {
+    return "large_string";
+  }
+
+  virtual std::string ToString() const {
+    return name();
+  }
+};
+
+
+// A string value held in memory owned by someone else, such as a decoder's
+// input buffer
+struct StringView {
+  const uint8_t* data;
+  size_t length;
+};
+
+
 // TODO: add a BinaryArray layer in between
-class StringArray : public ListArray {
+//
+// An array of strings of type TypeClass, stored as a list of bytes with
+// offsets of type TypeClass::offset_type
+template <typename TypeClass>
+class BaseStringArray : public BaseListArray<typename TypeClass::offset_type> {
  public:
-  StringArray() : ListArray(), bytes_(nullptr), raw_bytes_(nullptr) {}
+  typedef typename TypeClass::offset_type offset_type;
+  typedef BaseListArray<offset_type> ListArrayType;
+
+  BaseStringArray() : ListArrayType(), bytes_(nullptr), raw_bytes_(nullptr) {}
 
-  StringArray(size_t length, Buffer* offsets, const ArrayPtr& values,
+  BaseStringArray(size_t length, Buffer* offsets, const ArrayPtr& values,
       Buffer* nulls = nullptr) {
     Init(length, offsets, values, nulls);
   }
 
   void Init(const TypePtr& type, size_t length, Buffer* offsets, const ArrayPtr& values,
       Buffer* nulls = nullptr) {
-    ListArray::Init(type, length, offsets, values, nulls);
+    ListArrayType::Init(type, length, offsets, values, nulls);
 
-    // TODO: type validation for values array
+    // The type of the values is checked by Validate
 
     // For convenience
     bytes_ = static_cast<UInt8Array*>(values.get());
@@ -105,14 +142,14 @@ class StringArray : public ListArray {
 
   void Init(size_t length, Buffer* offsets, const ArrayPtr& values,
       Buffer* nulls = nullptr) {
-    TypePtr type(new StringType(nulls != nullptr));
+    TypePtr type(new TypeClass(nulls != nullptr));
     Init(type, length, offsets, values, nulls);
   }
 
   // Compute the pointer t
   const uint8_t* GetValue(size_t i, size_t* out_length) const {
-    int32_t pos = offsets_[i];
-    *out_length = offsets_[i + 1] - pos;
+    offset_type pos = this->offsets_[i];
+    *out_length = this->offsets_[i + 1] - pos;
     return raw_bytes_ + pos;
   }
 
@@ -123,11 +160,21 @@ class StringArray : public ListArray {
     return std::string(reinterpret_cast<const char*>(str), nchars);
   }
 
+  // The values must be a UInt8Array, on top of the ListArray checks
+  virtual Status Validate() const;
+
+  // Check that every slot, null or not, holds valid UTF-8. This reads the
+  // bytes, so it is kept separate from Validate, which must succeed first
+  Status ValidateUtf8() const;
+
  private:
   UInt8Array* bytes_;
   const uint8_t* raw_bytes_;
 };
 
+typedef BaseStringArray<StringType> StringArray;
+typedef BaseStringArray<LargeStringType> LargeStringArray;
+
 } // namespace arrow
 
 #endif // ARROW_TYPES_STRING_H
@@ -0,0 +1,93 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/types/struct.h"
+
+#include <sstream>
+#include <string>
+
+namespace arrow {
+
+std::string StructType::ToString() const {
+  std::stringstream s;
+  s << "struct<";
+  for (size_t i = 0; i < child_types_.size(); ++i) {
+    if (i) s << ", ";
+    s << child_types_[i]->ToString();
+  }
+  s << ">";
+  return s.str();
+}
+
+bool StructArray::RangeEquals(size_t start, size_t end, size_t other_start,
+    const Array& other) const {
+  if (this == &other && start == other_start) return true;
+  if (type_enum() != other.type_enum()) return false;
+
+  const StructArray& o = static_cast<const StructArray&>(other);
+  if (children_.size() != o.children_.size()) return false;
+  size_t length = end - start;
+  if (!util::bitmaps_equal(null_bits_, start, o.null_bits(), other_start,
+          length)) {
+    return false;
+  }
+
+  // Compare the children over each run of non-null records, skipping the
+  // placeholders of null ones
+  size_t i = 0;
+  while (i < length) {
+    if (IsNull(start + i)) {
+      ++i;
+      continue;
+    }
+    size_t run_start = i;
+    while (i < length && !IsNull(start + i)) ++i;
+    for (size_t c = 0; c < children_.size(); ++c) {
+      if (!children_[c]->RangeEquals(start + run_start, start + i,
+              other_start + run_start, *o.children_[c])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Status StructArray::Validate() const {
+  RETURN_NOT_OK(Array::Validate());
+  const StructType& type = static_cast<const StructType&>(*type_);
+  if (children_.size() != type.num_children()) {
+    return Status::Invalid("struct has " + std::to_string(children_.size()) +
+        " children but its type has " + std::to_string(type.num_children()));
+  }
+  for (size_t i = 0; i < children_.size(); ++i) {
+    std::string name = "struct child " + std::to_string(i);
+    if (!children_[i]) {
+      return Status::Invalid(name + " is missing");
+    }
+    if (children_[i]->type_enum() != type.child(i)->type) {
+      return Status::Invalid(name + " is " +
+          children_[i]->type()->ToString() + ", not " +
+          type.child(i)->ToString());
+    }
+    if (children_[i]->length() != length_) {
+      return Status::Invalid(name + " has " +
+          std::to_string(children_[i]->length()) + " slots but the struct has " +
+          std::to_string(length_));
+    }
+    RETURN_NOT_OK(children_[i]->Validate());
+  }
+  return Status::OK();
+}
+
+} // namespace arrow
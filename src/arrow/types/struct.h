@@ -18,8 +18,11 @@
 #include <string>
 #include <vector>
 
+#include "arrow/array.h"
 #include "arrow/types.h"
 
+namespace arrow {
+
 struct StructType : public CollectionType<TypeEnum::STRUCT> {
 
   typedef CollectionType<TypeEnum::STRUCT> Base;
@@ -29,7 +32,50 @@ struct StructType : public CollectionType<TypeEnum::STRUCT> {
       : Base(nullable) {
     child_types_ = child_types;
   }
+
+  static char const *name() {
+    return "struct";
+  }
+
+  virtual std::string ToString() const;
+};
+
+
+// An array of records, stored column-wise: child i holds field i of every
+// record, with one slot per record.
+//
+// The struct's null bitmap is the only one saying whether a record is null.
+// The children of a null record hold placeholder slots that need not be
+// null themselves, and are ignored by Equals
+class StructArray : public Array {
+ public:
+  StructArray() : Array() {}
+
+  StructArray(const TypePtr& type, size_t length,
+      const std::vector<ArrayPtr>& children, Buffer* nulls = nullptr) {
+    Init(type, length, children, nulls);
+  }
+
+  void Init(const TypePtr& type, size_t length,
+      const std::vector<ArrayPtr>& children, Buffer* nulls = nullptr) {
+    children_ = children;
+    Array::Init(type, length, nulls);
+  }
+
+  const ArrayPtr& child(size_t i) const { return children_[i];}
+  size_t num_children() const { return children_.size();}
+
+  virtual bool RangeEquals(size_t start, size_t end, size_t other_start,
+      const Array& other) const;
+
+  // There must be one child per child type, of that type and of the
+  // struct's length
+  virtual Status Validate() const;
+
+ protected:
+  std::vector<ArrayPtr> children_;
 };
 
+} // namespace arrow
 
 #endif // ARROW_TYPES_STRUCT_H
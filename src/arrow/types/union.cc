@@ -14,10 +14,12 @@
 
 #include "arrow/types/union.h"
 
+#include <cstring>
 #include <sstream>
 #include <string>
 
 #include "arrow/types.h"
+#include "arrow/types/integer.h"
 
 namespace arrow {
 
@@ -41,5 +43,127 @@ std::string SparseUnionType::ToString() const {
   return format_union(child_types_);
 }
 
+template <typename T>
+static const T* raw_values(const ArrayPtr& array) {
+  if (!array) return nullptr;
+  const PrimitiveArray& values = static_cast<const PrimitiveArray&>(*array);
+  return values.data() == nullptr ? nullptr :
+    reinterpret_cast<const T*>(values.data()->data());
+}
+
+void UnionArray::Init(const TypePtr& type, const ArrayPtr& types,
+    const ArrayPtr& offsets, const std::vector<ArrayPtr>& children) {
+  types_ = types;
+  offsets_ = offsets;
+  children_ = children;
+  raw_types_ = raw_values<int16_t>(types);
+  raw_offsets_ = raw_values<int32_t>(offsets);
+  Array::Init(type, types ? types->length() : 0, nullptr);
+
+  // Nulls are kept in the children
+  nullable_ = false;
+}
+
+bool UnionArray::RangeEquals(size_t start, size_t end, size_t other_start,
+    const Array& other) const {
+  if (this == &other && start == other_start) return true;
+  if (type_enum() != other.type_enum()) return false;
+  if (start == end) return true;
+
+  const UnionArray& o = static_cast<const UnionArray&>(other);
+  if (children_.size() != o.children_.size()) return false;
+  if (memcmp(raw_types_ + start, o.raw_types_ + other_start,
+          (end - start) * sizeof(int16_t)) != 0) {
+    return false;
+  }
+  for (size_t i = start, j = other_start; i < end; ++i, ++j) {
+    const Array& child = *children_[raw_types_[i]];
+    size_t offset = value_offset(i);
+    if (!child.RangeEquals(offset, offset + 1, o.value_offset(j),
+            *o.children_[raw_types_[i]])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status UnionArray::Validate() const {
+  if (!types_) {
+    return Status::Invalid("union has no type codes");
+  }
+  if (types_->type_enum() != TypeEnum::INT16) {
+    return Status::Invalid("union type codes must be int16, not " +
+        types_->type()->ToString());
+  }
+  RETURN_NOT_OK(types_->Validate());
+  if (types_->null_bits() != nullptr &&
+      util::count_set_bits(types_->null_bits(), 0, length_) > 0) {
+    return Status::Invalid("union type codes must not be null");
+  }
+
+  bool dense = type_enum() == TypeEnum::DENSE_UNION;
+  const std::vector<TypePtr>& child_types = dense ?
+    static_cast<const DenseUnionType&>(*type_).child_types_ :
+    static_cast<const SparseUnionType&>(*type_).child_types_;
+  if (children_.size() != child_types.size()) {
+    return Status::Invalid("union has " + std::to_string(children_.size()) +
+        " children but its type has " + std::to_string(child_types.size()));
+  }
+  for (size_t c = 0; c < children_.size(); ++c) {
+    std::string name = "union child " + std::to_string(c);
+    if (!children_[c]) {
+      return Status::Invalid(name + " is missing");
+    }
+    if (children_[c]->type_enum() != child_types[c]->type) {
+      return Status::Invalid(name + " is " +
+          children_[c]->type()->ToString() + ", not " +
+          child_types[c]->ToString());
+    }
+    if (!dense && children_[c]->length() != length_) {
+      return Status::Invalid(name + " has " +
+          std::to_string(children_[c]->length()) +
+          " slots but the sparse union has " + std::to_string(length_));
+    }
+    RETURN_NOT_OK(children_[c]->Validate());
+  }
+
+  // Accumulated without branching so that the loop vectorizes
+  uint16_t num_children = static_cast<uint16_t>(children_.size());
+  bool out_of_range = false;
+  for (size_t i = 0; i < length_; ++i) {
+    out_of_range |= static_cast<uint16_t>(raw_types_[i]) >= num_children;
+  }
+  if (out_of_range) {
+    return Status::Invalid("union type code out of range");
+  }
+
+  if (dense) {
+    if (!offsets_ || offsets_->type_enum() != TypeEnum::INT32 ||
+        offsets_->length() != length_) {
+      return Status::Invalid("dense union offsets must be an int32 array of "
+          "the union's length");
+    }
+    RETURN_NOT_OK(offsets_->Validate());
+    if (offsets_->null_bits() != nullptr &&
+        util::count_set_bits(offsets_->null_bits(), 0, length_) > 0) {
+      return Status::Invalid("dense union offsets must not be null");
+    }
+    std::vector<int64_t> child_lengths(children_.size());
+    for (size_t c = 0; c < children_.size(); ++c) {
+      child_lengths[c] = children_[c]->length();
+    }
+    for (size_t i = 0; i < length_; ++i) {
+      int32_t offset = raw_offsets_[i];
+      if (offset < 0 || offset >= child_lengths[raw_types_[i]]) {
+        return Status::Invalid("dense union offset " + std::to_string(i) +
+            " is outside its child");
+      }
+    }
+  } else if (offsets_) {
+    return Status::Invalid("sparse union has offsets");
+  }
+  return Status::OK();
+}
+
 
 } // namespace arrow
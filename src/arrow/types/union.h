@@ -52,30 +52,86 @@ struct SparseUnionType : public CollectionType<TypeEnum::SPARSE_UNION> {
 };
 
 
+// An array whose slot i holds a value of child types()[i], the int16 type
+// code of the slot, found at value_offset(i) in that child. Dense unions
+// store that offset per slot, so that each child has only the values of
+// its type; in sparse unions every child has one slot per union slot and the
+// offset is i.
+//
+// There is no null bitmap per slot, so IsNull is always false: nulls are
+// held by the children, for example as a child of NullType
 class UnionArray : public Array {
  public:
-  UnionArray() : Array() {}
+  UnionArray() : Array(), raw_types_(nullptr), raw_offsets_(nullptr) {}
+
+  const ArrayPtr& types() const { return types_;}
+  const int16_t* raw_types() const { return raw_types_;}
+  int16_t type_code(size_t i) const { return raw_types_[i];}
+
+  // nullptr for sparse unions
+  const ArrayPtr& offsets() const { return offsets_;}
+  const int32_t* raw_offsets() const { return raw_offsets_;}
+
+  // Neither of these functions will perform boundschecking
+  size_t value_offset(size_t i) const {
+    return raw_offsets_ == nullptr ? i : raw_offsets_[i];
+  }
+  const ArrayPtr& child(size_t i) const { return children_[i];}
+  size_t num_children() const { return children_.size();}
+
+  // Slots are equal if they have the same type code and equal values in
+  // that child
+  virtual bool RangeEquals(size_t start, size_t end, size_t other_start,
+      const Array& other) const;
+
+  // The type codes must be a non-null Int16Array naming one of the
+  // children, which must match the child types. Dense offsets must be a
+  // non-null Int32Array within the child of each slot; sparse children must
+  // be as long as the union
+  virtual Status Validate() const;
 
  protected:
-  // The data are types encoded as int16
-  Buffer* types_;
-  std::vector<std::shared_ptr<Array> > children_;
+  void Init(const TypePtr& type, const ArrayPtr& types,
+      const ArrayPtr& offsets, const std::vector<ArrayPtr>& children);
+
+  ArrayPtr types_;
+  ArrayPtr offsets_;
+  std::vector<ArrayPtr> children_;
+
+  const int16_t* raw_types_;
+  const int32_t* raw_offsets_;
 };
 
 
 class DenseUnionArray : public UnionArray {
-
  public:
   DenseUnionArray() : UnionArray() {}
 
- protected:
-  Buffer* offset_buf_;
+  DenseUnionArray(const TypePtr& type, const ArrayPtr& types,
+      const ArrayPtr& offsets, const std::vector<ArrayPtr>& children) {
+    Init(type, types, offsets, children);
+  }
+
+  void Init(const TypePtr& type, const ArrayPtr& types,
+      const ArrayPtr& offsets, const std::vector<ArrayPtr>& children) {
+    UnionArray::Init(type, types, offsets, children);
+  }
 };
 
 
 class SparseUnionArray : public UnionArray {
  public:
   SparseUnionArray() : UnionArray() {}
+
+  SparseUnionArray(const TypePtr& type, const ArrayPtr& types,
+      const std::vector<ArrayPtr>& children) {
+    Init(type, types, children);
+  }
+
+  void Init(const TypePtr& type, const ArrayPtr& types,
+      const std::vector<ArrayPtr>& children) {
+    UnionArray::Init(type, types, ArrayPtr(), children);
+  }
 };
 
 } // namespace arrow
@@ -0,0 +1,88 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Minimal timing harness for the *-benchmark executables
+
+#ifndef ARROW_UTIL_BENCHMARK_UTIL_H
+#define ARROW_UTIL_BENCHMARK_UTIL_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "arrow/memory.h"
+#include "arrow/util/status.h"
+
+namespace arrow {
+
+namespace benchmark {
+
+// Abort the benchmark if a call fails; there is nothing useful to report
+#define BENCHMARK_OK(expr)                                      \
+  do {                                                          \
+    ::arrow::Status _s = (expr);                                \
+    if (!_s.ok()) {                                             \
+      fprintf(stderr, "%s failed\n", #expr);                     \
+      abort();                                                  \
+    }                                                           \
+  } while (0)
+
+// A new buffer from pool holding a copy of values, for the input arrays
+template <typename T>
+Buffer* make_buffer(MemoryPool* pool, const std::vector<T>& values) {
+  Buffer* buf;
+  BENCHMARK_OK(pool->NewBuffer(values.size() * sizeof(T), &buf));
+  memcpy(buf->data(), values.data(), values.size() * sizeof(T));
+  return buf;
+}
+
+// Make the compiler assume value is read, so that the computation of a
+// result the benchmark never uses is not optimized away
+template <typename T>
+inline void do_not_optimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Call fn once to warm up, then repeatedly until at least min_seconds have
+// elapsed, and print the mean time per call. If bytes is nonzero, the
+// throughput (bytes processed per call) is printed as well
+template <typename Fn>
+void run(const char* name, size_t bytes, Fn fn, double min_seconds = 0.5) {
+  typedef std::chrono::steady_clock clock;
+
+  fn();
+  size_t iterations = 0;
+  double elapsed = 0;
+  clock::time_point start = clock::now();
+  do {
+    fn();
+    ++iterations;
+    elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  } while (elapsed < min_seconds);
+
+  double per_call = elapsed / iterations;
+  printf("%-50s %12.1f us", name, per_call * 1e6);
+  if (bytes > 0) {
+    printf(" %10.3f GB/s", bytes / per_call / 1e9);
+  }
+  printf("\n");
+}
+
+} // namespace benchmark
+
+} // namespace arrow
+
+#endif // ARROW_UTIL_BENCHMARK_UTIL_H
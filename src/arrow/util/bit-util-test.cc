@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <cstdlib>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -41,4 +42,100 @@ TEST(UtilTests, TestNextPower2) {
   ASSERT_EQ(1ULL << 63, next_power2((1ULL << 63) - 1));
 }
 
+TEST(UtilTests, TestLoadBits) {
+  using util::load_bits;
+
+  std::vector<uint8_t> bits = {0xF0, 0x0F, 0xAA, 0x55, 0xFF, 0x00, 0x81,
+                               0x18, 0x3C};
+
+  ASSERT_EQ(0xF0, load_bits(bits.data(), 0, 8));
+  ASSERT_EQ(0xFF, load_bits(bits.data(), 4, 8));
+  ASSERT_EQ(0x7, load_bits(bits.data(), 5, 3));
+  ASSERT_EQ(0x3C18, load_bits(bits.data(), 56, 16));
+
+  // A full word that straddles nine bytes
+  uint64_t expected = 0;
+  for (int i = 0; i < 64; ++i) {
+    size_t bit = i + 3;
+    expected |= static_cast<uint64_t>((bits[bit / 8] >> (bit % 8)) & 1) << i;
+  }
+  ASSERT_EQ(expected, load_bits(bits.data(), 3, 64));
+}
+
+TEST(UtilTests, TestBitmapsEqual) {
+  using util::bitmaps_equal;
+
+  std::vector<uint8_t> left = {0xB6, 0x01};
+  std::vector<uint8_t> right = {0x6C, 0x03};
+
+  // right is left shifted by one bit
+  ASSERT_TRUE(bitmaps_equal(left.data(), 0, right.data(), 1, 9));
+  ASSERT_FALSE(bitmaps_equal(left.data(), 0, right.data(), 0, 9));
+
+  std::vector<uint8_t> zeros = {0x00, 0x00};
+  ASSERT_TRUE(bitmaps_equal(zeros.data(), 0, nullptr, 0, 16));
+  ASSERT_FALSE(bitmaps_equal(left.data(), 0, nullptr, 0, 16));
+}
+
+TEST(UtilTests, TestCopyBits) {
+  std::vector<uint8_t> bytes;
+  for (int i = 0; i < 200; ++i) {
+    bytes.push_back(static_cast<uint8_t>((i * 7) % 3 == 0));
+  }
+  size_t nbytes = 0;
+  uint8_t* src = util::bytes_to_bits(bytes.data(), bytes.size(), &nbytes);
+
+  for (size_t src_offset : {0, 3, 8, 61}) {
+    for (size_t dst_offset : {0, 5, 16, 67}) {
+      size_t length = bytes.size() - src_offset;
+      std::vector<uint8_t> dst(util::ceil_byte(dst_offset + length) / 8 + 1,
+          0xFF);
+      util::copy_bits(src, src_offset, length, dst.data(), dst_offset);
+
+      for (size_t i = 0; i < dst_offset; ++i) {
+        ASSERT_TRUE(util::get_bit(dst.data(), i));
+      }
+      for (size_t i = 0; i < length; ++i) {
+        ASSERT_EQ(static_cast<bool>(bytes[src_offset + i]),
+            util::get_bit(dst.data(), dst_offset + i));
+      }
+      // Bits past the end are untouched
+      for (size_t i = dst_offset + length; i < dst.size() * 8; ++i) {
+        ASSERT_TRUE(util::get_bit(dst.data(), i));
+      }
+    }
+  }
+  free(src);
+}
+
+TEST(UtilTests, TestCountSetBits) {
+  std::vector<uint8_t> bits = {0xFF, 0x01, 0x80, 0x00, 0x0F, 0xF0, 0xAA, 0x55,
+                               0x3C};
+  ASSERT_EQ(8, util::count_set_bits(bits.data(), 0, 8));
+  ASSERT_EQ(9, util::count_set_bits(bits.data(), 0, 9));
+  ASSERT_EQ(5, util::count_set_bits(bits.data(), 4, 8));
+  ASSERT_EQ(30, util::count_set_bits(bits.data(), 0, 72));
+  ASSERT_EQ(26, util::count_set_bits(bits.data(), 3, 66));
+}
+
+TEST(UtilTests, TestVisitSetRuns) {
+  std::vector<uint8_t> bytes(200, 0);
+  std::vector<std::pair<size_t, size_t> > runs = {{0, 3}, {10, 1}, {20, 100},
+                                                  {130, 70}};
+  for (auto& run : runs) {
+    for (size_t i = run.first; i < run.first + run.second; ++i) {
+      bytes[i] = 1;
+    }
+  }
+  size_t nbytes;
+  uint8_t* bits = util::bytes_to_bits(bytes.data(), bytes.size(), &nbytes);
+
+  std::vector<std::pair<size_t, size_t> > visited;
+  util::visit_set_runs(bits, bytes.size(), [&](size_t start, size_t length) {
+        visited.push_back({start, length});
+      });
+  ASSERT_EQ(runs, visited);
+  free(bits);
+}
+
 } // namespace arrow
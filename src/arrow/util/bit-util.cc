@@ -18,6 +18,31 @@
 
 namespace arrow {
 
+size_t util::count_set_bits(const uint8_t* bits, size_t offset, size_t length) {
+  size_t count = 0;
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    count += __builtin_popcountll(load_bits(bits, offset + i, n));
+  }
+  return count;
+}
+
+void util::copy_bits(const uint8_t* src, size_t src_offset, size_t length,
+    uint8_t* dst, size_t dst_offset) {
+  if (src_offset % 8 == 0 && dst_offset % 8 == 0) {
+    // Whole bytes can be copied directly
+    size_t nbytes = length / 8;
+    memcpy(dst + dst_offset / 8, src + src_offset / 8, nbytes);
+    src_offset += nbytes * 8;
+    dst_offset += nbytes * 8;
+    length -= nbytes * 8;
+  }
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    store_bits(dst, dst_offset + i, load_bits(src, src_offset + i, n), n);
+  }
+}
+
 void util::bytes_to_bits(uint8_t* bytes, size_t length, uint8_t* bits) {
   for (size_t i = 0; i < length; ++i) {
     set_bit(bits, i, static_cast<bool>(bytes[i]));
@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
 namespace arrow {
 
@@ -52,6 +53,161 @@ static inline size_t next_power2(size_t n) {
   return n;
 }
 
+// Load up to 64 bits starting at an arbitrary bit position into the low bits
+// of a word. Only the bytes covering [offset, offset + nbits) are touched, so
+// this is safe to use at the tail of a bitmap. Assumes little-endian
+static inline uint64_t load_bits(const uint8_t* bits, size_t offset,
+    size_t nbits) {
+  const uint8_t* base = bits + offset / 8;
+  size_t shift = offset % 8;
+  size_t nbytes = (shift + nbits + 7) / 8;
+
+  uint64_t word = 0;
+  memcpy(&word, base, nbytes < 8 ? nbytes : 8);
+  word >>= shift;
+  if (nbytes > 8) {
+    word |= static_cast<uint64_t>(base[8]) << (64 - shift);
+  }
+  if (nbits < 64) {
+    word &= (static_cast<uint64_t>(1) << nbits) - 1;
+  }
+  return word;
+}
+
+// Store the low nbits (at most 64) of word starting at an arbitrary bit
+// position, leaving the surrounding bits untouched. Assumes little-endian
+static inline void store_bits(uint8_t* bits, size_t offset, uint64_t word,
+    size_t nbits) {
+  uint8_t* base = bits + offset / 8;
+  size_t shift = offset % 8;
+  size_t nbytes = (shift + nbits + 7) / 8;
+  uint64_t mask = nbits < 64 ? (static_cast<uint64_t>(1) << nbits) - 1 :
+    ~static_cast<uint64_t>(0);
+  word &= mask;
+
+  uint64_t current = 0;
+  size_t low_bytes = nbytes < 8 ? nbytes : 8;
+  memcpy(&current, base, low_bytes);
+  current = (current & ~(mask << shift)) | (word << shift);
+  memcpy(base, &current, low_bytes);
+  if (nbytes > 8) {
+    uint8_t high_mask = static_cast<uint8_t>(mask >> (64 - shift));
+    base[8] = (base[8] & ~high_mask) |
+      (static_cast<uint8_t>(word >> (64 - shift)) & high_mask);
+  }
+}
+
+// Set the bits [offset, offset + length) to 1
+static inline void set_bits(uint8_t* bits, size_t offset, size_t length) {
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    store_bits(bits, offset + i, ~static_cast<uint64_t>(0), n);
+  }
+}
+
+// Compare length bits of two bitmaps starting at arbitrary bit offsets. A
+// nullptr bitmap compares as all zeros
+static inline bool bitmaps_equal(const uint8_t* left, size_t left_offset,
+    const uint8_t* right, size_t right_offset, size_t length) {
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t lword = left == nullptr ? 0 : load_bits(left, left_offset + i, n);
+    uint64_t rword = right == nullptr ? 0 :
+      load_bits(right, right_offset + i, n);
+    if (lword != rword) return false;
+  }
+  return true;
+}
+
+// Unsigned integer type with the given width in bytes, for bitwise
+// comparisons of arbitrary fixed-width values
+template <size_t WIDTH> struct uint_for_width {};
+template <> struct uint_for_width<1> { typedef uint8_t type;};
+template <> struct uint_for_width<2> { typedef uint16_t type;};
+template <> struct uint_for_width<4> { typedef uint32_t type;};
+template <> struct uint_for_width<8> { typedef uint64_t type;};
+
+// Compare two runs of length values slot by slot with the predicate eq,
+// 64 slots at a time. A slot that is null on both sides is skipped, and one
+// that is null on only one side is a mismatch. The null bitmaps are read
+// starting at the given bit offsets; nullptr means there are no nulls
+template <typename T, typename Predicate>
+static inline bool masked_equals(const T* left, const uint8_t* left_nulls,
+    size_t left_offset, const T* right, const uint8_t* right_nulls,
+    size_t right_offset, size_t length, Predicate eq) {
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t lnull = left_nulls == nullptr ? 0 :
+      load_bits(left_nulls, left_offset + i, n);
+    uint64_t rnull = right_nulls == nullptr ? 0 :
+      load_bits(right_nulls, right_offset + i, n);
+    if (lnull != rnull) return false;
+
+    // The comparisons are evaluated without branching so that the inner
+    // loops vectorize; null slots are masked out afterwards
+    if (lnull == 0) {
+      bool all_equal = true;
+      for (size_t j = 0; j < n; ++j) {
+        all_equal &= eq(left[i + j], right[i + j]);
+      }
+      if (!all_equal) return false;
+    } else {
+      uint64_t mismatch = 0;
+      for (size_t j = 0; j < n; ++j) {
+        mismatch |= static_cast<uint64_t>(!eq(left[i + j], right[i + j])) << j;
+      }
+      if (mismatch & ~lnull) return false;
+    }
+  }
+  return true;
+}
+
+// Call visit(start, length) for each maximal run of set bits in the first
+// length bits of bits, in order. Whole words of zeros or ones are skipped in
+// one step
+template <typename Visitor>
+static inline void visit_set_runs(const uint8_t* bits, size_t length,
+    Visitor visit) {
+  bool in_run = false;
+  size_t run_start = 0;
+  for (size_t i = 0; i < length; i += 64) {
+    size_t n = length - i < 64 ? length - i : 64;
+    uint64_t word = load_bits(bits, i, n);
+    uint64_t full = n < 64 ? (static_cast<uint64_t>(1) << n) - 1 :
+      ~static_cast<uint64_t>(0);
+    if (word == (in_run ? full : 0)) continue;
+
+    // Walk the transitions within the word
+    size_t pos = 0;
+    while (pos < n) {
+      if (in_run) {
+        uint64_t zeros = (~word & full) >> pos;
+        if (zeros == 0) break;
+        pos += __builtin_ctzll(zeros);
+        visit(run_start, i + pos - run_start);
+        in_run = false;
+      } else {
+        uint64_t ones = word >> pos;
+        if (ones == 0) break;
+        pos += __builtin_ctzll(ones);
+        run_start = i + pos;
+        in_run = true;
+      }
+    }
+  }
+  if (in_run) {
+    visit(run_start, length - run_start);
+  }
+}
+
+// Number of set bits in [offset, offset + length)
+size_t count_set_bits(const uint8_t* bits, size_t offset, size_t length);
+
+// Copy length bits from src starting at bit src_offset into dst starting at
+// bit dst_offset. The offsets need not be byte aligned
+void copy_bits(const uint8_t* src, size_t src_offset, size_t length,
+    uint8_t* dst, size_t dst_offset);
+
 void bytes_to_bits(uint8_t* bytes, size_t length, uint8_t* bits);
 uint8_t* bytes_to_bits(uint8_t* bytes, size_t length, size_t* out_length);
 
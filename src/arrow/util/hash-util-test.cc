@@ -0,0 +1,112 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/util/hash-util.h"
+#include "arrow/util/string-hash-table.h"
+
+namespace arrow {
+
+TEST(HashUtilTests, TestCrc32c) {
+  // Standard CRC32C check value, with the usual inversion on both ends
+  std::string check = "123456789";
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(check.data());
+  ASSERT_EQ(0xE3069283, ~util::crc32c(~0U, data, check.size()));
+  ASSERT_EQ(0xE3069283, ~util::crc32c_portable(~0U, data, check.size()));
+}
+
+TEST(HashUtilTests, TestHardwareMatchesPortable) {
+  std::vector<uint8_t> data(100);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+  for (size_t length = 0; length <= data.size(); ++length) {
+    ASSERT_EQ(util::crc32c_portable(12345, data.data(), length),
+        util::crc32c(12345, data.data(), length));
+  }
+
+  uint64_t word = 0x0123456789ABCDEFULL;
+  ASSERT_EQ(util::crc32c_portable(7, reinterpret_cast<uint8_t*>(&word), 8),
+      util::crc32c_u64(7, word));
+}
+
+TEST(HashUtilTests, TestHashBytes) {
+  std::string a = "hello world, hashed";
+  std::string b = a;
+  const uint8_t* a_data = reinterpret_cast<const uint8_t*>(a.data());
+  const uint8_t* b_data = reinterpret_cast<const uint8_t*>(b.data());
+  ASSERT_EQ(util::hash_bytes(util::kHashSeed, a_data, a.size()),
+      util::hash_bytes(util::kHashSeed, b_data, b.size()));
+  ASSERT_NE(util::hash_bytes(util::kHashSeed, a_data, a.size()),
+      util::hash_bytes(util::kHashSeed, a_data, a.size() - 1));
+
+  // Split points matter when strings are hashed one after another
+  uint64_t h1 = util::hash_bytes(util::kHashSeed, a_data, 2);
+  h1 = util::hash_bytes(h1, a_data + 2, 1);
+  uint64_t h2 = util::hash_bytes(util::kHashSeed, a_data, 1);
+  h2 = util::hash_bytes(h2, a_data + 1, 2);
+  ASSERT_NE(h1, h2);
+
+  // Both halves of the hash depend on the input
+  uint64_t x = util::hash_word(util::kHashSeed, 1);
+  uint64_t y = util::hash_word(util::kHashSeed, 2);
+  ASSERT_NE(x >> 32, y >> 32);
+  ASSERT_NE(x & 0xFFFFFFFF, y & 0xFFFFFFFF);
+  ASSERT_NE((x ^ y) >> 32, (x ^ y) & 0xFFFFFFFF);
+}
+
+TEST(HashUtilTests, TestStringHashTable) {
+  util::StringHashTable table(4);
+  std::vector<std::string> strings;
+  for (int i = 0; i < 1000; ++i) {
+    strings.push_back(std::to_string(i * 7919));
+  }
+  strings.push_back("");
+
+  // Inserting grows the table many times over
+  for (size_t i = 0; i < strings.size(); ++i) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(strings[i].data());
+    ASSERT_EQ(util::StringHashTable::kNotFound,
+        table.Get(data, strings[i].size()));
+    ASSERT_EQ(i, table.GetOrInsert(data, strings[i].size()));
+  }
+  ASSERT_EQ(strings.size(), table.size());
+
+  for (size_t i = 0; i < strings.size(); ++i) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(strings[i].data());
+    ASSERT_EQ(i, table.GetOrInsert(data, strings[i].size()));
+    ASSERT_EQ(i, table.Get(data, strings[i].size()));
+
+    // Stored contiguously in id order
+    int32_t start = table.offsets()[i];
+    std::string stored(table.bytes().begin() + start,
+        table.bytes().begin() + table.offsets()[i + 1]);
+    ASSERT_EQ(strings[i], stored);
+  }
+  ASSERT_EQ(strings.size(), table.size());
+
+  table.Clear();
+  ASSERT_EQ(0, table.size());
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(strings[5].data());
+  ASSERT_EQ(util::StringHashTable::kNotFound,
+      table.Get(data, strings[5].size()));
+  ASSERT_EQ(0, table.GetOrInsert(data, strings[5].size()));
+}
+
+} // namespace arrow
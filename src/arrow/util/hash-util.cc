@@ -0,0 +1,54 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/util/hash-util.h"
+
+namespace arrow {
+
+namespace util {
+
+namespace {
+
+// Reflected Castagnoli polynomial
+static constexpr uint32_t kCrc32cPoly = 0x82F63B78;
+
+struct Crc32cTable {
+  uint32_t entries[256];
+
+  Crc32cTable() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc >> 1) ^ (kCrc32cPoly & (0 - (crc & 1)));
+      }
+      entries[i] = crc;
+    }
+  }
+};
+
+static const Crc32cTable kCrc32cTable;
+
+} // namespace
+
+uint32_t crc32c_portable(uint32_t crc, const uint8_t* data, size_t length) {
+  const uint32_t* table = kCrc32cTable.entries;
+  for (size_t i = 0; i < length; ++i) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+} // namespace util
+
+} // namespace arrow
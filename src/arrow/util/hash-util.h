@@ -0,0 +1,109 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// CRC32C-based hashing of values and byte strings
+
+#ifndef ARROW_UTIL_HASH_UTIL_H
+#define ARROW_UTIL_HASH_UTIL_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+namespace arrow {
+
+namespace util {
+
+// Table-driven CRC32C (Castagnoli polynomial), used where the SSE4.2 crc32
+// instruction is not available. Like the instruction, no bit inversion is
+// applied to crc on the way in or out
+uint32_t crc32c_portable(uint32_t crc, const uint8_t* data, size_t length);
+
+// Whether crc32c_u64 and crc32c use the SSE4.2 crc32 instruction
+static constexpr bool kHardwareCrc32c =
+#ifdef __SSE4_2__
+  true;
+#else
+  false;
+#endif
+
+static inline uint32_t crc32c_u64(uint32_t crc, uint64_t value) {
+#ifdef __SSE4_2__
+  return static_cast<uint32_t>(_mm_crc32_u64(crc, value));
+#else
+  uint8_t bytes[8];
+  memcpy(bytes, &value, 8);
+  return crc32c_portable(crc, bytes, 8);
+#endif
+}
+
+static inline uint32_t crc32c(uint32_t crc, const uint8_t* data,
+    size_t length) {
+#ifdef __SSE4_2__
+  for (; length >= 8; data += 8, length -= 8) {
+    uint64_t word;
+    memcpy(&word, data, 8);
+    crc = static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+  }
+  for (; length > 0; ++data, --length) {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+  return crc;
+#else
+  return crc32c_portable(crc, data, length);
+#endif
+}
+
+// Initial state for hash_word / hash_bytes
+static constexpr uint64_t kHashSeed = 0x2545F4914F6CDD1DULL;
+
+// Mix a 64-bit word into a 64-bit hash state. The state is two independent
+// CRC32C lanes. CRC is linear, so two lanes over the same input would only
+// differ by a constant; the high lane instead hashes a multiplied copy of
+// the word
+static inline uint64_t hash_word(uint64_t hash, uint64_t word) {
+  uint32_t lo = crc32c_u64(static_cast<uint32_t>(hash), word);
+  uint32_t hi = crc32c_u64(static_cast<uint32_t>(hash >> 32),
+      word * 0x9E3779B97F4A7C15ULL);
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+
+// Mix length bytes into a hash state, 8 bytes at a time. The length is
+// mixed in last so that consecutive byte strings hashed into the same state
+// cannot run together ("ab", "c" and "a", "bc" hash differently)
+static inline uint64_t hash_bytes(uint64_t hash, const uint8_t* data,
+    size_t length) {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, 8);
+    hash = hash_word(hash, word);
+  }
+  if (i < length) {
+    uint64_t word = 0;
+    memcpy(&word, data + i, length - i);
+    hash = hash_word(hash, word);
+  }
+  return hash_word(hash, length);
+}
+
+} // namespace util
+
+} // namespace arrow
+
+#endif // ARROW_UTIL_HASH_UTIL_H
@@ -0,0 +1,59 @@
+// Copyright 2016 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/util/prefix-sum.h"
+
+namespace arrow {
+
+template <typename T>
+static void CheckPrefixSum(size_t length, T base) {
+  std::vector<T> values(length);
+  for (size_t i = 0; i < length; ++i) {
+    values[i] = static_cast<T>((i * 37 + 11) % 101);
+  }
+  std::vector<T> expected(values);
+  T sum = base;
+  for (size_t i = 0; i < length; ++i) {
+    sum += expected[i];
+    expected[i] = sum;
+  }
+  util::prefix_sum(values.data(), length, base);
+  ASSERT_EQ(expected, values);
+}
+
+TEST(PrefixSumTests, TestInt32) {
+  // Lengths around the vector width exercise the scalar tail
+  for (size_t length = 0; length <= 20; ++length) {
+    CheckPrefixSum<int32_t>(length, 0);
+    CheckPrefixSum<int32_t>(length, 1000);
+  }
+  CheckPrefixSum<int32_t>(10001, 7);
+}
+
+TEST(PrefixSumTests, TestInt64) {
+  for (size_t length = 0; length <= 20; ++length) {
+    CheckPrefixSum<int64_t>(length, 0);
+    CheckPrefixSum<int64_t>(length, 1000);
+  }
+  // Sums past the range of int32
+  CheckPrefixSum<int64_t>(10001, std::numeric_limits<int32_t>::max());
+}
+
+} // namespace arrow
@@ -0,0 +1,82 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// In-place prefix sums, as used to turn string lengths into offsets
+
+#ifndef ARROW_UTIL_PREFIX_SUM_H
+#define ARROW_UTIL_PREFIX_SUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace arrow {
+
+namespace util {
+
+// Replace values[i] by base + values[0] + ... + values[i]. The sums wrap
+// around on overflow, so callers must check that the total fits
+static inline void prefix_sum(int32_t* values, size_t length, int32_t base) {
+  size_t i = 0;
+#ifdef __SSE2__
+  // Scan each 4-lane register with two shifted adds, then add the running
+  // total carried over in every lane from the previous register
+  __m128i carry = _mm_set1_epi32(base);
+  for (; i + 4 <= length; i += 4) {
+    __m128i* p = reinterpret_cast<__m128i*>(values + i);
+    __m128i x = _mm_loadu_si128(p);
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi32(x, carry);
+    _mm_storeu_si128(p, x);
+    carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+  }
+  base = _mm_cvtsi128_si32(carry);
+#endif
+  uint32_t sum = static_cast<uint32_t>(base);
+  for (; i < length; ++i) {
+    sum += static_cast<uint32_t>(values[i]);
+    values[i] = static_cast<int32_t>(sum);
+  }
+}
+
+static inline void prefix_sum(int64_t* values, size_t length, int64_t base) {
+  size_t i = 0;
+#ifdef __SSE2__
+  __m128i carry = _mm_set1_epi64x(base);
+  for (; i + 2 <= length; i += 2) {
+    __m128i* p = reinterpret_cast<__m128i*>(values + i);
+    __m128i x = _mm_loadu_si128(p);
+    x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi64(x, carry);
+    _mm_storeu_si128(p, x);
+    carry = _mm_unpackhi_epi64(x, x);
+  }
+  base = _mm_cvtsi128_si64(carry);
+#endif
+  uint64_t sum = static_cast<uint64_t>(base);
+  for (; i < length; ++i) {
+    sum += static_cast<uint64_t>(values[i]);
+    values[i] = static_cast<int64_t>(sum);
+  }
+}
+
+} // namespace util
+
+} // namespace arrow
+
+#endif // ARROW_UTIL_PREFIX_SUM_H
@@ -33,4 +33,43 @@ const char* Status::CopyState(const char* state) {
   return result;
 }
 
+std::string Status::CodeAsString() const {
+  if (state_ == NULL) {
+    return "OK";
+  }
+
+  const char* type;
+  switch (code()) {
+    case StatusCode::OutOfMemory:
+      type = "Out of memory";
+      break;
+    case StatusCode::KeyError:
+      type = "Key error";
+      break;
+    case StatusCode::Invalid:
+      type = "Invalid";
+      break;
+    case StatusCode::NotImplemented:
+      type = "Not implemented";
+      break;
+    default:
+      type = "Unknown";
+      break;
+  }
+  return std::string(type);
+}
+
+std::string Status::ToString() const {
+  std::string result(CodeAsString());
+  if (state_ == NULL) {
+    return result;
+  }
+
+  uint32_t length;
+  memcpy(&length, state_, sizeof(length));
+  result.append(": ");
+  result.append(state_ + 7, length);
+  return result;
+}
+
 } // namespace arrow
@@ -103,6 +103,9 @@ class Status {
   bool IsOutOfMemory() const { return code() == StatusCode::OutOfMemory; }
   bool IsKeyError() const { return code() == StatusCode::KeyError; }
   bool IsInvalid() const { return code() == StatusCode::Invalid; }
+  bool IsNotImplemented() const {
+    return code() == StatusCode::NotImplemented;
+  }
 
   // Return a string representation of this status suitable for printing.
   // Returns the string "OK" for success.
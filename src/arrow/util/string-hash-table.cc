@@ -0,0 +1,58 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/util/string-hash-table.h"
+
+#include <algorithm>
+
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+
+namespace util {
+
+constexpr int32_t StringHashTable::kNotFound;
+
+StringHashTable::StringHashTable(size_t capacity) {
+  capacity = next_power2(capacity < 2 ? 2 : capacity);
+  slots_.assign(capacity, Slot{0, kNotFound});
+  mask_ = capacity - 1;
+  offsets_.push_back(0);
+}
+
+void StringHashTable::Clear() {
+  std::fill(slots_.begin(), slots_.end(), Slot{0, kNotFound});
+  offsets_.resize(1);
+  bytes_.clear();
+}
+
+void StringHashTable::Grow() {
+  std::vector<Slot> old_slots(slots_.size() * 2, Slot{0, kNotFound});
+  old_slots.swap(slots_);
+  mask_ = slots_.size() - 1;
+
+  // The stored hashes are reused, and the strings are known to be distinct
+  for (const Slot& slot : old_slots) {
+    if (slot.id == kNotFound) continue;
+    size_t pos = slot.hash & mask_;
+    while (slots_[pos].id != kNotFound) {
+      pos = (pos + 1) & mask_;
+    }
+    slots_[pos] = slot;
+  }
+}
+
+} // namespace util
+
+} // namespace arrow
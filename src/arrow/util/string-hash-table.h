@@ -0,0 +1,132 @@
+// Copyright 2016 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ARROW_UTIL_STRING_HASH_TABLE_H
+#define ARROW_UTIL_STRING_HASH_TABLE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "arrow/util/hash-util.h"
+
+namespace arrow {
+
+namespace util {
+
+// Open-addressing hash table that interns byte strings, giving each distinct
+// string the next consecutive id. The distinct strings are stored back to
+// back in insertion order with int32 offsets, i.e. in the layout of a
+// StringArray, so they can be copied out as one.
+//
+// Slots hold the full 64-bit hash next to the id, so probes only touch the
+// string bytes on a hash match. Linear probing; the table doubles when it is
+// half full
+class StringHashTable {
+ public:
+  static constexpr int32_t kNotFound = -1;
+
+  explicit StringHashTable(size_t capacity = 64);
+
+  // The id of the string, inserting it if not yet present
+  int32_t GetOrInsert(const uint8_t* data, size_t length) {
+    return GetOrInsert(hash_bytes(kHashSeed, data, length), data, length);
+  }
+
+  // As above, with the hash_bytes(kHashSeed, ...) of the string computed
+  // by the caller, e.g. for a whole batch of strings up front
+  int32_t GetOrInsert(uint64_t hash, const uint8_t* data, size_t length) {
+    size_t pos = Find(hash, data, length);
+    if (slots_[pos].id != kNotFound) {
+      return slots_[pos].id;
+    }
+
+    int32_t id = static_cast<int32_t>(size());
+    slots_[pos].hash = hash;
+    slots_[pos].id = id;
+    bytes_.insert(bytes_.end(), data, data + length);
+    offsets_.push_back(static_cast<int32_t>(bytes_.size()));
+    if (size() * 2 > slots_.size()) {
+      Grow();
+    }
+    return id;
+  }
+
+  // The id of the string, or kNotFound
+  int32_t Get(const uint8_t* data, size_t length) const {
+    return Get(hash_bytes(kHashSeed, data, length), data, length);
+  }
+
+  int32_t Get(uint64_t hash, const uint8_t* data, size_t length) const {
+    return slots_[Find(hash, data, length)].id;
+  }
+
+  // Pull the first slot probed for hash into the cache ahead of a lookup
+  void Prefetch(uint64_t hash) const {
+    __builtin_prefetch(slots_.data() + (hash & mask_));
+  }
+
+  // Number of distinct strings
+  size_t size() const { return offsets_.size() - 1;}
+
+  // Bytes of the distinct strings so far
+  size_t num_bytes() const { return bytes_.size();}
+
+  // size() + 1 offsets into bytes(), in id order
+  const std::vector<int32_t>& offsets() const { return offsets_;}
+  const std::vector<uint8_t>& bytes() const { return bytes_;}
+
+  // Remove all strings, keeping the allocated capacity
+  void Clear();
+
+ private:
+  struct Slot {
+    uint64_t hash;
+    int32_t id;
+  };
+
+  // The slot holding the string, or the empty slot where it would go
+  size_t Find(uint64_t hash, const uint8_t* data, size_t length) const {
+    size_t pos = hash & mask_;
+    while (true) {
+      const Slot& slot = slots_[pos];
+      if (slot.id == kNotFound) {
+        return pos;
+      }
+      if (slot.hash == hash) {
+        int32_t start = offsets_[slot.id];
+        if (static_cast<size_t>(offsets_[slot.id + 1] - start) == length &&
+            memcmp(bytes_.data() + start, data, length) == 0) {
+          return pos;
+        }
+      }
+      pos = (pos + 1) & mask_;
+    }
+  }
+
+  void Grow();
+
+  std::vector<Slot> slots_;
+  size_t mask_;
+
+  std::vector<int32_t> offsets_;
+  std::vector<uint8_t> bytes_;
+};
+
+} // namespace util
+
+} // namespace arrow
+
+#endif // ARROW_UTIL_STRING_HASH_TABLE_H
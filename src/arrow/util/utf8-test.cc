@@ -0,0 +1,70 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "arrow/util/utf8.h"
+
+using std::string;
+
+namespace arrow {
+
+static bool IsValid(const string& s) {
+  return util::validate_utf8(reinterpret_cast<const uint8_t*>(s.data()),
+      s.size());
+}
+
+TEST(Utf8Tests, TestValid) {
+  ASSERT_TRUE(IsValid(""));
+  ASSERT_TRUE(IsValid("abc"));
+  ASSERT_TRUE(IsValid("\xC3\xA9"));
+  ASSERT_TRUE(IsValid("\xE2\x82\xAC"));
+  ASSERT_TRUE(IsValid("\xF0\x9F\x98\x80"));
+  ASSERT_TRUE(IsValid("\xF4\x8F\xBF\xBF"));
+  ASSERT_TRUE(IsValid("\xED\x9F\xBF"));
+  ASSERT_TRUE(IsValid(string(100, 'a') + "\xC3\xA9" + string(100, 'b')));
+}
+
+TEST(Utf8Tests, TestInvalid) {
+  // Stray continuation byte and invalid lead bytes
+  ASSERT_FALSE(IsValid("\x80"));
+  ASSERT_FALSE(IsValid("\xFF"));
+  ASSERT_FALSE(IsValid("\xF8\x88\x80\x80\x80"));
+
+  // Truncated sequences
+  ASSERT_FALSE(IsValid("\xC3"));
+  ASSERT_FALSE(IsValid("\xE2\x82"));
+  ASSERT_FALSE(IsValid("\xE2\x82" "a"));
+
+  // Overlong encodings
+  ASSERT_FALSE(IsValid("\xC0\xAF"));
+  ASSERT_FALSE(IsValid("\xE0\x80\xAF"));
+  ASSERT_FALSE(IsValid("\xF0\x80\x80\xAF"));
+
+  // Surrogates and code points past U+10FFFF
+  ASSERT_FALSE(IsValid("\xED\xA0\x80"));
+  ASSERT_FALSE(IsValid("\xF4\x90\x80\x80"));
+
+  // A bad byte at every position around the 32-byte blocks
+  for (size_t pos = 0; pos < 70; ++pos) {
+    string s(70, 'a');
+    s[pos] = '\x80';
+    ASSERT_FALSE(IsValid(s)) << pos;
+  }
+}
+
+} // namespace arrow
@@ -0,0 +1,82 @@
+// Copyright 2015 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arrow/util/utf8.h"
+
+#include <cstring>
+
+namespace arrow {
+
+namespace util {
+
+static constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+bool validate_utf8(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  while (i < length) {
+    // The words are combined before testing so that the check vectorizes
+    if (length - i >= 32) {
+      uint64_t words[4];
+      memcpy(words, data + i, sizeof(words));
+      if (((words[0] | words[1] | words[2] | words[3]) & kHighBits) == 0) {
+        i += 32;
+        continue;
+      }
+    }
+
+    uint8_t c = data[i];
+    if (c < 0x80) {
+      ++i;
+      continue;
+    }
+
+    // The number of continuation bytes and the smallest code point that
+    // needs this many
+    size_t ncont;
+    uint32_t min;
+    uint32_t code_point;
+    if ((c & 0xE0) == 0xC0) {
+      ncont = 1;
+      min = 0x80;
+      code_point = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+      ncont = 2;
+      min = 0x800;
+      code_point = c & 0x0F;
+    } else if ((c & 0xF8) == 0xF0) {
+      ncont = 3;
+      min = 0x10000;
+      code_point = c & 0x07;
+    } else {
+      return false;
+    }
+    if (length - i - 1 < ncont) return false;
+
+    for (size_t k = 1; k <= ncont; ++k) {
+      uint8_t b = data[i + k];
+      if ((b & 0xC0) != 0x80) return false;
+      code_point = (code_point << 6) | (b & 0x3F);
+    }
+    if (code_point < min || code_point > 0x10FFFF ||
+        (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+      return false;
+    }
+    i += ncont + 1;
+  }
+  return true;
+}
+
+} // namespace util
+
+} // namespace arrow
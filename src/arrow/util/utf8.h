@@ -0,0 +1,36 @@
+// Copyright 2015 Cloudera Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// UTF-8 validation
+
+#ifndef ARROW_UTIL_UTF8_H
+#define ARROW_UTIL_UTF8_H
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace arrow {
+
+namespace util {
+
+// Whether data[0, length) is valid UTF-8: every sequence is complete, and
+// there are no overlong encodings, surrogates or code points past U+10FFFF.
+// Runs of ASCII are skipped 32 bytes at a time
+bool validate_utf8(const uint8_t* data, size_t length);
+
+} // namespace util
+
+} // namespace arrow
+
+#endif // ARROW_UTIL_UTF8_H